@@ -0,0 +1,319 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "bench"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "bench.h"
+#include "gbox/core/impl/polygon_raster.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default iterations
+#define GB_BENCH_ITERATIONS_DEFAULT     (8)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the counting allocator type
+typedef struct __gb_bench_allocator_t
+{
+    // the base
+    tb_allocator_t          base;
+
+    // the native allocator
+    tb_allocator_ref_t      native;
+
+    // the allocations count
+    tb_atomic_t             count;
+
+}gb_bench_allocator_t;
+
+// the bench op type
+typedef struct __gb_bench_op_t
+{
+    // the op name
+    tb_char_t const*        name;
+
+    // the tessellator mode, (tb_size_t)-1: polygon raster
+    tb_size_t               mode;
+
+}gb_bench_op_t;
+
+// the bench result type
+typedef struct __gb_bench_result_t
+{
+    // the polygons count
+    tb_size_t               polygons;
+
+    // the edges count
+    tb_size_t               edges;
+
+    // the outputs count, contours for the tessellator and spans for the raster
+    tb_size_t               outputs;
+
+    // the allocations count
+    tb_size_t               allocs;
+
+    // the elapsed time (us)
+    tb_hong_t               time;
+
+}gb_bench_result_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the counting allocator
+static gb_bench_allocator_t     g_allocator;
+
+// the inputs
+static gb_bench_input_maker_t   g_inputs[] =
+{
+    gb_bench_input_make_stars
+,   gb_bench_input_make_spirals
+,   gb_bench_input_make_holes
+,   gb_bench_input_make_tiger
+,   gb_bench_input_make_maps
+};
+
+// the ops
+static gb_bench_op_t            g_ops[] =
+{
+    { "tessellator_convex",         GB_TESSELLATOR_MODE_CONVEX          }
+,   { "tessellator_monotone",       GB_TESSELLATOR_MODE_MONOTONE        }
+,   { "tessellator_triangulation",  GB_TESSELLATOR_MODE_TRIANGULATION   }
+,   { "polygon_raster",             (tb_size_t)-1                       }
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * allocator
+ */
+static tb_pointer_t gb_bench_allocator_malloc(tb_allocator_ref_t allocator, tb_size_t size __tb_debug_decl__)
+{
+    gb_bench_allocator_t* impl = (gb_bench_allocator_t*)allocator;
+    tb_atomic_fetch_and_inc(&impl->count);
+    return tb_allocator_malloc_(impl->native, size __tb_debug_args__);
+}
+static tb_pointer_t gb_bench_allocator_ralloc(tb_allocator_ref_t allocator, tb_pointer_t data, tb_size_t size __tb_debug_decl__)
+{
+    gb_bench_allocator_t* impl = (gb_bench_allocator_t*)allocator;
+    tb_atomic_fetch_and_inc(&impl->count);
+    return tb_allocator_ralloc_(impl->native, data, size __tb_debug_args__);
+}
+static tb_bool_t gb_bench_allocator_free(tb_allocator_ref_t allocator, tb_pointer_t data __tb_debug_decl__)
+{
+    gb_bench_allocator_t* impl = (gb_bench_allocator_t*)allocator;
+    return tb_allocator_free_(impl->native, data __tb_debug_args__);
+}
+static tb_pointer_t gb_bench_allocator_large_malloc(tb_allocator_ref_t allocator, tb_size_t size, tb_size_t* real __tb_debug_decl__)
+{
+    gb_bench_allocator_t* impl = (gb_bench_allocator_t*)allocator;
+    tb_atomic_fetch_and_inc(&impl->count);
+    return tb_allocator_large_malloc_(impl->native, size, real __tb_debug_args__);
+}
+static tb_pointer_t gb_bench_allocator_large_ralloc(tb_allocator_ref_t allocator, tb_pointer_t data, tb_size_t size, tb_size_t* real __tb_debug_decl__)
+{
+    gb_bench_allocator_t* impl = (gb_bench_allocator_t*)allocator;
+    tb_atomic_fetch_and_inc(&impl->count);
+    return tb_allocator_large_ralloc_(impl->native, data, size, real __tb_debug_args__);
+}
+static tb_bool_t gb_bench_allocator_large_free(tb_allocator_ref_t allocator, tb_pointer_t data __tb_debug_decl__)
+{
+    gb_bench_allocator_t* impl = (gb_bench_allocator_t*)allocator;
+    return tb_allocator_large_free_(impl->native, data __tb_debug_args__);
+}
+static tb_allocator_ref_t gb_bench_allocator_init()
+{
+    // init it
+    tb_memset(&g_allocator, 0, sizeof(g_allocator));
+    g_allocator.base.type           = TB_ALLOCATOR_NATIVE;
+    g_allocator.base.malloc         = gb_bench_allocator_malloc;
+    g_allocator.base.ralloc         = gb_bench_allocator_ralloc;
+    g_allocator.base.free           = gb_bench_allocator_free;
+    g_allocator.base.large_malloc   = gb_bench_allocator_large_malloc;
+    g_allocator.base.large_ralloc   = gb_bench_allocator_large_ralloc;
+    g_allocator.base.large_free     = gb_bench_allocator_large_free;
+    g_allocator.native              = tb_native_allocator();
+
+    // init lock
+    tb_spinlock_init(&g_allocator.base.lock);
+
+    // ok
+    return (tb_allocator_ref_t)&g_allocator;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_bench_tessellator_func(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // count the output contours
+    (*((tb_size_t*)priv))++;
+}
+static tb_void_t gb_bench_raster_func(tb_long_t lx, tb_long_t rx, tb_long_t yb, tb_long_t ye, tb_cpointer_t priv)
+{
+    // count the output spans
+    (*((tb_size_t*)priv))++;
+}
+static tb_void_t gb_bench_done_input(gb_bench_input_ref_t input, gb_bench_op_t const* op, tb_size_t iterations, gb_bench_result_t* result)
+{
+    // check
+    tb_assert_and_check_return(input && op && iterations && result);
+
+    // init result
+    tb_memset(result, 0, sizeof(gb_bench_result_t));
+
+    // init tessellator or raster
+    gb_tessellator_ref_t    tessellator = tb_null;
+    gb_polygon_raster_ref_t raster      = tb_null;
+    if (op->mode != (tb_size_t)-1)
+    {
+        tessellator = gb_tessellator_init();
+        tb_assert_and_check_return(tessellator);
+
+        gb_tessellator_mode_set(tessellator, op->mode);
+        gb_tessellator_rule_set(tessellator, GB_TESSELLATOR_RULE_NONZERO);
+        gb_tessellator_func_set(tessellator, gb_bench_tessellator_func, &result->outputs);
+    }
+    else
+    {
+        raster = gb_polygon_raster_init();
+        tb_assert_and_check_return(raster);
+    }
+
+    // count edges and warm up the caches, the polygons of the paths have been made here
+    tb_size_t i = 0;
+    for (i = 0; i < input->count; i++)
+    {
+        // the polygon and bounds
+        gb_polygon_ref_t    polygon = gb_path_polygon(input->paths[i]);
+        gb_rect_ref_t       bounds  = gb_path_bounds(input->paths[i]);
+        tb_check_continue(polygon && polygon->points && polygon->counts && bounds);
+
+        // count edges, the contour is closed and the first point is repeated
+        tb_uint16_t const*  counts = polygon->counts;
+        tb_uint16_t         count;
+        while ((count = *counts++)) result->edges += count - 1;
+        result->polygons++;
+
+        // warm up
+        if (tessellator) gb_tessellator_done(tessellator, polygon, bounds);
+        else gb_polygon_raster_done(raster, polygon, bounds, GB_POLYGON_RASTER_RULE_NONZERO, gb_bench_raster_func, &result->outputs);
+    }
+
+    // reset counters
+    result->outputs = 0;
+    tb_size_t allocs = (tb_size_t)tb_atomic_get(&g_allocator.count);
+
+    // done
+    tb_size_t   n = 0;
+    tb_hong_t   time = tb_uclock();
+    for (n = 0; n < iterations; n++)
+    {
+        for (i = 0; i < input->count; i++)
+        {
+            // the polygon and bounds
+            gb_polygon_ref_t    polygon = gb_path_polygon(input->paths[i]);
+            gb_rect_ref_t       bounds  = gb_path_bounds(input->paths[i]);
+            tb_check_continue(polygon && polygon->points && polygon->counts && bounds);
+
+            // done it
+            if (tessellator) gb_tessellator_done(tessellator, polygon, bounds);
+            else gb_polygon_raster_done(raster, polygon, bounds, GB_POLYGON_RASTER_RULE_NONZERO, gb_bench_raster_func, &result->outputs);
+        }
+    }
+    result->time    = tb_uclock() - time;
+    result->allocs  = (tb_size_t)tb_atomic_get(&g_allocator.count) - allocs;
+
+    // exit tessellator
+    if (tessellator) gb_tessellator_exit(tessellator);
+    tessellator = tb_null;
+
+    // exit raster
+    if (raster) gb_polygon_raster_exit(raster);
+    raster = tb_null;
+}
+static tb_void_t gb_bench_dump_result(gb_bench_input_ref_t input, gb_bench_op_t const* op, tb_size_t iterations, gb_bench_result_t const* result)
+{
+    // check
+    tb_assert_and_check_return(input && op && iterations && result);
+
+    // the totals
+    tb_hize_t polygons  = (tb_hize_t)result->polygons * iterations;
+    tb_hize_t edges     = (tb_hize_t)result->edges * iterations;
+    tb_hize_t time      = (tb_hize_t)tb_max(result->time, 1);
+    tb_check_return(polygons);
+
+    // the results
+    tb_hize_t ns_per_polygon        = (time * 1000) / polygons;
+    tb_hize_t edges_per_second      = (edges * 1000000) / time;
+    tb_hize_t allocs_per_polygon    = ((tb_hize_t)result->allocs * 100) / polygons;
+
+    // dump it as the json line for tracking the regression
+    tb_printf("{\"input\": \"%s\", \"op\": \"%s\", \"polygons\": %lu, \"edges\": %lu, \"iterations\": %lu, \"time_us\": %llu, \"ns_per_polygon\": %llu, \"edges_per_second\": %llu, \"allocs\": %lu, \"allocs_per_polygon\": %llu.%02llu, \"outputs\": %lu}\n"
+            ,   input->name
+            ,   op->name
+            ,   result->polygons
+            ,   result->edges
+            ,   iterations
+            ,   time
+            ,   ns_per_polygon
+            ,   edges_per_second
+            ,   result->allocs
+            ,   allocs_per_polygon / 100
+            ,   allocs_per_polygon % 100
+            ,   result->outputs / iterations);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t main(tb_int_t argc, tb_char_t** argv)
+{
+    // init tbox with the counting allocator
+    if (!tb_init(tb_null, gb_bench_allocator_init())) return 0;
+
+    // init gbox
+    if (!gb_init()) return 0;
+
+    // the iterations: bench [iterations]
+    tb_size_t iterations = (argc > 1 && argv[1])? tb_atoi(argv[1]) : GB_BENCH_ITERATIONS_DEFAULT;
+    if (!iterations) iterations = GB_BENCH_ITERATIONS_DEFAULT;
+
+    // done
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(g_inputs); i++)
+    {
+        // make input
+        gb_bench_input_t input = {0};
+        if (g_inputs[i](&input))
+        {
+            // done ops
+            tb_size_t j = 0;
+            for (j = 0; j < tb_arrayn(g_ops); j++)
+            {
+                gb_bench_result_t result;
+                gb_bench_done_input(&input, &g_ops[j], iterations, &result);
+                gb_bench_dump_result(&input, &g_ops[j], iterations, &result);
+            }
+        }
+        else tb_trace_e("make input failed!");
+
+        // exit input
+        gb_bench_input_exit(&input);
+    }
+
+    // exit gbox
+    gb_exit();
+
+    // exit tbox
+    tb_exit();
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2009 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        bench.h
+ *
+ */
+#ifndef GB_BENCH_H
+#define GB_BENCH_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "gbox/gbox.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bench input type
+typedef struct __gb_bench_input_t
+{
+    // the input name
+    tb_char_t const*        name;
+
+    // the paths
+    gb_path_ref_t*          paths;
+
+    // the paths count
+    tb_size_t               count;
+
+}gb_bench_input_t, *gb_bench_input_ref_t;
+
+/* the bench input maker type
+ *
+ * @param input             the input
+ *
+ * @return                  tb_true or tb_false
+ */
+typedef tb_bool_t           (*gb_bench_input_maker_t)(gb_bench_input_ref_t input);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* make the random stars
+ *
+ * all inputs are generated from the fixed seed, so the results are reproducible
+ *
+ * @param input             the input
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   gb_bench_input_make_stars(gb_bench_input_ref_t input);
+
+/* make the self-intersecting spirals
+ *
+ * @param input             the input
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   gb_bench_input_make_spirals(gb_bench_input_ref_t input);
+
+/* make the polygons with many holes
+ *
+ * @param input             the input
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   gb_bench_input_make_holes(gb_bench_input_ref_t input);
+
+/* make the tiger paths
+ *
+ * @param input             the input
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   gb_bench_input_make_tiger(gb_bench_input_ref_t input);
+
+/* make the large map contours
+ *
+ * @param input             the input
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   gb_bench_input_make_maps(gb_bench_input_ref_t input);
+
+/* exit the input
+ *
+ * @param input             the input
+ */
+tb_void_t                   gb_bench_input_exit(gb_bench_input_ref_t input);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
@@ -0,0 +1,337 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "bench_input"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "bench.h"
+#include "../demo/core/tiger.g"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the random seed
+#define GB_BENCH_INPUT_SEED             (0x2015)
+
+// the stars count
+#define GB_BENCH_INPUT_STARS            (1024)
+
+// the spirals count
+#define GB_BENCH_INPUT_SPIRALS          (64)
+
+// the polygons count with many holes
+#define GB_BENCH_INPUT_HOLES            (32)
+
+// the map tiles count
+#define GB_BENCH_INPUT_MAPS             (16)
+
+// the contours count of the map tile
+#define GB_BENCH_INPUT_MAP_CONTOURS     (4)
+
+// the points count of the map contour
+#define GB_BENCH_INPUT_MAP_POINTS       (2048)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_uint32_t gb_bench_input_random(tb_uint32_t* seed)
+{
+    // the linear congruential generator, we do not use tb_random() for reproducing the inputs on all platforms
+    *seed = *seed * 1103515245 + 12345;
+    return (*seed >> 16) & 0x7fff;
+}
+static __tb_inline__ gb_float_t gb_bench_input_random_float(tb_uint32_t* seed, gb_float_t minv, gb_float_t maxv)
+{
+    // [minv, maxv)
+    return minv + gb_imuldiv(maxv - minv, gb_bench_input_random(seed), 0x8000);
+}
+static tb_bool_t gb_bench_input_init(gb_bench_input_ref_t input, tb_char_t const* name, tb_size_t count)
+{
+    // check
+    tb_assert_and_check_return_val(input && name && count, tb_false);
+
+    // init paths
+    input->name     = name;
+    input->count    = count;
+    input->paths    = tb_nalloc0_type(count, gb_path_ref_t);
+    tb_assert_and_check_return_val(input->paths, tb_false);
+
+    // done
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        input->paths[i] = gb_path_init();
+        tb_assert_and_check_return_val(input->paths[i], tb_false);
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_bench_input_make_spiral(gb_path_ref_t path, gb_float_t x0, gb_float_t y0, tb_size_t turns, gb_float_t step)
+{
+    // the points count of one turn
+    tb_size_t n = 32;
+
+    // move to the center
+    gb_path_move2_to(path, x0, y0);
+
+    // done
+    tb_size_t i = 0;
+    for (i = 1; i <= turns * n; i++)
+    {
+        // the angle and radius
+        gb_float_t angle    = gb_idiv(gb_imul(GB_PI, 2 * (i % n)), n);
+        gb_float_t radius   = gb_idiv(gb_imul(step, i), n);
+
+        // line to the next point
+        gb_float_t s;
+        gb_float_t c;
+        gb_sincos(angle, &s, &c);
+        gb_path_line2_to(path, x0 + gb_mul(radius, c), y0 + gb_mul(radius, s));
+    }
+
+    // close it and the closed edge will cross all turns
+    gb_path_clos(path);
+}
+static tb_char_t const* gb_bench_input_tiger_float(tb_char_t const* p, gb_float_t* value)
+{
+    // skip the separators
+    while (*p && (tb_isspace(*p) || *p == ',')) p++;
+
+    // parse it
+    *value = tb_float_to_gb((tb_float_t)tb_s10tod(p));
+
+    // skip the number
+    if (*p == '-') p++;
+    while (*p && (tb_isdigit10(*p) || *p == '.')) p++;
+
+    // ok
+    return p;
+}
+static tb_void_t gb_bench_input_tiger_path(gb_path_ref_t path, tb_char_t const* d)
+{
+    // the tiger paths only use the absolute commands: M, L, C and z
+    tb_char_t           mode = '\0';
+    tb_char_t const*    p = d;
+    gb_float_t          v[6];
+    while (*p)
+    {
+        // skip the separators
+        while (*p && (tb_isspace(*p) || *p == ',')) p++;
+        tb_check_break(*p);
+
+        // the command?
+        if (tb_isalpha(*p))
+        {
+            mode = *p++;
+            if (mode == 'z' || mode == 'Z') gb_path_clos(path);
+            continue ;
+        }
+
+        // done
+        switch (mode)
+        {
+        case 'M':
+            p = gb_bench_input_tiger_float(p, &v[0]);
+            p = gb_bench_input_tiger_float(p, &v[1]);
+            gb_path_move2_to(path, v[0], v[1]);
+            break;
+        case 'L':
+            p = gb_bench_input_tiger_float(p, &v[0]);
+            p = gb_bench_input_tiger_float(p, &v[1]);
+            gb_path_line2_to(path, v[0], v[1]);
+            break;
+        case 'C':
+            p = gb_bench_input_tiger_float(p, &v[0]);
+            p = gb_bench_input_tiger_float(p, &v[1]);
+            p = gb_bench_input_tiger_float(p, &v[2]);
+            p = gb_bench_input_tiger_float(p, &v[3]);
+            p = gb_bench_input_tiger_float(p, &v[4]);
+            p = gb_bench_input_tiger_float(p, &v[5]);
+            gb_path_cubic2_to(path, v[0], v[1], v[2], v[3], v[4], v[5]);
+            break;
+        default:
+            // unknown command, skip it
+            tb_trace_noimpl();
+            p++;
+            break;
+        }
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_bench_input_make_stars(gb_bench_input_ref_t input)
+{
+    // init input
+    if (!gb_bench_input_init(input, "stars", GB_BENCH_INPUT_STARS)) return tb_false;
+
+    // done
+    tb_size_t   i = 0;
+    tb_uint32_t seed = GB_BENCH_INPUT_SEED;
+    for (i = 0; i < input->count; i++)
+    {
+        // the star
+        gb_path_ref_t   path    = input->paths[i];
+        tb_size_t       n       = 5 + gb_bench_input_random(&seed) % 28;
+        gb_float_t      x0      = gb_bench_input_random_float(&seed, 0, gb_long_to_float(1024));
+        gb_float_t      y0      = gb_bench_input_random_float(&seed, 0, gb_long_to_float(1024));
+        gb_float_t      r1      = gb_bench_input_random_float(&seed, gb_long_to_float(20), gb_long_to_float(80));
+        gb_float_t      r0      = gb_mul(r1, gb_bench_input_random_float(&seed, GB_ONE / 4, GB_ONE * 3 / 4));
+
+        // make the outer and inner points
+        tb_size_t k = 0;
+        for (k = 0; k < (n << 1); k++)
+        {
+            // the angle and radius with some jitters
+            gb_float_t angle    = gb_idiv(gb_imul(GB_PI, k), n);
+            gb_float_t radius   = (k & 1)? r0 : r1;
+            radius = gb_mul(radius, gb_bench_input_random_float(&seed, GB_ONE * 7 / 8, GB_ONE * 9 / 8));
+
+            // the point
+            gb_float_t s;
+            gb_float_t c;
+            gb_sincos(angle, &s, &c);
+            if (!k) gb_path_move2_to(path, x0 + gb_mul(radius, c), y0 + gb_mul(radius, s));
+            else gb_path_line2_to(path, x0 + gb_mul(radius, c), y0 + gb_mul(radius, s));
+        }
+        gb_path_clos(path);
+    }
+
+    // ok
+    return tb_true;
+}
+tb_bool_t gb_bench_input_make_spirals(gb_bench_input_ref_t input)
+{
+    // init input
+    if (!gb_bench_input_init(input, "spirals", GB_BENCH_INPUT_SPIRALS)) return tb_false;
+
+    // done
+    tb_size_t   i = 0;
+    tb_uint32_t seed = GB_BENCH_INPUT_SEED;
+    for (i = 0; i < input->count; i++)
+    {
+        // make spiral
+        gb_float_t x0 = gb_bench_input_random_float(&seed, 0, gb_long_to_float(1024));
+        gb_float_t y0 = gb_bench_input_random_float(&seed, 0, gb_long_to_float(1024));
+        gb_bench_input_make_spiral(input->paths[i], x0, y0, 4 + gb_bench_input_random(&seed) % 9, gb_bench_input_random_float(&seed, gb_long_to_float(8), gb_long_to_float(24)));
+    }
+
+    // ok
+    return tb_true;
+}
+tb_bool_t gb_bench_input_make_holes(gb_bench_input_ref_t input)
+{
+    // init input
+    if (!gb_bench_input_init(input, "holes", GB_BENCH_INPUT_HOLES)) return tb_false;
+
+    // done
+    tb_size_t   i = 0;
+    tb_uint32_t seed = GB_BENCH_INPUT_SEED;
+    for (i = 0; i < input->count; i++)
+    {
+        // the outer contour
+        gb_path_ref_t path = input->paths[i];
+        gb_path_add_rect2i(path, 0, 0, 512, 512, GB_ROTATE_DIRECTION_CW);
+
+        // the holes in the grid with the reversed direction
+        tb_size_t n = 8 + gb_bench_input_random(&seed) % 9;
+        tb_size_t w = 512 / n;
+        tb_size_t x = 0;
+        tb_size_t y = 0;
+        for (y = 0; y < n; y++)
+        {
+            for (x = 0; x < n; x++)
+            {
+                // circle or rect hole
+                if (gb_bench_input_random(&seed) & 1) gb_path_add_circle2i(path, x * w + (w >> 1), y * w + (w >> 1), w / 3, GB_ROTATE_DIRECTION_CCW);
+                else gb_path_add_rect2i(path, x * w + (w >> 2), y * w + (w >> 2), w >> 1, w >> 1, GB_ROTATE_DIRECTION_CCW);
+            }
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+tb_bool_t gb_bench_input_make_tiger(gb_bench_input_ref_t input)
+{
+    // init input, the tiger data is the pair list of the style and path
+    if (!gb_bench_input_init(input, "tiger", tb_arrayn(g_demo_tiger) >> 1)) return tb_false;
+
+    // done
+    tb_size_t i = 0;
+    for (i = 0; i < input->count; i++)
+        gb_bench_input_tiger_path(input->paths[i], g_demo_tiger[(i << 1) + 1]);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t gb_bench_input_make_maps(gb_bench_input_ref_t input)
+{
+    // init input
+    if (!gb_bench_input_init(input, "maps", GB_BENCH_INPUT_MAPS)) return tb_false;
+
+    // done
+    tb_size_t   i = 0;
+    tb_uint32_t seed = GB_BENCH_INPUT_SEED;
+    for (i = 0; i < input->count; i++)
+    {
+        // make the contours of this map tile
+        gb_path_ref_t   path = input->paths[i];
+        tb_size_t       j = 0;
+        for (j = 0; j < GB_BENCH_INPUT_MAP_CONTOURS; j++)
+        {
+            // the center and radius of this contour
+            gb_float_t x0       = gb_long_to_float(256 + (j & 1) * 512);
+            gb_float_t y0       = gb_long_to_float(256 + (j >> 1) * 512);
+            gb_float_t radius   = gb_long_to_float(200);
+
+            // make the coastline using the random walk of the radius
+            tb_size_t k = 0;
+            for (k = 0; k < GB_BENCH_INPUT_MAP_POINTS; k++)
+            {
+                // walk the radius
+                radius += gb_bench_input_random_float(&seed, -gb_long_to_float(4), gb_long_to_float(4));
+                radius = tb_max(radius, gb_long_to_float(120));
+                radius = tb_min(radius, gb_long_to_float(250));
+
+                // the point
+                gb_float_t s;
+                gb_float_t c;
+                gb_float_t angle = gb_idiv(gb_imul(GB_PI, k << 1), GB_BENCH_INPUT_MAP_POINTS);
+                gb_sincos(angle, &s, &c);
+                if (!k) gb_path_move2_to(path, x0 + gb_mul(radius, c), y0 + gb_mul(radius, s));
+                else gb_path_line2_to(path, x0 + gb_mul(radius, c), y0 + gb_mul(radius, s));
+            }
+            gb_path_clos(path);
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_bench_input_exit(gb_bench_input_ref_t input)
+{
+    // check
+    tb_assert_and_check_return(input);
+
+    // exit paths
+    if (input->paths)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < input->count; i++)
+        {
+            if (input->paths[i]) gb_path_exit(input->paths[i]);
+        }
+        tb_free(input->paths);
+    }
+
+    // clear it
+    input->paths = tb_null;
+    input->count = 0;
+}
@@ -1,16 +1,92 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
- */ 
+ */
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t gb_demo_core_bitmap_dirty_is(gb_bitmap_ref_t bitmap, tb_size_t generation, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h)
+{
+    // get the dirty rect
+    gb_rect_t rect;
+    if (!gb_bitmap_dirty(bitmap, generation, &rect)) return tb_false;
+
+    // trace
+    tb_trace_d("dirty: %{rect}", &rect);
+
+    // equal?
+    return (    gb_float_to_long(rect.x) == x && gb_float_to_long(rect.y) == y
+            &&  gb_float_to_long(rect.w) == w && gb_float_to_long(rect.h) == h)? tb_true : tb_false;
+}
+static tb_void_t gb_demo_core_bitmap_invalidate()
+{
+    // init bitmap
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_PIXFMT_ARGB8888 | GB_PIXFMT_NENDIAN, 100, 100, 0, tb_true);
+    if (!bitmap) tb_abort();
+
+    // invalidate the fractional rect, it will be expanded to the pixels
+    gb_rect_t rect;
+    tb_size_t generation = gb_bitmap_generation(bitmap);
+    gb_rect_make(&rect, gb_long_to_float(10) + GB_ONE / 2, gb_long_to_float(10) + GB_ONE / 4, gb_long_to_float(20), gb_long_to_float(20));
+    gb_bitmap_invalidate(bitmap, &rect);
+    if (gb_bitmap_generation(bitmap) != generation + 1) tb_abort();
+    if (!gb_demo_core_bitmap_dirty_is(bitmap, generation, 10, 10, 21, 21)) tb_abort();
+
+    // merge the other rect
+    gb_rect_imake(&rect, 50, 40, 10, 5);
+    gb_bitmap_invalidate(bitmap, &rect);
+    if (gb_bitmap_generation(bitmap) != generation + 2) tb_abort();
+    if (!gb_demo_core_bitmap_dirty_is(bitmap, generation, 10, 10, 50, 35)) tb_abort();
+
+    // the synchronized copy is updated
+    gb_bitmap_dirty_clear(bitmap);
+    generation = gb_bitmap_generation(bitmap);
+    if (!gb_demo_core_bitmap_dirty_is(bitmap, generation, 0, 0, 0, 0)) tb_abort();
+
+    // invalidate the rect which is partially out of the bitmap, it will be clipped
+    gb_rect_imake(&rect, -5, 90, 10, 20);
+    gb_bitmap_invalidate(bitmap, &rect);
+    if (gb_bitmap_generation(bitmap) != generation + 1) tb_abort();
+    if (!gb_demo_core_bitmap_dirty_is(bitmap, generation, 0, 90, 5, 10)) tb_abort();
+
+    // invalidate the rect out of the bitmap, nothing is changed
+    gb_rect_imake(&rect, 200, 200, 10, 10);
+    gb_bitmap_invalidate(bitmap, &rect);
+    if (gb_bitmap_generation(bitmap) != generation + 1) tb_abort();
+
+#ifdef GB_CONFIG_DEVICE_HAVE_BITMAP
+    // clear the clipped rect by the canvas, only this rect is changed
+    gb_canvas_ref_t canvas = gb_canvas_init_from_bitmap(bitmap);
+    if (!canvas) tb_abort();
+    gb_bitmap_dirty_clear(bitmap);
+    generation = gb_bitmap_generation(bitmap);
+    gb_rect_imake(&rect, 20, 30, 40, 10);
+    gb_canvas_clip_rect(canvas, GB_CLIPPER_MODE_REPLACE, &rect);
+    gb_canvas_draw_clear(canvas, GB_COLOR_RED);
+    if (gb_bitmap_generation(bitmap) == generation) tb_abort();
+    if (!gb_demo_core_bitmap_dirty_is(bitmap, generation, 20, 30, 40, 10)) tb_abort();
+    gb_canvas_exit(canvas);
+#endif
+
+    // exit bitmap
+    gb_bitmap_exit(bitmap);
+
+    // trace
+    tb_trace_i("invalidate: ok");
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
 tb_int_t gb_demo_core_bitmap_main(tb_int_t argc, tb_char_t** argv)
 {
+    // check the invalidated rects
+    gb_demo_core_bitmap_invalidate();
+
     // init bitmap
 //    gb_bitmap_ref_t bitmap = gb_bitmap_init_from_url(GB_PIXFMT_ARGB8888, argv[1]);
-    gb_bitmap_ref_t bitmap = gb_bitmap_init_from_url(GB_PIXFMT_RGB565, argv[1]);
+    gb_bitmap_ref_t bitmap = argv[1]? gb_bitmap_init_from_url(GB_PIXFMT_RGB565, argv[1]) : tb_null;
     if (bitmap)
     {
         // trace
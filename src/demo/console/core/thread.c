@@ -0,0 +1,397 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the bitmap width
+#define GB_DEMO_THREAD_WIDTH            (256)
+
+// the bitmap height
+#define GB_DEMO_THREAD_HEIGHT           (256)
+
+// the bitmap pixfmt
+#define GB_DEMO_THREAD_PIXFMT           (GB_PIXFMT_ARGB8888 | GB_PIXFMT_NENDIAN)
+
+// the scene count
+#define GB_DEMO_THREAD_SCENE_MAXN       (3)
+
+// the quality count
+#define GB_DEMO_THREAD_QUALITY_MAXN     (GB_QUALITY_TOP + 1)
+
+// the default threads count
+#define GB_DEMO_THREAD_COUNT            (4)
+
+// the default rounds count
+#define GB_DEMO_THREAD_ROUNDS           (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the scene func type
+typedef tb_void_t                       (*gb_demo_thread_scene_func_t)(gb_canvas_ref_t canvas);
+
+// the worker type
+typedef struct __gb_demo_thread_worker_t
+{
+    // the quality
+    tb_size_t                           quality;
+
+    // the rounds
+    tb_size_t                           rounds;
+
+    // the failed count
+    tb_size_t                           failed;
+
+    // the thread
+    tb_thread_ref_t                     thread;
+
+}gb_demo_thread_worker_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the serial references, only be read by the workers
+static gb_bitmap_ref_t                  g_references[GB_DEMO_THREAD_SCENE_MAXN][GB_DEMO_THREAD_QUALITY_MAXN];
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * scenes
+ */
+static tb_void_t gb_demo_thread_scene_shapes(gb_canvas_ref_t canvas)
+{
+    // fill shapes
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+
+    // draw rects
+    gb_canvas_color_set(canvas, GB_COLOR_RED);
+    gb_canvas_draw_rect2i(canvas, 10, 10, 100, 60);
+    gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+    gb_canvas_alpha_set(canvas, 128);
+    gb_canvas_draw_rect2i(canvas, 60, 40, 100, 60);
+    gb_canvas_alpha_set(canvas, 255);
+
+    // draw circle, it is transparent at the low quality
+    gb_canvas_color_set(canvas, GB_COLOR_GREEN);
+    gb_canvas_alpha_set(canvas, 12);
+    gb_canvas_draw_circle2i(canvas, 190, 60, 50);
+
+    // draw ellipse, it is opaque at the low quality
+    gb_canvas_color_set(canvas, GB_COLOR_YELLOW);
+    gb_canvas_alpha_set(canvas, 244);
+    gb_canvas_draw_ellipse2i(canvas, 80, 180, 70, 40);
+    gb_canvas_alpha_set(canvas, 255);
+
+    // draw round rect
+    gb_rect_t bounds;
+    gb_rect_imake(&bounds, 150, 140, 90, 100);
+    gb_canvas_color_set(canvas, GB_COLOR_BLACK);
+    gb_canvas_draw_round_rect2i(canvas, &bounds, 20, 30);
+}
+static tb_void_t gb_demo_thread_scene_strokes(gb_canvas_ref_t canvas)
+{
+    // stroke shapes
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+    gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+
+    // draw lines with all caps
+    tb_size_t cap = 0;
+    for (cap = 0; cap < 3; cap++)
+    {
+        gb_canvas_stroke_cap_set(canvas, cap);
+        gb_canvas_stroke_width_set(canvas, gb_long_to_float(4 + (cap << 2)));
+        gb_canvas_draw_line2i(canvas, 20, 20 + cap * 30, 230, 40 + cap * 30);
+    }
+
+    // draw polylines with all joins
+    gb_path_ref_t path = gb_path_init();
+    if (path)
+    {
+        tb_size_t join = 0;
+        for (join = 0; join < 3; join++)
+        {
+            // make polyline
+            gb_path_clear(path);
+            gb_path_move2i_to(path, 20 + join * 80, 220);
+            gb_path_line2i_to(path, 50 + join * 80, 130);
+            gb_path_line2i_to(path, 80 + join * 80, 220);
+
+            // draw it
+            gb_canvas_stroke_join_set(canvas, join);
+            gb_canvas_stroke_width_set(canvas, gb_long_to_float(10));
+            gb_canvas_draw_path(canvas, path);
+        }
+
+        // exit path
+        gb_path_exit(path);
+    }
+
+    // draw circle
+    gb_canvas_color_set(canvas, GB_COLOR_RED);
+    gb_canvas_stroke_width_set(canvas, GB_ONE);
+    gb_canvas_draw_circle2i(canvas, 128, 128, 120);
+}
+static tb_void_t gb_demo_thread_scene_path(gb_canvas_ref_t canvas)
+{
+    // init path
+    gb_path_ref_t path = gb_path_init();
+    tb_assert_and_check_return(path);
+
+    // make a self-intersecting star with curves
+    gb_path_move2i_to(path, 0, -100);
+    gb_path_quad2i_to(path, 30, -30, 95, -31);
+    gb_path_line2i_to(path, -59, 81);
+    gb_path_cubic2i_to(path, -20, 0, 20, 0, 59, 81);
+    gb_path_line2i_to(path, -95, -31);
+    gb_path_clos(path);
+    gb_path_add_circle2i(path, 0, 0, 30, GB_ROTATE_DIRECTION_CW);
+
+    // rotate it around the center
+    gb_matrix_ref_t matrix = gb_canvas_save_matrix(canvas);
+    if (matrix)
+    {
+        gb_matrix_translate(matrix, gb_long_to_float(128), gb_long_to_float(128));
+        gb_matrix_rotate(matrix, gb_long_to_float(15));
+    }
+
+    // fill it using the even-odd rule
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_fill_rule_set(canvas, GB_PAINT_FILL_RULE_ODD);
+    gb_canvas_color_set(canvas, GB_COLOR_GREEN);
+    gb_canvas_draw_path(canvas, path);
+
+    // stroke it
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+    gb_canvas_stroke_width_set(canvas, gb_long_to_float(3));
+    gb_canvas_color_set(canvas, GB_COLOR_BLACK);
+    gb_canvas_draw_path(canvas, path);
+
+    // leave matrix
+    if (matrix) gb_canvas_load_matrix(canvas);
+
+    // exit path
+    gb_path_exit(path);
+}
+
+// the scenes
+static gb_demo_thread_scene_func_t      g_scenes[GB_DEMO_THREAD_SCENE_MAXN] =
+{
+    gb_demo_thread_scene_shapes
+,   gb_demo_thread_scene_strokes
+,   gb_demo_thread_scene_path
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static gb_bitmap_ref_t gb_demo_thread_render(tb_size_t scene, tb_size_t quality)
+{
+    // check
+    tb_assert_and_check_return_val(scene < tb_arrayn(g_scenes), tb_null);
+
+    // the quality is thread-local, set it for this thread
+    gb_quality_set(quality);
+
+    // init bitmap
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_DEMO_THREAD_PIXFMT, GB_DEMO_THREAD_WIDTH, GB_DEMO_THREAD_HEIGHT, 0, tb_true);
+    tb_assert_and_check_return_val(bitmap, tb_null);
+
+    // init canvas
+#ifdef GB_CONFIG_DEVICE_HAVE_BITMAP
+    gb_canvas_ref_t canvas = gb_canvas_init_from_bitmap(bitmap);
+#else
+    gb_canvas_ref_t canvas = tb_null;
+#endif
+    if (canvas)
+    {
+        // clear it
+        gb_canvas_draw_clear(canvas, GB_COLOR_WHITE);
+
+        // draw scene
+        g_scenes[scene](canvas);
+
+        // exit canvas
+        gb_canvas_exit(canvas);
+    }
+    else
+    {
+        // exit bitmap
+        gb_bitmap_exit(bitmap);
+        bitmap = tb_null;
+    }
+
+    // ok?
+    return bitmap;
+}
+static tb_bool_t gb_demo_thread_equal(gb_bitmap_ref_t bitmap, gb_bitmap_ref_t reference)
+{
+    // check
+    tb_check_return_val(bitmap && reference, tb_false);
+
+    // the size
+    tb_size_t size = gb_bitmap_size(bitmap);
+    tb_check_return_val(size == gb_bitmap_size(reference), tb_false);
+
+    // compare them bit by bit
+    return !tb_memcmp(gb_bitmap_data(bitmap), gb_bitmap_data(reference), size);
+}
+static gb_bitmap_ref_t gb_demo_thread_blank()
+{
+    // init bitmap
+    gb_bitmap_ref_t bitmap = gb_bitmap_init(tb_null, GB_DEMO_THREAD_PIXFMT, GB_DEMO_THREAD_WIDTH, GB_DEMO_THREAD_HEIGHT, 0, tb_true);
+    tb_assert_and_check_return_val(bitmap, tb_null);
+
+    // init canvas
+#ifdef GB_CONFIG_DEVICE_HAVE_BITMAP
+    gb_canvas_ref_t canvas = gb_canvas_init_from_bitmap(bitmap);
+#else
+    gb_canvas_ref_t canvas = tb_null;
+#endif
+    if (canvas)
+    {
+        // only clear it
+        gb_canvas_draw_clear(canvas, GB_COLOR_WHITE);
+
+        // exit canvas
+        gb_canvas_exit(canvas);
+    }
+    else
+    {
+        // exit bitmap
+        gb_bitmap_exit(bitmap);
+        bitmap = tb_null;
+    }
+
+    // ok?
+    return bitmap;
+}
+static tb_pointer_t gb_demo_thread_loop(tb_cpointer_t priv)
+{
+    // check
+    gb_demo_thread_worker_t* worker = (gb_demo_thread_worker_t*)priv;
+    tb_assert_and_check_return_val(worker, tb_null);
+
+    // done rounds
+    tb_size_t round = 0;
+    for (round = 0; round < worker->rounds; round++)
+    {
+        // render all scenes
+        tb_size_t scene = 0;
+        for (scene = 0; scene < tb_arrayn(g_scenes); scene++)
+        {
+            // render it
+            gb_bitmap_ref_t bitmap = gb_demo_thread_render(scene, worker->quality);
+
+            // compare it with the serial reference
+            if (!gb_demo_thread_equal(bitmap, g_references[scene][worker->quality]))
+            {
+                // trace
+                tb_trace_e("thread[%lx]: scene %lu with quality %lu is different from the serial reference", tb_thread_self(), scene, worker->quality);
+
+                // failed
+                worker->failed++;
+            }
+
+            // exit bitmap
+            if (bitmap) gb_bitmap_exit(bitmap);
+        }
+    }
+
+    // exit thread
+    tb_thread_return(tb_null);
+    return tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_core_thread_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the threads and rounds count
+    tb_size_t count     = argv[1]? tb_atoi(argv[1]) : GB_DEMO_THREAD_COUNT;
+    tb_size_t rounds    = (argv[1] && argv[2])? tb_atoi(argv[2]) : GB_DEMO_THREAD_ROUNDS;
+    tb_assert_and_check_return_val(count && rounds, -1);
+
+    // init workers
+    gb_demo_thread_worker_t* workers = tb_nalloc0_type(count, gb_demo_thread_worker_t);
+    tb_assert_and_check_return_val(workers, -1);
+
+    // render the serial references for all scenes and qualities
+    tb_bool_t ok = tb_true;
+    tb_size_t scene = 0;
+    tb_size_t quality = 0;
+    for (scene = 0; scene < tb_arrayn(g_scenes); scene++)
+    {
+        for (quality = 0; quality < GB_DEMO_THREAD_QUALITY_MAXN; quality++)
+        {
+            g_references[scene][quality] = gb_demo_thread_render(scene, quality);
+            if (!g_references[scene][quality]) ok = tb_false;
+        }
+    }
+
+    // the references must be drawn, otherwise all blank bitmaps will be equal
+    gb_bitmap_ref_t blank = gb_demo_thread_blank();
+    if (!blank) ok = tb_false;
+    for (scene = 0; ok && scene < tb_arrayn(g_scenes); scene++)
+    {
+        for (quality = 0; quality < GB_DEMO_THREAD_QUALITY_MAXN; quality++)
+        {
+            if (gb_demo_thread_equal(g_references[scene][quality], blank))
+            {
+                // trace
+                tb_trace_e("scene %lu with quality %lu draws nothing", scene, quality);
+
+                // failed
+                ok = tb_false;
+            }
+        }
+    }
+    if (blank) gb_bitmap_exit(blank);
+
+    // start workers with the different qualities
+    tb_hong_t time = tb_mclock();
+    tb_size_t index = 0;
+    for (index = 0; ok && index < count; index++)
+    {
+        workers[index].quality  = index % GB_DEMO_THREAD_QUALITY_MAXN;
+        workers[index].rounds   = rounds;
+        workers[index].thread   = tb_thread_init(tb_null, gb_demo_thread_loop, &workers[index], 0);
+        if (!workers[index].thread) ok = tb_false;
+    }
+
+    // wait workers
+    tb_size_t failed = 0;
+    for (index = 0; index < count; index++)
+    {
+        if (workers[index].thread)
+        {
+            tb_thread_wait(workers[index].thread, -1);
+            tb_thread_exit(workers[index].thread);
+            failed += workers[index].failed;
+        }
+    }
+    time = tb_mclock() - time;
+
+    // trace
+    tb_trace_i("threads: %lu, rounds: %lu, scenes: %lu, failed: %lu, time: %lld ms", count, rounds, tb_arrayn(g_scenes), failed, time);
+
+    // exit references
+    for (scene = 0; scene < tb_arrayn(g_scenes); scene++)
+    {
+        for (quality = 0; quality < GB_DEMO_THREAD_QUALITY_MAXN; quality++)
+        {
+            if (g_references[scene][quality]) gb_bitmap_exit(g_references[scene][quality]);
+            g_references[scene][quality] = tb_null;
+        }
+    }
+
+    // exit workers
+    tb_free(workers);
+
+    // ok?
+    return (ok && !failed)? 0 : -1;
+}
@@ -36,10 +36,13 @@ static gb_demo_t g_demo[] =
     GB_DEMO_MAIN_ITEM(core_path)
 ,   GB_DEMO_MAIN_ITEM(core_bitmap)
 ,   GB_DEMO_MAIN_ITEM(core_vector)
+,   GB_DEMO_MAIN_ITEM(core_thread)
 
     // utils
 ,   GB_DEMO_MAIN_ITEM(utils_mesh)
+,   GB_DEMO_MAIN_ITEM(utils_index_mesh)
 ,   GB_DEMO_MAIN_ITEM(utils_geometry)
+,   GB_DEMO_MAIN_ITEM(utils_tessellator)
 
     // ohter
 ,   GB_DEMO_MAIN_ITEM(other_test)
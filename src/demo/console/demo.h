@@ -43,10 +43,13 @@
 GB_DEMO_MAIN_DECL(core_path);
 GB_DEMO_MAIN_DECL(core_bitmap);
 GB_DEMO_MAIN_DECL(core_vector);
+GB_DEMO_MAIN_DECL(core_thread);
 
 // utils
 GB_DEMO_MAIN_DECL(utils_mesh);
+GB_DEMO_MAIN_DECL(utils_index_mesh);
 GB_DEMO_MAIN_DECL(utils_geometry);
+GB_DEMO_MAIN_DECL(utils_tessellator);
 
 // other
 GB_DEMO_MAIN_DECL(other_test);
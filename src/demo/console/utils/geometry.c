@@ -3,9 +3,33 @@
  */ 
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the huge coordinate, the sums of the distances will overflow the 16.16 fixed beyond the maximum width
+#ifdef GB_CONFIG_FLOAT_FIXED
+#   define GB_DEMO_GEOMETRY_HUGE        (GB_WIDTH_MAXN)
+#else
+#   define GB_DEMO_GEOMETRY_HUGE        (1 << 30)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+static gb_float_t gb_demo_utils_geometry_next(gb_float_t x, tb_long_t n)
+{
+#ifdef GB_CONFIG_FLOAT_FIXED
+    // the next n-th fixed value
+    return x + n;
+#else
+    // the next n-th float value of the positive x
+    union { tb_float_t f; tb_uint32_t u; } v;
+    v.f = x;
+    v.u += n;
+    return v.f;
+#endif
+}
 static tb_void_t gb_demo_utils_geometry_is_ccw()
 {
     /* make points
@@ -87,6 +111,75 @@ static tb_void_t gb_demo_utils_geometry_in_segment()
     if (!gb_point_in_segment_top(&p1, &p2, &p0)) tb_abort();
     if (!gb_point_in_segment_bottom(&p0, &p2, &p1)) tb_abort();
 }
+static tb_void_t gb_demo_utils_geometry_orientation()
+{
+    // the points
+    gb_point_t p;
+    gb_point_t q;
+    gb_point_t r;
+    gb_point_t e;
+    gb_point_t a;
+    gb_point_t b;
+    gb_point_t c;
+    gb_point_imake(&a, 0, 1);
+    gb_point_imake(&b, 1, 0);
+    gb_point_imake(&c, 0, 0);
+
+    // the line y = x with the small and huge coordinates
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    tb_size_t k = 0;
+    for (k = 0; k < 2; k++)
+    {
+        // make line
+        if (k)
+        {
+            gb_point_imake(&q, GB_DEMO_GEOMETRY_HUGE >> 1, GB_DEMO_GEOMETRY_HUGE >> 1);
+            gb_point_imake(&r, GB_DEMO_GEOMETRY_HUGE, GB_DEMO_GEOMETRY_HUGE);
+        }
+        else
+        {
+            gb_point_imake(&q, 12, 12);
+            gb_point_imake(&r, 24, 24);
+        }
+
+        /* the points near (0.5, 0.5) on the ulp grid are almost collinear with the line,
+         * the orientation must be the same as the obvious points (0, 1), (1, 0) and (0, 0)
+         */
+        for (i = 0; i < 16; i++)
+        {
+            for (j = 0; j < 16; j++)
+            {
+                // make point
+                p.x = gb_demo_utils_geometry_next(GB_HALF, i);
+                p.y = gb_demo_utils_geometry_next(GB_HALF, j);
+
+                // the expected point
+                e = (j > i)? a : ((j < i)? b : c);
+
+                // check
+                if (gb_points_orientation(&p, &q, &r) != gb_points_orientation(&e, &q, &r)) tb_abort();
+                if (gb_points_orientation(&q, &r, &p) != gb_points_orientation(&q, &r, &e)) tb_abort();
+                if (gb_points_orientation(&p, &r, &q) != -gb_points_orientation(&e, &q, &r)) tb_abort();
+            }
+        }
+    }
+
+    // the huge point one ulp above the line y = x
+    gb_point_imake(&q, 0, 0);
+    gb_point_imake(&r, GB_DEMO_GEOMETRY_HUGE, GB_DEMO_GEOMETRY_HUGE);
+    gb_point_imake(&p, GB_DEMO_GEOMETRY_HUGE >> 1, GB_DEMO_GEOMETRY_HUGE >> 1);
+    p.y = gb_demo_utils_geometry_next(p.y, 1);
+    if (gb_points_orientation(&q, &r, &p) != gb_points_orientation(&q, &r, &a)) tb_abort();
+
+    // the huge point one ulp below the line y = x
+    p.y = gb_demo_utils_geometry_next(p.y, -2);
+    if (gb_points_orientation(&q, &r, &p) != gb_points_orientation(&q, &r, &b)) tb_abort();
+
+    // the huge point on the line y = x
+    p.y = gb_demo_utils_geometry_next(p.y, 1);
+    if (gb_points_orientation(&q, &r, &p)) tb_abort();
+}
 static tb_void_t gb_demo_utils_geometry_intersection()
 {
     // the points
@@ -149,6 +242,56 @@ static tb_void_t gb_demo_utils_geometry_intersection()
     tb_trace_i("intersection: count: %lu, time: %lld ms", in, dt);
 }
 
+static tb_void_t gb_demo_utils_geometry_intersection_degenerated()
+{
+    // the points
+    gb_point_t org1;
+    gb_point_t dst1;
+    gb_point_t org2;
+    gb_point_t dst2;
+    gb_point_t intersection;
+
+    // the huge segment on the line y = x
+    gb_point_imake(&org1, 0, 0);
+    gb_point_imake(&dst1, GB_DEMO_GEOMETRY_HUGE, GB_DEMO_GEOMETRY_HUGE);
+
+    // the near-collinear segment one ulp above it, no intersection
+    gb_point_imake(&org2, GB_DEMO_GEOMETRY_HUGE >> 1, GB_DEMO_GEOMETRY_HUGE >> 1);
+    gb_point_imake(&dst2, GB_DEMO_GEOMETRY_HUGE, GB_DEMO_GEOMETRY_HUGE);
+    org2.y = gb_demo_utils_geometry_next(org2.y, 1);
+    dst2.y = gb_demo_utils_geometry_next(dst2.y, 1);
+    if (gb_segment_intersection(&org1, &dst1, &org2, &dst2, &intersection) != -1) tb_abort();
+    if (gb_segment_intersection(&org2, &dst2, &org1, &dst1, &intersection) != -1) tb_abort();
+
+    // the near-collinear segment crossing it at a shallow angle, not rejected
+    dst2.y = gb_demo_utils_geometry_next(dst2.y, -2);
+    tb_long_t ok = gb_segment_intersection(&org1, &dst1, &org2, &dst2, &intersection);
+    if (ok < 0) tb_abort();
+    if (ok > 0)
+    {
+        // the intersection must be in the range of the second segment
+        if (intersection.x < org2.x || intersection.x > dst2.x) tb_abort();
+        if (intersection.y < org2.y || intersection.y > dst2.y) tb_abort();
+    }
+
+    // the overlapping collinear segment, parallel
+    gb_point_imake(&org2, GB_DEMO_GEOMETRY_HUGE >> 2, GB_DEMO_GEOMETRY_HUGE >> 2);
+    gb_point_imake(&dst2, (GB_DEMO_GEOMETRY_HUGE >> 2) * 3, (GB_DEMO_GEOMETRY_HUGE >> 2) * 3);
+    if (gb_segment_intersection(&org1, &dst1, &org2, &dst2, &intersection)) tb_abort();
+
+    // the segment touching it at the endpoint, not rejected
+    gb_point_imake(&org2, GB_DEMO_GEOMETRY_HUGE >> 1, GB_DEMO_GEOMETRY_HUGE >> 1);
+    gb_point_imake(&dst2, GB_DEMO_GEOMETRY_HUGE >> 1, GB_DEMO_GEOMETRY_HUGE);
+    if (gb_segment_intersection(&org1, &dst1, &org2, &dst2, &intersection) < 0) tb_abort();
+
+    // the huge crossing segment, intersect at the center
+    gb_point_imake(&org2, 0, GB_DEMO_GEOMETRY_HUGE);
+    gb_point_imake(&dst2, GB_DEMO_GEOMETRY_HUGE, 0);
+    if (gb_segment_intersection(&org1, &dst1, &org2, &dst2, &intersection) != 1) tb_abort();
+    if (gb_float_to_long(intersection.x) != (GB_DEMO_GEOMETRY_HUGE >> 1)) tb_abort();
+    if (gb_float_to_long(intersection.y) != (GB_DEMO_GEOMETRY_HUGE >> 1)) tb_abort();
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */
@@ -163,8 +306,14 @@ tb_int_t gb_demo_utils_geometry_main(tb_int_t argc, tb_char_t** argv)
     // test in segment
     gb_demo_utils_geometry_in_segment();
 
+    // test orientation
+    gb_demo_utils_geometry_orientation();
+
     // test intersection
     gb_demo_utils_geometry_intersection();
 
+    // test degenerated intersection
+    gb_demo_utils_geometry_intersection_degenerated();
+
     return 0;
 }
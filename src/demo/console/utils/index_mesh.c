@@ -0,0 +1,278 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the isolated edge count, larger than the grow size to grow the storage
+#define GB_DEMO_INDEX_MESH_EDGE_MAXN        (1000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the face split count
+static tb_size_t    g_face_split = 0;
+
+// the face merge count
+static tb_size_t    g_face_merge = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_void_t gb_demo_utils_index_mesh_listener(gb_index_mesh_event_ref_t event)
+{
+    // check
+    tb_assert_abort(event);
+
+    // done
+    switch (event->type)
+    {
+    case GB_MESH_EVENT_FACE_MERGE:
+        {
+            // trace
+            tb_trace_d("face.merge(%u, %u) => %u", event->org, event->dst, event->dst);
+
+            // update count
+            g_face_merge++;
+        }
+        break;
+    case GB_MESH_EVENT_FACE_SPLIT:
+        {
+            // trace
+            tb_trace_d("face.split(%u) => (%u, %u)", event->org, event->org, event->dst);
+
+            // update count
+            g_face_split++;
+        }
+        break;
+    default:
+        tb_assert_abort(0);
+        break;
+    }
+}
+static tb_size_t gb_demo_utils_index_mesh_face_edges(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge)
+{
+    // count the edges around the left face
+    tb_size_t               count = 0;
+    gb_index_mesh_index_t   iter = edge;
+    do
+    {
+        // the edge must be on this face
+        if (gb_index_mesh_edge_lface(mesh, iter) != gb_index_mesh_edge_lface(mesh, edge)) tb_abort();
+
+        // next
+        iter = gb_index_mesh_edge_lnext(mesh, iter);
+        count++;
+
+    } while (iter != edge && count <= mesh->edge_size);
+
+    // ok
+    return count;
+}
+static tb_void_t gb_demo_utils_index_mesh_check(gb_index_mesh_ref_t mesh, tb_size_t edges, tb_size_t faces, tb_size_t vertices)
+{
+    // check sizes
+    if (mesh->edge_size != edges) tb_abort();
+    if (mesh->face_size != faces) tb_abort();
+    if (mesh->vertex_size != vertices) tb_abort();
+
+#ifdef __gb_debug__
+    // check mesh
+    gb_index_mesh_check(mesh);
+#endif
+}
+static tb_void_t gb_demo_utils_index_mesh_quadrangle()
+{
+    // trace
+    tb_trace_i("==========================================================================");
+    tb_trace_i("quadrangle");
+
+    // init mesh
+    gb_index_mesh_ref_t mesh = gb_index_mesh_init(tb_element_str(tb_true), tb_element_str(tb_true), tb_element_str(tb_true));
+    if (!mesh) tb_abort();
+
+    // init listener
+    g_face_split = 0;
+    g_face_merge = 0;
+    gb_index_mesh_listener_set(mesh, gb_demo_utils_index_mesh_listener, mesh);
+    gb_index_mesh_listener_event_add(mesh, GB_MESH_EVENT_FACE_MERGE | GB_MESH_EVENT_FACE_SPLIT);
+
+    /* make a quadrangle
+     *
+     *                     e1
+     *           v0 --------------> v1
+     *            |                 |
+     *         e0 |      rface      | e2     lface
+     *            |                 |
+     *           v3 <-------------- v2
+     *                     e3
+     *
+     */
+    gb_index_mesh_index_t edge0 = gb_index_mesh_edge_make_loop(mesh, tb_false);
+    if (!edge0) tb_abort();
+    gb_index_mesh_index_t edge1 = gb_index_mesh_edge_insert(mesh, edge0, edge0);
+    gb_index_mesh_index_t edge2 = gb_index_mesh_edge_insert(mesh, edge1, edge0);
+    gb_index_mesh_index_t edge3 = gb_index_mesh_edge_insert(mesh, edge2, edge0);
+    if (!edge1 || !edge2 || !edge3) tb_abort();
+    gb_index_mesh_edge_data_set(mesh, edge0, "e0");
+    gb_index_mesh_edge_data_set(mesh, edge1, "e1");
+    gb_index_mesh_edge_data_set(mesh, edge2, "e2");
+    gb_index_mesh_edge_data_set(mesh, edge3, "e3");
+    gb_demo_utils_index_mesh_check(mesh, 4, 2, 4);
+    if (gb_demo_utils_index_mesh_face_edges(mesh, edge0) != 4) tb_abort();
+    if (tb_strcmp((tb_char_t const*)gb_index_mesh_edge_data(mesh, edge2), "e2")) tb_abort();
+
+    /* split e1 and e3
+     *
+     *                e1       e4
+     *           v0 ------ v4 -----> v1
+     *            |                 |
+     *         e0 |      rface      | e2     lface
+     *            |                 |
+     *           v3 <----- v5 <---- v2
+     *                 e5       e3
+     *
+     */
+    gb_index_mesh_index_t edge4 = gb_index_mesh_edge_split(mesh, edge1);
+    gb_index_mesh_index_t edge5 = gb_index_mesh_edge_split(mesh, edge3);
+    if (!edge4 || !edge5) tb_abort();
+    gb_demo_utils_index_mesh_check(mesh, 6, 2, 6);
+    if (gb_index_mesh_edge_dst(mesh, edge1) != gb_index_mesh_edge_org(mesh, edge4)) tb_abort();
+    if (gb_demo_utils_index_mesh_face_edges(mesh, edge0) != 6) tb_abort();
+
+    /* join v4 and v5 and split the face
+     *
+     *                e1       e4
+     *           v0 ------ v4 -----> v1
+     *            |         |       |
+     *         e0 |   e6    |       | e2
+     *            |         |       |
+     *           v3 <----- v5 <---- v2
+     *                 e5       e3
+     *
+     */
+    gb_index_mesh_index_t edge6 = gb_index_mesh_edge_connect(mesh, edge1, edge5);
+    if (!edge6) tb_abort();
+    gb_demo_utils_index_mesh_check(mesh, 7, 3, 6);
+    if (g_face_split != 1) tb_abort();
+    if (gb_index_mesh_edge_org(mesh, edge6) != gb_index_mesh_edge_org(mesh, edge4)) tb_abort();
+    if (gb_index_mesh_edge_dst(mesh, edge6) != gb_index_mesh_edge_org(mesh, edge5)) tb_abort();
+    if (gb_index_mesh_edge_lface(mesh, edge6) == gb_index_mesh_edge_rface(mesh, edge6)) tb_abort();
+    if (gb_demo_utils_index_mesh_face_edges(mesh, edge6) + gb_demo_utils_index_mesh_face_edges(mesh, edge6 ^ 1) != 8) tb_abort();
+
+    // kill e6 and join the two faces, the killed edge and face will be the head of the free lists
+    gb_index_mesh_index_t face6 = gb_index_mesh_edge_lface(mesh, edge6);
+    gb_index_mesh_edge_delete(mesh, edge6);
+    gb_demo_utils_index_mesh_check(mesh, 6, 2, 6);
+    if (g_face_merge != 1) tb_abort();
+    if (mesh->edge_free != edge6 || mesh->face_free != face6) tb_abort();
+    if (gb_index_mesh_edge_is_valid(mesh, edge6) || gb_index_mesh_face_is_valid(mesh, face6)) tb_abort();
+
+    // join v4 and v5 again, the killed edge and face must be reused
+    tb_size_t edge_maxn = mesh->edge_maxn;
+    tb_size_t face_maxn = mesh->face_maxn;
+    if (gb_index_mesh_edge_connect(mesh, edge1, edge5) != edge6) tb_abort();
+    gb_demo_utils_index_mesh_check(mesh, 7, 3, 6);
+    if (g_face_split != 2) tb_abort();
+    if (gb_index_mesh_edge_lface(mesh, edge6) != face6) tb_abort();
+    if (mesh->edge_maxn != edge_maxn || mesh->face_maxn != face_maxn) tb_abort();
+
+    // kill e4 and its destination vertex, the killed vertex will be the head of the free list
+    gb_index_mesh_index_t vertex1 = gb_index_mesh_edge_dst(mesh, edge4);
+    gb_index_mesh_edge_remove(mesh, edge4);
+    gb_demo_utils_index_mesh_check(mesh, 6, 3, 5);
+    if (mesh->vertex_free != vertex1 || mesh->edge_free != edge4) tb_abort();
+    if (gb_index_mesh_vertex_is_valid(mesh, vertex1)) tb_abort();
+
+    // split e2 again, the killed edge and vertex must be reused
+    tb_size_t vertex_maxn = mesh->vertex_maxn;
+    gb_index_mesh_index_t edge7 = gb_index_mesh_edge_split(mesh, edge2);
+    if (edge7 != edge4 || gb_index_mesh_edge_org(mesh, edge7) != vertex1) tb_abort();
+    gb_demo_utils_index_mesh_check(mesh, 7, 3, 6);
+    if (mesh->vertex_maxn != vertex_maxn) tb_abort();
+
+    // clear mesh and keep the storage
+    edge_maxn = mesh->edge_maxn;
+    gb_index_mesh_clear(mesh);
+    if (!gb_index_mesh_is_empty(mesh)) tb_abort();
+    gb_demo_utils_index_mesh_check(mesh, 0, 0, 0);
+    if (mesh->edge_maxn != edge_maxn) tb_abort();
+
+    // make the quadrangle again, the lower edges will be used first
+    if (gb_index_mesh_edge_make_loop(mesh, tb_false) != edge0) tb_abort();
+
+    // exit mesh
+    gb_index_mesh_exit(mesh);
+}
+static tb_void_t gb_demo_utils_index_mesh_reuse()
+{
+    // trace
+    tb_trace_i("==========================================================================");
+    tb_trace_i("reuse");
+
+    // init mesh
+    gb_index_mesh_ref_t mesh = gb_index_mesh_init(tb_element_str(tb_true), tb_element_str(tb_true), tb_element_str(tb_true));
+    if (!mesh) tb_abort();
+
+    // make the isolated edges and grow the storage
+    tb_size_t               i = 0;
+    gb_index_mesh_index_t   edges[GB_DEMO_INDEX_MESH_EDGE_MAXN];
+    for (i = 0; i < GB_DEMO_INDEX_MESH_EDGE_MAXN; i++)
+    {
+        edges[i] = gb_index_mesh_edge_make(mesh);
+        if (!edges[i]) tb_abort();
+        gb_index_mesh_edge_data_set(mesh, edges[i], "edge");
+        gb_index_mesh_vertex_data_set(mesh, gb_index_mesh_edge_org(mesh, edges[i]), "org");
+        gb_index_mesh_vertex_data_set(mesh, gb_index_mesh_edge_dst(mesh, edges[i]), "dst");
+        gb_index_mesh_face_data_set(mesh, gb_index_mesh_edge_lface(mesh, edges[i]), "face");
+        if (!gb_index_mesh_edge_is_isolated(mesh, edges[i])) tb_abort();
+    }
+    gb_demo_utils_index_mesh_check(mesh, GB_DEMO_INDEX_MESH_EDGE_MAXN, GB_DEMO_INDEX_MESH_EDGE_MAXN, GB_DEMO_INDEX_MESH_EDGE_MAXN << 1);
+
+    // save the storage
+    tb_size_t edge_maxn     = mesh->edge_maxn;
+    tb_size_t face_maxn     = mesh->face_maxn;
+    tb_size_t vertex_maxn   = mesh->vertex_maxn;
+
+    // kill the even edges with their faces and vertices
+    for (i = 0; i < GB_DEMO_INDEX_MESH_EDGE_MAXN; i += 2) gb_index_mesh_edge_delete(mesh, edges[i]);
+    gb_demo_utils_index_mesh_check(mesh, GB_DEMO_INDEX_MESH_EDGE_MAXN >> 1, GB_DEMO_INDEX_MESH_EDGE_MAXN >> 1, GB_DEMO_INDEX_MESH_EDGE_MAXN);
+
+    // make them again, all killed edges must be reused without growing
+    for (i = 0; i < GB_DEMO_INDEX_MESH_EDGE_MAXN; i += 2)
+    {
+        // the reused edge must be one of the killed edges
+        gb_index_mesh_index_t edge = gb_index_mesh_edge_make(mesh);
+        if (!edge || !gb_index_mesh_edge_is_isolated(mesh, edge)) tb_abort();
+        if (edge != edges[GB_DEMO_INDEX_MESH_EDGE_MAXN - 2 - i]) tb_abort();
+
+        // the user data of the reused edge must be cleared
+        if (gb_index_mesh_edge_data(mesh, edge)) tb_abort();
+    }
+    gb_demo_utils_index_mesh_check(mesh, GB_DEMO_INDEX_MESH_EDGE_MAXN, GB_DEMO_INDEX_MESH_EDGE_MAXN, GB_DEMO_INDEX_MESH_EDGE_MAXN << 1);
+    if (mesh->edge_maxn != edge_maxn || mesh->face_maxn != face_maxn || mesh->vertex_maxn != vertex_maxn) tb_abort();
+
+    // trace
+    tb_trace_i("edges: %lu, faces: %lu, vertices: %lu", mesh->edge_maxn, mesh->face_maxn, mesh->vertex_maxn);
+
+    // exit mesh
+    gb_index_mesh_exit(mesh);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_utils_index_mesh_main(tb_int_t argc, tb_char_t** argv)
+{
+    // test quadrangle
+    gb_demo_utils_index_mesh_quadrangle();
+
+    // test reuse
+    gb_demo_utils_index_mesh_reuse();
+
+    return 0;
+}
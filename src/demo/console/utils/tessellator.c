@@ -0,0 +1,414 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the polygon count, must be larger than the polygons of one list task
+#define GB_DEMO_TESSELLATOR_POLYGON_MAXN        (300)
+
+// the point count of the polygon
+#define GB_DEMO_TESSELLATOR_POINT_MAXN          (32)
+
+// the huge coordinate, the sums of the distances will overflow the 16.16 fixed beyond the maximum width
+#ifdef GB_CONFIG_FLOAT_FIXED
+#   define GB_DEMO_TESSELLATOR_HUGE             (GB_WIDTH_MAXN)
+#else
+#   define GB_DEMO_TESSELLATOR_HUGE             (1 << 30)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the output contour type
+typedef struct __gb_demo_tessellator_contour_t
+{
+    // the polygon index
+    tb_size_t               index;
+
+    // the points count
+    tb_size_t               count;
+
+}gb_demo_tessellator_contour_t;
+
+// the outputs type
+typedef struct __gb_demo_tessellator_outputs_t
+{
+    // the current polygon index for the serial tessellator
+    tb_size_t               index;
+
+    // the points
+    tb_vector_ref_t         points;
+
+    // the contours
+    tb_vector_ref_t         contours;
+
+}gb_demo_tessellator_outputs_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the polygon points
+static gb_point_t           g_points[GB_DEMO_TESSELLATOR_POLYGON_MAXN][GB_DEMO_TESSELLATOR_POINT_MAXN];
+
+// the polygon counts
+static tb_uint16_t          g_counts[GB_DEMO_TESSELLATOR_POLYGON_MAXN][3];
+
+// the polygons
+static gb_polygon_t         g_polygons[GB_DEMO_TESSELLATOR_POLYGON_MAXN];
+
+// the polygon bounds
+static gb_rect_t            g_bounds[GB_DEMO_TESSELLATOR_POLYGON_MAXN];
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_size_t gb_demo_utils_tessellator_random(tb_size_t* seed, tb_size_t range)
+{
+    // the deterministic lcg random
+    *seed = (*seed * 1103515245 + 12345) & 0x7fffffff;
+    return (*seed >> 8) % range;
+}
+static tb_void_t gb_demo_utils_tessellator_make()
+{
+    // make polygons, all contours are closed
+    tb_size_t i = 0;
+    tb_size_t seed = 2015;
+    for (i = 0; i < GB_DEMO_TESSELLATOR_POLYGON_MAXN; i++)
+    {
+        gb_point_ref_t  points = g_points[i];
+        tb_uint16_t*    counts = g_counts[i];
+        tb_size_t       kind = i % 3;
+
+        // the center
+        tb_long_t cx = (tb_long_t)gb_demo_utils_tessellator_random(&seed, 1000);
+        tb_long_t cy = (tb_long_t)gb_demo_utils_tessellator_random(&seed, 1000);
+
+        // make a concave star
+        if (kind == 0)
+        {
+            tb_size_t n = 12 + gb_demo_utils_tessellator_random(&seed, GB_DEMO_TESSELLATOR_POINT_MAXN - 14);
+            tb_size_t j = 0;
+            for (j = 0; j < n; j++)
+            {
+                // the radius
+                tb_long_t r = (j & 1)? 20 + (tb_long_t)gb_demo_utils_tessellator_random(&seed, 40) : 80 + (tb_long_t)gb_demo_utils_tessellator_random(&seed, 80);
+
+                // the angle
+                tb_double_t a = (2 * TB_PI * j) / n;
+                gb_point_imake(&points[j], cx + (tb_long_t)(r * tb_cos(a)), cy + (tb_long_t)(r * tb_sin(a)));
+            }
+            points[n] = points[0];
+            counts[0] = (tb_uint16_t)n + 1;
+            counts[1] = 0;
+        }
+        // make a self-intersecting pentagram
+        else if (kind == 1)
+        {
+            tb_size_t j = 0;
+            tb_long_t r = 50 + (tb_long_t)gb_demo_utils_tessellator_random(&seed, 100);
+            for (j = 0; j < 5; j++)
+            {
+                tb_double_t a = (4 * TB_PI * j) / 5;
+                gb_point_imake(&points[j], cx + (tb_long_t)(r * tb_cos(a)), cy + (tb_long_t)(r * tb_sin(a)));
+            }
+            points[5] = points[0];
+            counts[0] = 6;
+            counts[1] = 0;
+        }
+        // make a rect with an overlapping hole
+        else
+        {
+            tb_long_t w = 40 + (tb_long_t)gb_demo_utils_tessellator_random(&seed, 100);
+            tb_long_t h = 40 + (tb_long_t)gb_demo_utils_tessellator_random(&seed, 100);
+            tb_long_t d = (tb_long_t)gb_demo_utils_tessellator_random(&seed, 60);
+            gb_point_imake(&points[0], cx, cy);
+            gb_point_imake(&points[1], cx + w, cy);
+            gb_point_imake(&points[2], cx + w, cy + h);
+            gb_point_imake(&points[3], cx, cy + h);
+            gb_point_imake(&points[4], cx, cy);
+            gb_point_imake(&points[5], cx + d, cy + d);
+            gb_point_imake(&points[6], cx + d, cy + h + d);
+            gb_point_imake(&points[7], cx + w + d, cy + h + d);
+            gb_point_imake(&points[8], cx + w + d, cy + d);
+            gb_point_imake(&points[9], cx + d, cy + d);
+            counts[0] = 5;
+            counts[1] = 5;
+            counts[2] = 0;
+        }
+
+        // make polygon
+        g_polygons[i].points    = points;
+        g_polygons[i].counts    = counts;
+        g_polygons[i].convex    = tb_false;
+
+        // make bounds
+        tb_size_t total = counts[0] + counts[1];
+        tb_size_t j = 0;
+        gb_float_t x0 = points[0].x;
+        gb_float_t y0 = points[0].y;
+        gb_float_t x1 = points[0].x;
+        gb_float_t y1 = points[0].y;
+        for (j = 1; j < total; j++)
+        {
+            if (points[j].x < x0) x0 = points[j].x;
+            if (points[j].y < y0) y0 = points[j].y;
+            if (points[j].x > x1) x1 = points[j].x;
+            if (points[j].y > y1) y1 = points[j].y;
+        }
+        gb_rect_make(&g_bounds[i], x0, y0, x1 - x0, y1 - y0);
+    }
+}
+static tb_bool_t gb_demo_utils_tessellator_outputs_init(gb_demo_tessellator_outputs_t* outputs)
+{
+    // init outputs
+    tb_memset(outputs, 0, sizeof(gb_demo_tessellator_outputs_t));
+    outputs->points     = tb_vector_init(4096, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
+    outputs->contours   = tb_vector_init(1024, tb_element_mem(sizeof(gb_demo_tessellator_contour_t), tb_null, tb_null));
+    return outputs->points && outputs->contours;
+}
+static tb_void_t gb_demo_utils_tessellator_outputs_exit(gb_demo_tessellator_outputs_t* outputs)
+{
+    // exit outputs
+    if (outputs->points) tb_vector_exit(outputs->points);
+    if (outputs->contours) tb_vector_exit(outputs->contours);
+    outputs->points     = tb_null;
+    outputs->contours   = tb_null;
+}
+static tb_void_t gb_demo_utils_tessellator_list_func(tb_size_t index, gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_demo_tessellator_outputs_t* outputs = (gb_demo_tessellator_outputs_t*)priv;
+    tb_assert_and_check_return(outputs && points && count);
+
+    // save contour
+    gb_demo_tessellator_contour_t contour = {index, count};
+    tb_vector_insert_tail(outputs->contours, &contour);
+
+    // save points
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++) tb_vector_insert_tail(outputs->points, &points[i]);
+}
+static tb_void_t gb_demo_utils_tessellator_func(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_demo_tessellator_outputs_t* outputs = (gb_demo_tessellator_outputs_t*)priv;
+    tb_assert_and_check_return(outputs);
+
+    // save it for the current polygon
+    gb_demo_utils_tessellator_list_func(outputs->index, points, count, priv);
+}
+static tb_bool_t gb_demo_utils_tessellator_equal(gb_demo_tessellator_outputs_t* serial, gb_demo_tessellator_outputs_t* parallel)
+{
+    // the contours are equal?
+    tb_size_t count = tb_vector_size(serial->contours);
+    if (!count || count != tb_vector_size(parallel->contours)) return tb_false;
+    if (tb_memcmp(tb_vector_data(serial->contours), tb_vector_data(parallel->contours), count * sizeof(gb_demo_tessellator_contour_t))) return tb_false;
+
+    // the points are equal?
+    count = tb_vector_size(serial->points);
+    if (!count || count != tb_vector_size(parallel->points)) return tb_false;
+    return !tb_memcmp(tb_vector_data(serial->points), tb_vector_data(parallel->points), count * sizeof(gb_point_t));
+}
+static tb_void_t gb_demo_utils_tessellator_list(tb_size_t mode, tb_size_t rule)
+{
+    // init tessellator
+    gb_tessellator_ref_t tessellator = gb_tessellator_init();
+    if (!tessellator) tb_abort();
+
+    // init outputs
+    gb_demo_tessellator_outputs_t serial;
+    gb_demo_tessellator_outputs_t parallel;
+    if (!gb_demo_utils_tessellator_outputs_init(&serial)) tb_abort();
+    if (!gb_demo_utils_tessellator_outputs_init(&parallel)) tb_abort();
+
+    // init mode and rule
+    gb_tessellator_mode_set(tessellator, mode);
+    gb_tessellator_rule_set(tessellator, rule);
+
+    // tessellate polygons serially
+    gb_tessellator_func_set(tessellator, gb_demo_utils_tessellator_func, &serial);
+    for (serial.index = 0; serial.index < GB_DEMO_TESSELLATOR_POLYGON_MAXN; serial.index++)
+        gb_tessellator_done(tessellator, &g_polygons[serial.index], &g_bounds[serial.index]);
+
+    // tessellate polygons in parallel
+    gb_tessellator_done_list(tessellator, g_polygons, g_bounds, GB_DEMO_TESSELLATOR_POLYGON_MAXN, tb_null, gb_demo_utils_tessellator_list_func, &parallel);
+
+    // trace
+    tb_trace_i("mode: %lu, rule: %lu, contours: %lu, points: %lu", mode, rule, tb_vector_size(serial.contours), tb_vector_size(serial.points));
+
+    // the parallel outputs must be equal to the serial outputs in the same order
+    if (!gb_demo_utils_tessellator_equal(&serial, &parallel)) tb_abort();
+
+    // exit outputs
+    gb_demo_utils_tessellator_outputs_exit(&serial);
+    gb_demo_utils_tessellator_outputs_exit(&parallel);
+
+    // exit tessellator
+    gb_tessellator_exit(tessellator);
+}
+
+static gb_float_t gb_demo_utils_tessellator_next(gb_float_t x, tb_long_t n)
+{
+#ifdef GB_CONFIG_FLOAT_FIXED
+    // the next n-th fixed value
+    return x + n;
+#else
+    // the next n-th float value of the positive x
+    union { tb_float_t f; tb_uint32_t u; } v;
+    v.f = x;
+    v.u += n;
+    return v.f;
+#endif
+}
+static tb_double_t gb_demo_utils_tessellator_area(gb_point_ref_t points, tb_size_t count)
+{
+    // compute the signed area of the closed contour
+    tb_size_t   i = 0;
+    tb_double_t area = 0;
+    for (i = 0; i + 1 < count; i++)
+    {
+#ifdef GB_CONFIG_FLOAT_FIXED
+        area += ((tb_double_t)points[i].x * points[i + 1].y - (tb_double_t)points[i + 1].x * points[i].y) / (65536.0 * 65536.0);
+#else
+        area += (tb_double_t)points[i].x * points[i + 1].y - (tb_double_t)points[i + 1].x * points[i].y;
+#endif
+    }
+    return area / 2;
+}
+static tb_void_t gb_demo_utils_tessellator_area_func(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    tb_double_t* area = (tb_double_t*)priv;
+    tb_assert_and_check_return(area && points && count);
+
+    // the outputs are not overlapped, sum their areas
+    *area += tb_fabs(gb_demo_utils_tessellator_area(points, count));
+}
+static tb_void_t gb_demo_utils_tessellator_degenerated_done(gb_point_ref_t points, tb_uint16_t count, tb_char_t const* name)
+{
+    // make polygon
+    tb_uint16_t     counts[] = {count, 0};
+    gb_polygon_t    polygon = {points, counts, tb_false};
+
+    // make bounds
+    tb_size_t  i = 0;
+    gb_float_t x0 = points[0].x;
+    gb_float_t y0 = points[0].y;
+    gb_float_t x1 = points[0].x;
+    gb_float_t y1 = points[0].y;
+    for (i = 1; i < count; i++)
+    {
+        if (points[i].x < x0) x0 = points[i].x;
+        if (points[i].y < y0) y0 = points[i].y;
+        if (points[i].x > x1) x1 = points[i].x;
+        if (points[i].y > y1) y1 = points[i].y;
+    }
+    gb_rect_t bounds;
+    gb_rect_make(&bounds, x0, y0, x1 - x0, y1 - y0);
+
+    // the polygon area
+    tb_double_t area = tb_fabs(gb_demo_utils_tessellator_area(points, count));
+
+    // init tessellator
+    gb_tessellator_ref_t tessellator = gb_tessellator_init();
+    if (!tessellator) tb_abort();
+
+    // the outputs must cover the polygon for all modes and rules
+    tb_size_t mode = 0;
+    tb_size_t rule = 0;
+    for (mode = GB_TESSELLATOR_MODE_CONVEX; mode <= GB_TESSELLATOR_MODE_TRIANGULATION; mode++)
+    {
+        for (rule = GB_TESSELLATOR_RULE_ODD; rule <= GB_TESSELLATOR_RULE_NONZERO; rule++)
+        {
+            // tessellate it
+            tb_double_t result = 0;
+            gb_tessellator_mode_set(tessellator, mode);
+            gb_tessellator_rule_set(tessellator, rule);
+            gb_tessellator_func_set(tessellator, gb_demo_utils_tessellator_area_func, &result);
+            gb_tessellator_done(tessellator, &polygon, &bounds);
+
+            // trace
+            tb_trace_i("%s: mode: %lu, rule: %lu, area: %lf => %lf", name, mode, rule, area, result);
+
+            // check area
+            if (tb_fabs(result - area) > area * 1e-4) tb_abort();
+        }
+    }
+
+    // exit tessellator
+    gb_tessellator_exit(tessellator);
+}
+static tb_void_t gb_demo_utils_tessellator_degenerated()
+{
+    // the points
+    tb_size_t   i = 0;
+    tb_long_t   h = GB_DEMO_TESSELLATOR_HUGE;
+    gb_point_t  points[GB_DEMO_TESSELLATOR_POINT_MAXN];
+
+    /* make a huge rect, the vertices on the bottom edge are almost collinear
+     *
+     * . . . . . . . . . . . . . . . . .
+     * .                               .
+     * .                               .
+     * .                               .
+     * . . ` . ` . ` . ` . ` . ` . ` . .
+     *
+     */
+    gb_point_imake(&points[0], h >> 2, h >> 2);
+    for (i = 1; i < 16; i++)
+    {
+        gb_point_imake(&points[i], (h >> 2) + (tb_long_t)i * (h >> 5), h >> 2);
+        points[i].y = gb_demo_utils_tessellator_next(points[i].y, (i & 1)? 1 : -1);
+    }
+    gb_point_imake(&points[16], (h >> 2) * 3, h >> 2);
+    gb_point_imake(&points[17], (h >> 2) * 3, (h >> 2) * 3);
+    gb_point_imake(&points[18], h >> 2, (h >> 2) * 3);
+    points[19] = points[0];
+    gb_demo_utils_tessellator_degenerated_done(points, 20, "collinear");
+
+    // make a huge sliver triangle, the apex is one ulp off the base
+    gb_point_imake(&points[0], 0, 0);
+    gb_point_imake(&points[1], h, h);
+    gb_point_imake(&points[2], h >> 1, h >> 1);
+    points[2].y = gb_demo_utils_tessellator_next(points[2].y, 1);
+    points[3] = points[0];
+    gb_demo_utils_tessellator_degenerated_done(points, 4, "sliver");
+
+    // make a huge concave star
+    for (i = 0; i < 16; i++)
+    {
+        tb_double_t r = (i & 1)? h / 8 : h / 2;
+        tb_double_t a = (2 * TB_PI * i) / 16;
+        gb_point_imake(&points[i], (h >> 1) + (tb_long_t)(r * tb_cos(a)), (h >> 1) + (tb_long_t)(r * tb_sin(a)));
+    }
+    points[16] = points[0];
+    gb_demo_utils_tessellator_degenerated_done(points, 17, "star");
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t gb_demo_utils_tessellator_main(tb_int_t argc, tb_char_t** argv)
+{
+    // make polygons
+    gb_demo_utils_tessellator_make();
+
+    // test the polygon list for all modes and rules
+    gb_demo_utils_tessellator_list(GB_TESSELLATOR_MODE_CONVEX, GB_TESSELLATOR_RULE_ODD);
+    gb_demo_utils_tessellator_list(GB_TESSELLATOR_MODE_CONVEX, GB_TESSELLATOR_RULE_NONZERO);
+    gb_demo_utils_tessellator_list(GB_TESSELLATOR_MODE_MONOTONE, GB_TESSELLATOR_RULE_ODD);
+    gb_demo_utils_tessellator_list(GB_TESSELLATOR_MODE_MONOTONE, GB_TESSELLATOR_RULE_NONZERO);
+    gb_demo_utils_tessellator_list(GB_TESSELLATOR_MODE_TRIANGULATION, GB_TESSELLATOR_RULE_ODD);
+    gb_demo_utils_tessellator_list(GB_TESSELLATOR_MODE_TRIANGULATION, GB_TESSELLATOR_RULE_NONZERO);
+
+    // test the near-collinear and huge polygons
+    gb_demo_utils_tessellator_degenerated();
+
+    return 0;
+}
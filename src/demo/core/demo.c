@@ -16,6 +16,10 @@
 #include "line.h"
 #include "lines.h"
 #include "tiger.h"
+#include "markers.h"
+#include "record.h"
+#include "layer.h"
+#include "hit.h"
 #include "point.h"
 #include "points.h"
 #include "circle.h"
@@ -68,6 +72,10 @@ static gb_demo_entry_t  g_entries[] =
 ,   {gb_demo_triangle_init,     gb_demo_triangle_exit,      gb_demo_triangle_draw,      gb_demo_triangle_event      }
 ,   {gb_demo_arc_init,          gb_demo_arc_exit,           gb_demo_arc_draw,           gb_demo_arc_event           }
 ,   {gb_demo_tiger_init,        gb_demo_tiger_exit,         gb_demo_tiger_draw,         gb_demo_tiger_event         }
+,   {gb_demo_markers_init,      gb_demo_markers_exit,       gb_demo_markers_draw,       gb_demo_markers_event       }
+,   {gb_demo_record_init,       gb_demo_record_exit,        gb_demo_record_draw,        gb_demo_record_event        }
+,   {gb_demo_layer_init,        gb_demo_layer_exit,         gb_demo_layer_draw,         gb_demo_layer_event         }
+,   {gb_demo_hit_init,          gb_demo_hit_exit,           gb_demo_hit_draw,           gb_demo_hit_event           }
 };
 
 // the matrix
@@ -173,6 +181,9 @@ tb_void_t gb_demo_draw(gb_window_ref_t window, gb_canvas_ref_t canvas, tb_cpoint
     // enter matrix
     gb_matrix_copy(gb_canvas_save_matrix(canvas), &g_matrix);
 
+    // apply quality
+    gb_canvas_quality_set(canvas, g_quality);
+
     // apply cap
     gb_canvas_stroke_cap_set(canvas, g_cap);
 
@@ -205,6 +216,9 @@ tb_void_t gb_demo_resize(gb_window_ref_t window, gb_canvas_ref_t canvas, tb_cpoi
 
 	// update matrix
 	gb_matrix_init_translate(&g_matrix, x0, y0);	
+
+    // redraw it
+    gb_window_invalidate(window, tb_null);
 }
 tb_void_t gb_demo_event(gb_window_ref_t window, gb_event_ref_t event, tb_cpointer_t priv)
 {
@@ -318,5 +332,8 @@ tb_void_t gb_demo_event(gb_window_ref_t window, gb_event_ref_t event, tb_cpointe
 
     // done event
     entry->event(window, event);
+
+    // the drawings may be changed by this event, redraw it
+    gb_window_invalidate(window, tb_null);
 }
 
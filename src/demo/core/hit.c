@@ -0,0 +1,114 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "hit"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "hit.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the shapes count of each row and column
+#define GB_DEMO_HIT_GRID            (40)
+
+// the shapes count
+#define GB_DEMO_HIT_COUNT           (GB_DEMO_HIT_GRID * GB_DEMO_HIT_GRID)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the shapes
+static gb_path_ref_t            g_shapes[GB_DEMO_HIT_COUNT];
+
+// the spatial index of the shapes
+static gb_spatial_index_ref_t   g_index = tb_null;
+
+// the hovered shape index
+static tb_size_t                g_hovered = -1;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_demo_hit_func(tb_size_t index, gb_rect_ref_t bounds, tb_cpointer_t item, tb_cpointer_t priv)
+{
+    // the point
+    gb_point_ref_t point = (gb_point_ref_t)priv;
+
+    // the topmost shape under the point is the last drawn one
+    if ((g_hovered == -1 || index > g_hovered) && gb_path_contains((gb_path_ref_t)item, point, GB_PAINT_FILL_RULE_NONZERO)) 
+        g_hovered = index;
+
+    // continue
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t gb_demo_hit_init(gb_window_ref_t window)
+{
+    // init the spatial index
+    g_index = gb_spatial_index_init();
+    tb_check_return(g_index);
+
+    // init the overlapped circles and triangles, the index is bulk-loaded on the first query
+    tb_size_t i = 0;
+    for (i = 0; i < GB_DEMO_HIT_COUNT; i++)
+    {
+        g_shapes[i] = gb_path_init();
+        tb_check_break(g_shapes[i]);
+
+        tb_long_t x = ((tb_long_t)(i % GB_DEMO_HIT_GRID) - (GB_DEMO_HIT_GRID >> 1)) << 4;
+        tb_long_t y = ((tb_long_t)(i / GB_DEMO_HIT_GRID) - (GB_DEMO_HIT_GRID >> 1)) << 4;
+        if (i & 1) gb_path_add_circle2i(g_shapes[i], x + 8, y + 8, 10, GB_ROTATE_DIRECTION_CW);
+        else gb_path_add_triangle2i(g_shapes[i], x, y + 16, x + 8, y - 4, x + 16, y + 16);
+
+        gb_spatial_index_insert(g_index, gb_path_bounds(g_shapes[i]), g_shapes[i]);
+    }
+}
+tb_void_t gb_demo_hit_exit(gb_window_ref_t window)
+{
+    // exit the spatial index
+    if (g_index) gb_spatial_index_exit(g_index);
+    g_index = tb_null;
+
+    // exit the shapes
+    tb_size_t i = 0;
+    for (i = 0; i < GB_DEMO_HIT_COUNT; i++)
+    {
+        if (g_shapes[i]) gb_path_exit(g_shapes[i]);
+        g_shapes[i] = tb_null;
+    }
+}
+tb_void_t gb_demo_hit_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
+{
+    // draw the shapes and highlight the hovered one
+    tb_size_t i = 0;
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    for (i = 0; i < GB_DEMO_HIT_COUNT; i++)
+    {
+        if (!g_shapes[i]) continue;
+        gb_canvas_color_set(canvas, i == g_hovered? GB_COLOR_RED : ((i & 1)? GB_COLOR_BLUE : GB_COLOR_GRAY));
+        gb_canvas_draw_path(canvas, g_shapes[i]);
+    }
+}
+tb_void_t gb_demo_hit_event(gb_window_ref_t window, gb_event_ref_t event)
+{
+    // check
+    tb_check_return(g_index && event->type == GB_EVENT_TYPE_MOUSE && event->u.mouse.code == GB_MOUSE_MOVE);
+
+    // map the cursor to the shapes, the origin of the demo is at the center of the window
+    gb_point_t point;
+    point.x = event->u.mouse.cursor.x - gb_long_to_float(gb_window_width(window) >> 1);
+    point.y = event->u.mouse.cursor.y - gb_long_to_float(gb_window_height(window) >> 1);
+
+    // find the topmost shape under the cursor
+    g_hovered = -1;
+    gb_spatial_index_query_point(g_index, &point, gb_demo_hit_func, &point);
+}
@@ -0,0 +1,82 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "layer"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "layer.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the shapes count of each row and column in the background
+#define GB_DEMO_LAYER_GRID          (40)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the cached background layer
+static gb_layer_ref_t           g_background = tb_null;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t gb_demo_layer_init(gb_window_ref_t window)
+{
+    // init the background layer
+    g_background = gb_layer_init();
+}
+tb_void_t gb_demo_layer_exit(gb_window_ref_t window)
+{
+    // exit the background layer
+    if (g_background) gb_layer_exit(g_background);
+    g_background = tb_null;
+}
+tb_void_t gb_demo_layer_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
+{
+    // the bounds of the background
+    gb_rect_t bounds;
+    gb_rect_imake(&bounds, -(GB_DEMO_LAYER_GRID << 3), -(GB_DEMO_LAYER_GRID << 3), GB_DEMO_LAYER_GRID << 4, GB_DEMO_LAYER_GRID << 4);
+
+    // draw the background only if the cached pixels is invalid
+    gb_canvas_save_paint(canvas);
+    if (gb_canvas_save_layer(canvas, &bounds, 255, g_background))
+    {
+        // trace
+        tb_trace_i("draw background");
+
+        tb_size_t i = 0;
+        tb_size_t n = GB_DEMO_LAYER_GRID * GB_DEMO_LAYER_GRID;
+        gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+        gb_canvas_color_set(canvas, GB_COLOR_GRAY);
+        for (i = 0; i < n; i++)
+        {
+            tb_long_t x = ((tb_long_t)(i % GB_DEMO_LAYER_GRID) - (GB_DEMO_LAYER_GRID >> 1)) << 4;
+            tb_long_t y = ((tb_long_t)(i / GB_DEMO_LAYER_GRID) - (GB_DEMO_LAYER_GRID >> 1)) << 4;
+            gb_canvas_draw_circle2i(canvas, x + 8, y + 8, 4);
+        }
+    }
+    gb_canvas_load_layer(canvas);
+
+    // draw the overlapped circles as one translucent group, the overlapped area is not blended twice
+    gb_rect_imake(&bounds, -200, -150, 400, 300);
+    gb_canvas_save_layer(canvas, &bounds, 128, tb_null);
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_color_set(canvas, GB_COLOR_RED);
+    gb_canvas_draw_circle2i(canvas, -50, 0, 100);
+    gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+    gb_canvas_draw_circle2i(canvas, 50, 0, 100);
+    gb_canvas_load_layer(canvas);
+    gb_canvas_load_paint(canvas);
+}
+tb_void_t gb_demo_layer_event(gb_window_ref_t window, gb_event_ref_t event)
+{
+    // redraw the background
+    if (event->type == GB_EVENT_TYPE_KEYBOARD && event->u.keyboard.pressed && event->u.keyboard.code == 'l')
+        gb_layer_invalidate(g_background);
+}
@@ -0,0 +1,75 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "markers"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "markers.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the markers count of each row and column
+#define GB_DEMO_MARKERS_GRID        (100)
+
+// the markers count
+#define GB_DEMO_MARKERS_COUNT       (GB_DEMO_MARKERS_GRID * GB_DEMO_MARKERS_GRID)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the marker path
+static gb_path_ref_t    g_marker = tb_null;
+
+// the marker matrices
+static gb_matrix_t      g_matrices[GB_DEMO_MARKERS_COUNT];
+
+// the marker colors
+static gb_color_t       g_colors[GB_DEMO_MARKERS_COUNT];
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t gb_demo_markers_init(gb_window_ref_t window)
+{
+    // init the marker path
+    g_marker = gb_path_init();
+    if (g_marker) gb_path_add_circle2i(g_marker, 0, 0, 3, GB_ROTATE_DIRECTION_CW);
+
+    // init the grid of the markers
+    tb_size_t i = 0;
+    for (i = 0; i < GB_DEMO_MARKERS_COUNT; i++)
+    {
+        tb_long_t x = (tb_long_t)(i % GB_DEMO_MARKERS_GRID) - (GB_DEMO_MARKERS_GRID >> 1);
+        tb_long_t y = (tb_long_t)(i / GB_DEMO_MARKERS_GRID) - (GB_DEMO_MARKERS_GRID >> 1);
+        gb_matrix_init_translate(&g_matrices[i], gb_long_to_float(x << 3), gb_long_to_float(y << 3));
+
+        g_colors[i].r = (tb_byte_t)((i % GB_DEMO_MARKERS_GRID) * 255 / GB_DEMO_MARKERS_GRID);
+        g_colors[i].g = (tb_byte_t)((i / GB_DEMO_MARKERS_GRID) * 255 / GB_DEMO_MARKERS_GRID);
+        g_colors[i].b = 128;
+        g_colors[i].a = 255;
+    }
+}
+tb_void_t gb_demo_markers_exit(gb_window_ref_t window)
+{
+    // exit the marker path
+    if (g_marker) gb_path_exit(g_marker);
+    g_marker = tb_null;
+}
+tb_void_t gb_demo_markers_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
+{
+    // check
+    tb_check_return(g_marker);
+
+    // fill all markers, the marker is only tessellated once
+    gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+    gb_canvas_draw_instances(canvas, g_marker, g_matrices, g_colors, GB_DEMO_MARKERS_COUNT);
+}
+tb_void_t gb_demo_markers_event(gb_window_ref_t window, gb_event_ref_t event)
+{
+}
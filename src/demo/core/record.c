@@ -0,0 +1,82 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "record"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "record.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the shapes count of each row and column
+#define GB_DEMO_RECORD_GRID         (40)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the display list
+static gb_display_list_ref_t    g_list = tb_null;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t gb_demo_record_init(gb_window_ref_t window)
+{
+    // init the display list
+    g_list = gb_display_list_init();
+    tb_check_return(g_list);
+
+    // init the recording canvas
+    gb_canvas_ref_t canvas = gb_canvas_init_from_record(g_list, gb_window_width(window), gb_window_height(window));
+    tb_check_return(canvas);
+
+    // record the grid of the shapes once, it is only replayed for drawing
+    tb_size_t i = 0;
+    tb_size_t n = GB_DEMO_RECORD_GRID * GB_DEMO_RECORD_GRID;
+    for (i = 0; i < n; i++)
+    {
+        tb_long_t x = ((tb_long_t)(i % GB_DEMO_RECORD_GRID) - (GB_DEMO_RECORD_GRID >> 1)) << 4;
+        tb_long_t y = ((tb_long_t)(i / GB_DEMO_RECORD_GRID) - (GB_DEMO_RECORD_GRID >> 1)) << 4;
+        if (i & 1)
+        {
+            gb_canvas_mode_set(canvas, GB_PAINT_MODE_FILL);
+            gb_canvas_color_set(canvas, GB_COLOR_BLUE);
+            gb_canvas_draw_circle2i(canvas, x + 8, y + 8, 6);
+        }
+        else
+        {
+            gb_canvas_mode_set(canvas, GB_PAINT_MODE_STROKE);
+            gb_canvas_color_set(canvas, GB_COLOR_RED);
+            gb_canvas_draw_rect2i(canvas, x + 2, y + 2, 12, 12);
+        }
+    }
+
+    // trace
+    tb_trace_i("recorded: %lu commands", gb_display_list_size(g_list));
+
+    // exit the recording canvas
+    gb_canvas_exit(canvas);
+}
+tb_void_t gb_demo_record_exit(gb_window_ref_t window)
+{
+    // exit the display list
+    if (g_list) gb_display_list_exit(g_list);
+    g_list = tb_null;
+}
+tb_void_t gb_demo_record_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
+{
+    // check
+    tb_check_return(g_list);
+
+    // replay it with the current matrix, the shapes out of the window are skipped
+    gb_canvas_draw_display_list(canvas, g_list);
+}
+tb_void_t gb_demo_record_event(gb_window_ref_t window, gb_event_ref_t event)
+{
+}
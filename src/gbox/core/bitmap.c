@@ -59,8 +59,47 @@ typedef struct __gb_bitmap_impl_t
 	// the lpitch
 	tb_uint16_t         row_bytes;
 
+	// the id
+	tb_size_t           id;
+
+	// the content generation
+	tb_size_t           generation;
+
+	// the generation since which the dirty rect is accumulated
+	tb_size_t           dirty_generation;
+
+	// the dirty rect: [dirty_x0, dirty_x1) x [dirty_y0, dirty_y1), empty if dirty_x0 >= dirty_x1
+	tb_uint16_t         dirty_x0;
+	tb_uint16_t         dirty_y0;
+	tb_uint16_t         dirty_x1;
+	tb_uint16_t         dirty_y1;
+
 }gb_bitmap_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the bitmap id
+static tb_atomic_t      g_id = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_bitmap_changed(gb_bitmap_impl_t* impl)
+{
+    // check
+    tb_assert_abort(impl);
+
+    // all pixels are changed, the old dirty rect is not used now
+    impl->generation++;
+    impl->dirty_generation = impl->generation;
+    impl->dirty_x0 = 0;
+    impl->dirty_y0 = 0;
+    impl->dirty_x1 = 0;
+    impl->dirty_y1 = 0;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -96,6 +135,7 @@ gb_bitmap_ref_t gb_bitmap_init(tb_pointer_t data, tb_size_t pixfmt, tb_size_t wi
         impl->data          = data? data : tb_malloc0(impl->size);
         impl->has_alpha     = !!has_alpha;
         impl->is_owner      = !data;
+        impl->id            = (tb_size_t)tb_atomic_fetch_and_inc(&g_id) + 1;
         tb_assert_and_check_break(impl->data);
 
         // ok
@@ -217,6 +257,9 @@ tb_bool_t gb_bitmap_data_set(gb_bitmap_ref_t bitmap, tb_pointer_t data, tb_size_
         impl->is_owner      = 1;
         impl->has_alpha     = !!has_alpha;
 
+        // changed
+        gb_bitmap_changed(impl);
+
         // ok
         ok = tb_true;
 
@@ -263,6 +306,9 @@ tb_bool_t gb_bitmap_resize(gb_bitmap_ref_t bitmap, tb_size_t width, tb_size_t he
         tb_assert_and_check_return_val(impl->data, tb_false);
     }
 
+    // changed
+    gb_bitmap_changed(impl);
+
 	// ok
 	return tb_true;
 }
@@ -308,8 +354,11 @@ tb_void_t gb_bitmap_set_alpha(gb_bitmap_ref_t bitmap, tb_bool_t has_alpha)
 	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
 	tb_assert_and_check_return(impl);
 
+    // changed?
+    if (impl->has_alpha != !!has_alpha) gb_bitmap_changed(impl);
+
     // done
-    impl->has_alpha = has_alpha;
+    impl->has_alpha = !!has_alpha;
 }
 tb_size_t gb_bitmap_row_bytes(gb_bitmap_ref_t bitmap)
 {
@@ -320,3 +369,95 @@ tb_size_t gb_bitmap_row_bytes(gb_bitmap_ref_t bitmap)
     // the row bytes
 	return impl->row_bytes;
 }
+tb_size_t gb_bitmap_id(gb_bitmap_ref_t bitmap)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return_val(impl, 0);
+
+    // the id
+	return impl->id;
+}
+tb_size_t gb_bitmap_generation(gb_bitmap_ref_t bitmap)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return_val(impl, 0);
+
+    // the generation
+	return impl->generation;
+}
+tb_void_t gb_bitmap_invalidate(gb_bitmap_ref_t bitmap, gb_rect_ref_t rect)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return(impl);
+
+    // all pixels are changed?
+    if (!rect)
+    {
+        gb_bitmap_changed(impl);
+        return ;
+    }
+
+    // the changed pixels, clipped by the bitmap
+    tb_long_t x0 = tb_max(gb_floor(rect->x), 0);
+    tb_long_t y0 = tb_max(gb_floor(rect->y), 0);
+    tb_long_t x1 = tb_min(gb_ceil(rect->x + rect->w), (tb_long_t)impl->width);
+    tb_long_t y1 = tb_min(gb_ceil(rect->y + rect->h), (tb_long_t)impl->height);
+    tb_check_return(x0 < x1 && y0 < y1);
+
+    // update generation
+    impl->generation++;
+
+    // merge the dirty rect
+    if (impl->dirty_x0 < impl->dirty_x1)
+    {
+        impl->dirty_x0 = (tb_uint16_t)tb_min(x0, (tb_long_t)impl->dirty_x0);
+        impl->dirty_y0 = (tb_uint16_t)tb_min(y0, (tb_long_t)impl->dirty_y0);
+        impl->dirty_x1 = (tb_uint16_t)tb_max(x1, (tb_long_t)impl->dirty_x1);
+        impl->dirty_y1 = (tb_uint16_t)tb_max(y1, (tb_long_t)impl->dirty_y1);
+    }
+    else
+    {
+        impl->dirty_x0 = (tb_uint16_t)x0;
+        impl->dirty_y0 = (tb_uint16_t)y0;
+        impl->dirty_x1 = (tb_uint16_t)x1;
+        impl->dirty_y1 = (tb_uint16_t)y1;
+    }
+}
+tb_bool_t gb_bitmap_dirty(gb_bitmap_ref_t bitmap, tb_size_t generation, gb_rect_ref_t rect)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return_val(impl && rect, tb_false);
+
+    // the dirty rect does not contain all changes since this generation?
+    tb_check_return_val(generation >= impl->dirty_generation && generation <= impl->generation, tb_false);
+
+    // not changed?
+    if (generation == impl->generation || impl->dirty_x0 >= impl->dirty_x1)
+    {
+        gb_rect_imake(rect, 0, 0, 0, 0);
+        return tb_true;
+    }
+
+    // the dirty rect
+    gb_rect_imake(rect, impl->dirty_x0, impl->dirty_y0, impl->dirty_x1 - impl->dirty_x0, impl->dirty_y1 - impl->dirty_y0);
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_bitmap_dirty_clear(gb_bitmap_ref_t bitmap)
+{
+    // check
+	gb_bitmap_impl_t* impl = (gb_bitmap_impl_t*)bitmap;
+	tb_assert_and_check_return(impl);
+
+    // clear the dirty rect
+    impl->dirty_generation = impl->generation;
+    impl->dirty_x0 = 0;
+    impl->dirty_y0 = 0;
+    impl->dirty_x1 = 0;
+    impl->dirty_y1 = 0;
+}
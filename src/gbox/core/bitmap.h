@@ -162,6 +162,45 @@ tb_void_t           gb_bitmap_set_alpha(gb_bitmap_ref_t bitmap, tb_bool_t has_al
  */
 tb_size_t           gb_bitmap_row_bytes(gb_bitmap_ref_t bitmap);
 
+/*! the bitmap id which is unique for all bitmaps and will not be reused
+ *
+ * @param bitmap    the bitmap
+ *
+ * @return          the bitmap id
+ */
+tb_size_t           gb_bitmap_id(gb_bitmap_ref_t bitmap);
+
+/*! the content generation, it will be increased if the bitmap is changed
+ *
+ * @param bitmap    the bitmap
+ *
+ * @return          the generation
+ */
+tb_size_t           gb_bitmap_generation(gb_bitmap_ref_t bitmap);
+
+/*! invalidate the changed pixels after modifying the bitmap data directly
+ *
+ * @param bitmap    the bitmap
+ * @param rect      the changed rect in pixels, invalidate all pixels if be null
+ */
+tb_void_t           gb_bitmap_invalidate(gb_bitmap_ref_t bitmap, gb_rect_ref_t rect);
+
+/*! the dirty rect of the pixels which are changed since the given generation
+ *
+ * @param bitmap    the bitmap
+ * @param generation the generation of the synchronized copy, .e.g the uploaded texture
+ * @param rect      the dirty rect in pixels, it is empty if not changed
+ *
+ * @return          tb_false if the changed pixels are unknown and all pixels need be synchronized
+ */
+tb_bool_t           gb_bitmap_dirty(gb_bitmap_ref_t bitmap, tb_size_t generation, gb_rect_ref_t rect);
+
+/*! clear the dirty rect after the synchronized copy is updated to the current generation
+ *
+ * @param bitmap    the bitmap
+ */
+tb_void_t           gb_bitmap_dirty_clear(gb_bitmap_ref_t bitmap);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -35,14 +35,55 @@
 #include "device.h"
 #include "path.h"
 #include "paint.h"
+#include "bitmap.h"
 #include "clipper.h"
+#include "display_list.h"
+#include "layer.h"
 #include "impl/bounds.h"
 #include "impl/cache_stack.h"
+#include "impl/shape.h"
+#include "impl/layer.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum count of the pooled layers
+#define GB_CANVAS_LAYER_POOL_MAXN       (4)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the canvas layer type
+typedef struct __gb_canvas_layer_t
+{
+    // the parent device
+    gb_device_ref_t         device;
+
+    // the layer, be null if it is drawn to the parent device directly
+    gb_layer_ref_t          layer;
+
+    // the layer is allocated from the pool?
+    tb_bool_t               pooled;
+
+    // the alpha of the composition
+    tb_byte_t               alpha;
+
+    // the layer is drawn directly and its alpha is multiplied into the paint?
+    tb_bool_t               direct;
+
+    // the alpha of the direct layers before this layer is saved
+    tb_byte_t               direct_alpha;
+
+    // the integer bounds in the device space
+    gb_rect_t               bounds;
+
+    // the matrix when the layer is saved
+    gb_matrix_t             matrix;
+
+}gb_canvas_layer_t, *gb_canvas_layer_ref_t;
+
 // the canvas impl type
 typedef struct __gb_canvas_impl_t
 {
@@ -64,8 +105,140 @@ typedef struct __gb_canvas_impl_t
     // the clipper stack
     gb_cache_stack_ref_t    clipper_stack;
 
+    // the shape path for drawing the arc, circle, ellipse and round rect
+    gb_path_ref_t           shape_path;
+
+    // the layer stack
+    tb_stack_ref_t          layer_stack;
+
+    // the free layers of the pool
+    gb_layer_ref_t          layer_pool[GB_CANVAS_LAYER_POOL_MAXN];
+
+    // the free layers count of the pool
+    tb_size_t               layer_pool_size;
+
+    // the paint for compositing the layer
+    gb_paint_ref_t          layer_paint;
+
+    // the alpha of the layers drawn directly, it is multiplied into the alpha of the paint
+    tb_byte_t               direct_alpha;
+
 }gb_canvas_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_canvas_culled(gb_canvas_impl_t* impl, gb_rect_ref_t rect, tb_bool_t stroke)
+{
+    // check
+    tb_assert_abort(impl && impl->device && rect);
+
+    // the paint
+    gb_paint_ref_t paint = (gb_paint_ref_t)gb_cache_stack_peek(impl->paint_stack);
+    tb_assert_abort(paint);
+
+    // stroked?
+    if (!stroke) stroke = (gb_paint_mode(paint) & GB_PAINT_MODE_STROKE)? tb_true : tb_false;
+
+    // the visible bounds of the device
+    gb_rect_t visible;
+    gb_rect_imake(&visible, 0, 0, gb_device_width(impl->device), gb_device_height(impl->device));
+
+    // the clipped rect
+    gb_rect_ref_t clip = gb_clipper_rect((gb_clipper_ref_t)gb_cache_stack_peek(impl->clipper_stack));
+    if (clip && !gb_rect_intersect(&visible, clip)) return tb_true;
+
+    // the device bounds of the drawing
+    gb_rect_t bounds;
+    gb_bounds_make_for_device(&bounds, rect, &impl->matrix, paint, stroke);
+
+    // out of the visible bounds?
+    return !gb_rect_intersect(&bounds, &visible);
+}
+static tb_bool_t gb_canvas_culled_points(gb_canvas_impl_t* impl, gb_point_ref_t points, tb_size_t count, tb_bool_t stroke, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert_abort(impl && points && count && bounds);
+
+    // make the bounds of the points
+    gb_bounds_make(bounds, points, count);
+
+    // culled?
+    return gb_canvas_culled(impl, bounds, stroke);
+}
+
+static tb_size_t gb_canvas_layer_pixfmt(tb_size_t pixfmt)
+{
+    // uses the pixfmt of the device if it has the alpha channel, otherwise the transparent pixels will be lost
+    return (GB_PIXFMT_HAS_ALPHA(pixfmt) && GB_PIXFMT(pixfmt) != GB_PIXFMT(GB_PIXFMT_PAL8))? pixfmt : (GB_PIXFMT_ARGB8888 | GB_PIXFMT_NENDIAN);
+}
+static gb_layer_ref_t gb_canvas_layer_alloc(gb_canvas_impl_t* impl, tb_size_t pixfmt, tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert_abort(impl);
+
+    // find the free layer of the same size class
+    tb_size_t i = 0;
+    for (i = 0; i < impl->layer_pool_size; i++)
+    {
+        // fits?
+        gb_layer_ref_t layer = impl->layer_pool[i];
+        if (gb_layer_fits(layer, pixfmt, width, height))
+        {
+            // remove it from the pool
+            impl->layer_pool[i] = impl->layer_pool[--impl->layer_pool_size];
+            return layer;
+        }
+    }
+
+    // reuse the last free layer, its bitmap will be reallocated 
+    if (impl->layer_pool_size) return impl->layer_pool[--impl->layer_pool_size];
+
+    // make a new layer
+    return gb_layer_init();
+}
+static tb_void_t gb_canvas_layer_free(gb_canvas_impl_t* impl, gb_layer_ref_t layer)
+{
+    // check
+    tb_assert_abort(impl && layer);
+
+    // put it to the pool if the pool is not full
+    if (impl->layer_pool_size < GB_CANVAS_LAYER_POOL_MAXN) impl->layer_pool[impl->layer_pool_size++] = layer;
+    else gb_layer_exit(layer);
+}
+static tb_void_t gb_canvas_layer_bounds(gb_canvas_impl_t* impl, gb_rect_ref_t rect, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert_abort(impl && impl->device && bounds);
+
+    // the device size
+    tb_long_t width     = (tb_long_t)gb_device_width(impl->device);
+    tb_long_t height    = (tb_long_t)gb_device_height(impl->device);
+
+    // the whole device?
+    if (!rect) 
+    {
+        gb_rect_imake(bounds, 0, 0, width, height);
+        return ;
+    }
+
+    // map the rect to the device space
+    gb_point_t points[4];
+    gb_point_make(&points[0], rect->x, rect->y);
+    gb_point_make(&points[1], rect->x + rect->w, rect->y);
+    gb_point_make(&points[2], rect->x, rect->y + rect->h);
+    gb_point_make(&points[3], rect->x + rect->w, rect->y + rect->h);
+    gb_matrix_apply_points(&impl->matrix, points, tb_arrayn(points));
+    gb_bounds_make(bounds, points, tb_arrayn(points));
+
+    // align it to the pixels and clip it by the device
+    tb_long_t x0 = tb_max(gb_floor(bounds->x), 0);
+    tb_long_t y0 = tb_max(gb_floor(bounds->y), 0);
+    tb_long_t x1 = tb_min(gb_ceil(bounds->x + bounds->w), width);
+    tb_long_t y1 = tb_min(gb_ceil(bounds->y + bounds->h), height);
+    gb_rect_imake(bounds, x0, y0, tb_max(x1 - x0, 0), tb_max(y1 - y0, 0));
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -102,6 +275,21 @@ gb_canvas_ref_t gb_canvas_init(gb_device_ref_t device)
         impl->clipper_stack = gb_cache_stack_init(8, GB_CACHE_STACK_TYPE_CLIPPER);
         tb_assert_and_check_break(impl->clipper_stack);
 
+        // init shape path
+        impl->shape_path = gb_path_init();
+        tb_assert_and_check_break(impl->shape_path);
+
+        // init layer stack
+        impl->layer_stack = tb_stack_init(8, tb_element_mem(sizeof(gb_canvas_layer_t), tb_null, tb_null));
+        tb_assert_and_check_break(impl->layer_stack);
+
+        // init layer paint
+        impl->layer_paint = gb_paint_init();
+        tb_assert_and_check_break(impl->layer_paint);
+
+        // init the alpha of the direct layers
+        impl->direct_alpha = 0xff;
+
         // bind matrix
         gb_device_bind_matrix(impl->device, &impl->matrix);
 
@@ -215,12 +403,71 @@ gb_canvas_ref_t gb_canvas_init_from_bitmap(gb_bitmap_ref_t bitmap)
     return canvas;
 }
 #endif
+gb_canvas_ref_t gb_canvas_init_from_record(gb_display_list_ref_t list, tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert_and_check_return_val(list, tb_null);
+
+    // done
+    gb_canvas_ref_t canvas = tb_null;
+    gb_device_ref_t device = tb_null;
+    do
+    {
+        // init device 
+        device = gb_device_init_record(list, width, height);
+        tb_assert_and_check_break(device);
+
+        // init canvas 
+        canvas = gb_canvas_init(device);
+
+    } while (0);
+
+    // failed?
+    if (!canvas)
+    {
+        // exit device
+        if (device) gb_device_exit(device);
+        device = tb_null;
+    }
+
+    // ok?
+    return canvas;
+}
 tb_void_t gb_canvas_exit(gb_canvas_ref_t canvas)
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl);
 
+    // exit layer stack
+    if (impl->layer_stack) 
+    {
+        // discard the unloaded layers and restore the device of the canvas
+        while (tb_stack_size(impl->layer_stack))
+        {
+            gb_canvas_layer_ref_t layer = (gb_canvas_layer_ref_t)tb_stack_top(impl->layer_stack);
+            if (layer)
+            {
+                impl->device = layer->device;
+                if (layer->pooled && layer->layer) gb_layer_exit(layer->layer);
+            }
+            tb_stack_pop(impl->layer_stack);
+        }
+        tb_stack_exit(impl->layer_stack);
+    }
+    impl->layer_stack = tb_null;
+
+    // exit layer pool
+    while (impl->layer_pool_size) gb_layer_exit(impl->layer_pool[--impl->layer_pool_size]);
+
+    // exit layer paint
+    if (impl->layer_paint) gb_paint_exit(impl->layer_paint);
+    impl->layer_paint = tb_null;
+
+    // exit shape path
+    if (impl->shape_path) gb_path_exit(impl->shape_path);
+    impl->shape_path = tb_null;
+
     // exit clipper stack
     if (impl->clipper_stack) gb_cache_stack_exit(impl->clipper_stack);
     impl->clipper_stack = tb_null;
@@ -316,14 +563,14 @@ gb_clipper_ref_t gb_canvas_clipper(gb_canvas_ref_t canvas)
     // the clipper
     return (gb_clipper_ref_t)gb_cache_stack_object(impl->clipper_stack);
 }
-gb_path_ref_t gb_canvas_save_path(gb_canvas_ref_t canvas)
+tb_void_t gb_canvas_save_path(gb_canvas_ref_t canvas)
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
-    tb_assert_and_check_return_val(impl && impl->path_stack, tb_null);
+    tb_assert_and_check_return(impl && impl->path_stack);
 
     // save path
-    return (gb_path_ref_t)gb_cache_stack_save(impl->path_stack);
+    gb_cache_stack_save(impl->path_stack);
 }
 tb_void_t gb_canvas_load_path(gb_canvas_ref_t canvas)
 {
@@ -334,20 +581,14 @@ tb_void_t gb_canvas_load_path(gb_canvas_ref_t canvas)
     // load path
     gb_cache_stack_load(impl->path_stack);
 }
-gb_paint_ref_t gb_canvas_save_paint(gb_canvas_ref_t canvas)
+tb_void_t gb_canvas_save_paint(gb_canvas_ref_t canvas)
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
-    tb_assert_and_check_return_val(impl && impl->device && impl->paint_stack, tb_null);
+    tb_assert_and_check_return(impl && impl->paint_stack);
 
-    // save paint
-    gb_paint_ref_t paint = (gb_paint_ref_t)gb_cache_stack_save(impl->paint_stack);
-
-    // bind paint
-    gb_device_bind_paint(impl->device, paint);
-
-    // ok?
-    return paint;
+    // save paint, the bound paint will not be changed
+    gb_cache_stack_save(impl->paint_stack);
 }
 tb_void_t gb_canvas_load_paint(gb_canvas_ref_t canvas)
 {
@@ -359,7 +600,7 @@ tb_void_t gb_canvas_load_paint(gb_canvas_ref_t canvas)
     gb_cache_stack_load(impl->paint_stack);
 
     // bind paint
-    gb_device_bind_paint(impl->device, gb_canvas_paint(canvas));
+    gb_device_bind_paint(impl->device, (gb_paint_ref_t)gb_cache_stack_peek(impl->paint_stack));
 }
 gb_matrix_ref_t gb_canvas_save_matrix(gb_canvas_ref_t canvas)
 {
@@ -395,20 +636,14 @@ tb_void_t gb_canvas_load_matrix(gb_canvas_ref_t canvas)
     // pop it
     tb_stack_pop(impl->matrix_stack);
 }
-gb_clipper_ref_t gb_canvas_save_clipper(gb_canvas_ref_t canvas)
+tb_void_t gb_canvas_save_clipper(gb_canvas_ref_t canvas)
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
-    tb_assert_and_check_return_val(impl && impl->clipper_stack, tb_null);
-
-    // save clipper
-    gb_clipper_ref_t clipper = (gb_clipper_ref_t)gb_cache_stack_save(impl->clipper_stack);
-
-    // bind clipper
-    gb_device_bind_clipper(impl->device, clipper);
+    tb_assert_and_check_return(impl && impl->clipper_stack);
 
-    // ok?
-    return clipper;
+    // save clipper, the bound clipper will not be changed
+    gb_cache_stack_save(impl->clipper_stack);
 }
 tb_void_t gb_canvas_load_clipper(gb_canvas_ref_t canvas)
 {
@@ -420,7 +655,140 @@ tb_void_t gb_canvas_load_clipper(gb_canvas_ref_t canvas)
     gb_cache_stack_load(impl->clipper_stack);
 
     // bind clipper
-    gb_device_bind_clipper(impl->device, gb_canvas_clipper(canvas));
+    gb_device_bind_clipper(impl->device, (gb_clipper_ref_t)gb_cache_stack_peek(impl->clipper_stack));
+}
+tb_bool_t gb_canvas_save_layer(gb_canvas_ref_t canvas, gb_rect_ref_t bounds, tb_byte_t alpha, gb_layer_ref_t layer)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return_val(impl && impl->device && impl->layer_stack, tb_false);
+
+    // init layer
+    gb_canvas_layer_t entry = {0};
+    entry.device    = impl->device;
+    entry.alpha     = alpha;
+    entry.matrix    = impl->matrix;
+    gb_canvas_layer_bounds(impl, bounds, &entry.bounds);
+
+    // draw it to the offscreen device? 
+    tb_bool_t       drawn = tb_true;
+    gb_device_ref_t device = tb_null;
+    if (entry.bounds.w > 0 && entry.bounds.h > 0)
+    {
+        /* the record device records the drawings directly, 
+         * because the pooled bitmap may be changed before the display list is replayed
+         */
+        if (gb_device_type(impl->device) != GB_DEVICE_TYPE_RECORD)
+        {
+            // the pixfmt and size of the layer
+            tb_size_t pixfmt    = gb_canvas_layer_pixfmt(gb_device_pixfmt(impl->device));
+            tb_size_t width     = gb_device_width(impl->device);
+            tb_size_t height    = gb_device_height(impl->device);
+
+            // the cacheable layer or the pooled layer
+            entry.layer     = layer? layer : gb_canvas_layer_alloc(impl, pixfmt, width, height);
+            entry.pooled    = !layer;
+
+            // the offscreen device
+            if (entry.layer) device = gb_layer_device(entry.layer, pixfmt, width, height);
+            if (device)
+            {
+                // the cached pixels is valid? skip the drawing
+                if (layer && gb_layer_cached(layer, &entry.bounds, &entry.matrix)) drawn = tb_false;
+                // clear the pixels of the layer
+                else gb_layer_clear(entry.layer, &entry.bounds);
+            }
+            else 
+            {
+                // draw it to the parent device directly
+                if (entry.pooled && entry.layer) gb_canvas_layer_free(impl, entry.layer);
+                entry.layer     = tb_null;
+                entry.pooled    = tb_false;
+            }
+        }
+    }
+    // the layer is out of the device, skip the drawing
+    else drawn = tb_false;
+
+    /* the layer is drawn to the parent device directly, .e.g the record device or no memory for the layer,
+     * so multiply its alpha into the paint, but the overlapped drawings in it will be blended separately
+     */
+    entry.direct        = (drawn && !device && alpha != 0xff)? tb_true : tb_false;
+    entry.direct_alpha  = impl->direct_alpha;
+    if (entry.direct)
+    {
+        // save paint, it will be restored when the layer is loaded
+        gb_canvas_save_paint(canvas);
+
+        // multiply the alpha of this layer
+        gb_paint_ref_t paint = gb_canvas_paint(canvas);
+        if (paint) gb_paint_alpha_set(paint, (tb_byte_t)((gb_paint_alpha(paint) * alpha) / 0xff));
+        impl->direct_alpha = (tb_byte_t)((impl->direct_alpha * alpha) / 0xff);
+    }
+
+    // save layer
+    tb_stack_put(impl->layer_stack, &entry);
+
+    // switch to the offscreen device
+    if (device)
+    {
+        impl->device = device;
+        gb_device_bind_matrix(impl->device, &impl->matrix);
+        gb_device_bind_paint(impl->device, (gb_paint_ref_t)gb_cache_stack_peek(impl->paint_stack));
+        gb_device_bind_clipper(impl->device, (gb_clipper_ref_t)gb_cache_stack_peek(impl->clipper_stack));
+    }
+
+    // drawn?
+    return drawn;
+}
+tb_void_t gb_canvas_load_layer(gb_canvas_ref_t canvas)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->layer_stack && impl->layer_paint);
+
+    // the top layer
+    gb_canvas_layer_ref_t top = (gb_canvas_layer_ref_t)tb_stack_top(impl->layer_stack);
+    tb_assert_and_check_return(top);
+
+    // load layer
+    gb_canvas_layer_t entry = *top;
+    tb_stack_pop(impl->layer_stack);
+
+    // restore the parent device
+    impl->device = entry.device;
+    tb_assert_and_check_return(impl->device);
+
+    // the layer is drawn directly? restore the paint and the alpha of the parent layers
+    if (entry.direct)
+    {
+        gb_canvas_load_paint(canvas);
+        impl->direct_alpha = entry.direct_alpha;
+    }
+
+    // composite the offscreen layer
+    if (entry.layer)
+    {
+        // the cacheable layer? keep its pixels until it is invalidated or moved
+        if (!entry.pooled) gb_layer_cache(entry.layer, &entry.bounds, &entry.matrix);
+
+        // draw the pixels in the bounds with the alpha of the layer
+        gb_matrix_t identity;
+        gb_matrix_clear(&identity);
+        gb_paint_alpha_set(impl->layer_paint, entry.alpha);
+        gb_paint_quality_set(impl->layer_paint, gb_paint_quality((gb_paint_ref_t)gb_cache_stack_peek(impl->paint_stack)));
+        gb_device_bind_matrix(impl->device, &identity);
+        gb_device_bind_paint(impl->device, impl->layer_paint);
+        gb_device_draw_bitmap(impl->device, gb_layer_bitmap(entry.layer), &entry.bounds, &entry.bounds);
+
+        // recycle the pooled layer
+        if (entry.pooled) gb_canvas_layer_free(impl, entry.layer);
+    }
+
+    // rebind the matrix, paint and clipper, they may be changed in the layer
+    gb_device_bind_matrix(impl->device, &impl->matrix);
+    gb_device_bind_paint(impl->device, (gb_paint_ref_t)gb_cache_stack_peek(impl->paint_stack));
+    gb_device_bind_clipper(impl->device, (gb_clipper_ref_t)gb_cache_stack_peek(impl->clipper_stack));
 }
 tb_void_t gb_canvas_clear_path(gb_canvas_ref_t canvas)
 {
@@ -428,7 +796,17 @@ tb_void_t gb_canvas_clear_path(gb_canvas_ref_t canvas)
 }
 tb_void_t gb_canvas_clear_paint(gb_canvas_ref_t canvas)
 {
-    gb_paint_clear(gb_canvas_paint(canvas));
+    // the paint
+    gb_paint_ref_t paint = gb_canvas_paint(canvas);
+    tb_assert_and_check_return(paint);
+
+    // clear it and keep the quality of this canvas
+    tb_size_t quality = gb_paint_quality(paint);
+    gb_paint_clear(paint);
+    gb_paint_quality_set(paint, quality);
+
+    // keep the alpha of the layers drawn directly
+    gb_canvas_alpha_set(canvas, 0xff);
 }
 tb_void_t gb_canvas_clear_matrix(gb_canvas_ref_t canvas)
 {
@@ -446,13 +824,22 @@ tb_void_t gb_canvas_flag_set(gb_canvas_ref_t canvas, tb_size_t flag)
 {
     gb_paint_flag_set(gb_canvas_paint(canvas), flag);
 }
+tb_void_t gb_canvas_quality_set(gb_canvas_ref_t canvas, tb_size_t quality)
+{
+    gb_paint_quality_set(gb_canvas_paint(canvas), quality);
+}
 tb_void_t gb_canvas_color_set(gb_canvas_ref_t canvas, gb_color_t color)
 {
     gb_paint_color_set(gb_canvas_paint(canvas), color);
 }
 tb_void_t gb_canvas_alpha_set(gb_canvas_ref_t canvas, tb_byte_t alpha)
 {
-    gb_paint_alpha_set(gb_canvas_paint(canvas), alpha);
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl);
+
+    // set alpha, multiply the alpha of the layers drawn directly
+    gb_paint_alpha_set(gb_canvas_paint(canvas), (tb_byte_t)((alpha * impl->direct_alpha) / 0xff));
 }
 tb_void_t gb_canvas_stroke_width_set(gb_canvas_ref_t canvas, gb_float_t width)
 {
@@ -831,8 +1218,12 @@ tb_void_t gb_canvas_draw_clear(gb_canvas_ref_t canvas, gb_color_t color)
 }
 tb_void_t gb_canvas_draw(gb_canvas_ref_t canvas)
 {
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->path_stack);
+
     // draw path
-    gb_canvas_draw_path(canvas, gb_canvas_path(canvas));
+    gb_canvas_draw_path(canvas, (gb_path_ref_t)gb_cache_stack_peek(impl->path_stack));
 }
 tb_void_t gb_canvas_draw_path(gb_canvas_ref_t canvas, gb_path_ref_t path)
 {
@@ -840,6 +1231,9 @@ tb_void_t gb_canvas_draw_path(gb_canvas_ref_t canvas, gb_path_ref_t path)
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl && impl->device && path);
 
+    // null or out of the device? 
+    if (gb_path_null(path) || gb_canvas_culled(impl, gb_path_bounds(path), tb_false)) return ;
+
     // draw path
     gb_device_draw_path(impl->device, path);
 }
@@ -847,7 +1241,11 @@ tb_void_t gb_canvas_draw_point(gb_canvas_ref_t canvas, gb_point_ref_t point)
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
-    tb_assert_and_check_return(impl && impl->device);
+    tb_assert_and_check_return(impl && impl->device && point);
+
+    // out of the device?
+    gb_rect_t bounds;
+    if (gb_canvas_culled_points(impl, point, 1, tb_true, &bounds)) return ;
 
     // draw point
     gb_device_draw_points(impl->device, point, 1, tb_null);
@@ -879,9 +1277,9 @@ tb_void_t gb_canvas_draw_line(gb_canvas_ref_t canvas, gb_line_ref_t line)
     // init points
     gb_point_t points[] = {line->p0, line->p1};
 
-    // init bounds
+    // init bounds, out of the device?
     gb_rect_t bounds;
-    gb_bounds_make(&bounds, points, tb_arrayn(points));
+    if (gb_canvas_culled_points(impl, points, tb_arrayn(points), tb_true, &bounds)) return ;
 
     // draw lines
     gb_device_draw_lines(impl->device, points, 2, &bounds);
@@ -908,21 +1306,23 @@ tb_void_t gb_canvas_draw_arc(gb_canvas_ref_t canvas, gb_arc_ref_t arc)
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
-    tb_assert_and_check_return(impl && arc);
+    tb_assert_and_check_return(impl && impl->device && arc);
 
-    // save path
-    gb_path_ref_t path = gb_canvas_save_path(canvas);
+    // the bounds of the whole ellipse, out of the device?
+    gb_rect_t bounds;
+    gb_rect_make(&bounds, arc->c.x - arc->rx, arc->c.y - arc->ry, gb_lsh(arc->rx, 1), gb_lsh(arc->ry, 1));
+    if (gb_canvas_culled(impl, &bounds, tb_false)) return ;
+
+    // the shape path
+    gb_path_ref_t path = impl->shape_path;
     tb_assert_and_check_return(path);
 
     // make arc
     gb_path_clear(path);
     gb_path_add_arc(path, arc);
 
-    // draw it
-    gb_canvas_draw_path(canvas, path);
-
-    // load path
-    gb_canvas_load_path(canvas);
+    // draw it, it has been culled
+    gb_device_draw_path(impl->device, path);
 }
 tb_void_t gb_canvas_draw_arc2(gb_canvas_ref_t canvas, gb_float_t x0, gb_float_t y0, gb_float_t rx, gb_float_t ry, gb_float_t ab, gb_float_t an)
 {
@@ -949,18 +1349,15 @@ tb_void_t gb_canvas_draw_triangle(gb_canvas_ref_t canvas, gb_triangle_ref_t tria
     tb_assert_and_check_return(impl && impl->device && triangle);
 
     // init polygon
-    gb_point_t      points[] = {triangle->p0, triangle->p1, triangle->p2, triangle->p0};
-    tb_uint16_t     counts[] = {4, 0};
-    gb_polygon_t    polygon = {points, counts, tb_true};
-
-    // init hint
+    gb_point_t      points[4];
+    tb_uint16_t     counts[2];
+    gb_polygon_t    polygon;
     gb_shape_t      hint;
-    hint.type       = GB_SHAPE_TYPE_TRIANGLE;
-    hint.u.triangle = *triangle;
+    gb_shape_make_polygon_for_triangle(&polygon, &hint, points, counts, triangle);
 
-    // init bounds
+    // init bounds, out of the device?
     gb_rect_t       bounds;
-    gb_bounds_make(&bounds, points, tb_arrayn(points));
+    if (gb_canvas_culled_points(impl, points, 3, tb_false, &bounds)) return ;
 
     // draw it
     gb_device_draw_polygon(impl->device, &polygon, &hint, &bounds);
@@ -989,26 +1386,15 @@ tb_void_t gb_canvas_draw_rect(gb_canvas_ref_t canvas, gb_rect_ref_t rect)
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
     tb_assert_and_check_return(impl && impl->device && rect);
 
+    // out of the device?
+    if (gb_canvas_culled(impl, rect, tb_false)) return ;
+
     // init polygon
     gb_point_t      points[5];
-    tb_uint16_t     counts[] = {5, 0};
-    gb_polygon_t    polygon = {points, counts, tb_true};
-
-    // init points
-    points[0].x = rect->x;
-    points[0].y = rect->y;
-    points[1].x = rect->x + rect->w;
-    points[1].y = rect->y;
-    points[2].x = rect->x + rect->w;
-    points[2].y = rect->y + rect->h;
-    points[3].x = rect->x;
-    points[3].y = rect->y + rect->h;
-    points[4] = points[0];
-
-    // init hint
+    tb_uint16_t     counts[2];
+    gb_polygon_t    polygon;
     gb_shape_t      hint;
-    hint.type       = GB_SHAPE_TYPE_RECT;
-    hint.u.rect     = *rect;
+    gb_shape_make_polygon_for_rect(&polygon, &hint, points, counts, rect);
 
     // draw it
     gb_device_draw_polygon(impl->device, &polygon, &hint, rect);
@@ -1035,7 +1421,10 @@ tb_void_t gb_canvas_draw_round_rect(gb_canvas_ref_t canvas, gb_round_rect_ref_t
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
-    tb_assert_and_check_return(impl && rect);
+    tb_assert_and_check_return(impl && impl->device && rect);
+
+    // out of the device?
+    if (gb_canvas_culled(impl, &rect->bounds, tb_false)) return ;
 
     // is rect? 
     if (gb_round_rect_is_rect(rect))
@@ -1056,19 +1445,16 @@ tb_void_t gb_canvas_draw_round_rect(gb_canvas_ref_t canvas, gb_round_rect_ref_t
         return ;
     }
 
-    // save path
-    gb_path_ref_t path = gb_canvas_save_path(canvas);
+    // the shape path
+    gb_path_ref_t path = impl->shape_path;
     tb_assert_and_check_return(path);
 
     // make rect
     gb_path_clear(path);
     gb_path_add_round_rect(path, rect, GB_ROTATE_DIRECTION_CW);
 
-    // draw it
-    gb_canvas_draw_path(canvas, path);
-
-    // load path
-    gb_canvas_load_path(canvas);
+    // draw it, it has been culled
+    gb_device_draw_path(impl->device, path);
 }
 tb_void_t gb_canvas_draw_round_rect2(gb_canvas_ref_t canvas, gb_rect_ref_t bounds, gb_float_t rx, gb_float_t ry)
 {
@@ -1092,21 +1478,23 @@ tb_void_t gb_canvas_draw_circle(gb_canvas_ref_t canvas, gb_circle_ref_t circle)
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
-    tb_assert_and_check_return(impl && circle);
+    tb_assert_and_check_return(impl && impl->device && circle);
 
-    // save path
-    gb_path_ref_t path = gb_canvas_save_path(canvas);
+    // out of the device?
+    gb_rect_t bounds;
+    gb_rect_make(&bounds, circle->c.x - circle->r, circle->c.y - circle->r, gb_lsh(circle->r, 1), gb_lsh(circle->r, 1));
+    if (gb_canvas_culled(impl, &bounds, tb_false)) return ;
+
+    // the shape path
+    gb_path_ref_t path = impl->shape_path;
     tb_assert_and_check_return(path);
 
     // make circle
     gb_path_clear(path);
     gb_path_add_circle(path, circle, GB_ROTATE_DIRECTION_CW);
 
-    // draw it
-    gb_canvas_draw_path(canvas, path);
-
-    // load path
-    gb_canvas_load_path(canvas);
+    // draw it, it has been culled
+    gb_device_draw_path(impl->device, path);
 }
 tb_void_t gb_canvas_draw_circle2(gb_canvas_ref_t canvas, gb_float_t x0, gb_float_t y0, gb_float_t r)
 {
@@ -1130,21 +1518,23 @@ tb_void_t gb_canvas_draw_ellipse(gb_canvas_ref_t canvas, gb_ellipse_ref_t ellips
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
-    tb_assert_and_check_return(impl && ellipse);
+    tb_assert_and_check_return(impl && impl->device && ellipse);
 
-    // save path
-    gb_path_ref_t path = gb_canvas_save_path(canvas);
+    // out of the device?
+    gb_rect_t bounds;
+    gb_rect_make(&bounds, ellipse->c.x - ellipse->rx, ellipse->c.y - ellipse->ry, gb_lsh(ellipse->rx, 1), gb_lsh(ellipse->ry, 1));
+    if (gb_canvas_culled(impl, &bounds, tb_false)) return ;
+
+    // the shape path
+    gb_path_ref_t path = impl->shape_path;
     tb_assert_and_check_return(path);
 
     // make ellipse
     gb_path_clear(path);
     gb_path_add_ellipse(path, ellipse, GB_ROTATE_DIRECTION_CW);
 
-    // draw it
-    gb_canvas_draw_path(canvas, path);
-
-    // load path
-    gb_canvas_load_path(canvas);
+    // draw it, it has been culled
+    gb_device_draw_path(impl->device, path);
 }
 tb_void_t gb_canvas_draw_ellipse2(gb_canvas_ref_t canvas, gb_float_t x0, gb_float_t y0, gb_float_t rx, gb_float_t ry)
 {
@@ -1168,26 +1558,230 @@ tb_void_t gb_canvas_draw_polygon(gb_canvas_ref_t canvas, gb_polygon_ref_t polygo
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
-    tb_assert_and_check_return(impl && impl->device);
+    tb_assert_and_check_return(impl && impl->device && polygon && polygon->points && polygon->counts);
+
+    // the points count
+    tb_uint16_t         count;
+    tb_uint16_t const*  counts = polygon->counts;
+    tb_size_t           total = 0;
+    while ((count = *counts++)) total += count;
+    tb_check_return(total);
+
+    // init bounds, out of the device?
+    gb_rect_t bounds;
+    if (gb_canvas_culled_points(impl, polygon->points, total, tb_false, &bounds)) return ;
 
     // draw polygon
-    gb_device_draw_polygon(impl->device, polygon, tb_null, tb_null);
+    gb_device_draw_polygon(impl->device, polygon, tb_null, &bounds);
 }
 tb_void_t gb_canvas_draw_lines(gb_canvas_ref_t canvas, gb_point_ref_t points, tb_size_t count)
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
-    tb_assert_and_check_return(impl && impl->device && count && !(count & 0x1));
+    tb_assert_and_check_return(impl && impl->device && points && count && !(count & 0x1));
  
+    // init bounds, out of the device?
+    gb_rect_t bounds;
+    if (gb_canvas_culled_points(impl, points, count, tb_true, &bounds)) return ;
+
     // draw lines
-    gb_device_draw_lines(impl->device, points, count, tb_null);
+    gb_device_draw_lines(impl->device, points, count, &bounds);
 }
 tb_void_t gb_canvas_draw_points(gb_canvas_ref_t canvas, gb_point_ref_t points, tb_size_t count)
 {
     // check
     gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
-    tb_assert_and_check_return(impl && impl->device && count);
+    tb_assert_and_check_return(impl && impl->device && points && count);
+
+    // init bounds, out of the device?
+    gb_rect_t bounds;
+    if (gb_canvas_culled_points(impl, points, count, tb_true, &bounds)) return ;
 
     // draw points
-    gb_device_draw_points(impl->device, points, count, tb_null);
+    gb_device_draw_points(impl->device, points, count, &bounds);
+}
+tb_void_t gb_canvas_draw_rects(gb_canvas_ref_t canvas, gb_rect_ref_t rects, tb_size_t count)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && rects);
+
+    // no rects?
+    tb_check_return(count);
+
+    // init bounds
+    tb_size_t i = 0;
+    gb_rect_t bounds = rects[0];
+    for (i = 1; i < count; i++) gb_rect_merge(&bounds, &rects[i]);
+
+    // out of the device?
+    if (gb_canvas_culled(impl, &bounds, tb_false)) return ;
+
+    // draw rects
+    gb_device_draw_rects(impl->device, rects, count, &bounds);
+}
+tb_void_t gb_canvas_draw_triangles(gb_canvas_ref_t canvas, gb_triangle_ref_t triangles, tb_size_t count)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && triangles);
+
+    // no triangles?
+    tb_check_return(count);
+
+    // init bounds, the triangle is three points
+    gb_rect_t bounds;
+    gb_bounds_make(&bounds, (gb_point_ref_t)triangles, count * 3);
+
+    // out of the device?
+    if (gb_canvas_culled(impl, &bounds, tb_false)) return ;
+
+    // draw triangles
+    gb_device_draw_triangles(impl->device, triangles, count, &bounds);
+}
+tb_void_t gb_canvas_draw_circles(gb_canvas_ref_t canvas, gb_circle_ref_t circles, tb_size_t count)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && circles);
+
+    // no circles?
+    tb_check_return(count);
+
+    // init bounds
+    tb_size_t i = 0;
+    gb_rect_t bounds;
+    gb_rect_t circle_bounds;
+    for (i = 0; i < count; i++)
+    {
+        // the bounds of this circle
+        gb_rect_make(&circle_bounds, circles[i].c.x - circles[i].r, circles[i].c.y - circles[i].r, gb_lsh(circles[i].r, 1), gb_lsh(circles[i].r, 1));
+
+        // merge it
+        if (i) gb_rect_merge(&bounds, &circle_bounds);
+        else bounds = circle_bounds;
+    }
+
+    // out of the device?
+    if (gb_canvas_culled(impl, &bounds, tb_false)) return ;
+
+    // the shape path
+    gb_path_ref_t path = impl->shape_path;
+    tb_assert_and_check_return(path);
+
+    // the paint
+    gb_paint_ref_t paint = gb_canvas_paint(canvas);
+    tb_assert_and_check_return(paint);
+
+    // make circles
+    gb_path_clear(path);
+    for (i = 0; i < count; i++) gb_path_add_circle(path, &circles[i], GB_ROTATE_DIRECTION_CW);
+
+    /* fill the overlapped circles by the nonzero rule, 
+     * the odd rule will cut the overlapped areas of the clockwise circles
+     */
+    tb_size_t rule = gb_paint_fill_rule(paint);
+    if (rule != GB_PAINT_FILL_RULE_NONZERO) gb_paint_fill_rule_set(paint, GB_PAINT_FILL_RULE_NONZERO);
+
+    // draw it, it has been culled
+    gb_device_draw_path(impl->device, path);
+
+    // restore the fill rule
+    if (rule != GB_PAINT_FILL_RULE_NONZERO) gb_paint_fill_rule_set(paint, rule);
+}
+tb_void_t gb_canvas_draw_polylines(gb_canvas_ref_t canvas, gb_point_ref_t points, tb_uint16_t const* counts)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && points && counts);
+
+    // the paint
+    gb_paint_ref_t paint = gb_canvas_paint(canvas);
+    tb_assert_and_check_return(paint);
+
+    // the polylines are only stroked
+    tb_size_t mode = gb_paint_mode(paint);
+    tb_check_return(mode & GB_PAINT_MODE_STROKE);
+
+    // the points count
+    tb_uint16_t         count;
+    tb_uint16_t const*  counts_data = counts;
+    tb_size_t           total = 0;
+    while ((count = *counts_data++)) total += count;
+    tb_check_return(total);
+
+    // init bounds, out of the device?
+    gb_rect_t bounds;
+    if (gb_canvas_culled_points(impl, points, total, tb_true, &bounds)) return ;
+
+    // the shape path
+    gb_path_ref_t path = impl->shape_path;
+    tb_assert_and_check_return(path);
+
+    // make the open contours of the polylines
+    tb_size_t index = 0;
+    gb_path_clear(path);
+    while ((count = *counts++))
+    {
+        // make one polyline
+        gb_path_move_to(path, points++);
+        for (index = 1; index < count; index++) gb_path_line_to(path, points++);
+    }
+
+    // only stroke it, the open contours will be closed and filled by the fill mode
+    if (mode != GB_PAINT_MODE_STROKE) gb_paint_mode_set(paint, GB_PAINT_MODE_STROKE);
+
+    // draw it, it has been culled
+    gb_device_draw_path(impl->device, path);
+
+    // restore the mode
+    if (mode != GB_PAINT_MODE_STROKE) gb_paint_mode_set(paint, mode);
+}
+tb_void_t gb_canvas_draw_bitmap(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && bitmap);
+
+    // init bounds
+    gb_rect_t bounds;
+    if (dst_rect) bounds = *dst_rect;
+    else if (src_rect) gb_rect_make(&bounds, 0, 0, src_rect->w, src_rect->h);
+    else gb_rect_imake(&bounds, 0, 0, gb_bitmap_width(bitmap), gb_bitmap_height(bitmap));
+
+    // out of the device?
+    if (gb_canvas_culled(impl, &bounds, tb_false)) return ;
+
+    // draw bitmap
+    gb_device_draw_bitmap(impl->device, bitmap, src_rect, dst_rect);
+}
+tb_void_t gb_canvas_draw_bitmap2i(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, tb_long_t x, tb_long_t y)
+{
+    // check
+    tb_assert_and_check_return(bitmap);
+
+    // make the destination rect
+    gb_rect_t dst_rect;
+    gb_rect_imake(&dst_rect, x, y, gb_bitmap_width(bitmap), gb_bitmap_height(bitmap));
+
+    // draw bitmap
+    gb_canvas_draw_bitmap(canvas, bitmap, tb_null, &dst_rect);
+}
+tb_void_t gb_canvas_draw_instances(gb_canvas_ref_t canvas, gb_path_ref_t path, gb_matrix_ref_t matrices, gb_color_t const* colors, tb_size_t count)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device);
+
+    // draw instances
+    gb_device_draw_instances(impl->device, path, matrices, colors, count);
+}
+tb_void_t gb_canvas_draw_display_list(gb_canvas_ref_t canvas, gb_display_list_ref_t list)
+{
+    // check
+    gb_canvas_impl_t* impl = (gb_canvas_impl_t*)canvas;
+    tb_assert_and_check_return(impl && impl->device && list);
+
+    // replay it
+    gb_display_list_replay(list, impl->device, &impl->matrix);
 }
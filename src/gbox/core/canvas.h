@@ -74,6 +74,16 @@ gb_canvas_ref_t     gb_canvas_init_from_skia(gb_bitmap_ref_t bitmap);
 gb_canvas_ref_t     gb_canvas_init_from_bitmap(gb_bitmap_ref_t bitmap);
 #endif
 
+/*! init canvas for recording the drawings to the given display list
+ *
+ * @param list      the display list
+ * @param width     the width
+ * @param height    the height
+ *
+ * @return          the canvas
+ */
+gb_canvas_ref_t     gb_canvas_init_from_record(gb_display_list_ref_t list, tb_size_t width, tb_size_t height);
+
 /*! exit canvas
  *
  * @param canvas    the canvas
@@ -146,11 +156,12 @@ gb_clipper_ref_t    gb_canvas_clipper(gb_canvas_ref_t canvas);
 
 /*! save path 
  *
- * @param canvas    the canvas
+ * the saved path is shared with the current path and it will be copied 
+ * only when the current path is modified, so the save and load are cheap
  *
- * @return          the current path
+ * @param canvas    the canvas
  */
-gb_path_ref_t       gb_canvas_save_path(gb_canvas_ref_t canvas);
+tb_void_t           gb_canvas_save_path(gb_canvas_ref_t canvas);
 
 /*! load path 
  *
@@ -160,11 +171,12 @@ tb_void_t           gb_canvas_load_path(gb_canvas_ref_t canvas);
 
 /*! save paint 
  *
- * @param canvas    the canvas
+ * the saved paint is shared with the current paint and it will be copied 
+ * only when the current paint is modified, so the save and load are cheap
  *
- * @return          the current paint
+ * @param canvas    the canvas
  */
-gb_paint_ref_t      gb_canvas_save_paint(gb_canvas_ref_t canvas);
+tb_void_t           gb_canvas_save_paint(gb_canvas_ref_t canvas);
 
 /*! load paint 
  *
@@ -188,11 +200,12 @@ tb_void_t           gb_canvas_load_matrix(gb_canvas_ref_t canvas);
 
 /*! save clipper 
  *
- * @param canvas    the canvas
+ * the saved clipper is shared with the current clipper and it will be copied 
+ * only when the current clipper is modified, so the save and load are cheap
  *
- * @return          the current clipper
+ * @param canvas    the canvas
  */
-gb_clipper_ref_t    gb_canvas_save_clipper(gb_canvas_ref_t canvas);
+tb_void_t           gb_canvas_save_clipper(gb_canvas_ref_t canvas);
 
 /*! load clipper 
  *
@@ -200,6 +213,39 @@ gb_clipper_ref_t    gb_canvas_save_clipper(gb_canvas_ref_t canvas);
  */
 tb_void_t           gb_canvas_load_clipper(gb_canvas_ref_t canvas);
 
+/*! save layer and redirect the drawings to the offscreen layer
+ *
+ * the drawings are composited back to the parent device with the alpha of the layer 
+ * when the layer is loaded. the offscreen bitmaps of the layers are pooled by the size class.
+ *
+ * @code
+ * // draw a translucent group
+ * gb_canvas_save_layer(canvas, &bounds, 128, tb_null);
+ * gb_canvas_draw_rect(canvas, &rect);
+ * gb_canvas_draw_circle(canvas, &circle);
+ * gb_canvas_load_layer(canvas);
+ * @endcode
+ *
+ * @note the record device draws the layer directly, and so does the other device if the layer cannot be allocated.
+ * the alpha of the direct layer is multiplied into the alpha of the paint until the layer is loaded,
+ * and gb_canvas_alpha_set() and gb_canvas_clear_paint() keep it, 
+ * but the overlapped drawings in the direct layer are blended separately instead of as a group.
+ *
+ * @param canvas    the canvas
+ * @param bounds    the bounds of the layer, uses the whole device if be null
+ * @param alpha     the alpha of the composition
+ * @param layer     the cacheable layer which keeps the pixels between frames, uses the pooled layer if be null
+ *
+ * @return          tb_false if the drawings can be skipped, .e.g the cached pixels is valid or the layer is out of the device
+ */
+tb_bool_t           gb_canvas_save_layer(gb_canvas_ref_t canvas, gb_rect_ref_t bounds, tb_byte_t alpha, gb_layer_ref_t layer);
+
+/*! load layer and composite it to the parent device
+ *
+ * @param canvas    the canvas
+ */
+tb_void_t           gb_canvas_load_layer(gb_canvas_ref_t canvas);
+
 /*! clear path 
  *
  * @param canvas    the canvas
@@ -238,6 +284,16 @@ tb_void_t           gb_canvas_mode_set(gb_canvas_ref_t canvas, tb_size_t mode);
  */
 tb_void_t           gb_canvas_flag_set(gb_canvas_ref_t canvas, tb_size_t flag);
 
+/*! set the paint quality 
+ *
+ * the canvas keeps this quality until it is changed again, even if the paint is cleared,
+ * so the canvases with the different qualities can be rendered in the same process
+ *
+ * @param canvas    the canvas
+ * @param quality   the quality
+ */
+tb_void_t           gb_canvas_quality_set(gb_canvas_ref_t canvas, tb_size_t quality);
+
 /*! set the paint color 
  *
  * @param canvas    the canvas
@@ -1112,6 +1168,107 @@ tb_void_t           gb_canvas_draw_lines(gb_canvas_ref_t canvas, gb_point_ref_t
  */
 tb_void_t           gb_canvas_draw_points(gb_canvas_ref_t canvas, gb_point_ref_t points, tb_size_t count);
 
+/*! draw rects
+ *
+ * the rects are drawn one by one like gb_canvas_draw_rect(), 
+ * but the culling and the render setup of the device are done only once
+ *
+ * @param canvas    the canvas
+ * @param rects     the rects
+ * @param count     the rects count
+ */
+tb_void_t           gb_canvas_draw_rects(gb_canvas_ref_t canvas, gb_rect_ref_t rects, tb_size_t count);
+
+/*! draw triangles
+ *
+ * the triangles are drawn one by one like gb_canvas_draw_triangle(), 
+ * but the culling and the render setup of the device are done only once
+ *
+ * @param canvas    the canvas
+ * @param triangles the triangles
+ * @param count     the triangles count
+ */
+tb_void_t           gb_canvas_draw_triangles(gb_canvas_ref_t canvas, gb_triangle_ref_t triangles, tb_size_t count);
+
+/*! draw circles
+ *
+ * all circles are drawn as one path, so the overlapped areas are only blended once,
+ * and they are always filled by the nonzero rule whatever the fill rule of the paint
+ *
+ * @param canvas    the canvas
+ * @param circles   the circles
+ * @param count     the circles count
+ */
+tb_void_t           gb_canvas_draw_circles(gb_canvas_ref_t canvas, gb_circle_ref_t circles, tb_size_t count);
+
+/*! draw polylines
+ *
+ * all polylines are drawn as one path of the open contours, 
+ * they are only stroked and nothing will be drawn if the paint has not the stroke mode
+ *
+ * <pre>
+ * gb_point_t       points[] = {{0, 0}, {10, 10}, {10, 20}, {30, 30}, {40, 30}};
+ * tb_uint16_t      counts[] = {3, 2, 0};
+ * gb_canvas_draw_polylines(canvas, points, counts);
+ * </pre>
+ *
+ * @param canvas    the canvas
+ * @param points    the points of all polylines
+ * @param counts    the points count of each polyline, end with zero
+ */
+tb_void_t           gb_canvas_draw_polylines(gb_canvas_ref_t canvas, gb_point_ref_t points, tb_uint16_t const* counts);
+
+/*! draw bitmap
+ *
+ * the source rect is scaled to the destination rect, 
+ * the bitmap device blits it directly if the matrix is only translated
+ * and samples it with the bilinear filter if GB_PAINT_FLAG_FILTER_BITMAP is set
+ *
+ * @param canvas    the canvas
+ * @param bitmap    the bitmap
+ * @param src_rect  the source rect in the bitmap, draw the whole bitmap if be null
+ * @param dst_rect  the destination rect, uses the size of the source rect at (0, 0) if be null
+ */
+tb_void_t           gb_canvas_draw_bitmap(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect);
+
+/*! draw bitmap at the given position
+ *
+ * @param canvas    the canvas
+ * @param bitmap    the bitmap
+ * @param x         the x-coordinate
+ * @param y         the y-coordinate
+ */
+tb_void_t           gb_canvas_draw_bitmap2i(gb_canvas_ref_t canvas, gb_bitmap_ref_t bitmap, tb_long_t x, tb_long_t y);
+
+/*! draw the instances of the path
+ *
+ * draw the same path many times with the different matrices and colors, .e.g the markers of the scatter plot.
+ * the path is only tessellated once for all instances by the gl device.
+ *
+ * @code
+    gb_matrix_t matrices[count];
+    for (i = 0; i < count; i++) gb_matrix_init_translate(&matrices[i], x[i], y[i]);
+    gb_canvas_draw_instances(canvas, marker, matrices, colors, count);
+ * @endcode
+ *
+ * @param canvas    the canvas
+ * @param path      the path of one instance
+ * @param matrices  the matrices of the instances, it is applied before the canvas matrix
+ * @param colors    the colors of the instances, uses the paint color if be null
+ * @param count     the instances count
+ */
+tb_void_t           gb_canvas_draw_instances(gb_canvas_ref_t canvas, gb_path_ref_t path, gb_matrix_ref_t matrices, gb_color_t const* colors, tb_size_t count);
+
+/*! draw the display list
+ *
+ * replay the recorded drawings with the current matrix of the canvas,
+ * the drawings out of the device are skipped.
+ *
+ * @param canvas    the canvas
+ * @param list      the display list
+ */
+tb_void_t           gb_canvas_draw_display_list(gb_canvas_ref_t canvas, gb_display_list_ref_t list);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -31,6 +31,7 @@
  * includes
  */
 #include "clipper.h"
+#include "impl/bounds.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -39,43 +40,97 @@
 // the clipper impl type
 typedef struct __gb_clipper_impl_t
 {
+    // the items count
+    tb_size_t               size;
 
+    // the matrix
+    gb_matrix_t             matrix;
+
+    // the clipped rect in the device space
+    gb_rect_t               rect;
 
 }gb_clipper_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-
 gb_clipper_ref_t gb_clipper_init()
 {
-    return (gb_clipper_ref_t)1;
+    // make clipper
+    gb_clipper_impl_t* impl = tb_malloc0_type(gb_clipper_impl_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init matrix
+    gb_matrix_clear(&impl->matrix);
+
+    // ok
+    return (gb_clipper_ref_t)impl;
 }
 tb_void_t gb_clipper_exit(gb_clipper_ref_t clipper)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl);
+
+    // exit it
+    tb_free(impl);
 }
 tb_size_t gb_clipper_size(gb_clipper_ref_t clipper)
 {
-    tb_trace_noimpl();
-    return 0;
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the items count
+    return impl->size;
 }
 tb_void_t gb_clipper_clear(gb_clipper_ref_t clipper)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl);
+
+    // clear it
+    impl->size = 0;
+    gb_matrix_clear(&impl->matrix);
 }
 tb_void_t gb_clipper_copy(gb_clipper_ref_t clipper, gb_clipper_ref_t copied)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    gb_clipper_impl_t* impl_copied = (gb_clipper_impl_t*)copied;
+    tb_assert_and_check_return(impl && impl_copied);
+
+    // copy it
+    tb_memcpy(impl, impl_copied, sizeof(gb_clipper_impl_t));
 }
 gb_matrix_ref_t gb_clipper_matrix(gb_clipper_ref_t clipper)
 {
-    tb_trace_noimpl();
-    return tb_null;
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the matrix
+    return &impl->matrix;
 }
 tb_void_t gb_clipper_matrix_set(gb_clipper_ref_t clipper, gb_matrix_ref_t matrix)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl);
+
+    // set it
+    if (matrix) impl->matrix = *matrix;
+    else gb_matrix_clear(&impl->matrix);
+}
+gb_rect_ref_t gb_clipper_rect(gb_clipper_ref_t clipper)
+{
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the clipped rect
+    return impl->size? &impl->rect : tb_null;
 }
 tb_void_t gb_clipper_add_path(gb_clipper_ref_t clipper, tb_size_t mode, gb_path_ref_t path)
 {
@@ -87,10 +142,46 @@ tb_void_t gb_clipper_add_triangle(gb_clipper_ref_t clipper, tb_size_t mode, gb_t
 }
 tb_void_t gb_clipper_add_rect(gb_clipper_ref_t clipper, tb_size_t mode, gb_rect_ref_t rect)
 {
-    tb_trace_noimpl();
+    // check
+    gb_clipper_impl_t* impl = (gb_clipper_impl_t*)clipper;
+    tb_assert_and_check_return(impl && rect);
+
+    // map the four corners to the device space, the rotated rect is clipped by its bounds
+    gb_rect_t   bounds;
+    gb_point_t  points[4];
+    gb_point_make(&points[0], rect->x, rect->y);
+    gb_point_make(&points[1], rect->x + rect->w, rect->y);
+    gb_point_make(&points[2], rect->x, rect->y + rect->h);
+    gb_point_make(&points[3], rect->x + rect->w, rect->y + rect->h);
+    gb_matrix_apply_points(&impl->matrix, points, tb_arrayn(points));
+    gb_bounds_make(&bounds, points, tb_arrayn(points));
+
+    // done
+    switch (mode)
+    {
+    case GB_CLIPPER_MODE_REPLACE:
+        impl->rect = bounds;
+        impl->size = 1;
+        break;
+    case GB_CLIPPER_MODE_INTERSECT:
+        if (impl->size) gb_rect_intersect(&impl->rect, &bounds);
+        else impl->rect = bounds;
+        impl->size++;
+        break;
+    case GB_CLIPPER_MODE_UNION:
+        if (impl->size) gb_rect_merge(&impl->rect, &bounds);
+        else impl->rect = bounds;
+        impl->size++;
+        break;
+    default:
+        // the subtracted rect cannot be kept by one rect
+        tb_trace_noimpl();
+        break;
+    }
 }
 tb_void_t gb_clipper_add_round_rect(gb_clipper_ref_t clipper, tb_size_t mode, gb_round_rect_ref_t rect)
 {
+    tb_trace_noimpl();
 }
 tb_void_t gb_clipper_add_circle(gb_clipper_ref_t clipper, tb_size_t mode, gb_circle_ref_t circle)
 {
@@ -100,4 +191,3 @@ tb_void_t gb_clipper_add_ellipse(gb_clipper_ref_t clipper, tb_size_t mode, gb_el
 {
     tb_trace_noimpl();
 }
-
@@ -100,6 +100,16 @@ gb_matrix_ref_t             gb_clipper_matrix(gb_clipper_ref_t clipper);
  */
 tb_void_t                   gb_clipper_matrix_set(gb_clipper_ref_t clipper, gb_matrix_ref_t matrix);
 
+/*! the clipped rect in the device space
+ *
+ * only the rect items are supported now, the drawings out of this rect are discarded by the device
+ *
+ * @param clipper           the clipper 
+ *
+ * @return                  the rect, null if not clipped
+ */
+gb_rect_ref_t               gb_clipper_rect(gb_clipper_ref_t clipper);
+
 /*! add path
  *
  * @param clipper           the clipper
@@ -35,6 +35,8 @@
 #include "canvas.h"
 #include "device.h"
 #include "clipper.h"
+#include "display_list.h"
+#include "layer.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
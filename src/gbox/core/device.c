@@ -35,6 +35,10 @@
 #include "device/prefix.h"
 #include "path.h"
 #include "paint.h"
+#include "shader.h"
+#include "bitmap.h"
+#include "impl/shape.h"
+#include "impl/bounds.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
@@ -201,6 +205,24 @@ tb_void_t gb_device_draw_clear(gb_device_ref_t device, gb_color_t color)
     // clear it
     impl->draw_clear(impl, color);
 }
+tb_void_t gb_device_draw_begin(gb_device_ref_t device)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl);
+
+    // begin it
+    if (impl->draw_begin) impl->draw_begin(impl);
+}
+tb_void_t gb_device_draw_flush(gb_device_ref_t device)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl);
+
+    // flush it
+    if (impl->draw_flush) impl->draw_flush(impl);
+}
 tb_void_t gb_device_draw_path(gb_device_ref_t device, gb_path_ref_t path)
 {
     // check
@@ -248,4 +270,184 @@ tb_void_t gb_device_draw_polygon(gb_device_ref_t device, gb_polygon_ref_t polygo
     // draw polygon
     impl->draw_polygon(impl, polygon, hint, bounds);
 }
+tb_void_t gb_device_draw_rects(gb_device_ref_t device, gb_rect_ref_t rects, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl && impl->draw_polygon && rects);
+
+    // no rects?
+    tb_check_return(count);
+
+    // draw rects by the device 
+    if (impl->draw_rects) 
+    {
+        impl->draw_rects(impl, rects, count, bounds);
+        return ;
+    }
+
+    // draw them one by one
+    tb_size_t       i = 0;
+    gb_point_t      points[5];
+    tb_uint16_t     counts[2];
+    gb_polygon_t    polygon;
+    gb_shape_t      hint;
+    for (i = 0; i < count; i++)
+    {
+        // make polygon
+        gb_shape_make_polygon_for_rect(&polygon, &hint, points, counts, &rects[i]);
+
+        // draw polygon
+        impl->draw_polygon(impl, &polygon, &hint, &rects[i]);
+    }
+}
+tb_void_t gb_device_draw_triangles(gb_device_ref_t device, gb_triangle_ref_t triangles, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl && impl->draw_polygon && triangles);
+
+    // no triangles?
+    tb_check_return(count);
+
+    // draw triangles by the device 
+    if (impl->draw_triangles) 
+    {
+        impl->draw_triangles(impl, triangles, count, bounds);
+        return ;
+    }
+
+    // draw them one by one
+    tb_size_t       i = 0;
+    gb_point_t      points[4];
+    tb_uint16_t     counts[2];
+    gb_polygon_t    polygon;
+    gb_shape_t      hint;
+    gb_rect_t       triangle_bounds;
+    for (i = 0; i < count; i++)
+    {
+        // make polygon
+        gb_shape_make_polygon_for_triangle(&polygon, &hint, points, counts, &triangles[i]);
+
+        // make bounds
+        gb_bounds_make(&triangle_bounds, points, 3);
+
+        // draw polygon
+        impl->draw_polygon(impl, &polygon, &hint, &triangle_bounds);
+    }
+}
+tb_void_t gb_device_draw_bitmap(gb_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl && impl->paint && bitmap);
+
+    // the source rect
+    gb_rect_t src;
+    if (src_rect) src = *src_rect;
+    else gb_rect_imake(&src, 0, 0, gb_bitmap_width(bitmap), gb_bitmap_height(bitmap));
+
+    // the destination rect
+    gb_rect_t dst;
+    if (dst_rect) dst = *dst_rect;
+    else gb_rect_make(&dst, 0, 0, src.w, src.h);
+
+    // empty?
+    tb_check_return(src.w > 0 && src.h > 0 && dst.w > 0 && dst.h > 0);
+
+    // draw bitmap by the device 
+    if (impl->draw_bitmap) 
+    {
+        impl->draw_bitmap(impl, bitmap, &src, &dst);
+        return ;
+    }
+
+    // init the bitmap shader
+    tb_assert_and_check_return(impl->shader_bitmap && impl->draw_polygon);
+    gb_shader_ref_t shader = impl->shader_bitmap(impl, GB_SHADER_MODE_CLAMP, bitmap);
+    tb_check_return(shader);
+
+    // map the source rect to the destination rect: translate(dst) * scale(dst / src) * translate(-src)
+    gb_matrix_t matrix;
+    gb_matrix_init_translate(&matrix, dst.x, dst.y);
+    gb_matrix_scale(&matrix, gb_div(dst.w, src.w), gb_div(dst.h, src.h));
+    gb_matrix_translate(&matrix, -src.x, -src.y);
+    gb_shader_matrix_set(shader, &matrix);
+
+    // save the shader and mode of the bound paint
+    gb_shader_ref_t shader_saved = gb_paint_shader(impl->paint);
+    tb_size_t       mode_saved = gb_paint_mode(impl->paint);
+    if (shader_saved) gb_shader_inc(shader_saved);
+
+    // fill the destination rect by the bitmap shader
+    gb_paint_shader_set(impl->paint, shader);
+    gb_paint_mode_set(impl->paint, GB_PAINT_MODE_FILL);
+
+    // make polygon
+    gb_point_t      points[5];
+    tb_uint16_t     counts[2];
+    gb_polygon_t    polygon;
+    gb_shape_t      hint;
+    gb_shape_make_polygon_for_rect(&polygon, &hint, points, counts, &dst);
+
+    // draw polygon
+    impl->draw_polygon(impl, &polygon, &hint, &dst);
+
+    // restore the shader and mode of the bound paint
+    gb_paint_shader_set(impl->paint, shader_saved);
+    gb_paint_mode_set(impl->paint, mode_saved);
+    if (shader_saved) gb_shader_dec(shader_saved);
+
+    // exit shader
+    gb_shader_exit(shader);
+}
+tb_void_t gb_device_draw_instances(gb_device_ref_t device, gb_path_ref_t path, gb_matrix_ref_t matrices, gb_color_t const* colors, tb_size_t count)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl && impl->matrix && impl->paint && path && matrices);
+
+    // null?
+    if (gb_path_null(path) || !count) return ;
+
+    // draw the instances by the device 
+    if (impl->draw_instances && impl->draw_instances(impl, path, matrices, colors, count)) return ;
+
+    // save the bound matrix and color
+    gb_matrix_t matrix = *impl->matrix;
+    gb_color_t  color = gb_paint_color(impl->paint);
+
+    // draw them one by one
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // apply the matrix of this instance: matrix * matrices[i]
+        *impl->matrix = matrix;
+        gb_matrix_multiply(impl->matrix, &matrices[i]);
+
+        // apply the color of this instance
+        if (colors) gb_paint_color_set(impl->paint, colors[i]);
+
+        // draw it
+        gb_device_draw_path(device, path);
+    }
+
+    // restore the bound matrix and color
+    *impl->matrix = matrix;
+    gb_paint_color_set(impl->paint, color);
+}
+tb_bool_t gb_device_read(gb_device_ref_t device, gb_bitmap_ref_t bitmap, tb_bool_t wait)
+{
+    // check
+    gb_device_impl_t* impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return_val(impl && bitmap, tb_false);
+
+    // not supported?
+    tb_check_return_val(impl->read, tb_false);
 
+    // flush the pending draws
+    gb_device_draw_flush(device);
+
+    // read it
+    return impl->read(impl, bitmap, wait);
+}
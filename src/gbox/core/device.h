@@ -46,6 +46,7 @@ typedef enum __gb_device_type_e
 ,   GB_DEVICE_TYPE_GL       = 1
 ,   GB_DEVICE_TYPE_BITMAP   = 2
 ,   GB_DEVICE_TYPE_SKIA     = 3
+,   GB_DEVICE_TYPE_RECORD   = 4
 
 }gb_device_type_e;
 
@@ -61,6 +62,20 @@ typedef enum __gb_device_type_e
  */
 gb_device_ref_t     gb_device_init(gb_window_ref_t window);
 
+#ifdef GB_CONFIG_PACKAGE_HAVE_OPENGL
+/*! init the offscreen gl device without any window
+ *
+ * the headless gl context is created by egl or osmesa and the device renders to the framebuffer object,
+ * the pixels can be read back to the bitmap by gb_device_read(), .e.g for the thumbnails on the servers.
+ *
+ * @param width     the width
+ * @param height    the height
+ *
+ * @return          the device
+ */
+gb_device_ref_t     gb_device_init_gl_offscreen(tb_size_t width, tb_size_t height);
+#endif
+
 #ifdef GB_CONFIG_PACKAGE_HAVE_SKIA
 /*! init skia device
  *
@@ -81,6 +96,19 @@ gb_device_ref_t     gb_device_init_skia(gb_bitmap_ref_t bitmap);
 gb_device_ref_t     gb_device_init_bitmap(gb_bitmap_ref_t bitmap);
 #endif
 
+/*! init the record device
+ *
+ * the drawings are recorded to the display list instead of being rendered,
+ * and the list can be replayed to any device later by gb_display_list_replay().
+ *
+ * @param list      the display list, it will not be exited with the device
+ * @param width     the width
+ * @param height    the height
+ *
+ * @return          the device
+ */
+gb_device_ref_t     gb_device_init_record(gb_display_list_ref_t list, tb_size_t width, tb_size_t height);
+
 /*! exit device 
  *
  * @param device    the device
@@ -155,6 +183,18 @@ tb_void_t           gb_device_bind_clipper(gb_device_ref_t device, gb_clipper_re
  */
 tb_void_t           gb_device_draw_clear(gb_device_ref_t device, gb_color_t color);
 
+/*! begin drawing a frame, .e.g the gl device forgets the gl states which may be modified outside by the window
+ *
+ * @param device    the device
+ */
+tb_void_t           gb_device_draw_begin(gb_device_ref_t device);
+
+/*! flush the pending draws to the target, .e.g the batched geometries of the gl device
+ *
+ * @param device    the device
+ */
+tb_void_t           gb_device_draw_flush(gb_device_ref_t device);
+
 /*! draw path
  *
  * @param device    the device
@@ -189,6 +229,80 @@ tb_void_t           gb_device_draw_points(gb_device_ref_t device, gb_point_ref_t
  */
 tb_void_t           gb_device_draw_polygon(gb_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds);
 
+/*! draw rects
+ *
+ * the rects are drawn one by one, but the render is only inited once
+ *
+ * @param device    the device
+ * @param rects     the rects
+ * @param count     the rects count
+ * @param bounds    the bounds of all rects
+ */
+tb_void_t           gb_device_draw_rects(gb_device_ref_t device, gb_rect_ref_t rects, tb_size_t count, gb_rect_ref_t bounds);
+
+/*! draw triangles
+ *
+ * the triangles are drawn one by one, but the render is only inited once
+ *
+ * @param device    the device
+ * @param triangles the triangles
+ * @param count     the triangles count
+ * @param bounds    the bounds of all triangles
+ */
+tb_void_t           gb_device_draw_triangles(gb_device_ref_t device, gb_triangle_ref_t triangles, tb_size_t count, gb_rect_ref_t bounds);
+
+/*! draw the source rect of the bitmap to the destination rect
+ *
+ * the bitmap is blended with the alpha of the paint and transformed by the bound matrix
+ *
+ * @param device    the device
+ * @param bitmap    the bitmap
+ * @param src_rect  the source rect in the bitmap, draw the whole bitmap if be null
+ * @param dst_rect  the destination rect, uses the size of the source rect at (0, 0) if be null
+ */
+tb_void_t           gb_device_draw_bitmap(gb_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect);
+
+/*! draw the instances of the path
+ *
+ * the matrix of each instance is applied before the bound matrix
+ *
+ * @param device    the device
+ * @param path      the path of one instance
+ * @param matrices  the matrices of the instances
+ * @param colors    the colors of the instances, uses the paint color if be null
+ * @param count     the instances count
+ */
+tb_void_t           gb_device_draw_instances(gb_device_ref_t device, gb_path_ref_t path, gb_matrix_ref_t matrices, gb_color_t const* colors, tb_size_t count);
+
+/*! read back the pixels of the device to the bitmap
+ *
+ * the pending draws will be flushed first. 
+ * the reading of the gl device is asynchronous if wait is tb_false: the current frame is started to read 
+ * and the previous frame is copied to the bitmap, so it returns tb_false for the first frame.
+ *
+ * @code
+ * gb_device_ref_t device = gb_device_init_gl_offscreen(256, 256);
+ * if (device)
+ * {
+ *     // draw something
+ *     // ...
+ *
+ *     // read the current frame
+ *     gb_device_read(device, bitmap, tb_true);
+ *
+ *     // exit device
+ *     gb_device_exit(device);
+ * }
+ * @endcode
+ *
+ * @param device    the device
+ * @param bitmap    the bitmap, the pixels out of the bitmap or device are ignored
+ * @param wait      wait the current frame? otherwise read the previous frame 
+ *
+ * @return          tb_true if the bitmap is updated, tb_false if no frame is ready or it is not supported
+ */
+tb_bool_t           gb_device_read(gb_device_ref_t device, gb_bitmap_ref_t bitmap, tb_bool_t wait);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -55,7 +55,11 @@ static tb_void_t gb_device_bitmap_resize(gb_device_impl_t* device, tb_size_t wid
     tb_assert_and_check_return(impl && impl->bitmap);
 
     // resize
-    gb_bitmap_resize(impl->bitmap, width, height);
+    if (!gb_bitmap_resize(impl->bitmap, width, height)) return ;
+
+    // update the width and height
+    impl->base.width    = (tb_uint16_t)width;
+    impl->base.height   = (tb_uint16_t)height;
 }
 static tb_void_t gb_device_bitmap_draw_clear(gb_device_impl_t* device, gb_color_t color)
 {
@@ -71,12 +75,43 @@ static tb_void_t gb_device_bitmap_draw_clear(gb_device_impl_t* device, gb_color_
     gb_pixmap_ref_t pixmap = impl->pixmap;
     tb_assert_abort(pixmap && pixmap->pixel && pixmap->pixels_fill);
 
+    // the clipped rect
+    gb_rect_ref_t clip = impl->base.clipper? gb_clipper_rect(impl->base.clipper) : tb_null;
+    if (clip)
+    {
+        // the clipped bounds
+        tb_long_t width     = (tb_long_t)gb_bitmap_width(impl->bitmap);
+        tb_long_t height    = (tb_long_t)gb_bitmap_height(impl->bitmap);
+        tb_long_t x0        = tb_max(gb_floor(clip->x), 0);
+        tb_long_t y0        = tb_max(gb_floor(clip->y), 0);
+        tb_long_t x1        = tb_min(gb_ceil(clip->x + clip->w), width);
+        tb_long_t y1        = tb_min(gb_ceil(clip->y + clip->h), height);
+        tb_check_return(x0 < x1 && y0 < y1);
+
+        // clear the clipped rows only
+        gb_pixel_t  pixel = pixmap->pixel(color);
+        tb_size_t   row_bytes = gb_bitmap_row_bytes(impl->bitmap);
+        tb_byte_t*  data = (tb_byte_t*)pixels + y0 * row_bytes + x0 * pixmap->btp;
+        tb_long_t   y;
+        for (y = y0; y < y1; y++, data += row_bytes)
+            pixmap->pixels_fill(data, pixel, x1 - x0, 0xff);
+
+        // the clipped pixels are changed
+        gb_rect_t rect;
+        gb_rect_imake(&rect, x0, y0, x1 - x0, y1 - y0);
+        gb_bitmap_invalidate(impl->bitmap, &rect);
+        return ;
+    }
+
     // the pixels count
     tb_size_t count = gb_bitmap_size(impl->bitmap) / pixmap->btp;
     tb_assert_abort(count);
 
     // clear it
     pixmap->pixels_fill(pixels, pixmap->pixel(color), count, 0xff);
+
+    // all pixels are changed
+    gb_bitmap_invalidate(impl->bitmap, tb_null);
 }
 static tb_void_t gb_device_bitmap_draw_lines(gb_device_impl_t* device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
 {
@@ -126,6 +161,52 @@ static tb_void_t gb_device_bitmap_draw_polygon(gb_device_impl_t* device, gb_poly
         gb_bitmap_render_exit(impl);
     }
 }
+static tb_void_t gb_device_bitmap_draw_rects(gb_device_impl_t* device, gb_rect_ref_t rects, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
+    tb_assert_and_check_return(impl && rects && count);
+
+    // init render
+    if (gb_bitmap_render_init(impl))
+    {
+        // draw rects
+        gb_bitmap_render_draw_rects(impl, rects, count, bounds);
+    
+        // exit render
+        gb_bitmap_render_exit(impl);
+    }
+}
+static tb_void_t gb_device_bitmap_draw_triangles(gb_device_impl_t* device, gb_triangle_ref_t triangles, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
+    tb_assert_and_check_return(impl && triangles && count);
+
+    // init render
+    if (gb_bitmap_render_init(impl))
+    {
+        // draw triangles
+        gb_bitmap_render_draw_triangles(impl, triangles, count, bounds);
+    
+        // exit render
+        gb_bitmap_render_exit(impl);
+    }
+}
+static tb_void_t gb_device_bitmap_draw_bitmap(gb_device_impl_t* device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    gb_bitmap_device_ref_t impl = (gb_bitmap_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->bitmap && bitmap && src_rect && dst_rect);
+
+    // draw bitmap
+    gb_rect_t bounds;
+    if (gb_bitmap_render_draw_bitmap(impl, bitmap, src_rect, dst_rect, &bounds))
+    {
+        // the changed pixels
+        gb_bitmap_invalidate(impl->bitmap, &bounds);
+    }
+}
 static tb_void_t gb_device_bitmap_draw_path(gb_device_impl_t* device, gb_path_ref_t path)
 {
     // check
@@ -219,12 +300,18 @@ gb_device_ref_t gb_device_init_bitmap(gb_bitmap_ref_t bitmap)
 
         // init base 
         impl->base.type             = GB_DEVICE_TYPE_BITMAP;
+        impl->base.pixfmt           = (tb_uint16_t)gb_bitmap_pixfmt(bitmap);
+        impl->base.width            = (tb_uint16_t)width;
+        impl->base.height           = (tb_uint16_t)height;
         impl->base.resize           = gb_device_bitmap_resize;
         impl->base.draw_clear       = gb_device_bitmap_draw_clear;
         impl->base.draw_path        = gb_device_bitmap_draw_path;
         impl->base.draw_lines       = gb_device_bitmap_draw_lines;
         impl->base.draw_points      = gb_device_bitmap_draw_points;
         impl->base.draw_polygon     = gb_device_bitmap_draw_polygon;
+        impl->base.draw_rects       = gb_device_bitmap_draw_rects;
+        impl->base.draw_triangles   = gb_device_bitmap_draw_triangles;
+        impl->base.draw_bitmap      = gb_device_bitmap_draw_bitmap;
         impl->base.shader_linear    = gb_device_bitmap_shader_linear;
         impl->base.shader_radial    = gb_device_bitmap_shader_radial;
         impl->base.shader_bitmap    = gb_device_bitmap_shader_bitmap;
@@ -44,7 +44,33 @@ tb_bool_t gb_bitmap_biltter_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_
     tb_assert_abort(biltter && bitmap && paint);
 
     // init it
-    return gb_paint_shader(paint)? gb_bitmap_biltter_shader_init(biltter, bitmap, paint) : gb_bitmap_biltter_solid_init(biltter, bitmap, paint);
+    if (!(gb_paint_shader(paint)? gb_bitmap_biltter_shader_init(biltter, bitmap, paint) : gb_bitmap_biltter_solid_init(biltter, bitmap, paint))) return tb_false;
+
+    // init the clipped bounds
+    biltter->clip_x0 = 0;
+    biltter->clip_y0 = 0;
+    biltter->clip_x1 = (tb_long_t)gb_bitmap_width(bitmap);
+    biltter->clip_y1 = (tb_long_t)gb_bitmap_height(bitmap);
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_bitmap_biltter_clip(gb_bitmap_biltter_ref_t biltter, gb_rect_ref_t rect)
+{
+    // check
+    tb_assert_abort(biltter && rect);
+
+    // the covered pixels of the rect
+    tb_long_t x0 = gb_floor(rect->x);
+    tb_long_t y0 = gb_floor(rect->y);
+    tb_long_t x1 = gb_ceil(rect->x + rect->w);
+    tb_long_t y1 = gb_ceil(rect->y + rect->h);
+
+    // intersect it
+    if (biltter->clip_x0 < x0) biltter->clip_x0 = x0;
+    if (biltter->clip_y0 < y0) biltter->clip_y0 = y0;
+    if (biltter->clip_x1 > x1) biltter->clip_x1 = x1;
+    if (biltter->clip_y1 > y1) biltter->clip_y1 = y1;
 }
 tb_void_t gb_bitmap_biltter_exit(gb_bitmap_biltter_ref_t biltter)
 {
@@ -59,6 +85,9 @@ tb_void_t gb_bitmap_biltter_done_p(gb_bitmap_biltter_ref_t biltter, tb_long_t x,
     // check
     tb_assert_abort(biltter && biltter->done_p);
 
+    // clipped?
+    tb_check_return(x >= biltter->clip_x0 && x < biltter->clip_x1 && y >= biltter->clip_y0 && y < biltter->clip_y1);
+
     // done it
     biltter->done_p(biltter, x, y);
 }
@@ -67,6 +96,16 @@ tb_void_t gb_bitmap_biltter_done_h(gb_bitmap_biltter_ref_t biltter, tb_long_t x,
     // check
     tb_assert_abort(biltter && biltter->done_h);
 
+    // clip it
+    tb_check_return(y >= biltter->clip_y0 && y < biltter->clip_y1);
+    if (x < biltter->clip_x0) 
+    {
+        w -= biltter->clip_x0 - x;
+        x = biltter->clip_x0;
+    }
+    if (x + w > biltter->clip_x1) w = biltter->clip_x1 - x;
+    tb_check_return(w > 0);
+
     // done it
     biltter->done_h(biltter, x, y, w);
 }
@@ -75,6 +114,16 @@ tb_void_t gb_bitmap_biltter_done_v(gb_bitmap_biltter_ref_t biltter, tb_long_t x,
     // check
     tb_assert_abort(biltter && biltter->done_v);
 
+    // clip it
+    tb_check_return(x >= biltter->clip_x0 && x < biltter->clip_x1);
+    if (y < biltter->clip_y0) 
+    {
+        h -= biltter->clip_y0 - y;
+        y = biltter->clip_y0;
+    }
+    if (y + h > biltter->clip_y1) h = biltter->clip_y1 - y;
+    tb_check_return(h > 0);
+
     // done it
     biltter->done_v(biltter, x, y, h);
 }
@@ -83,6 +132,21 @@ tb_void_t gb_bitmap_biltter_done_r(gb_bitmap_biltter_ref_t biltter, tb_long_t x,
     // check
     tb_assert_abort(biltter);
 
+    // clip it
+    if (x < biltter->clip_x0) 
+    {
+        w -= biltter->clip_x0 - x;
+        x = biltter->clip_x0;
+    }
+    if (y < biltter->clip_y0) 
+    {
+        h -= biltter->clip_y0 - y;
+        y = biltter->clip_y0;
+    }
+    if (x + w > biltter->clip_x1) w = biltter->clip_x1 - x;
+    if (y + h > biltter->clip_y1) h = biltter->clip_y1 - y;
+    tb_check_return(w > 0 && h > 0);
+
     // horizontal?
     if (h == 1) 
     {
@@ -70,6 +70,18 @@ typedef struct __gb_bitmap_biltter_t
     // the row bytes of the bitmap
     tb_size_t                       row_bytes;
 
+    // the left of the clipped bounds
+    tb_long_t                       clip_x0;
+
+    // the top of the clipped bounds
+    tb_long_t                       clip_y0;
+
+    // the right of the clipped bounds, exclusive
+    tb_long_t                       clip_x1;
+
+    // the bottom of the clipped bounds, exclusive
+    tb_long_t                       clip_y1;
+
     /* exit the biltter
      *
      * @param biltter               the biltter 
@@ -128,6 +140,15 @@ typedef struct __gb_bitmap_biltter_t
  */
 tb_bool_t               gb_bitmap_biltter_init(gb_bitmap_biltter_ref_t biltter, gb_bitmap_ref_t bitmap, gb_paint_ref_t paint);
 
+/* clip biltter with the given rect
+ *
+ * the clipped bounds is the bitmap bounds after initializing
+ *
+ * @param biltter       the biltter
+ * @param rect          the clipped rect in the device space
+ */
+tb_void_t               gb_bitmap_biltter_clip(gb_bitmap_biltter_ref_t biltter, gb_rect_ref_t rect);
+
 /* exit biltter
  *
  * @param biltter       the biltter
@@ -44,8 +44,11 @@ tb_bool_t gb_bitmap_biltter_shader_init(gb_bitmap_biltter_ref_t biltter, gb_bitm
     // init bitmap
     biltter->bitmap = bitmap;
 
+    // the alpha for the quality
+    tb_byte_t alpha = gb_quality_alpha(gb_paint_quality(paint), gb_paint_alpha(paint));
+
     // init pixmap
-    biltter->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), gb_paint_alpha(paint));
+    biltter->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), alpha);
     tb_check_return_val(biltter->pixmap, tb_false);
 
     // init btp and row_bytes
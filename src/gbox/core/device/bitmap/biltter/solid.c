@@ -132,8 +132,11 @@ tb_bool_t gb_bitmap_biltter_solid_init(gb_bitmap_biltter_ref_t biltter, gb_bitma
     // init bitmap
     biltter->bitmap = bitmap;
 
+    // the alpha for the quality
+    tb_byte_t alpha = gb_quality_alpha(gb_paint_quality(paint), gb_paint_alpha(paint));
+
     // init pixmap
-    biltter->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), gb_paint_alpha(paint));
+    biltter->pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), alpha);
     tb_check_return_val(biltter->pixmap, tb_false);
 
     // init btp and row_bytes
@@ -142,7 +145,7 @@ tb_bool_t gb_bitmap_biltter_solid_init(gb_bitmap_biltter_ref_t biltter, gb_bitma
 
     // init solid
     biltter->u.solid.pixel = biltter->pixmap->pixel(gb_paint_color(paint));
-    biltter->u.solid.alpha = gb_paint_alpha(paint);
+    biltter->u.solid.alpha = alpha;
 
     // init operations
     biltter->done_p     = gb_bitmap_biltter_solid_done_p;
@@ -34,6 +34,7 @@
 #include "render.h"
 #include "biltter.h"
 #include "render/render.h"
+#include "../../impl/shape.h"
 #include "../../impl/bounds.h"
 #include "../../impl/stroker.h"
 
@@ -212,6 +213,10 @@ tb_bool_t gb_bitmap_render_init(gb_bitmap_device_ref_t device)
         // init biltter
         if (!gb_bitmap_biltter_init(&device->biltter, device->bitmap, device->base.paint)) break;
 
+        // clip biltter
+        gb_rect_ref_t clip = device->base.clipper? gb_clipper_rect(device->base.clipper) : tb_null;
+        if (clip) gb_bitmap_biltter_clip(&device->biltter, clip);
+
         // ok
         ok = tb_true;
 
@@ -230,6 +235,9 @@ tb_void_t gb_bitmap_render_exit(gb_bitmap_device_ref_t device)
 
     // exit biltter
     gb_bitmap_biltter_exit(&device->biltter);
+
+    // the pixels of the bitmap may be changed
+    if (device->bitmap) gb_bitmap_invalidate(device->bitmap, tb_null);
 }
 tb_void_t gb_bitmap_render_draw_path(gb_bitmap_device_ref_t device, gb_path_ref_t path)
 {
@@ -387,4 +395,94 @@ tb_void_t gb_bitmap_render_draw_polygon(gb_bitmap_device_ref_t device, gb_polygo
         else gb_bitmap_render_stroke_fill(device, gb_stroker_done_polygon(device->stroker, device->base.paint, polygon, hint));
     }
 }
+tb_void_t gb_bitmap_render_draw_rects(gb_bitmap_device_ref_t device, gb_rect_ref_t rects, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert_abort(device && device->base.paint && device->base.matrix && rects);
+
+    // only fill them and no rotation? fill the transformed rects directly
+    tb_size_t i = 0;
+    if (    GB_PAINT_MODE_FILL == gb_paint_mode(device->base.paint)
+        &&  0 == device->base.matrix->kx && 0 == device->base.matrix->ky)
+    {
+        gb_rect_t filled_rect;
+        for (i = 0; i < count; i++)
+        {
+            // apply matrix to rect
+            gb_rect_apply2(&rects[i], &filled_rect, device->base.matrix);
+
+            // fill rect
+            gb_bitmap_render_fill_rect(device, &filled_rect);
+        }
+        return ;
+    }
+
+    // draw them one by one
+    gb_point_t      points[5];
+    tb_uint16_t     counts[2];
+    gb_polygon_t    polygon;
+    gb_shape_t      hint;
+    for (i = 0; i < count; i++)
+    {
+        // make polygon
+        gb_shape_make_polygon_for_rect(&polygon, &hint, points, counts, &rects[i]);
+
+        // draw polygon
+        gb_bitmap_render_draw_polygon(device, &polygon, &hint, &rects[i]);
+    }
+}
+tb_void_t gb_bitmap_render_draw_triangles(gb_bitmap_device_ref_t device, gb_triangle_ref_t triangles, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert_abort(device && device->base.paint && device->base.matrix && triangles);
+
+    // the polygon
+    tb_size_t       i = 0;
+    gb_point_t      points[4];
+    tb_uint16_t     counts[2];
+    gb_polygon_t    polygon;
+    gb_shape_t      hint;
+    gb_rect_t       triangle_bounds;
+
+    // only fill them? raster the transformed triangles directly
+    if (GB_PAINT_MODE_FILL == gb_paint_mode(device->base.paint))
+    {
+        for (i = 0; i < count; i++)
+        {
+            // make polygon
+            gb_shape_make_polygon_for_triangle(&polygon, &hint, points, counts, &triangles[i]);
+
+            // apply matrix to points
+            gb_matrix_apply_points(device->base.matrix, points, 3);
+            points[3] = points[0];
+
+            // make bounds
+            gb_bounds_make(&triangle_bounds, points, 3);
+
+            // fill polygon
+            gb_bitmap_render_fill_polygon(device, &polygon, &triangle_bounds);
+        }
+        return ;
+    }
+
+    // draw them one by one
+    for (i = 0; i < count; i++)
+    {
+        // make polygon
+        gb_shape_make_polygon_for_triangle(&polygon, &hint, points, counts, &triangles[i]);
+
+        // make bounds
+        gb_bounds_make(&triangle_bounds, points, 3);
+
+        // draw polygon
+        gb_bitmap_render_draw_polygon(device, &polygon, &hint, &triangle_bounds);
+    }
+}
+tb_bool_t gb_bitmap_render_draw_bitmap(gb_bitmap_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert_abort(device && bitmap && src_rect && dst_rect && bounds);
 
+    // copy, convert, blend or transform the pixels of the bitmap
+    return gb_bitmap_render_fill_bitmap(device, bitmap, src_rect, dst_rect, bounds);
+}
@@ -86,6 +86,36 @@ tb_void_t           gb_bitmap_render_draw_points(gb_bitmap_device_ref_t device,
  */
 tb_void_t           gb_bitmap_render_draw_polygon(gb_bitmap_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds);
 
+/* draw rects
+ *
+ * @param device    the device
+ * @param rects     the rects
+ * @param count     the rects count
+ * @param bounds    the bounds
+ */
+tb_void_t           gb_bitmap_render_draw_rects(gb_bitmap_device_ref_t device, gb_rect_ref_t rects, tb_size_t count, gb_rect_ref_t bounds);
+
+/* draw triangles
+ *
+ * @param device    the device
+ * @param triangles the triangles
+ * @param count     the triangles count
+ * @param bounds    the bounds
+ */
+tb_void_t           gb_bitmap_render_draw_triangles(gb_bitmap_device_ref_t device, gb_triangle_ref_t triangles, tb_size_t count, gb_rect_ref_t bounds);
+
+/* draw the source rect of the bitmap to the destination rect
+ *
+ * @param device    the device
+ * @param bitmap    the bitmap
+ * @param src_rect  the source rect in the bitmap
+ * @param dst_rect  the destination rect
+ * @param bounds    the changed device bounds
+ *
+ * @return          tb_true if some pixels have been changed
+ */
+tb_bool_t           gb_bitmap_render_draw_bitmap(gb_bitmap_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect, gb_rect_ref_t bounds);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,352 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        bitmap.c
+ * @ingroup     core
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "bitmap_bitmap"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "bitmap.h"
+#include "../../../impl/bounds.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the bitmap blit type
+typedef struct __gb_bitmap_render_blit_t
+{
+    // the source data
+    tb_byte_t const*        src_data;
+
+    // the source row bytes
+    tb_size_t               src_row_bytes;
+
+    // the source pixmap
+    gb_pixmap_ref_t         src_pixmap;
+
+    // the source bounds in pixels, the right and bottom are exclusive
+    tb_long_t               src_x0;
+    tb_long_t               src_y0;
+    tb_long_t               src_x1;
+    tb_long_t               src_y1;
+
+    // the destination data
+    tb_byte_t*              dst_data;
+
+    // the destination row bytes
+    tb_size_t               dst_row_bytes;
+
+    // the destination pixmap for the opaque pixels
+    gb_pixmap_ref_t         dst_pixmap;
+
+    // the destination pixmap for blending the translucent pixels
+    gb_pixmap_ref_t         dst_blender;
+
+    // the alpha of the paint
+    tb_byte_t               alpha;
+
+    // the minimum and maximum alpha of the paint quality
+    tb_byte_t               alpha_minn;
+    tb_byte_t               alpha_maxn;
+
+    // the source has alpha?
+    tb_bool_t               has_alpha;
+
+}gb_bitmap_render_blit_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ gb_color_t gb_bitmap_render_blit_color_get(gb_bitmap_render_blit_t* blit, tb_long_t x, tb_long_t y)
+{
+    // get the source color
+    return blit->src_pixmap->color_get(blit->src_data + y * blit->src_row_bytes + x * blit->src_pixmap->btp);
+}
+static __tb_inline__ tb_void_t gb_bitmap_render_blit_color_set(gb_bitmap_render_blit_t* blit, tb_byte_t* data, gb_color_t color)
+{
+    // apply the alpha of the paint
+    color.a = blit->has_alpha? (tb_byte_t)((color.a * (blit->alpha + 1)) >> 8) : blit->alpha;
+
+    // opaque? set it
+    if (color.a > blit->alpha_maxn) blit->dst_pixmap->color_set(data, color);
+    // translucent? blend it
+    else if (color.a >= blit->alpha_minn) blit->dst_blender->color_set(data, color);
+}
+static __tb_inline__ tb_byte_t gb_bitmap_render_blit_lerp(tb_byte_t c0, tb_byte_t c1, tb_long_t factor)
+{
+    // c0 + (c1 - c0) * factor / 256
+    return (tb_byte_t)((tb_long_t)c0 + ((((tb_long_t)c1 - (tb_long_t)c0) * factor) >> 8));
+}
+static gb_color_t gb_bitmap_render_blit_color_filter(gb_bitmap_render_blit_t* blit, tb_fixed_t u, tb_fixed_t v)
+{
+    // the top-left sample, the pixel center is at (x + 0.5, y + 0.5)
+    u -= TB_FIXED_HALF;
+    v -= TB_FIXED_HALF;
+    tb_long_t x0 = tb_fixed_floor(u);
+    tb_long_t y0 = tb_fixed_floor(v);
+
+    // the weights of the right and bottom samples, [0, 256)
+    tb_long_t fx = (u & 0xffff) >> 8;
+    tb_long_t fy = (v & 0xffff) >> 8;
+
+    // clamp the samples to the source bounds
+    tb_long_t x1 = tb_min(x0 + 1, blit->src_x1 - 1);
+    tb_long_t y1 = tb_min(y0 + 1, blit->src_y1 - 1);
+    x0 = tb_max(x0, blit->src_x0);
+    y0 = tb_max(y0, blit->src_y0);
+
+    // the four samples
+    gb_color_t c00 = gb_bitmap_render_blit_color_get(blit, x0, y0);
+    gb_color_t c01 = gb_bitmap_render_blit_color_get(blit, x1, y0);
+    gb_color_t c10 = gb_bitmap_render_blit_color_get(blit, x0, y1);
+    gb_color_t c11 = gb_bitmap_render_blit_color_get(blit, x1, y1);
+
+    // lerp the top and bottom samples
+    c00.r = gb_bitmap_render_blit_lerp(c00.r, c01.r, fx);
+    c00.g = gb_bitmap_render_blit_lerp(c00.g, c01.g, fx);
+    c00.b = gb_bitmap_render_blit_lerp(c00.b, c01.b, fx);
+    c00.a = gb_bitmap_render_blit_lerp(c00.a, c01.a, fx);
+    c10.r = gb_bitmap_render_blit_lerp(c10.r, c11.r, fx);
+    c10.g = gb_bitmap_render_blit_lerp(c10.g, c11.g, fx);
+    c10.b = gb_bitmap_render_blit_lerp(c10.b, c11.b, fx);
+    c10.a = gb_bitmap_render_blit_lerp(c10.a, c11.a, fx);
+
+    // lerp them vertically
+    c00.r = gb_bitmap_render_blit_lerp(c00.r, c10.r, fy);
+    c00.g = gb_bitmap_render_blit_lerp(c00.g, c10.g, fy);
+    c00.b = gb_bitmap_render_blit_lerp(c00.b, c10.b, fy);
+    c00.a = gb_bitmap_render_blit_lerp(c00.a, c10.a, fy);
+
+    // ok
+    return c00;
+}
+static tb_void_t gb_bitmap_render_blit_translate(gb_bitmap_render_blit_t* blit, tb_long_t x, tb_long_t y, tb_long_t w, tb_long_t h, tb_long_t dx, tb_long_t dy)
+{
+    // check
+    tb_assert_abort(blit && w > 0 && h > 0);
+
+    // the bytes per-pixel
+    tb_size_t           src_btp = blit->src_pixmap->btp;
+    tb_size_t           dst_btp = blit->dst_pixmap->btp;
+
+    // the first rows, the source pixel (x, y) is drawn to (x + dx, y + dy)
+    tb_byte_t const*    src = blit->src_data + y * blit->src_row_bytes + x * src_btp;
+    tb_byte_t*          dst = blit->dst_data + (y + dy) * blit->dst_row_bytes + (x + dx) * dst_btp;
+
+    // the same pixel format?
+    tb_bool_t           same = blit->src_pixmap->pixfmt == blit->dst_pixmap->pixfmt;
+
+    // done
+    tb_long_t i;
+    tb_long_t j;
+    tb_byte_t const*    s;
+    tb_byte_t*          d;
+    if (same && !blit->has_alpha && blit->alpha > blit->alpha_maxn)
+    {
+        // copy the opaque rows directly
+        tb_size_t row_size = w * dst_btp;
+        for (j = 0; j < h; j++, src += blit->src_row_bytes, dst += blit->dst_row_bytes)
+            tb_memcpy(dst, src, row_size);
+    }
+    else if (same && !blit->has_alpha)
+    {
+        // blend the rows of the same format by the constant alpha
+        gb_pixmap_ref_t blender = gb_pixmap(blit->dst_pixmap->pixfmt, blit->alpha);
+        tb_assert_abort(blender && blender->pixel_cpy);
+        for (j = 0; j < h; j++, src += blit->src_row_bytes, dst += blit->dst_row_bytes)
+        {
+            for (i = 0, s = src, d = dst; i < w; i++, s += src_btp, d += dst_btp)
+                blender->pixel_cpy(d, s, blit->alpha);
+        }
+    }
+    else
+    {
+        // convert the pixel format or blend the source alpha pixel by pixel
+        for (j = 0; j < h; j++, src += blit->src_row_bytes, dst += blit->dst_row_bytes)
+        {
+            for (i = 0, s = src, d = dst; i < w; i++, s += src_btp, d += dst_btp)
+                gb_bitmap_render_blit_color_set(blit, d, blit->src_pixmap->color_get(s));
+        }
+    }
+}
+static tb_void_t gb_bitmap_render_blit_transform(gb_bitmap_render_blit_t* blit, gb_matrix_ref_t inverse, tb_long_t x0, tb_long_t y0, tb_long_t x1, tb_long_t y1, tb_bool_t filter)
+{
+    // check
+    tb_assert_abort(blit && inverse && x0 < x1 && y0 < y1);
+
+    // the source steps for one pixel in the x-direction
+    tb_fixed_t          du = gb_float_to_fixed(inverse->sx);
+    tb_fixed_t          dv = gb_float_to_fixed(inverse->ky);
+
+    // the source bounds
+    tb_fixed_t          u0 = tb_long_to_fixed(blit->src_x0);
+    tb_fixed_t          v0 = tb_long_to_fixed(blit->src_y0);
+    tb_fixed_t          u1 = tb_long_to_fixed(blit->src_x1);
+    tb_fixed_t          v1 = tb_long_to_fixed(blit->src_y1);
+
+    // done
+    tb_long_t           x;
+    tb_long_t           y;
+    tb_fixed_t          u;
+    tb_fixed_t          v;
+    tb_size_t           dst_btp = blit->dst_pixmap->btp;
+    tb_byte_t*          dst = blit->dst_data + y0 * blit->dst_row_bytes + x0 * dst_btp;
+    tb_byte_t*          d;
+    gb_float_t          cx = gb_long_to_float(x0) + gb_half(GB_ONE);
+    gb_float_t          cy;
+    for (y = y0; y < y1; y++, dst += blit->dst_row_bytes)
+    {
+        // map the center of the first pixel in this row to the source
+        cy = gb_long_to_float(y) + gb_half(GB_ONE);
+        u = gb_float_to_fixed(gb_matrix_apply_x(inverse, cx, cy));
+        v = gb_float_to_fixed(gb_matrix_apply_y(inverse, cx, cy));
+
+        // walk this row
+        for (x = x0, d = dst; x < x1; x++, d += dst_btp, u += du, v += dv)
+        {
+            // out of the source?
+            if (u < u0 || v < v0 || u >= u1 || v >= v1) continue;
+
+            // draw the filtered or nearest source pixel
+            if (filter) gb_bitmap_render_blit_color_set(blit, d, gb_bitmap_render_blit_color_filter(blit, u, v));
+            else gb_bitmap_render_blit_color_set(blit, d, gb_bitmap_render_blit_color_get(blit, tb_fixed_floor(u), tb_fixed_floor(v)));
+        }
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t gb_bitmap_render_fill_bitmap(gb_bitmap_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert_abort(device && device->bitmap && device->base.paint && device->base.matrix && bitmap && src_rect && dst_rect && bounds);
+
+    // empty?
+    tb_check_return_val(src_rect->w > 0 && src_rect->h > 0 && dst_rect->w > 0 && dst_rect->h > 0, tb_false);
+
+    // init blit
+    gb_bitmap_render_blit_t blit;
+    blit.alpha          = gb_paint_alpha(device->base.paint);
+    blit.alpha_minn     = GB_QUALITY_ALPHA_MINN(gb_paint_quality(device->base.paint));
+    blit.alpha_maxn     = GB_QUALITY_ALPHA_MAXN(gb_paint_quality(device->base.paint));
+    blit.has_alpha      = gb_bitmap_has_alpha(bitmap);
+    tb_check_return_val(blit.alpha >= blit.alpha_minn, tb_false);
+
+    // init the source
+    blit.src_data       = (tb_byte_t const*)gb_bitmap_data(bitmap);
+    blit.src_row_bytes  = gb_bitmap_row_bytes(bitmap);
+    blit.src_pixmap     = gb_pixmap(gb_bitmap_pixfmt(bitmap), 0xff);
+    tb_assert_and_check_return_val(blit.src_data && blit.src_pixmap, tb_false);
+
+    // init the source bounds, clamp it to the bitmap
+    blit.src_x0         = tb_max(gb_round(src_rect->x), 0);
+    blit.src_y0         = tb_max(gb_round(src_rect->y), 0);
+    blit.src_x1         = tb_min(gb_round(src_rect->x + src_rect->w), (tb_long_t)gb_bitmap_width(bitmap));
+    blit.src_y1         = tb_min(gb_round(src_rect->y + src_rect->h), (tb_long_t)gb_bitmap_height(bitmap));
+    tb_check_return_val(blit.src_x0 < blit.src_x1 && blit.src_y0 < blit.src_y1, tb_false);
+
+    // init the destination
+    blit.dst_data       = (tb_byte_t*)gb_bitmap_data(device->bitmap);
+    blit.dst_row_bytes  = gb_bitmap_row_bytes(device->bitmap);
+    blit.dst_pixmap     = gb_pixmap(gb_bitmap_pixfmt(device->bitmap), 0xff);
+    blit.dst_blender    = gb_pixmap(gb_bitmap_pixfmt(device->bitmap), blit.alpha_maxn);
+    tb_assert_and_check_return_val(blit.dst_data && blit.dst_pixmap && blit.dst_blender, tb_false);
+
+    // the clipped bounds of the device
+    tb_long_t clip_x0 = 0;
+    tb_long_t clip_y0 = 0;
+    tb_long_t clip_x1 = (tb_long_t)gb_bitmap_width(device->bitmap);
+    tb_long_t clip_y1 = (tb_long_t)gb_bitmap_height(device->bitmap);
+    gb_rect_ref_t clip = device->base.clipper? gb_clipper_rect(device->base.clipper) : tb_null;
+    if (clip)
+    {
+        clip_x0 = tb_max(gb_floor(clip->x), clip_x0);
+        clip_y0 = tb_max(gb_floor(clip->y), clip_y0);
+        clip_x1 = tb_min(gb_ceil(clip->x + clip->w), clip_x1);
+        clip_y1 = tb_min(gb_ceil(clip->y + clip->h), clip_y1);
+    }
+    tb_check_return_val(clip_x0 < clip_x1 && clip_y0 < clip_y1, tb_false);
+
+    // make the matrix from the source to the device: matrix * translate(dst) * scale(dst / src) * translate(-src)
+    gb_matrix_t matrix = *device->base.matrix;
+    gb_matrix_translate(&matrix, dst_rect->x, dst_rect->y);
+    gb_matrix_scale(&matrix, gb_div(dst_rect->w, src_rect->w), gb_div(dst_rect->h, src_rect->h));
+    gb_matrix_translate(&matrix, -src_rect->x, -src_rect->y);
+
+    // only translate it? 
+    if (matrix.sx == GB_ONE && matrix.sy == GB_ONE && !matrix.kx && !matrix.ky)
+    {
+        // the integer offset
+        tb_long_t dx = gb_round(matrix.tx);
+        tb_long_t dy = gb_round(matrix.ty);
+
+        // clip the source bounds by the device bounds
+        tb_long_t x0 = tb_max(blit.src_x0, clip_x0 - dx);
+        tb_long_t y0 = tb_max(blit.src_y0, clip_y0 - dy);
+        tb_long_t x1 = tb_min(blit.src_x1, clip_x1 - dx);
+        tb_long_t y1 = tb_min(blit.src_y1, clip_y1 - dy);
+        tb_check_return_val(x0 < x1 && y0 < y1, tb_false);
+
+        // copy, convert or blend the rows
+        gb_bitmap_render_blit_translate(&blit, x0, y0, x1 - x0, y1 - y0, dx, dy);
+
+        // the changed bounds
+        gb_rect_imake(bounds, x0 + dx, y0 + dy, x1 - x0, y1 - y0);
+        return tb_true;
+    }
+
+    // the inverse matrix from the device to the source
+    gb_matrix_t inverse = matrix;
+    tb_check_return_val(gb_matrix_invert(&inverse), tb_false);
+
+    // the device bounds of the source rect
+    gb_rect_t   rect;
+    gb_point_t  points[4];
+    gb_point_imake(&points[0], blit.src_x0, blit.src_y0);
+    gb_point_imake(&points[1], blit.src_x1, blit.src_y0);
+    gb_point_imake(&points[2], blit.src_x0, blit.src_y1);
+    gb_point_imake(&points[3], blit.src_x1, blit.src_y1);
+    gb_matrix_apply_points(&matrix, points, tb_arrayn(points));
+    gb_bounds_make(&rect, points, tb_arrayn(points));
+
+    // clip it
+    tb_long_t x0 = tb_max(gb_floor(rect.x), clip_x0);
+    tb_long_t y0 = tb_max(gb_floor(rect.y), clip_y0);
+    tb_long_t x1 = tb_min(gb_ceil(rect.x + rect.w), clip_x1);
+    tb_long_t y1 = tb_min(gb_ceil(rect.y + rect.h), clip_y1);
+    tb_check_return_val(x0 < x1 && y0 < y1, tb_false);
+
+    // sample the source for each device pixel
+    gb_bitmap_render_blit_transform(&blit, &inverse, x0, y0, x1, y1, (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_FILTER_BITMAP)? tb_true : tb_false);
+
+    // the changed bounds
+    gb_rect_imake(bounds, x0, y0, x1 - x0, y1 - y0);
+    return tb_true;
+}
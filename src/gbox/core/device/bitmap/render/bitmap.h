@@ -0,0 +1,60 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        bitmap.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_BITMAP_RENDER_BITMAP_H
+#define GB_CORE_DEVICE_BITMAP_RENDER_BITMAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interface
+ */
+
+/* draw the source rect of the bitmap to the destination rect
+ *
+ * @param device    the device
+ * @param bitmap    the bitmap
+ * @param src_rect  the source rect in the bitmap
+ * @param dst_rect  the destination rect
+ * @param bounds    the changed device bounds
+ *
+ * @return          tb_true if some pixels have been changed
+ */
+tb_bool_t           gb_bitmap_render_fill_bitmap(gb_bitmap_device_ref_t device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect, gb_rect_ref_t bounds);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
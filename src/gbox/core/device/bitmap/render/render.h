@@ -31,6 +31,7 @@
 #include "lines.h"
 #include "points.h"
 #include "polygon.h"
+#include "bitmap.h"
 
 #endif
 
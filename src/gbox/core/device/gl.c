@@ -41,11 +41,34 @@
 // testing gl v1 interfaces
 //#define GB_DEVICE_GL_TEST_v1
 
+// trace the draw and state calls of each frame
+//#define GB_DEVICE_GL_TRACE_STATS
+
+// use the analytic antialiasing by the fringe even if the multisample buffer exists
+//#define GB_DEVICE_GL_FRINGE_ALWAYS
+
+// the maximum entries count of the path cache
+#ifdef __gb_small__
+#   define GB_DEVICE_GL_PATH_CACHE_MAXN     (256)
+#else
+#   define GB_DEVICE_GL_PATH_CACHE_MAXN     (1024)
+#endif
+
+// the vram budget of the bitmap texture cache
+#ifndef GB_DEVICE_GL_TEXTURE_CACHE_BUDGET
+#   ifdef __gb_small__
+#       define GB_DEVICE_GL_TEXTURE_CACHE_BUDGET    (8 << 20)
+#   else
+#       define GB_DEVICE_GL_TEXTURE_CACHE_BUDGET    (32 << 20)
+#   endif
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
  */
 #ifdef GB_CONFIG_PACKAGE_HAVE_OPENGL
 __tb_extern_c__ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window);
+__tb_extern_c__ gb_device_ref_t gb_device_init_gl_offscreen(tb_size_t width, tb_size_t height);
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -78,12 +101,72 @@ static tb_size_t gb_device_gl_version()
 	return ((major << 4) + minor);
 #endif
 }
+static tb_void_t gb_device_gl_forget(gb_gl_device_ref_t impl)
+{
+    // check
+    tb_assert_and_check_return(impl);
+
+    // the bound program and the scissor box are unknown now, apply them again for the next drawing
+    impl->program_bound = tb_null;
+    impl->scissor_ok    = tb_true;
+    impl->scissor[2]    = -1;
+}
+static tb_bool_t gb_device_gl_enter(gb_gl_device_ref_t impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // make the headless context current, the calling thread may be changed or use the other contexts
+    if (impl->context && !gb_gl_context_make_current(impl->context))
+    {
+        // trace
+        tb_trace_e("make the gl context current failed!");
+        return tb_false;
+    }
+
+    // enter the shadow state of this context, it will be reset if the other context was entered
+    if (impl->shadow && gb_gl_interface_shadow_enter(impl->shadow)) gb_device_gl_forget(impl);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_device_gl_draw_begin(gb_device_impl_t* device)
+{
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // enter the context
+    tb_check_return(gb_device_gl_enter(impl));
+
+    /* the context of the window is shared with the window and the application, 
+     * so its states may be modified outside between the frames, reset the shadow state once for each frame
+     */
+    if (!impl->context && impl->shadow)
+    {
+        gb_gl_interface_reset();
+        gb_device_gl_forget(impl);
+    }
+}
 static tb_void_t gb_device_gl_resize(gb_device_impl_t* device, tb_size_t width, tb_size_t height)
 {
     // check
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return(impl);
 
+    // enter the context
+    tb_check_return(gb_device_gl_enter(impl));
+
+    // flush the pending draws with the old viewport
+    gb_gl_render_flush(impl);
+
+    // resize the offscreen target
+    if (impl->offscreen && !gb_gl_offscreen_resize(impl->offscreen, width, height))
+    {
+        // trace
+        tb_trace_e("resize the offscreen target failed!");
+    }
+
 	// update viewport
 	gb_glViewport(0, 0, width, height);
 
@@ -107,9 +190,44 @@ static tb_void_t gb_device_gl_resize(gb_device_impl_t* device, tb_size_t width,
 }
 static tb_void_t gb_device_gl_draw_clear(gb_device_impl_t* device, gb_color_t color)
 {
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // enter the context
+    tb_check_return(gb_device_gl_enter(impl));
+
+    // flush the pending draws before clearing
+    gb_gl_render_flush(impl);
+
+    // only clear the clipped rect
+    gb_gl_render_scissor(impl);
+
     // clear it
 	gb_glClearColor((gb_GLfloat_t)color.r / 0xff, (gb_GLfloat_t)color.g / 0xff, (gb_GLfloat_t)color.b / 0xff, (gb_GLfloat_t)color.a / 0xff);
-	gb_glClear(GB_GL_COLOR_BUFFER_BIT);
+	gb_glClear(impl->stencil_bits? (GB_GL_COLOR_BUFFER_BIT | GB_GL_STENCIL_BUFFER_BIT) : GB_GL_COLOR_BUFFER_BIT);
+}
+static tb_void_t gb_device_gl_draw_flush(gb_device_impl_t* device)
+{
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // enter the context
+    tb_check_return(gb_device_gl_enter(impl));
+
+    // flush the pending draws
+    gb_gl_render_flush(impl);
+
+#ifdef GB_DEVICE_GL_TRACE_STATS
+    // trace the gl calls of this frame
+    gb_gl_interface_stats_t stats;
+    gb_gl_interface_stats(&stats);
+    tb_trace_d("frame: draws: %lu, calls: %lu, skipped: %lu", stats.draws, stats.calls, stats.skipped);
+#endif
+
+    // clear the stats for the next frame
+    gb_gl_interface_stats_clear();
 }
 static tb_void_t gb_device_gl_draw_path(gb_device_impl_t* device, gb_path_ref_t path)
 {
@@ -117,6 +235,9 @@ static tb_void_t gb_device_gl_draw_path(gb_device_impl_t* device, gb_path_ref_t
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return(impl && path);
 
+    // enter the context
+    tb_check_return(gb_device_gl_enter(impl));
+
     // init render
     if (gb_gl_render_init(impl))
     {
@@ -127,12 +248,38 @@ static tb_void_t gb_device_gl_draw_path(gb_device_impl_t* device, gb_path_ref_t
         gb_gl_render_exit(impl);
     }
 }
+static tb_bool_t gb_device_gl_draw_instances(gb_device_impl_t* device, gb_path_ref_t path, gb_matrix_ref_t matrices, gb_color_t const* colors, tb_size_t count)
+{
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return_val(impl && path, tb_false);
+
+    // enter the context
+    tb_check_return_val(gb_device_gl_enter(impl), tb_false);
+
+    // init render
+    tb_bool_t ok = tb_false;
+    if (gb_gl_render_init(impl))
+    {
+        // draw instances
+        ok = gb_gl_render_draw_instances(impl, path, matrices, colors, count);
+    
+        // exit render
+        gb_gl_render_exit(impl);
+    }
+
+    // ok?
+    return ok;
+}
 static tb_void_t gb_device_gl_draw_lines(gb_device_impl_t* device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
 {
     // check
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return(impl && points && count);
 
+    // enter the context
+    tb_check_return(gb_device_gl_enter(impl));
+
     // init render
     if (gb_gl_render_init(impl))
     {
@@ -149,6 +296,9 @@ static tb_void_t gb_device_gl_draw_points(gb_device_impl_t* device, gb_point_ref
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return(impl && points && count);
 
+    // enter the context
+    tb_check_return(gb_device_gl_enter(impl));
+
     // init render
     if (gb_gl_render_init(impl))
     {
@@ -165,6 +315,9 @@ static tb_void_t gb_device_gl_draw_polygon(gb_device_impl_t* device, gb_polygon_
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return(impl && polygon);
 
+    // enter the context
+    tb_check_return(gb_device_gl_enter(impl));
+
     // init render
     if (gb_gl_render_init(impl))
     {
@@ -175,12 +328,27 @@ static tb_void_t gb_device_gl_draw_polygon(gb_device_impl_t* device, gb_polygon_
         gb_gl_render_exit(impl);
     }
 }
+static tb_bool_t gb_device_gl_read(gb_device_impl_t* device, gb_bitmap_ref_t bitmap, tb_bool_t wait)
+{
+    // check
+    gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
+    tb_assert_and_check_return_val(impl && impl->offscreen && bitmap, tb_false);
+
+    // enter the context
+    tb_check_return_val(gb_device_gl_enter(impl), tb_false);
+
+    // read the offscreen target
+    return gb_gl_offscreen_read(impl->offscreen, bitmap, wait);
+}
 static gb_shader_ref_t gb_device_gl_shader_linear(gb_device_impl_t* device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line)
 {
     // check
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return_val(impl, tb_null);
 
+    // enter the context
+    tb_check_return_val(gb_device_gl_enter(impl), tb_null);
+
     // init shader
     return gb_gl_shader_init_linear(impl, mode, gradient, line);
 }
@@ -190,6 +358,9 @@ static gb_shader_ref_t gb_device_gl_shader_radial(gb_device_impl_t* device, tb_s
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return_val(impl, tb_null);
 
+    // enter the context
+    tb_check_return_val(gb_device_gl_enter(impl), tb_null);
+
     // init shader
     return gb_gl_shader_init_radial(impl, mode, gradient, circle);
 }
@@ -199,6 +370,9 @@ static gb_shader_ref_t gb_device_gl_shader_bitmap(gb_device_impl_t* device, tb_s
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return_val(impl, tb_null);
 
+    // enter the context
+    tb_check_return_val(gb_device_gl_enter(impl), tb_null);
+
     // init shader
     return gb_gl_shader_init_bitmap(impl, mode, bitmap);
 }
@@ -208,13 +382,40 @@ static tb_void_t gb_device_gl_exit(gb_device_impl_t* device)
     gb_gl_device_ref_t impl = (gb_gl_device_ref_t)device;
     tb_assert_and_check_return(impl);
      
+    // enter the context
+    gb_device_gl_enter(impl);
+
     // exit tessellator
     if (impl->tessellator) gb_tessellator_exit(impl->tessellator);
     impl->tessellator = tb_null;
+
+    // exit triangle strip
+    if (impl->strip) gb_triangle_strip_exit(impl->strip);
+    impl->strip = tb_null;
+
+    // exit batch
+    if (impl->batch) gb_gl_batch_exit(impl->batch);
+    impl->batch = tb_null;
+
+    // exit path cache
+    if (impl->cache) gb_gl_path_cache_exit(impl->cache);
+    impl->cache = tb_null;
+
+    // exit texture cache
+    if (impl->textures) gb_gl_texture_cache_exit(impl->textures);
+    impl->textures = tb_null;
+
+    // exit fringe
+    if (impl->fringe) gb_gl_fringe_exit(impl->fringe);
+    impl->fringe = tb_null;
  
     // exit stroker
     if (impl->stroker) gb_stroker_exit(impl->stroker);
     impl->stroker = tb_null;
+
+    // exit the stroker of the triangle strip
+    if (impl->strip_stroker) gb_gl_stroker_exit(impl->strip_stroker);
+    impl->strip_stroker = tb_null;
  
     // exit programs 
     tb_size_t i = 0;
@@ -224,28 +425,32 @@ static tb_void_t gb_device_gl_exit(gb_device_impl_t* device)
         impl->programs[i] = 0;
     }
 
+    // exit offscreen target
+    if (impl->offscreen) gb_gl_offscreen_exit(impl->offscreen);
+    impl->offscreen = tb_null;
+
+    // exit the shadow state
+    if (impl->shadow) gb_gl_interface_shadow_exit(impl->shadow);
+    impl->shadow = tb_null;
+
+    // exit context
+    if (impl->context) gb_gl_context_exit(impl->context);
+    impl->context = tb_null;
+
     // exit it
     if (impl) tb_free(impl);
 }
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
- */
-gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
+static gb_gl_device_ref_t gb_device_gl_init(gb_window_ref_t window, tb_size_t width, tb_size_t height)
 {
     // check
-    tb_assert_and_check_return_val(window, tb_null);
+    tb_assert_and_check_return_val(width && height && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN, tb_null);
 
     // done
     tb_bool_t               ok = tb_false;
     gb_gl_device_ref_t      impl = tb_null;
     do
     {
-        // the width and height
-        tb_size_t width     = gb_window_width(window);
-        tb_size_t height    = gb_window_height(window);
-        tb_assert_and_check_break(width && height && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN);
-
         // make device
         impl = tb_malloc0_type(gb_gl_device_t);
         tb_assert_and_check_break(impl);
@@ -254,7 +459,10 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
         impl->base.type             = GB_DEVICE_TYPE_GL;
         impl->base.resize           = gb_device_gl_resize;
         impl->base.draw_clear       = gb_device_gl_draw_clear;
+        impl->base.draw_begin       = gb_device_gl_draw_begin;
+        impl->base.draw_flush       = gb_device_gl_draw_flush;
         impl->base.draw_path        = gb_device_gl_draw_path;
+        impl->base.draw_instances   = gb_device_gl_draw_instances;
         impl->base.draw_lines       = gb_device_gl_draw_lines;
         impl->base.draw_points      = gb_device_gl_draw_points;
         impl->base.draw_polygon     = gb_device_gl_draw_polygon;
@@ -263,13 +471,27 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
         impl->base.shader_bitmap    = gb_device_gl_shader_bitmap;
         impl->base.exit             = gb_device_gl_exit;
 
-        // init window
+        // init window, null: the offscreen device
         impl->window                = window;
 
+        // init the headless context for the offscreen device
+        if (!window)
+        {
+            impl->context = gb_gl_context_init();
+            tb_check_break(impl->context);
+
+            // init read
+            impl->base.read = gb_device_gl_read;
+        }
+
         // init stroker
         impl->stroker = gb_stroker_init();
         tb_assert_and_check_break(impl->stroker);
 
+        // init the stroker of the triangle strip
+        impl->strip_stroker = gb_gl_stroker_init();
+        tb_assert_and_check_break(impl->strip_stroker);
+
         // init tessellator
         impl->tessellator = gb_tessellator_init();
         tb_assert_and_check_break(impl->tessellator);
@@ -277,6 +499,10 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
         // init tessellator mode
         gb_tessellator_mode_set(impl->tessellator, GB_TESSELLATOR_MODE_CONVEX);
 
+        // init triangle strip
+        impl->strip = gb_triangle_strip_init();
+        tb_assert_and_check_break(impl->strip);
+
         // init version 
         if (!impl->version)
         {
@@ -298,6 +524,13 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
 #endif
         }
 
+        // init the shadow state of this context
+        impl->shadow = gb_gl_interface_shadow_init();
+        tb_assert_and_check_break(impl->shadow);
+
+        // enter the context
+        if (!gb_device_gl_enter(impl)) break;
+
         // init viewport
         gb_glViewport(0, 0, width, height);
 
@@ -312,12 +545,70 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
             impl->programs[GB_GL_PROGRAM_TYPE_BITMAP] = gb_gl_program_init_bitmap();
             tb_assert_and_check_break(impl->programs[GB_GL_PROGRAM_TYPE_BITMAP]);
 
+            // init linear gradient program
+            impl->programs[GB_GL_PROGRAM_TYPE_LINEAR] = gb_gl_program_init_linear();
+            tb_assert_and_check_break(impl->programs[GB_GL_PROGRAM_TYPE_LINEAR]);
+
+            // init radial gradient program
+            impl->programs[GB_GL_PROGRAM_TYPE_RADIAL] = gb_gl_program_init_radial();
+            tb_assert_and_check_break(impl->programs[GB_GL_PROGRAM_TYPE_RADIAL]);
+
+            // init batch
+            impl->batch = gb_gl_batch_init();
+            tb_assert_and_check_break(impl->batch);
+
+            // init path cache
+            impl->cache = gb_gl_path_cache_init(GB_DEVICE_GL_PATH_CACHE_MAXN);
+            tb_assert_and_check_break(impl->cache);
+
+            // init texture cache
+            impl->textures = gb_gl_texture_cache_init(GB_DEVICE_GL_TEXTURE_CACHE_BUDGET);
+            tb_assert_and_check_break(impl->textures);
+
+            // init the offscreen target and render to it
+            if (!window)
+            {
+                impl->offscreen = gb_gl_offscreen_init(impl->version, width, height);
+                tb_check_break(impl->offscreen);
+            }
+
+            // init the stencil bits for the stencil-then-cover filling
+            if (impl->offscreen) impl->stencil_bits = gb_gl_offscreen_stencil_bits(impl->offscreen);
+            else
+            {
+                gb_GLint_t stencil_bits = 0;
+                gb_glGetIntegerv(GB_GL_STENCIL_BITS, &stencil_bits);
+                impl->stencil_bits = stencil_bits > 0? (tb_size_t)stencil_bits : 0;
+            }
+
+            // init the stencil value for clearing
+            if (impl->stencil_bits) gb_glClearStencil(0);
+
+            // init the fringe for the analytic antialiasing if no multisample buffer, .e.g most gl es targets
+            gb_GLint_t sample_buffers = 0;
+#ifndef GB_DEVICE_GL_FRINGE_ALWAYS
+            gb_glGetIntegerv(GB_GL_SAMPLE_BUFFERS, &sample_buffers);
+#endif
+            if (sample_buffers <= 0)
+            {
+                impl->fringe = gb_gl_fringe_init();
+                tb_assert_and_check_break(impl->fringe);
+            }
+
             // init the projection matrix
             gb_gl_matrix_orthof(impl->matrix_project, 0.0f, (gb_GLfloat_t)width, (gb_GLfloat_t)height, 0.0f, -1.0f, 1.0f);
         }
         // init gl 1.x
         else
         {
+            // the offscreen device is not supported
+            if (!window)
+            {
+                // trace
+                tb_trace_e("the offscreen device need gl >= 2.0!");
+                break;
+            }
+
             // init the projection matrix
             gb_glMatrixMode(GB_GL_PROJECTION);
             gb_glLoadIdentity();
@@ -342,5 +633,33 @@ gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
     }
 
     // ok?
+    return impl;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_device_ref_t gb_device_init_gl(gb_window_ref_t window)
+{
+    // check
+    tb_assert_and_check_return_val(window, tb_null);
+
+    // init it
+    return (gb_device_ref_t)gb_device_gl_init(window, gb_window_width(window), gb_window_height(window));
+}
+gb_device_ref_t gb_device_init_gl_offscreen(tb_size_t width, tb_size_t height)
+{
+    // init it
+    gb_gl_device_ref_t impl = gb_device_gl_init(tb_null, width, height);
+    tb_check_return_val(impl, tb_null);
+
+    // init pixfmt, the byte order of the read pixels is r, g, b, a
+    impl->base.pixfmt   = GB_PIXFMT_RGBA8888 | GB_PIXFMT_BENDIAN;
+
+    // init width and height
+    impl->base.width    = (tb_uint16_t)width;
+    impl->base.height   = (tb_uint16_t)height;
+
+    // ok
     return (gb_device_ref_t)impl;
 }
@@ -0,0 +1,508 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        batch.c
+ * @ingroup     core
+ */
+
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_batch"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "batch.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the vertex buffers count of the ring
+#define GB_GL_BATCH_BUFFER_MAXN         (4)
+
+// the vertices grow
+#ifdef __gb_small__
+#   define GB_GL_BATCH_VERTICES_GROW    (1024)
+#else
+#   define GB_GL_BATCH_VERTICES_GROW    (4096)
+#endif
+
+// the maximum vertices count of the batch, flush it if be overflow
+#define GB_GL_BATCH_VERTICES_MAXN       (65536)
+
+// the floats count of the texture vertex: texcoord(2) + texrect(4) + texclamp(4)
+#define GB_GL_BATCH_TEXTURE_FLOATS      (10)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl batch impl type
+typedef struct __gb_gl_batch_impl_t
+{
+    // the program
+    gb_gl_program_ref_t         program;
+
+    // the vertex matrix
+    gb_gl_matrix_t              matrix;
+
+    // enable antialiasing?
+    tb_uint8_t                  antialiasing    : 1;
+
+    // need blend for the transparent colors?
+    tb_uint8_t                  blend           : 1;
+
+    // the texture of the bitmap geometries, the texture id is zero for the solid geometries
+    gb_gl_batch_texture_t       texture;
+
+    // the points
+    gb_point_ref_t              points;
+
+    // the colors, rgba
+    tb_byte_t*                  colors;
+
+    // the interleaved texcoords, texrects and texclamps of the bitmap geometries
+    gb_GLfloat_t*               textures;
+
+    // the vertices maxn of the textures
+    tb_size_t                   textures_maxn;
+
+    // the vertices count
+    tb_size_t                   size;
+
+    // the vertices maxn
+    tb_size_t                   maxn;
+
+    // the vertex buffers of the ring
+    gb_GLuint_t                 buffers[GB_GL_BATCH_BUFFER_MAXN];
+
+    // the current vertex buffer index
+    tb_size_t                   buffer_index;
+
+}gb_gl_batch_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_gl_batch_grow(gb_gl_batch_impl_t* impl, tb_size_t count)
+{
+    // check
+    tb_assert_abort(impl);
+
+    // flush the pending vertices first if be overflow
+    if (impl->size && impl->size + count > GB_GL_BATCH_VERTICES_MAXN) gb_gl_batch_flush((gb_gl_batch_ref_t)impl);
+
+    // grow points and colors if not enough
+    if (impl->size + count > impl->maxn)
+    {
+        // the new maxn
+        tb_size_t maxn = tb_align(impl->size + count + GB_GL_BATCH_VERTICES_GROW, GB_GL_BATCH_VERTICES_GROW);
+
+        // grow points
+        gb_point_ref_t points = tb_ralloc_type(impl->points, maxn, gb_point_t);
+        tb_assert_and_check_return_val(points, tb_false);
+        impl->points = points;
+
+        // grow colors
+        tb_byte_t* colors = tb_ralloc_bytes(impl->colors, maxn << 2);
+        tb_assert_and_check_return_val(colors, tb_false);
+        impl->colors = colors;
+
+        // save maxn
+        impl->maxn = maxn;
+    }
+
+    // grow textures for the bitmap geometries if not enough
+    if (impl->texture.texture && impl->textures_maxn < impl->maxn)
+    {
+        gb_GLfloat_t* textures = tb_ralloc_type(impl->textures, impl->maxn * GB_GL_BATCH_TEXTURE_FLOATS, gb_GLfloat_t);
+        tb_assert_and_check_return_val(textures, tb_false);
+        impl->textures      = textures;
+        impl->textures_maxn = impl->maxn;
+    }
+
+    // ok
+    return tb_true;
+}
+static __tb_inline__ tb_void_t gb_gl_batch_add_point(gb_gl_batch_impl_t* impl, gb_point_ref_t point, gb_color_t color)
+{
+    // add point
+    impl->points[impl->size] = *point;
+
+    // add color
+    tb_byte_t* p = impl->colors + (impl->size << 2);
+    p[0] = color.r;
+    p[1] = color.g;
+    p[2] = color.b;
+    p[3] = color.a;
+
+    // add the texcoord, texrect and texclamp of the bitmap
+    if (impl->texture.texture)
+    {
+        gb_GLfloat_t        x = (gb_GLfloat_t)gb_float_to_tb(point->x);
+        gb_GLfloat_t        y = (gb_GLfloat_t)gb_float_to_tb(point->y);
+        gb_GLfloat_t const* m = impl->texture.matrix;
+        gb_GLfloat_t*       t = impl->textures + impl->size * GB_GL_BATCH_TEXTURE_FLOATS;
+        t[0] = m[0] * x + m[4] * y + m[12];
+        t[1] = m[1] * x + m[5] * y + m[13];
+        tb_memcpy(t + 2, impl->texture.rect, sizeof(impl->texture.rect));
+        tb_memcpy(t + 6, impl->texture.clamp, sizeof(impl->texture.clamp));
+    }
+
+    // update size
+    impl->size++;
+}
+static tb_void_t gb_gl_batch_add_join(gb_gl_batch_impl_t* impl, gb_point_ref_t point, gb_color_t color)
+{
+    // check
+    tb_assert_abort(impl);
+
+    // empty? no join
+    tb_check_return(impl->size);
+
+    // the last vertex
+    tb_size_t last = impl->size - 1;
+
+    // join the disjoint pieces by the degenerate triangles: ..., last, last, first, first, ...
+    impl->points[impl->size] = impl->points[last];
+    tb_memcpy(impl->colors + (impl->size << 2), impl->colors + (last << 2), 4);
+    if (impl->texture.texture) tb_memcpy(impl->textures + impl->size * GB_GL_BATCH_TEXTURE_FLOATS, impl->textures + last * GB_GL_BATCH_TEXTURE_FLOATS, GB_GL_BATCH_TEXTURE_FLOATS * sizeof(gb_GLfloat_t));
+    impl->size++;
+    gb_gl_batch_add_point(impl, point, color);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_batch_ref_t gb_gl_batch_init()
+{
+    // make batch
+    return (gb_gl_batch_ref_t)tb_malloc0_type(gb_gl_batch_impl_t);
+}
+tb_void_t gb_gl_batch_exit(gb_gl_batch_ref_t batch)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return(impl);
+
+    // exit vertex buffers
+    tb_size_t i = 0;
+    for (i = 0; i < GB_GL_BATCH_BUFFER_MAXN; i++)
+    {
+        if (impl->buffers[i]) gb_glDeleteBuffers(1, &impl->buffers[i]);
+        impl->buffers[i] = 0;
+    }
+
+    // exit points
+    if (impl->points) tb_free(impl->points);
+    impl->points = tb_null;
+
+    // exit colors
+    if (impl->colors) tb_free(impl->colors);
+    impl->colors = tb_null;
+
+    // exit textures
+    if (impl->textures) tb_free(impl->textures);
+    impl->textures = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_size_t gb_gl_batch_size(gb_gl_batch_ref_t batch)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the vertices count
+    return impl->size;
+}
+tb_bool_t gb_gl_batch_state_set(gb_gl_batch_ref_t batch, gb_gl_program_ref_t program, gb_gl_matrix_ref_t matrix, tb_bool_t antialiasing, gb_gl_batch_texture_ref_t texture)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return_val(impl && program && matrix, tb_false);
+
+    // the pending vertices use the other state?
+    if (impl->size)
+    {
+        if (    impl->program != program
+            ||  impl->antialiasing != (antialiasing? 1 : 0)
+            ||  tb_memcmp(impl->matrix, matrix, sizeof(gb_gl_matrix_t)))
+            return tb_false;
+
+        // the bitmaps in the same atlas page with the same mode can be merged
+        if (impl->texture.texture != (texture? texture->texture : 0)) return tb_false;
+        if (texture && impl->texture.mode != texture->mode) return tb_false;
+    }
+    else
+    {
+        // save state
+        impl->program       = program;
+        impl->antialiasing  = antialiasing? 1 : 0;
+        tb_memcpy(impl->matrix, matrix, sizeof(gb_gl_matrix_t));
+    }
+
+    // save the texture mapping of the next vertices
+    if (texture) impl->texture = *texture;
+    else tb_memset(&impl->texture, 0, sizeof(gb_gl_batch_texture_t));
+
+    // ok
+    return tb_true;
+}
+tb_void_t gb_gl_batch_add_strip(gb_gl_batch_ref_t batch, gb_point_ref_t points, tb_size_t count, gb_color_t color)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return(impl && points);
+
+    // no triangles?
+    tb_check_return(count >= 3);
+
+    // grow it
+    if (!gb_gl_batch_grow(impl, count + 2)) return ;
+
+    // join it
+    gb_gl_batch_add_join(impl, points, color);
+
+    // add points
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++) gb_gl_batch_add_point(impl, points + i, color);
+
+    // need blend?
+    if (color.a != 0xff || (impl->texture.texture && !impl->texture.opaque)) impl->blend = 1;
+}
+tb_void_t gb_gl_batch_add_fan(gb_gl_batch_ref_t batch, gb_point_ref_t points, tb_size_t count, gb_color_t color)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return(impl && points);
+
+    // the contour is closed? remove the repeated last point
+    if (count > 1 && gb_point_eq(points, points + count - 1)) count--;
+
+    // no triangles?
+    tb_check_return(count >= 3);
+
+    // grow it
+    if (!gb_gl_batch_grow(impl, count + 2)) return ;
+
+    // join it
+    gb_gl_batch_add_join(impl, points, color);
+
+    /* add the convex polygon as the zigzag triangle strip
+     *
+     * p0, p1, pn-1, p2, pn-2, ...
+     *
+     *        p1 ---- p2
+     *       /          \
+     *     p0            p3
+     *       \          /
+     *        p5 ---- p4
+     */
+    tb_size_t l = 1;
+    tb_size_t r = count - 1;
+    gb_gl_batch_add_point(impl, points, color);
+    while (l <= r)
+    {
+        gb_gl_batch_add_point(impl, points + l++, color);
+        if (l <= r) gb_gl_batch_add_point(impl, points + r--, color);
+    }
+
+    // need blend?
+    if (color.a != 0xff || (impl->texture.texture && !impl->texture.opaque)) impl->blend = 1;
+}
+tb_void_t gb_gl_batch_add_instance(gb_gl_batch_ref_t batch, gb_point_ref_t points, tb_size_t count, gb_matrix_ref_t matrix, gb_color_t color)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return(impl && points && matrix);
+
+    // no triangles?
+    tb_check_return(count >= 3);
+
+    // grow it
+    if (!gb_gl_batch_grow(impl, count + 2)) return ;
+
+    // join it
+    gb_point_t point;
+    point.x = gb_matrix_apply_x(matrix, points[0].x, points[0].y);
+    point.y = gb_matrix_apply_y(matrix, points[0].x, points[0].y);
+    gb_gl_batch_add_join(impl, &point, color);
+
+    // add the transformed points
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        point.x = gb_matrix_apply_x(matrix, points[i].x, points[i].y);
+        point.y = gb_matrix_apply_y(matrix, points[i].x, points[i].y);
+        gb_gl_batch_add_point(impl, &point, color);
+    }
+
+    // need blend?
+    if (color.a != 0xff || (impl->texture.texture && !impl->texture.opaque)) impl->blend = 1;
+}
+tb_void_t gb_gl_batch_add_fringe(gb_gl_batch_ref_t batch, gb_point_ref_t points, tb_size_t count, gb_color_t color)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return(impl && points);
+
+    // no triangles?
+    tb_check_return(count >= 4);
+
+    // grow it
+    if (!gb_gl_batch_grow(impl, count + 2)) return ;
+
+    // the transparent color of the outer side
+    gb_color_t outer = color;
+    outer.a = 0;
+
+    // join it
+    gb_gl_batch_add_join(impl, points, color);
+
+    // add points
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++) gb_gl_batch_add_point(impl, points + i, (i & 1)? outer : color);
+
+    // the coverage is blended
+    impl->blend = 1;
+}
+tb_void_t gb_gl_batch_flush(gb_gl_batch_ref_t batch)
+{
+    // check
+    gb_gl_batch_impl_t* impl = (gb_gl_batch_impl_t*)batch;
+    tb_assert_and_check_return(impl);
+
+    // no vertices?
+    tb_check_return(impl->size);
+
+    // check
+    tb_assert_and_check_return(impl->program && impl->points && impl->colors);
+
+    // trace
+    tb_trace_d("flush: %lu vertices", impl->size);
+
+    // bind program
+    gb_gl_program_bind(impl->program);
+
+    // apply vertex matrix
+    gb_gl_program_matrix_set(impl->program, GB_GL_PROGRAM_LOCATION_MATRIX_MODEL, impl->matrix);
+
+    // apply antialiasing
+    if (impl->antialiasing) gb_glEnable(GB_GL_MULTISAMPLE);
+    else gb_glDisable(GB_GL_MULTISAMPLE);
+
+    // the next vertex buffer of the ring
+    gb_GLuint_t* buffer = &impl->buffers[impl->buffer_index];
+    impl->buffer_index = (impl->buffer_index + 1) % GB_GL_BATCH_BUFFER_MAXN;
+    if (!*buffer) gb_glGenBuffers(1, buffer);
+
+    // the points, colors and textures size
+    tb_size_t points_size   = impl->size * sizeof(gb_point_t);
+    tb_size_t colors_size   = impl->size << 2;
+    tb_size_t textures_size = impl->texture.texture? impl->size * GB_GL_BATCH_TEXTURE_FLOATS * sizeof(gb_GLfloat_t) : 0;
+
+    // orphan the old storage and upload the vertices 
+    gb_glBindBuffer(GB_GL_ARRAY_BUFFER, *buffer);
+    gb_glBufferData(GB_GL_ARRAY_BUFFER, (gb_GLsizeiptr_t)(points_size + colors_size + textures_size), tb_null, GB_GL_STREAM_DRAW);
+    gb_glBufferSubData(GB_GL_ARRAY_BUFFER, 0, (gb_GLsizeiptr_t)points_size, impl->points);
+    gb_glBufferSubData(GB_GL_ARRAY_BUFFER, (gb_GLintptr_t)points_size, (gb_GLsizeiptr_t)colors_size, impl->colors);
+    if (textures_size) gb_glBufferSubData(GB_GL_ARRAY_BUFFER, (gb_GLintptr_t)(points_size + colors_size), (gb_GLsizeiptr_t)textures_size, impl->textures);
+
+    // the locations
+    gb_GLint_t location_vertices    = gb_gl_program_location(impl->program, GB_GL_PROGRAM_LOCATION_VERTICES);
+    gb_GLint_t location_colors      = gb_gl_program_location(impl->program, GB_GL_PROGRAM_LOCATION_COLORS);
+
+    // apply vertices
+    gb_glEnableVertexAttribArray(location_vertices);
+    gb_glVertexAttribPointer(location_vertices, 2, GB_GL_VERTEX_TYPE, GB_GL_FALSE, 0, (gb_GLvoid_t const*)0);
+
+    // apply colors
+    gb_glEnableVertexAttribArray(location_colors);
+    gb_glVertexAttribPointer(location_colors, 4, GB_GL_UNSIGNED_BYTE, GB_GL_TRUE, 0, (gb_GLvoid_t const*)points_size);
+
+    // apply the texture of the bitmap geometries
+    if (textures_size)
+    {
+        // the locations
+        gb_GLint_t location_texcoords   = gb_gl_program_location(impl->program, GB_GL_PROGRAM_LOCATION_TEXCOORDS);
+        gb_GLint_t location_texrect     = gb_gl_program_location(impl->program, GB_GL_PROGRAM_LOCATION_TEXRECT);
+        gb_GLint_t location_texclamp    = gb_gl_program_location(impl->program, GB_GL_PROGRAM_LOCATION_TEXCLAMP);
+
+        // apply the interleaved texcoords, texrects and texclamps
+        gb_GLsizei_t    stride = GB_GL_BATCH_TEXTURE_FLOATS * sizeof(gb_GLfloat_t);
+        tb_size_t       offset = points_size + colors_size;
+        gb_glEnableVertexAttribArray(location_texcoords);
+        gb_glEnableVertexAttribArray(location_texrect);
+        gb_glEnableVertexAttribArray(location_texclamp);
+        gb_glVertexAttribPointer(location_texcoords, 2, GB_GL_FLOAT, GB_GL_FALSE, stride, (gb_GLvoid_t const*)offset);
+        gb_glVertexAttribPointer(location_texrect, 4, GB_GL_FLOAT, GB_GL_FALSE, stride, (gb_GLvoid_t const*)(offset + 2 * sizeof(gb_GLfloat_t)));
+        gb_glVertexAttribPointer(location_texclamp, 4, GB_GL_FLOAT, GB_GL_FALSE, stride, (gb_GLvoid_t const*)(offset + 6 * sizeof(gb_GLfloat_t)));
+
+        // the texcoords are mapped per vertex, clear the texcoord matrix
+        gb_gl_matrix_t texcoord = {0};
+        gb_gl_program_matrix_set(impl->program, GB_GL_PROGRAM_LOCATION_MATRIX_TEXCOORD, texcoord);
+
+        // apply the mode
+        gb_gl_program_integer_set(impl->program, GB_GL_PROGRAM_LOCATION_MODE, (gb_GLint_t)impl->texture.mode);
+
+        // bind the texture to the first texture unit
+        gb_glActiveTexture(GB_GL_TEXTURE0);
+        gb_glBindTexture(GB_GL_TEXTURE_2D, impl->texture.texture);
+        gb_gl_program_integer_set(impl->program, GB_GL_PROGRAM_LOCATION_SAMPLER, 0);
+    }
+
+    // enable blend for the transparent colors
+    if (impl->blend)
+    {
+        gb_glEnable(GB_GL_BLEND);
+        gb_glBlendFunc(GB_GL_SRC_ALPHA, GB_GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else gb_glDisable(GB_GL_BLEND);
+
+    // draw it
+    gb_glDrawArrays(GB_GL_TRIANGLE_STRIP, 0, (gb_GLint_t)impl->size);
+
+    // disable blend
+    gb_glDisable(GB_GL_BLEND);
+
+    // disable colors and restore the constant color attribute
+    gb_glDisableVertexAttribArray(location_colors);
+
+    // disable the texture arrays and unbind the texture
+    if (textures_size)
+    {
+        gb_glDisableVertexAttribArray(gb_gl_program_location(impl->program, GB_GL_PROGRAM_LOCATION_TEXCOORDS));
+        gb_glDisableVertexAttribArray(gb_gl_program_location(impl->program, GB_GL_PROGRAM_LOCATION_TEXRECT));
+        gb_glDisableVertexAttribArray(gb_gl_program_location(impl->program, GB_GL_PROGRAM_LOCATION_TEXCLAMP));
+        gb_glBindTexture(GB_GL_TEXTURE_2D, 0);
+    }
+
+    // unbind the vertex buffer for the client-side vertices
+    gb_glBindBuffer(GB_GL_ARRAY_BUFFER, 0);
+
+    // clear it
+    impl->size  = 0;
+    impl->blend = 0;
+}
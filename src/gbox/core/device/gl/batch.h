@@ -0,0 +1,174 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        batch.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_BATCH_H
+#define GB_CORE_DEVICE_GL_BATCH_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "program.h"
+#include "matrix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl batch texture type of the bitmap geometries
+typedef struct __gb_gl_batch_texture_t
+{
+    // the texture, it is shared by all small bitmaps in the same atlas page
+    gb_GLuint_t                 texture;
+
+    // the mode
+    tb_size_t                   mode;
+
+    // the texcoord matrix which maps the vertices to the normalized bitmap space
+    gb_gl_matrix_t              matrix;
+
+    // the normalized rect of the bitmap in the texture: x, y, width, height
+    gb_GLfloat_t                rect[4];
+
+    // the normalized texel-center bounds of the bitmap in the texture: x0, y0, x1, y1
+    gb_GLfloat_t                clamp[4];
+
+    // is opaque?
+    tb_bool_t                   opaque;
+
+}gb_gl_batch_texture_t, *gb_gl_batch_texture_ref_t;
+
+/*! the gl batch type for gl >= 2.0
+ *
+ * append the geometries of the consecutive draws with the same state into one triangle strip
+ * with the per-vertex colors, the disjoint pieces are joined by the degenerate triangles.
+ *
+ * the bitmap geometries also use the per-vertex texcoords, rects and clamps of the bitmaps,
+ * so the draws of the different bitmaps in the same atlas page are merged into one draw call.
+ *
+ * the batch is uploaded to a ring of the streaming vertex buffers and drawn by one glDrawArrays 
+ * when the state is changed or the frame is finished.
+ *
+ * <pre>
+ * state: program + vertex matrix + antialiasing + texture + mode
+ * </pre>
+ */
+typedef struct{}*       gb_gl_batch_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init batch
+ *
+ * @return              the batch
+ */
+gb_gl_batch_ref_t       gb_gl_batch_init(tb_noarg_t);
+
+/* exit batch and the pending geometries will be discarded
+ *
+ * @param batch         the batch
+ */
+tb_void_t               gb_gl_batch_exit(gb_gl_batch_ref_t batch);
+
+/* the pending vertices count
+ *
+ * @param batch         the batch
+ *
+ * @return              the vertices count
+ */
+tb_size_t               gb_gl_batch_size(gb_gl_batch_ref_t batch);
+
+/* set the state of the next geometries
+ *
+ * @param batch         the batch
+ * @param program       the program
+ * @param matrix        the vertex matrix
+ * @param antialiasing  enable antialiasing?
+ * @param texture       the texture of the bitmap geometries, tb_null for the solid geometries
+ *
+ * @return              tb_false if the pending geometries use the other state and need be flushed first
+ */
+tb_bool_t               gb_gl_batch_state_set(gb_gl_batch_ref_t batch, gb_gl_program_ref_t program, gb_gl_matrix_ref_t matrix, tb_bool_t antialiasing, gb_gl_batch_texture_ref_t texture);
+
+/* add a triangle strip 
+ *
+ * @param batch         the batch
+ * @param points        the points of the triangle strip
+ * @param count         the points count
+ * @param color         the color
+ */
+tb_void_t               gb_gl_batch_add_strip(gb_gl_batch_ref_t batch, gb_point_ref_t points, tb_size_t count, gb_color_t color);
+
+/* add a triangle fan of the convex polygon
+ *
+ * @param batch         the batch
+ * @param points        the points of the convex polygon
+ * @param count         the points count
+ * @param color         the color
+ */
+tb_void_t               gb_gl_batch_add_fan(gb_gl_batch_ref_t batch, gb_point_ref_t points, tb_size_t count, gb_color_t color);
+
+/* add a triangle strip transformed by the given matrix
+ *
+ * expand the instance to the vertices for gl 2.0 which has no instanced arrays
+ *
+ * @param batch         the batch
+ * @param points        the points of the triangle strip
+ * @param count         the points count
+ * @param matrix        the matrix of this instance
+ * @param color         the color
+ */
+tb_void_t               gb_gl_batch_add_instance(gb_gl_batch_ref_t batch, gb_point_ref_t points, tb_size_t count, gb_matrix_ref_t matrix, gb_color_t color);
+
+/* add a triangle strip of the antialiasing fringe
+ *
+ * the points are interleaved by the inner and outer sides: inner, outer, inner, outer, ...
+ * the inner points use the given color and the alpha of the outer points is zero
+ *
+ * @param batch         the batch
+ * @param points        the points of the triangle strip
+ * @param count         the points count
+ * @param color         the color
+ */
+tb_void_t               gb_gl_batch_add_fringe(gb_gl_batch_ref_t batch, gb_point_ref_t points, tb_size_t count, gb_color_t color);
+
+/* flush the pending geometries 
+ *
+ * the program and texture of the current state will be bound 
+ *
+ * @param batch         the batch
+ */
+tb_void_t               gb_gl_batch_flush(gb_gl_batch_ref_t batch);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,491 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        context.c
+ * @ingroup     core
+ */
+
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_context"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "context.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the egl constants
+#define GB_EGL_TRUE                         (1)
+#define GB_EGL_NONE                         (0x3038)
+#define GB_EGL_ALPHA_SIZE                   (0x3021)
+#define GB_EGL_BLUE_SIZE                    (0x3022)
+#define GB_EGL_GREEN_SIZE                   (0x3023)
+#define GB_EGL_RED_SIZE                     (0x3024)
+#define GB_EGL_STENCIL_SIZE                 (0x3026)
+#define GB_EGL_SURFACE_TYPE                 (0x3033)
+#define GB_EGL_RENDERABLE_TYPE              (0x3040)
+#define GB_EGL_EXTENSIONS                   (0x3055)
+#define GB_EGL_HEIGHT                       (0x3056)
+#define GB_EGL_WIDTH                        (0x3057)
+#define GB_EGL_CONTEXT_CLIENT_VERSION       (0x3098)
+#define GB_EGL_PBUFFER_BIT                  (0x0001)
+#define GB_EGL_OPENGL_ES2_BIT               (0x0004)
+#define GB_EGL_OPENGL_BIT                   (0x0008)
+#define GB_EGL_OPENGL_ES_API                (0x30A0)
+#define GB_EGL_OPENGL_API                   (0x30A2)
+#define GB_EGL_PLATFORM_SURFACELESS_MESA    (0x31DD)
+#define GB_EGL_TRACK_REFERENCES_KHR         (0x3352)
+
+// the osmesa constants
+#define GB_OSMESA_RGBA                      (0x1908)
+#define GB_OSMESA_UNSIGNED_BYTE             (0x1401)
+
+// the egl library names
+#ifdef TB_CONFIG_OS_ANDROID
+#   define GB_GL_CONTEXT_EGL_LIBRARY        "libEGL.so"
+#else
+#   define GB_GL_CONTEXT_EGL_LIBRARY        "libEGL.so.1"
+#endif
+
+// the osmesa library names
+#define GB_GL_CONTEXT_OSMESA_LIBRARY        "libOSMesa.so.8"
+#define GB_GL_CONTEXT_OSMESA_LIBRARY_       "libOSMesa.so"
+
+// load the egl or osmesa function
+#define GB_GL_CONTEXT_LOAD(impl, func)      impl->func = (gb_##func##_t)tb_dynamic_func(impl->library, #func); tb_assert_and_check_break(impl->func)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the egl types
+typedef tb_int32_t      gb_EGLint_t;
+typedef tb_uint_t       gb_EGLboolean_t;
+typedef tb_uint_t       gb_EGLenum_t;
+typedef tb_pointer_t    gb_EGLDisplay_t;
+typedef tb_pointer_t    gb_EGLConfig_t;
+typedef tb_pointer_t    gb_EGLContext_t;
+typedef tb_pointer_t    gb_EGLSurface_t;
+
+// the osmesa types
+typedef tb_pointer_t    gb_OSMesaContext_t;
+
+// the egl interface types
+typedef tb_pointer_t        (GB_GL_INTERFACE_TYPE(eglGetProcAddress))       (tb_char_t const* name);
+typedef gb_EGLDisplay_t     (GB_GL_INTERFACE_TYPE(eglGetDisplay))           (tb_pointer_t native);
+typedef gb_EGLDisplay_t     (GB_GL_INTERFACE_TYPE(eglGetPlatformDisplayEXT))(gb_EGLenum_t platform, tb_pointer_t native, gb_EGLint_t const* attribs);
+typedef gb_EGLboolean_t     (GB_GL_INTERFACE_TYPE(eglInitialize))           (gb_EGLDisplay_t display, gb_EGLint_t* major, gb_EGLint_t* minor);
+typedef gb_EGLboolean_t     (GB_GL_INTERFACE_TYPE(eglTerminate))            (gb_EGLDisplay_t display);
+typedef tb_char_t const*    (GB_GL_INTERFACE_TYPE(eglQueryString))          (gb_EGLDisplay_t display, gb_EGLint_t name);
+typedef gb_EGLboolean_t     (GB_GL_INTERFACE_TYPE(eglBindAPI))              (gb_EGLenum_t api);
+typedef gb_EGLboolean_t     (GB_GL_INTERFACE_TYPE(eglChooseConfig))         (gb_EGLDisplay_t display, gb_EGLint_t const* attribs, gb_EGLConfig_t* configs, gb_EGLint_t size, gb_EGLint_t* count);
+typedef gb_EGLContext_t     (GB_GL_INTERFACE_TYPE(eglCreateContext))        (gb_EGLDisplay_t display, gb_EGLConfig_t config, gb_EGLContext_t share, gb_EGLint_t const* attribs);
+typedef gb_EGLboolean_t     (GB_GL_INTERFACE_TYPE(eglDestroyContext))       (gb_EGLDisplay_t display, gb_EGLContext_t context);
+typedef gb_EGLSurface_t     (GB_GL_INTERFACE_TYPE(eglCreatePbufferSurface)) (gb_EGLDisplay_t display, gb_EGLConfig_t config, gb_EGLint_t const* attribs);
+typedef gb_EGLboolean_t     (GB_GL_INTERFACE_TYPE(eglDestroySurface))       (gb_EGLDisplay_t display, gb_EGLSurface_t surface);
+typedef gb_EGLboolean_t     (GB_GL_INTERFACE_TYPE(eglMakeCurrent))          (gb_EGLDisplay_t display, gb_EGLSurface_t draw, gb_EGLSurface_t read, gb_EGLContext_t context);
+typedef gb_EGLboolean_t     (GB_GL_INTERFACE_TYPE(eglReleaseThread))        (tb_void_t);
+
+// the osmesa interface types
+typedef gb_OSMesaContext_t  (GB_GL_INTERFACE_TYPE(OSMesaCreateContextExt))  (gb_GLenum_t format, gb_GLint_t depth, gb_GLint_t stencil, gb_GLint_t accum, gb_OSMesaContext_t share);
+typedef gb_GLboolean_t      (GB_GL_INTERFACE_TYPE(OSMesaMakeCurrent))       (gb_OSMesaContext_t context, tb_pointer_t buffer, gb_GLenum_t type, gb_GLsizei_t width, gb_GLsizei_t height);
+typedef gb_GLvoid_t         (GB_GL_INTERFACE_TYPE(OSMesaDestroyContext))    (gb_OSMesaContext_t context);
+
+// the gl context impl type
+typedef struct __gb_gl_context_impl_t
+{
+    // the type
+    tb_size_t                           type;
+
+    // the library
+    tb_dynamic_ref_t                    library;
+
+    // the egl display
+    gb_EGLDisplay_t                     display;
+
+    /* the egl display is owned by this context?
+     *
+     * the display of the same platform is shared by the whole process, 
+     * so it is owned only if it tracks the references and can be terminated by this context
+     */
+    tb_bool_t                           display_owned;
+
+    // the egl context
+    gb_EGLContext_t                     context;
+
+    // the egl pbuffer surface, null: surfaceless
+    gb_EGLSurface_t                     surface;
+
+    // the osmesa context
+    gb_OSMesaContext_t                  osmesa;
+
+    // the 1x1 color buffer of the osmesa context, the framebuffer objects will be used for rendering
+    tb_uint32_t                         buffer;
+
+    // the egl interfaces
+    gb_eglGetProcAddress_t              eglGetProcAddress;
+    gb_eglGetDisplay_t                  eglGetDisplay;
+    gb_eglInitialize_t                  eglInitialize;
+    gb_eglTerminate_t                   eglTerminate;
+    gb_eglQueryString_t                 eglQueryString;
+    gb_eglBindAPI_t                     eglBindAPI;
+    gb_eglChooseConfig_t                eglChooseConfig;
+    gb_eglCreateContext_t               eglCreateContext;
+    gb_eglDestroyContext_t              eglDestroyContext;
+    gb_eglCreatePbufferSurface_t        eglCreatePbufferSurface;
+    gb_eglDestroySurface_t              eglDestroySurface;
+    gb_eglMakeCurrent_t                 eglMakeCurrent;
+    gb_eglReleaseThread_t               eglReleaseThread;
+
+    // the osmesa interfaces
+    gb_OSMesaCreateContextExt_t         OSMesaCreateContextExt;
+    gb_OSMesaMakeCurrent_t              OSMesaMakeCurrent;
+    gb_OSMesaDestroyContext_t           OSMesaDestroyContext;
+
+}gb_gl_context_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_gl_context_has_extension(tb_char_t const* extensions, tb_char_t const* name)
+{
+    // check
+    tb_check_return_val(extensions && name, tb_false);
+
+    // find the whole word of the extension name
+    tb_size_t           n = tb_strlen(name);
+    tb_char_t const*    p = extensions;
+    while ((p = tb_strstr(p, name)))
+    {
+        // found?
+        if ((p == extensions || p[-1] == ' ') && (p[n] == ' ' || p[n] == '\0')) return tb_true;
+        p += n;
+    }
+
+    // not found
+    return tb_false;
+}
+static tb_bool_t gb_gl_context_init_egl(gb_gl_context_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && !impl->library, tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // load library
+        impl->library = tb_dynamic_init(GB_GL_CONTEXT_EGL_LIBRARY);
+        tb_check_break(impl->library);
+
+        // load interfaces
+        GB_GL_CONTEXT_LOAD(impl, eglGetProcAddress);
+        GB_GL_CONTEXT_LOAD(impl, eglGetDisplay);
+        GB_GL_CONTEXT_LOAD(impl, eglInitialize);
+        GB_GL_CONTEXT_LOAD(impl, eglTerminate);
+        GB_GL_CONTEXT_LOAD(impl, eglQueryString);
+        GB_GL_CONTEXT_LOAD(impl, eglBindAPI);
+        GB_GL_CONTEXT_LOAD(impl, eglChooseConfig);
+        GB_GL_CONTEXT_LOAD(impl, eglCreateContext);
+        GB_GL_CONTEXT_LOAD(impl, eglDestroyContext);
+        GB_GL_CONTEXT_LOAD(impl, eglCreatePbufferSurface);
+        GB_GL_CONTEXT_LOAD(impl, eglDestroySurface);
+        GB_GL_CONTEXT_LOAD(impl, eglMakeCurrent);
+        GB_GL_CONTEXT_LOAD(impl, eglReleaseThread);
+
+        // get the surfaceless display first, no display server is needed
+        tb_char_t const* extensions = impl->eglQueryString(tb_null, GB_EGL_EXTENSIONS);
+        if (gb_gl_context_has_extension(extensions, "EGL_MESA_platform_surfaceless"))
+        {
+            gb_eglGetPlatformDisplayEXT_t get_platform_display = (gb_eglGetPlatformDisplayEXT_t)impl->eglGetProcAddress("eglGetPlatformDisplayEXT");
+            if (get_platform_display) 
+            {
+                // track the references of the display if supported, so we own the initialized reference and can terminate it
+                gb_EGLint_t const display_attribs[] = 
+                {
+                    GB_EGL_TRACK_REFERENCES_KHR,    GB_EGL_TRUE
+                ,   GB_EGL_NONE
+                };
+                if (gb_gl_context_has_extension(extensions, "EGL_KHR_display_reference"))
+                {
+                    impl->display = get_platform_display(GB_EGL_PLATFORM_SURFACELESS_MESA, tb_null, display_attribs);
+                    impl->display_owned = impl->display? tb_true : tb_false;
+                }
+                if (!impl->display) impl->display = get_platform_display(GB_EGL_PLATFORM_SURFACELESS_MESA, tb_null, tb_null);
+            }
+        }
+
+        // get the default display, it is shared and will not be terminated
+        if (!impl->display) impl->display = impl->eglGetDisplay(tb_null);
+        tb_check_break(impl->display);
+
+        // init display
+        gb_EGLint_t major = 0;
+        gb_EGLint_t minor = 0;
+        if (!impl->eglInitialize(impl->display, &major, &minor))
+        {
+            impl->display       = tb_null;
+            impl->display_owned = tb_false;
+            break;
+        }
+
+        // the surfaceless context is supported?
+        tb_bool_t surfaceless = gb_gl_context_has_extension(impl->eglQueryString(impl->display, GB_EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+
+        // trace
+        tb_trace_d("egl: %d.%d, surfaceless: %s", major, minor, surfaceless? "ok" : "no");
+
+        // bind api
+#if defined(TB_CONFIG_OS_ANDROID) || defined(TB_CONFIG_OS_IOS)
+        if (!impl->eglBindAPI(GB_EGL_OPENGL_ES_API)) break;
+        gb_EGLint_t renderable = GB_EGL_OPENGL_ES2_BIT;
+#else
+        if (!impl->eglBindAPI(GB_EGL_OPENGL_API)) break;
+        gb_EGLint_t renderable = GB_EGL_OPENGL_BIT;
+#endif
+
+        // choose config
+        gb_EGLint_t const config_attribs[] = 
+        {
+            GB_EGL_SURFACE_TYPE,        surfaceless? 0 : GB_EGL_PBUFFER_BIT
+        ,   GB_EGL_RENDERABLE_TYPE,     renderable
+        ,   GB_EGL_RED_SIZE,            8
+        ,   GB_EGL_GREEN_SIZE,          8
+        ,   GB_EGL_BLUE_SIZE,           8
+        ,   GB_EGL_ALPHA_SIZE,          8
+        ,   GB_EGL_NONE
+        };
+        gb_EGLConfig_t  config = tb_null;
+        gb_EGLint_t     count = 0;
+        if (!impl->eglChooseConfig(impl->display, config_attribs, &config, 1, &count) || count < 1) break;
+
+        // init context
+        gb_EGLint_t const context_attribs[] = 
+        {
+#if defined(TB_CONFIG_OS_ANDROID) || defined(TB_CONFIG_OS_IOS)
+            GB_EGL_CONTEXT_CLIENT_VERSION, 2,
+#endif
+            GB_EGL_NONE
+        };
+        impl->context = impl->eglCreateContext(impl->display, config, tb_null, context_attribs);
+        tb_check_break(impl->context);
+
+        // init the 1x1 pbuffer surface if the surfaceless context is not supported
+        if (!surfaceless)
+        {
+            gb_EGLint_t const surface_attribs[] = 
+            {
+                GB_EGL_WIDTH,               1
+            ,   GB_EGL_HEIGHT,              1
+            ,   GB_EGL_NONE
+            };
+            impl->surface = impl->eglCreatePbufferSurface(impl->display, config, surface_attribs);
+            tb_check_break(impl->surface);
+        }
+
+        // ok
+        impl->type = GB_GL_CONTEXT_TYPE_EGL;
+        ok = tb_true;
+
+    } while (0);
+
+    // ok?
+    return ok;
+}
+static tb_void_t gb_gl_context_exit_egl(gb_gl_context_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->library);
+
+    // exit display
+    if (impl->display)
+    {
+        // release the current context
+        if (impl->eglMakeCurrent) impl->eglMakeCurrent(impl->display, tb_null, tb_null, tb_null);
+
+        // exit surface
+        if (impl->surface && impl->eglDestroySurface) impl->eglDestroySurface(impl->display, impl->surface);
+        impl->surface = tb_null;
+
+        // exit context
+        if (impl->context && impl->eglDestroyContext) impl->eglDestroyContext(impl->display, impl->context);
+        impl->context = tb_null;
+
+        // release the egl state of this thread
+        if (impl->eglReleaseThread) impl->eglReleaseThread();
+
+        // exit display only if it is owned, the shared display may be still used by the other contexts
+        if (impl->display_owned && impl->eglTerminate) impl->eglTerminate(impl->display);
+        impl->display       = tb_null;
+        impl->display_owned = tb_false;
+    }
+
+    // exit library
+    tb_dynamic_exit(impl->library);
+    impl->library = tb_null;
+}
+static tb_bool_t gb_gl_context_init_osmesa(gb_gl_context_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && !impl->library, tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // load library
+        impl->library = tb_dynamic_init(GB_GL_CONTEXT_OSMESA_LIBRARY);
+        if (!impl->library) impl->library = tb_dynamic_init(GB_GL_CONTEXT_OSMESA_LIBRARY_);
+        tb_check_break(impl->library);
+
+        // load interfaces
+        GB_GL_CONTEXT_LOAD(impl, OSMesaCreateContextExt);
+        GB_GL_CONTEXT_LOAD(impl, OSMesaMakeCurrent);
+        GB_GL_CONTEXT_LOAD(impl, OSMesaDestroyContext);
+
+        // init context, the stencil buffer is attached to the framebuffer objects
+        impl->osmesa = impl->OSMesaCreateContextExt(GB_OSMESA_RGBA, 0, 0, 0, tb_null);
+        tb_check_break(impl->osmesa);
+
+        // ok
+        impl->type = GB_GL_CONTEXT_TYPE_OSMESA;
+        ok = tb_true;
+
+    } while (0);
+
+    // ok?
+    return ok;
+}
+static tb_void_t gb_gl_context_exit_osmesa(gb_gl_context_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->library);
+
+    // exit context
+    if (impl->osmesa && impl->OSMesaDestroyContext) impl->OSMesaDestroyContext(impl->osmesa);
+    impl->osmesa = tb_null;
+
+    // exit library
+    tb_dynamic_exit(impl->library);
+    impl->library = tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_context_ref_t gb_gl_context_init()
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    gb_gl_context_impl_t*   impl = tb_null;
+    do
+    {
+        // make context
+        impl = tb_malloc0_type(gb_gl_context_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init the egl context first
+        if (!gb_gl_context_init_egl(impl))
+        {
+            // exit the partial egl context
+            if (impl->library) gb_gl_context_exit_egl(impl);
+
+            // init the osmesa context
+            if (!gb_gl_context_init_osmesa(impl))
+            {
+                // trace
+                tb_trace_e("no headless gl context, libEGL or libOSMesa is not found!");
+                break;
+            }
+        }
+
+        // make it current
+        if (!gb_gl_context_make_current((gb_gl_context_ref_t)impl)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_context_exit((gb_gl_context_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_gl_context_ref_t)impl;
+}
+tb_void_t gb_gl_context_exit(gb_gl_context_ref_t context)
+{
+    // check
+    gb_gl_context_impl_t* impl = (gb_gl_context_impl_t*)context;
+    tb_assert_and_check_return(impl);
+
+    // exit it
+    if (impl->library)
+    {
+        if (impl->type == GB_GL_CONTEXT_TYPE_OSMESA) gb_gl_context_exit_osmesa(impl);
+        else gb_gl_context_exit_egl(impl);
+    }
+
+    // exit it
+    tb_free(impl);
+}
+tb_size_t gb_gl_context_type(gb_gl_context_ref_t context)
+{
+    // check
+    gb_gl_context_impl_t* impl = (gb_gl_context_impl_t*)context;
+    tb_assert_and_check_return_val(impl, GB_GL_CONTEXT_TYPE_NONE);
+
+    // the type
+    return impl->type;
+}
+tb_bool_t gb_gl_context_make_current(gb_gl_context_ref_t context)
+{
+    // check
+    gb_gl_context_impl_t* impl = (gb_gl_context_impl_t*)context;
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    switch (impl->type)
+    {
+    case GB_GL_CONTEXT_TYPE_EGL:
+        ok = impl->eglMakeCurrent(impl->display, impl->surface, impl->surface, impl->context)? tb_true : tb_false;
+        break;
+    case GB_GL_CONTEXT_TYPE_OSMESA:
+        ok = impl->OSMesaMakeCurrent(impl->osmesa, &impl->buffer, GB_OSMESA_UNSIGNED_BYTE, 1, 1)? tb_true : tb_false;
+        break;
+    default:
+        break;
+    }
+
+    // ok?
+    return ok;
+}
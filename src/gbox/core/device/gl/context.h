@@ -0,0 +1,98 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        context.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_CONTEXT_H
+#define GB_CORE_DEVICE_GL_CONTEXT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl context type enum
+typedef enum __gb_gl_context_type_e
+{
+    GB_GL_CONTEXT_TYPE_NONE         = 0
+,   GB_GL_CONTEXT_TYPE_EGL          = 1     //!< the egl surfaceless or pbuffer context
+,   GB_GL_CONTEXT_TYPE_OSMESA       = 2     //!< the osmesa context
+
+}gb_gl_context_type_e;
+
+/*! the gl context ref type
+ *
+ * the headless gl context without any window for rendering to the framebuffer objects,
+ * the libEGL and libOSMesa are loaded dynamically, so it will fail only at runtime if they do not exist.
+ *
+ * the egl surfaceless context is tried first, .e.g the mesa surfaceless platform, 
+ * and the 1x1 pbuffer surface will be used if the surfaceless context is not supported.
+ * the osmesa context is the fallback for the software rasterizer.
+ */
+typedef struct{}*               gb_gl_context_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the headless context and make it current
+ *
+ * @return                      the context
+ */
+gb_gl_context_ref_t             gb_gl_context_init(tb_noarg_t);
+
+/* exit the context and release it from the current thread
+ *
+ * @param context               the context
+ */
+tb_void_t                       gb_gl_context_exit(gb_gl_context_ref_t context);
+
+/* the context type
+ *
+ * @param context               the context
+ *
+ * @return                      the type
+ */
+tb_size_t                       gb_gl_context_type(gb_gl_context_ref_t context);
+
+/* make the context current for the calling thread
+ *
+ * @param context               the context
+ *
+ * @return                      tb_true or tb_false
+ */
+tb_bool_t                       gb_gl_context_make_current(gb_gl_context_ref_t context);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
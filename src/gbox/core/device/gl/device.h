@@ -29,7 +29,15 @@
 #include "interface.h"
 #include "program.h"
 #include "matrix.h"
+#include "batch.h"
+#include "path_cache.h"
+#include "texture_cache.h"
+#include "context.h"
+#include "offscreen.h"
+#include "fringe.h"
+#include "stroker.h"
 #include "../../impl/stroker.h"
+#include "../../impl/triangle_strip.h"
 #include "../../../utils/tessellator.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -42,14 +50,26 @@ typedef struct __gb_gl_device_t
     // the base
     gb_device_impl_t            base;
 
-    // the window
+    // the window, null: the offscreen device
     gb_window_ref_t             window;
 
+    // the headless context for the offscreen device
+    gb_gl_context_ref_t         context;
+
+    // the shadow state of the gl context
+    gb_gl_interface_shadow_ref_t shadow;
+
+    // the offscreen target for the offscreen device
+    gb_gl_offscreen_ref_t       offscreen;
+
     // the version: 1.0, 2.x, ...
     tb_size_t                   version;
 
+    // the stencil bits of the framebuffer, 0: no stencil buffer
+    tb_size_t                   stencil_bits;
+
     // the programs
-    gb_gl_program_ref_t         programs[GB_GL_PROGRAM_LOCATION_MAXN];
+    gb_gl_program_ref_t         programs[GB_GL_PROGRAM_TYPE_MAXN];
 
 	// the projection matrix for gl >= 2.0
 	gb_gl_matrix_t              matrix_project;
@@ -63,12 +83,51 @@ typedef struct __gb_gl_device_t
     // the stroker
     gb_stroker_ref_t            stroker;
 
+    // the stroker for making the triangle strip of the wide stroke directly
+    gb_gl_stroker_ref_t         strip_stroker;
+
     // the program
     gb_gl_program_ref_t         program;
 
+    // the bound program of the gl context
+    gb_gl_program_ref_t         program_bound;
+
+    // the solid color of the current paint, it is the white color with the paint alpha for the batched bitmap
+    gb_color_t                  color;
+
+    // the batch for gl >= 2.0
+    gb_gl_batch_ref_t           batch;
+
+    // the bitmap of the current drawing is batched with the per-vertex texcoords?
+    tb_bool_t                   batch_texture;
+
+    // the path cache for gl >= 2.0
+    gb_gl_path_cache_ref_t      cache;
+
+    // the bitmap texture cache for gl >= 2.0
+    gb_gl_texture_cache_ref_t   textures;
+
+    // the fringe for the analytic antialiasing without the multisample buffer, gl >= 2.0
+    gb_gl_fringe_ref_t          fringe;
+
+    // the inverse of the bound matrix for making the fringe, be valid if fringe_ok is tb_true
+    gb_matrix_t                 fringe_inverse;
+
+    // the fringe is enabled for the current drawing?
+    tb_bool_t                   fringe_ok;
+
+    // the scissor box of the clipped rect in the framebuffer: x, y, width and height 
+    gb_GLint_t                  scissor[4];
+
+    // the scissor test is enabled?
+    tb_bool_t                   scissor_ok;
+
     // the tessellator
     gb_tessellator_ref_t        tessellator;
 
+    // the triangle strip for filling the monotone polygons
+    gb_triangle_strip_ref_t     strip;
+
 }gb_gl_device_t, *gb_gl_device_ref_t;
 
 #endif
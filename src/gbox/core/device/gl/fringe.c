@@ -0,0 +1,371 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        fringe.c
+ * @ingroup     core
+ */
+
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_fringe"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "fringe.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the half width of the fringe in pixels
+#define GB_GL_FRINGE_HALF_WIDTH         (0.5f)
+
+// the maximum scale of the miter offset at the sharp corners
+#define GB_GL_FRINGE_MITER_MAXN         (4.0f)
+
+// the offset of the testing point for the outer side in pixels
+#define GB_GL_FRINGE_TEST_OFFSET        (0.25f)
+
+// the minimum squared length of the edge in pixels
+#define GB_GL_FRINGE_EDGE_MINN          (1e-6f)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the float point type in the device space
+typedef struct __gb_gl_fringe_point_t
+{
+    tb_float_t                  x;
+    tb_float_t                  y;
+
+}gb_gl_fringe_point_t, *gb_gl_fringe_point_ref_t;
+
+// the gl fringe impl type
+typedef struct __gb_gl_fringe_impl_t
+{
+    // the polygon points in the device space
+    gb_gl_fringe_point_ref_t    points;
+
+    // the points maxn
+    tb_size_t                   points_maxn;
+
+    // the contour points without the repeated points
+    gb_gl_fringe_point_ref_t    contour;
+
+    // the contour maxn
+    tb_size_t                   contour_maxn;
+
+    // the triangle strip of the fringe
+    gb_point_ref_t              strip;
+
+    // the strip maxn
+    tb_size_t                   strip_maxn;
+
+}gb_gl_fringe_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_gl_fringe_grow(gb_gl_fringe_impl_t* impl, tb_size_t count)
+{
+    // check
+    tb_assert_abort(impl);
+
+    // grow points
+    if (count > impl->points_maxn)
+    {
+        impl->points = tb_ralloc_type(impl->points, count, gb_gl_fringe_point_t);
+        tb_assert_and_check_return_val(impl->points, tb_false);
+        impl->points_maxn = count;
+    }
+
+    // grow contour
+    if (count > impl->contour_maxn)
+    {
+        impl->contour = tb_ralloc_type(impl->contour, count, gb_gl_fringe_point_t);
+        tb_assert_and_check_return_val(impl->contour, tb_false);
+        impl->contour_maxn = count;
+    }
+
+    // grow strip, two points for each contour point and the closed points
+    if ((count + 1) << 1 > impl->strip_maxn)
+    {
+        impl->strip = tb_ralloc_type(impl->strip, (count + 1) << 1, gb_point_t);
+        tb_assert_and_check_return_val(impl->strip, tb_false);
+        impl->strip_maxn = (count + 1) << 1;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_gl_fringe_inside(gb_gl_fringe_impl_t* impl, tb_uint16_t const* counts, tb_size_t rule, tb_float_t x, tb_float_t y)
+{
+    // check
+    tb_assert_abort(impl && counts);
+
+    // compute the winding number of the point
+    tb_long_t                   winding = 0;
+    tb_uint16_t                 count;
+    gb_gl_fringe_point_ref_t    points = impl->points;
+    while ((count = *counts++))
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            // the edge of the closed contour
+            gb_gl_fringe_point_ref_t a = points + i;
+            gb_gl_fringe_point_ref_t b = points + (i + 1 < count? i + 1 : 0);
+
+            // the side of the point: > 0: left, < 0: right
+            tb_float_t side = (b->x - a->x) * (y - a->y) - (x - a->x) * (b->y - a->y);
+
+            // the upward or downward crossing
+            if (a->y <= y && b->y > y && side > 0) winding++;
+            else if (b->y <= y && a->y > y && side < 0) winding--;
+        }
+        points += count;
+    }
+
+    // inside?
+    return (rule == GB_PAINT_FILL_RULE_ODD)? (winding & 1) : (winding != 0);
+}
+static tb_void_t gb_gl_fringe_normal(gb_gl_fringe_point_ref_t a, gb_gl_fringe_point_ref_t b, tb_float_t* nx, tb_float_t* ny)
+{
+    // the edge
+    tb_float_t dx = b->x - a->x;
+    tb_float_t dy = b->y - a->y;
+
+    // the unit normal of the edge
+    tb_float_t d = tb_sqrtf(dx * dx + dy * dy);
+    if (d > 0)
+    {
+        *nx = dy / d;
+        *ny = -dx / d;
+    }
+    else
+    {
+        *nx = 0;
+        *ny = 0;
+    }
+}
+static tb_void_t gb_gl_fringe_done_contour(gb_gl_fringe_impl_t* impl, gb_gl_batch_ref_t batch, tb_uint16_t const* counts, tb_size_t rule, tb_size_t count, gb_matrix_ref_t inverse, gb_color_t color)
+{
+    // check
+    tb_assert_abort(impl && impl->contour && impl->strip && count >= 3);
+
+    // find the longest edge
+    tb_size_t                   i = 0;
+    tb_size_t                   longest = 0;
+    tb_float_t                  longest_d2 = 0;
+    gb_gl_fringe_point_ref_t    contour = impl->contour;
+    for (i = 0; i < count; i++)
+    {
+        gb_gl_fringe_point_ref_t    a = contour + i;
+        gb_gl_fringe_point_ref_t    b = contour + (i + 1 < count? i + 1 : 0);
+        tb_float_t                  d2 = (b->x - a->x) * (b->x - a->x) + (b->y - a->y) * (b->y - a->y);
+        if (d2 > longest_d2)
+        {
+            longest     = i;
+            longest_d2  = d2;
+        }
+    }
+
+    // the outer side: 1: the normal side, -1: the opposite side
+    tb_float_t nx;
+    tb_float_t ny;
+    gb_gl_fringe_point_ref_t a = contour + longest;
+    gb_gl_fringe_point_ref_t b = contour + (longest + 1 < count? longest + 1 : 0);
+    gb_gl_fringe_normal(a, b, &nx, &ny);
+    tb_float_t x    = (a->x + b->x) * 0.5f + nx * GB_GL_FRINGE_TEST_OFFSET;
+    tb_float_t y    = (a->y + b->y) * 0.5f + ny * GB_GL_FRINGE_TEST_OFFSET;
+    tb_float_t side = gb_gl_fringe_inside(impl, counts, rule, x, y)? -GB_GL_FRINGE_HALF_WIDTH : GB_GL_FRINGE_HALF_WIDTH;
+
+    // the inverse matrix
+    tb_float_t sx = gb_float_to_tb(inverse->sx);
+    tb_float_t kx = gb_float_to_tb(inverse->kx);
+    tb_float_t tx = gb_float_to_tb(inverse->tx);
+    tb_float_t ky = gb_float_to_tb(inverse->ky);
+    tb_float_t sy = gb_float_to_tb(inverse->sy);
+    tb_float_t ty = gb_float_to_tb(inverse->ty);
+
+    // make the triangle strip: inner0, outer0, inner1, outer1, ..., inner0, outer0
+    tb_float_t      nx0;
+    tb_float_t      ny0;
+    tb_float_t      nx1;
+    tb_float_t      ny1;
+    gb_point_ref_t  strip = impl->strip;
+    gb_gl_fringe_normal(contour + count - 1, contour, &nx0, &ny0);
+    for (i = 0; i <= count; i++)
+    {
+        // the current and next points
+        gb_gl_fringe_point_ref_t p = contour + (i < count? i : 0);
+        gb_gl_fringe_point_ref_t q = contour + (i + 1 < count? i + 1 : (i + 1 - count));
+
+        // the normal of the next edge
+        gb_gl_fringe_normal(p, q, &nx1, &ny1);
+
+        // the miter offset of the corner
+        tb_float_t dx = (nx0 + nx1) * 0.5f;
+        tb_float_t dy = (ny0 + ny1) * 0.5f;
+        tb_float_t d2 = dx * dx + dy * dy;
+        if (d2 > GB_GL_FRINGE_EDGE_MINN)
+        {
+            tb_float_t scale = 1.0f / d2;
+            if (scale > GB_GL_FRINGE_MITER_MAXN) scale = GB_GL_FRINGE_MITER_MAXN;
+            dx *= scale;
+            dy *= scale;
+        }
+        else
+        {
+            dx = nx1;
+            dy = ny1;
+        }
+        dx *= side;
+        dy *= side;
+
+        // the inner and outer points in the device space
+        tb_float_t ix = p->x - dx;
+        tb_float_t iy = p->y - dy;
+        tb_float_t ox = p->x + dx;
+        tb_float_t oy = p->y + dy;
+
+        // map them to the batched vertices
+        strip[0].x = tb_float_to_gb(ix * sx + iy * kx + tx);
+        strip[0].y = tb_float_to_gb(ix * ky + iy * sy + ty);
+        strip[1].x = tb_float_to_gb(ox * sx + oy * kx + tx);
+        strip[1].y = tb_float_to_gb(ox * ky + oy * sy + ty);
+        strip += 2;
+
+        // the next corner
+        nx0 = nx1;
+        ny0 = ny1;
+    }
+
+    // add it to the batch
+    gb_gl_batch_add_fringe(batch, impl->strip, (count + 1) << 1, color);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_fringe_ref_t gb_gl_fringe_init()
+{
+    // make fringe
+    return (gb_gl_fringe_ref_t)tb_malloc0_type(gb_gl_fringe_impl_t);
+}
+tb_void_t gb_gl_fringe_exit(gb_gl_fringe_ref_t fringe)
+{
+    // check
+    gb_gl_fringe_impl_t* impl = (gb_gl_fringe_impl_t*)fringe;
+    tb_assert_and_check_return(impl);
+
+    // exit points
+    if (impl->points) tb_free(impl->points);
+    impl->points = tb_null;
+
+    // exit contour
+    if (impl->contour) tb_free(impl->contour);
+    impl->contour = tb_null;
+
+    // exit strip
+    if (impl->strip) tb_free(impl->strip);
+    impl->strip = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_gl_fringe_done(gb_gl_fringe_ref_t fringe, gb_gl_batch_ref_t batch, gb_polygon_ref_t polygon, tb_size_t rule, gb_matrix_ref_t matrix, gb_matrix_ref_t inverse, gb_color_t color)
+{
+    // check
+    gb_gl_fringe_impl_t* impl = (gb_gl_fringe_impl_t*)fringe;
+    tb_assert_and_check_return(impl && batch && polygon && polygon->points && polygon->counts && matrix && inverse);
+
+    // transparent?
+    tb_check_return(color.a);
+
+    // count the points
+    tb_uint16_t         count;
+    tb_uint16_t const*  counts = polygon->counts;
+    tb_size_t           total = 0;
+    while ((count = *counts++)) total += count;
+    tb_check_return(total >= 3);
+
+    // grow buffers
+    if (!gb_gl_fringe_grow(impl, total)) return ;
+
+    // the matrix
+    tb_float_t sx = gb_float_to_tb(matrix->sx);
+    tb_float_t kx = gb_float_to_tb(matrix->kx);
+    tb_float_t tx = gb_float_to_tb(matrix->tx);
+    tb_float_t ky = gb_float_to_tb(matrix->ky);
+    tb_float_t sy = gb_float_to_tb(matrix->sy);
+    tb_float_t ty = gb_float_to_tb(matrix->ty);
+
+    // transform the points to the device space
+    tb_size_t i = 0;
+    for (i = 0; i < total; i++)
+    {
+        tb_float_t x = gb_float_to_tb(polygon->points[i].x);
+        tb_float_t y = gb_float_to_tb(polygon->points[i].y);
+        impl->points[i].x = x * sx + y * kx + tx;
+        impl->points[i].y = x * ky + y * sy + ty;
+    }
+
+    // done the contours
+    tb_size_t                   index = 0;
+    gb_gl_fringe_point_ref_t    points = impl->points;
+    counts = polygon->counts;
+    while ((count = *counts++))
+    {
+        // remove the repeated points
+        tb_size_t                   n = 0;
+        gb_gl_fringe_point_ref_t    contour = impl->contour;
+        for (i = 0; i < count; i++)
+        {
+            gb_gl_fringe_point_ref_t p = points + index + i;
+            if (n)
+            {
+                tb_float_t dx = p->x - contour[n - 1].x;
+                tb_float_t dy = p->y - contour[n - 1].y;
+                if (dx * dx + dy * dy <= GB_GL_FRINGE_EDGE_MINN) continue;
+            }
+            contour[n++] = *p;
+        }
+
+        // the contour is closed? remove the repeated last point
+        while (n > 1)
+        {
+            tb_float_t dx = contour[n - 1].x - contour[0].x;
+            tb_float_t dy = contour[n - 1].y - contour[0].y;
+            if (dx * dx + dy * dy > GB_GL_FRINGE_EDGE_MINN) break;
+            n--;
+        }
+
+        // done the fringe of this contour
+        if (n >= 3) gb_gl_fringe_done_contour(impl, batch, polygon->counts, rule, n, inverse, color);
+
+        // the next contour
+        index += count;
+    }
+}
@@ -0,0 +1,88 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        fringe.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_FRINGE_H
+#define GB_CORE_DEVICE_GL_FRINGE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "batch.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the gl fringe ref type
+ *
+ * the analytic antialiasing without the multisample buffer.
+ *
+ * the one pixel fringe is extruded along the edges of the filled polygon in the device space, 
+ * it straddles the edge and the coverage fades from the paint alpha on the inner side to zero on the outer side, 
+ * so the edges are smoothed at about 1x fill cost by the per-vertex colors of the batch.
+ *
+ * the outer side of each contour is found by testing the winding number of a point near its longest edge,
+ * so the self-intersecting contours may be smoothed on the wrong side partly.
+ */
+typedef struct{}*               gb_gl_fringe_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init fringe
+ *
+ * @return                      the fringe
+ */
+gb_gl_fringe_ref_t              gb_gl_fringe_init(tb_noarg_t);
+
+/* exit fringe
+ *
+ * @param fringe                the fringe
+ */
+tb_void_t                       gb_gl_fringe_exit(gb_gl_fringe_ref_t fringe);
+
+/* add the fringe of the filled polygon to the batch
+ *
+ * @param fringe                the fringe
+ * @param batch                 the batch
+ * @param polygon               the polygon
+ * @param rule                  the fill rule
+ * @param matrix                the matrix from the polygon to the device space
+ * @param inverse               the matrix from the device space to the batched vertices
+ * @param color                 the color
+ */
+tb_void_t                       gb_gl_fringe_done(gb_gl_fringe_ref_t fringe, gb_gl_batch_ref_t batch, gb_polygon_ref_t polygon, tb_size_t rule, gb_matrix_ref_t matrix, gb_matrix_ref_t inverse, gb_color_t color);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -40,6 +40,108 @@
 // define func
 #define GB_GL_INTERFACE_DEFINE(func)            gb_##func##_t gb_##func = tb_null
 
+// hook the loaded func by the shadow func
+#define GB_GL_INTERFACE_HOOK(func)              do { g_funcs.func = gb_##func; if (g_funcs.func) gb_##func = gb_gl_shadow_##func; } while (0)
+
+// the unknown state of the shadow
+#define GB_GL_SHADOW_UNKNOWN                    ((gb_GLuint_t)-1)
+
+// the maximum count of the tracked texture units
+#define GB_GL_SHADOW_TEXTURE_MAXN               (8)
+
+// the maximum count of the tracked vertex attributes
+#define GB_GL_SHADOW_ATTRIB_MAXN                (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the tracked capability enum
+typedef enum __gb_gl_shadow_cap_e
+{
+    GB_GL_SHADOW_CAP_BLEND          = 0
+,   GB_GL_SHADOW_CAP_TEXTURE_2D     = 1
+,   GB_GL_SHADOW_CAP_STENCIL_TEST   = 2
+,   GB_GL_SHADOW_CAP_SCISSOR_TEST   = 3
+,   GB_GL_SHADOW_CAP_MULTISAMPLE    = 4
+,   GB_GL_SHADOW_CAP_MAXN           = 5
+
+}gb_gl_shadow_cap_e;
+
+// the real functions of the hooked state functions
+typedef struct __gb_gl_shadow_funcs_t
+{
+    gb_glActiveTexture_t            glActiveTexture;
+    gb_glBindBuffer_t               glBindBuffer;
+    gb_glBindTexture_t              glBindTexture;
+    gb_glBlendFunc_t                glBlendFunc;
+    gb_glDeleteBuffers_t            glDeleteBuffers;
+    gb_glDeleteProgram_t            glDeleteProgram;
+    gb_glDeleteTextures_t           glDeleteTextures;
+    gb_glDisable_t                  glDisable;
+    gb_glDisableVertexAttribArray_t glDisableVertexAttribArray;
+    gb_glDrawArrays_t               glDrawArrays;
+    gb_glEnable_t                   glEnable;
+    gb_glEnableVertexAttribArray_t  glEnableVertexAttribArray;
+    gb_glUseProgram_t               glUseProgram;
+    gb_glVertexAttrib4f_t           glVertexAttrib4f;
+
+}gb_gl_shadow_funcs_t;
+
+// the gl shadow state type of the gl context
+typedef struct __gb_gl_shadow_t
+{
+    // the capabilities, 0: unknown, 1: enabled, 2: disabled
+    tb_uint8_t                      caps[GB_GL_SHADOW_CAP_MAXN];
+
+    // the blend factors
+    gb_GLenum_t                     blend_sfactor;
+    gb_GLenum_t                     blend_dfactor;
+
+    // the used program
+    gb_GLuint_t                     program;
+
+    // the active texture unit
+    gb_GLuint_t                     texture_unit;
+
+    // the bound 2d textures of the texture units
+    gb_GLuint_t                     textures[GB_GL_SHADOW_TEXTURE_MAXN];
+
+    // the bound array buffer
+    gb_GLuint_t                     array_buffer;
+
+    // the known and enabled flags of the vertex attribute arrays
+    tb_uint32_t                     attribs_known;
+    tb_uint32_t                     attribs_enabled;
+
+    // the valid flags and values of the constant vertex attributes
+    tb_uint32_t                     attribs_valid;
+    gb_GLfloat_t                    attribs[GB_GL_SHADOW_ATTRIB_MAXN][4];
+
+    // the stats
+    gb_gl_interface_stats_t         stats;
+
+}gb_gl_shadow_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the real functions, be loaded only once for the process
+static gb_gl_shadow_funcs_t         g_funcs;
+
+// the loaded flag and lock of the gl interfaces
+static tb_bool_t                    g_loaded = tb_false;
+static tb_spinlock_t                g_lock = TB_SPINLOCK_INIT;
+
+#ifdef __gb_thread_local__
+// the shadow state of the current gl context of the current thread, null: no shadow state
+static __gb_thread_local__ gb_gl_shadow_t*  g_shadow = tb_null;
+#else
+// the shadow state of the current gl context, the compiler has not the thread-local storage
+static gb_gl_shadow_t*              g_shadow = tb_null;
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * functions
  */
@@ -47,8 +149,14 @@
 GB_GL_INTERFACE_DEFINE(glActiveTexture);
 GB_GL_INTERFACE_DEFINE(glAlphaFunc);
 GB_GL_INTERFACE_DEFINE(glAttachShader);
+GB_GL_INTERFACE_DEFINE(glBindBuffer);
+GB_GL_INTERFACE_DEFINE(glBindFramebuffer);
+GB_GL_INTERFACE_DEFINE(glBindRenderbuffer);
 GB_GL_INTERFACE_DEFINE(glBindTexture);
 GB_GL_INTERFACE_DEFINE(glBlendFunc);
+GB_GL_INTERFACE_DEFINE(glBufferData);
+GB_GL_INTERFACE_DEFINE(glBufferSubData);
+GB_GL_INTERFACE_DEFINE(glCheckFramebufferStatus);
 GB_GL_INTERFACE_DEFINE(glClear);
 GB_GL_INTERFACE_DEFINE(glClearColor);
 GB_GL_INTERFACE_DEFINE(glClearStencil);
@@ -58,7 +166,10 @@ GB_GL_INTERFACE_DEFINE(glColorPointer);
 GB_GL_INTERFACE_DEFINE(glCompileShader);
 GB_GL_INTERFACE_DEFINE(glCreateProgram);
 GB_GL_INTERFACE_DEFINE(glCreateShader);
+GB_GL_INTERFACE_DEFINE(glDeleteBuffers);
+GB_GL_INTERFACE_DEFINE(glDeleteFramebuffers);
 GB_GL_INTERFACE_DEFINE(glDeleteProgram);
+GB_GL_INTERFACE_DEFINE(glDeleteRenderbuffers);
 GB_GL_INTERFACE_DEFINE(glDeleteShader);
 GB_GL_INTERFACE_DEFINE(glDeleteTextures);
 GB_GL_INTERFACE_DEFINE(glDisable);
@@ -68,8 +179,13 @@ GB_GL_INTERFACE_DEFINE(glDrawArrays);
 GB_GL_INTERFACE_DEFINE(glEnable);
 GB_GL_INTERFACE_DEFINE(glEnableClientState);
 GB_GL_INTERFACE_DEFINE(glEnableVertexAttribArray);
+GB_GL_INTERFACE_DEFINE(glFramebufferRenderbuffer);
+GB_GL_INTERFACE_DEFINE(glGenBuffers);
+GB_GL_INTERFACE_DEFINE(glGenFramebuffers);
+GB_GL_INTERFACE_DEFINE(glGenRenderbuffers);
 GB_GL_INTERFACE_DEFINE(glGenTextures);
 GB_GL_INTERFACE_DEFINE(glGetAttribLocation);
+GB_GL_INTERFACE_DEFINE(glGetIntegerv);
 GB_GL_INTERFACE_DEFINE(glGetProgramiv);
 GB_GL_INTERFACE_DEFINE(glGetProgramInfoLog);
 GB_GL_INTERFACE_DEFINE(glGetShaderiv);
@@ -82,6 +198,7 @@ GB_GL_INTERFACE_DEFINE(glLineWidth);
 GB_GL_INTERFACE_DEFINE(glLinkProgram);
 GB_GL_INTERFACE_DEFINE(glLoadIdentity);
 GB_GL_INTERFACE_DEFINE(glLoadMatrixf);
+GB_GL_INTERFACE_DEFINE(glMapBuffer);
 GB_GL_INTERFACE_DEFINE(glMatrixMode);
 GB_GL_INTERFACE_DEFINE(glMultMatrixf);
 GB_GL_INTERFACE_DEFINE(glOrtho);
@@ -89,6 +206,8 @@ GB_GL_INTERFACE_DEFINE(glOrthof);
 GB_GL_INTERFACE_DEFINE(glPixelStorei);
 GB_GL_INTERFACE_DEFINE(glPopMatrix);
 GB_GL_INTERFACE_DEFINE(glPushMatrix);
+GB_GL_INTERFACE_DEFINE(glReadPixels);
+GB_GL_INTERFACE_DEFINE(glRenderbufferStorage);
 GB_GL_INTERFACE_DEFINE(glRotatef);
 GB_GL_INTERFACE_DEFINE(glScalef);
 GB_GL_INTERFACE_DEFINE(glScissor);
@@ -96,14 +215,18 @@ GB_GL_INTERFACE_DEFINE(glShaderSource);
 GB_GL_INTERFACE_DEFINE(glStencilFunc);
 GB_GL_INTERFACE_DEFINE(glStencilMask);
 GB_GL_INTERFACE_DEFINE(glStencilOp);
+GB_GL_INTERFACE_DEFINE(glStencilOpSeparate);
 GB_GL_INTERFACE_DEFINE(glTexCoordPointer);
 GB_GL_INTERFACE_DEFINE(glTexEnvi);
 GB_GL_INTERFACE_DEFINE(glTexImage2D);
 GB_GL_INTERFACE_DEFINE(glTexParameterf);
 GB_GL_INTERFACE_DEFINE(glTexParameteri);
+GB_GL_INTERFACE_DEFINE(glTexSubImage2D);
 GB_GL_INTERFACE_DEFINE(glTranslatef);
 GB_GL_INTERFACE_DEFINE(glUniform1i);
+GB_GL_INTERFACE_DEFINE(glUniform4f);
 GB_GL_INTERFACE_DEFINE(glUniformMatrix4fv);
+GB_GL_INTERFACE_DEFINE(glUnmapBuffer);
 GB_GL_INTERFACE_DEFINE(glUseProgram);
 GB_GL_INTERFACE_DEFINE(glVertexAttrib4f);
 GB_GL_INTERFACE_DEFINE(glVertexAttribPointer);
@@ -118,15 +241,393 @@ static gb_GLvoid_t GB_GL_APICALL gb_gl_interface_glOrthof(gb_GLfloat_t left, gb_
     gb_glOrtho(left, right, bottom, top, nearp, farp);
 }
 
+static __tb_inline__ tb_long_t gb_gl_shadow_cap(gb_GLenum_t cap)
+{
+    // the tracked capability index
+    switch (cap)
+    {
+    case GB_GL_BLEND:           return GB_GL_SHADOW_CAP_BLEND;
+    case GB_GL_TEXTURE_2D:      return GB_GL_SHADOW_CAP_TEXTURE_2D;
+    case GB_GL_STENCIL_TEST:    return GB_GL_SHADOW_CAP_STENCIL_TEST;
+    case GB_GL_SCISSOR_TEST:    return GB_GL_SHADOW_CAP_SCISSOR_TEST;
+    case GB_GL_MULTISAMPLE:     return GB_GL_SHADOW_CAP_MULTISAMPLE;
+    default:                    break;
+    }
+
+    // not tracked
+    return -1;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glEnable(gb_GLenum_t cap)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glEnable(cap);
+        return ;
+    }
+
+    // redundant?
+    tb_long_t index = gb_gl_shadow_cap(cap);
+    if (index >= 0 && shadow->caps[index] == 1)
+    {
+        shadow->stats.skipped++;
+        return ;
+    }
+
+    // enable it
+    g_funcs.glEnable(cap);
+    if (index >= 0) shadow->caps[index] = 1;
+    shadow->stats.calls++;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glDisable(gb_GLenum_t cap)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glDisable(cap);
+        return ;
+    }
+
+    // redundant?
+    tb_long_t index = gb_gl_shadow_cap(cap);
+    if (index >= 0 && shadow->caps[index] == 2)
+    {
+        shadow->stats.skipped++;
+        return ;
+    }
+
+    // disable it
+    g_funcs.glDisable(cap);
+    if (index >= 0) shadow->caps[index] = 2;
+    shadow->stats.calls++;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glBlendFunc(gb_GLenum_t sfactor, gb_GLenum_t dfactor)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glBlendFunc(sfactor, dfactor);
+        return ;
+    }
+
+    // redundant?
+    if (shadow->blend_sfactor == sfactor && shadow->blend_dfactor == dfactor)
+    {
+        shadow->stats.skipped++;
+        return ;
+    }
+
+    // apply it
+    g_funcs.glBlendFunc(sfactor, dfactor);
+    shadow->blend_sfactor = sfactor;
+    shadow->blend_dfactor = dfactor;
+    shadow->stats.calls++;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glUseProgram(gb_GLuint_t program)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glUseProgram(program);
+        return ;
+    }
+
+    // redundant?
+    if (shadow->program == program)
+    {
+        shadow->stats.skipped++;
+        return ;
+    }
+
+    // use it
+    g_funcs.glUseProgram(program);
+    shadow->program = program;
+    shadow->stats.calls++;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glDeleteProgram(gb_GLuint_t program)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glDeleteProgram(program);
+        return ;
+    }
+
+    // the used program is deleted? forget it
+    if (shadow->program == program) shadow->program = GB_GL_SHADOW_UNKNOWN;
+
+    // delete it
+    g_funcs.glDeleteProgram(program);
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glActiveTexture(gb_GLenum_t texture)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glActiveTexture(texture);
+        return ;
+    }
+
+    // redundant?
+    if (shadow->texture_unit == texture)
+    {
+        shadow->stats.skipped++;
+        return ;
+    }
+
+    // active it
+    g_funcs.glActiveTexture(texture);
+    shadow->texture_unit = texture;
+    shadow->stats.calls++;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glBindTexture(gb_GLenum_t target, gb_GLuint_t texture)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glBindTexture(target, texture);
+        return ;
+    }
+
+    // the texture unit index, only the first unit is used if no glActiveTexture
+    tb_size_t unit = 0;
+    if (g_funcs.glActiveTexture) unit = shadow->texture_unit != GB_GL_SHADOW_UNKNOWN? shadow->texture_unit - GB_GL_TEXTURE0 : GB_GL_SHADOW_TEXTURE_MAXN;
+
+    // redundant?
+    tb_bool_t tracked = (target == GB_GL_TEXTURE_2D && unit < GB_GL_SHADOW_TEXTURE_MAXN)? tb_true : tb_false;
+    if (tracked && shadow->textures[unit] == texture)
+    {
+        shadow->stats.skipped++;
+        return ;
+    }
+
+    // bind it
+    g_funcs.glBindTexture(target, texture);
+    if (tracked) shadow->textures[unit] = texture;
+    shadow->stats.calls++;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glDeleteTextures(gb_GLsizei_t n, gb_GLuint_t const* textures)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glDeleteTextures(n, textures);
+        return ;
+    }
+
+    // the bound textures are deleted? forget them
+    gb_GLsizei_t i = 0;
+    tb_size_t    j = 0;
+    for (i = 0; i < n && textures; i++)
+    {
+        for (j = 0; j < GB_GL_SHADOW_TEXTURE_MAXN; j++)
+            if (shadow->textures[j] == textures[i]) shadow->textures[j] = GB_GL_SHADOW_UNKNOWN;
+    }
+
+    // delete them
+    g_funcs.glDeleteTextures(n, textures);
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glBindBuffer(gb_GLenum_t target, gb_GLuint_t buffer)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glBindBuffer(target, buffer);
+        return ;
+    }
+
+    // redundant?
+    if (target == GB_GL_ARRAY_BUFFER && shadow->array_buffer == buffer)
+    {
+        shadow->stats.skipped++;
+        return ;
+    }
+
+    // bind it
+    g_funcs.glBindBuffer(target, buffer);
+    if (target == GB_GL_ARRAY_BUFFER) shadow->array_buffer = buffer;
+    shadow->stats.calls++;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glDeleteBuffers(gb_GLsizei_t n, gb_GLuint_t const* buffers)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glDeleteBuffers(n, buffers);
+        return ;
+    }
+
+    // the bound buffer is deleted? forget it
+    gb_GLsizei_t i = 0;
+    for (i = 0; i < n && buffers; i++)
+        if (shadow->array_buffer == buffers[i]) shadow->array_buffer = GB_GL_SHADOW_UNKNOWN;
+
+    // delete them
+    g_funcs.glDeleteBuffers(n, buffers);
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glEnableVertexAttribArray(gb_GLuint_t index)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glEnableVertexAttribArray(index);
+        return ;
+    }
+
+    // redundant?
+    tb_uint32_t flag = index < GB_GL_SHADOW_ATTRIB_MAXN? (1 << index) : 0;
+    if (flag && (shadow->attribs_known & flag) && (shadow->attribs_enabled & flag))
+    {
+        shadow->stats.skipped++;
+        return ;
+    }
+
+    // enable it
+    g_funcs.glEnableVertexAttribArray(index);
+    shadow->attribs_known      |= flag;
+    shadow->attribs_enabled    |= flag;
+    shadow->stats.calls++;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glDisableVertexAttribArray(gb_GLuint_t index)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glDisableVertexAttribArray(index);
+        return ;
+    }
+
+    // redundant?
+    tb_uint32_t flag = index < GB_GL_SHADOW_ATTRIB_MAXN? (1 << index) : 0;
+    if (flag && (shadow->attribs_known & flag) && !(shadow->attribs_enabled & flag))
+    {
+        shadow->stats.skipped++;
+        return ;
+    }
+
+    // disable it
+    g_funcs.glDisableVertexAttribArray(index);
+    shadow->attribs_known      |= flag;
+    shadow->attribs_enabled    &= ~flag;
+    shadow->stats.calls++;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glVertexAttrib4f(gb_GLuint_t index, gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z, gb_GLfloat_t w)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glVertexAttrib4f(index, x, y, z, w);
+        return ;
+    }
+
+    // redundant? the constant value is kept even if the attribute array is enabled
+    tb_uint32_t     flag = index < GB_GL_SHADOW_ATTRIB_MAXN? (1 << index) : 0;
+    gb_GLfloat_t*   attrib = flag? shadow->attribs[index] : tb_null;
+    if (attrib && (shadow->attribs_valid & flag) && attrib[0] == x && attrib[1] == y && attrib[2] == z && attrib[3] == w)
+    {
+        shadow->stats.skipped++;
+        return ;
+    }
+
+    // apply it
+    g_funcs.glVertexAttrib4f(index, x, y, z, w);
+    if (attrib)
+    {
+        attrib[0] = x;
+        attrib[1] = y;
+        attrib[2] = z;
+        attrib[3] = w;
+        shadow->attribs_valid |= flag;
+    }
+    shadow->stats.calls++;
+}
+static gb_GLvoid_t GB_GL_APICALL gb_gl_shadow_glDrawArrays(gb_GLenum_t mode, gb_GLint_t first, gb_GLsizei_t count)
+{
+    // no shadow state? call it directly
+    gb_gl_shadow_t* shadow = g_shadow;
+    if (!shadow)
+    {
+        g_funcs.glDrawArrays(mode, first, count);
+        return ;
+    }
+
+    // draw it
+    g_funcs.glDrawArrays(mode, first, count);
+    shadow->stats.draws++;
+}
+static tb_void_t gb_gl_shadow_reset(gb_gl_shadow_t* shadow)
+{
+    // check
+    tb_assert_and_check_return(shadow);
+
+    // reset the capabilities
+    tb_memset(shadow->caps, 0, sizeof(shadow->caps));
+
+    // reset the bound objects
+    tb_size_t i = 0;
+    shadow->blend_sfactor   = GB_GL_SHADOW_UNKNOWN;
+    shadow->blend_dfactor   = GB_GL_SHADOW_UNKNOWN;
+    shadow->program         = GB_GL_SHADOW_UNKNOWN;
+    shadow->texture_unit    = GB_GL_SHADOW_UNKNOWN;
+    shadow->array_buffer    = GB_GL_SHADOW_UNKNOWN;
+    for (i = 0; i < GB_GL_SHADOW_TEXTURE_MAXN; i++) shadow->textures[i] = GB_GL_SHADOW_UNKNOWN;
+
+    // reset the vertex attributes
+    shadow->attribs_known   = 0;
+    shadow->attribs_enabled = 0;
+    shadow->attribs_valid   = 0;
+}
+static tb_void_t gb_gl_shadow_hook()
+{
+    // hook the state functions
+    GB_GL_INTERFACE_HOOK(glActiveTexture);
+    GB_GL_INTERFACE_HOOK(glBindBuffer);
+    GB_GL_INTERFACE_HOOK(glBindTexture);
+    GB_GL_INTERFACE_HOOK(glBlendFunc);
+    GB_GL_INTERFACE_HOOK(glDeleteBuffers);
+    GB_GL_INTERFACE_HOOK(glDeleteProgram);
+    GB_GL_INTERFACE_HOOK(glDeleteTextures);
+    GB_GL_INTERFACE_HOOK(glDisable);
+    GB_GL_INTERFACE_HOOK(glDisableVertexAttribArray);
+    GB_GL_INTERFACE_HOOK(glDrawArrays);
+    GB_GL_INTERFACE_HOOK(glEnable);
+    GB_GL_INTERFACE_HOOK(glEnableVertexAttribArray);
+    GB_GL_INTERFACE_HOOK(glUseProgram);
+    GB_GL_INTERFACE_HOOK(glVertexAttrib4f);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 tb_bool_t gb_gl_interface_load()
 {
+    // enter
+    tb_spinlock_enter(&g_lock);
+
     // done
     tb_bool_t ok = tb_false;
     do
     {
+        // loaded? the gl interfaces are shared by all gl contexts of the process
+        if (g_loaded)
+        {
+            ok = tb_true;
+            break;
+        }
+
 #ifdef TB_CONFIG_OS_ANDROID
 
         // load v2 library first
@@ -147,9 +648,11 @@ tb_bool_t gb_gl_interface_load()
             GB_GL_INTERFACE_LOAD_D(library, glDrawArrays);
             GB_GL_INTERFACE_LOAD_D(library, glEnable);
             GB_GL_INTERFACE_LOAD_D(library, glGenTextures);
+            GB_GL_INTERFACE_LOAD_D(library, glGetIntegerv);
             GB_GL_INTERFACE_LOAD_D(library, glGetString);
             GB_GL_INTERFACE_LOAD_D(library, glIsTexture);
             GB_GL_INTERFACE_LOAD_D(library, glPixelStorei);
+            GB_GL_INTERFACE_LOAD_D(library, glReadPixels);
             GB_GL_INTERFACE_LOAD_D(library, glScissor);
             GB_GL_INTERFACE_LOAD_D(library, glStencilFunc);
             GB_GL_INTERFACE_LOAD_D(library, glStencilMask);
@@ -157,17 +660,23 @@ tb_bool_t gb_gl_interface_load()
             GB_GL_INTERFACE_LOAD_D(library, glTexImage2D);
             GB_GL_INTERFACE_LOAD_D(library, glTexParameterf);
             GB_GL_INTERFACE_LOAD_D(library, glTexParameteri);
+            GB_GL_INTERFACE_LOAD_D(library, glTexSubImage2D);
             GB_GL_INTERFACE_LOAD_D(library, glViewport);
 
             // load interfaces for gl >= 2.0
             GB_GL_INTERFACE_LOAD_D(library, glAttachShader);
+            GB_GL_INTERFACE_LOAD_D(library, glBindBuffer);
+            GB_GL_INTERFACE_LOAD_D(library, glBufferData);
+            GB_GL_INTERFACE_LOAD_D(library, glBufferSubData);
             GB_GL_INTERFACE_LOAD_D(library, glCompileShader);
             GB_GL_INTERFACE_LOAD_D(library, glCreateProgram);
             GB_GL_INTERFACE_LOAD_D(library, glCreateShader);
+            GB_GL_INTERFACE_LOAD_D(library, glDeleteBuffers);
             GB_GL_INTERFACE_LOAD_D(library, glDeleteProgram);
             GB_GL_INTERFACE_LOAD_D(library, glDeleteShader);
             GB_GL_INTERFACE_LOAD_D(library, glDisableVertexAttribArray);
             GB_GL_INTERFACE_LOAD_D(library, glEnableVertexAttribArray);
+            GB_GL_INTERFACE_LOAD_D(library, glGenBuffers);
             GB_GL_INTERFACE_LOAD_D(library, glGetAttribLocation);
             GB_GL_INTERFACE_LOAD_D(library, glGetProgramiv);
             GB_GL_INTERFACE_LOAD_D(library, glGetProgramInfoLog);
@@ -176,11 +685,24 @@ tb_bool_t gb_gl_interface_load()
             GB_GL_INTERFACE_LOAD_D(library, glGetUniformLocation);
             GB_GL_INTERFACE_LOAD_D(library, glLinkProgram);
             GB_GL_INTERFACE_LOAD_D(library, glShaderSource);
+            GB_GL_INTERFACE_LOAD_D(library, glStencilOpSeparate);
             GB_GL_INTERFACE_LOAD_D(library, glUniform1i);
+            GB_GL_INTERFACE_LOAD_D(library, glUniform4f);
             GB_GL_INTERFACE_LOAD_D(library, glUniformMatrix4fv);
             GB_GL_INTERFACE_LOAD_D(library, glUseProgram);
             GB_GL_INTERFACE_LOAD_D(library, glVertexAttrib4f);
             GB_GL_INTERFACE_LOAD_D(library, glVertexAttribPointer);
+
+            // load interfaces of the framebuffer objects for gl >= 2.0
+            GB_GL_INTERFACE_LOAD_D(library, glBindFramebuffer);
+            GB_GL_INTERFACE_LOAD_D(library, glBindRenderbuffer);
+            GB_GL_INTERFACE_LOAD_D(library, glCheckFramebufferStatus);
+            GB_GL_INTERFACE_LOAD_D(library, glDeleteFramebuffers);
+            GB_GL_INTERFACE_LOAD_D(library, glDeleteRenderbuffers);
+            GB_GL_INTERFACE_LOAD_D(library, glFramebufferRenderbuffer);
+            GB_GL_INTERFACE_LOAD_D(library, glGenFramebuffers);
+            GB_GL_INTERFACE_LOAD_D(library, glGenRenderbuffers);
+            GB_GL_INTERFACE_LOAD_D(library, glRenderbufferStorage);
         }
         // load v1 library
         else if ((library = tb_dynamic_init("libGLESv1_CM.so")))
@@ -199,9 +721,11 @@ tb_bool_t gb_gl_interface_load()
             GB_GL_INTERFACE_LOAD_D(library, glDrawArrays);
             GB_GL_INTERFACE_LOAD_D(library, glEnable);
             GB_GL_INTERFACE_LOAD_D(library, glGenTextures);
+            GB_GL_INTERFACE_LOAD_D(library, glGetIntegerv);
             GB_GL_INTERFACE_LOAD_D(library, glGetString);
             GB_GL_INTERFACE_LOAD_D(library, glIsTexture);
             GB_GL_INTERFACE_LOAD_D(library, glPixelStorei);
+            GB_GL_INTERFACE_LOAD_D(library, glReadPixels);
             GB_GL_INTERFACE_LOAD_D(library, glScissor);
             GB_GL_INTERFACE_LOAD_D(library, glStencilFunc);
             GB_GL_INTERFACE_LOAD_D(library, glStencilMask);
@@ -209,6 +733,7 @@ tb_bool_t gb_gl_interface_load()
             GB_GL_INTERFACE_LOAD_D(library, glTexImage2D);
             GB_GL_INTERFACE_LOAD_D(library, glTexParameterf);
             GB_GL_INTERFACE_LOAD_D(library, glTexParameteri);
+            GB_GL_INTERFACE_LOAD_D(library, glTexSubImage2D);
             GB_GL_INTERFACE_LOAD_D(library, glViewport);
 
             // load interfaces for gl 1.x
@@ -248,11 +773,13 @@ tb_bool_t gb_gl_interface_load()
         GB_GL_INTERFACE_LOAD_S(glDrawArrays);
         GB_GL_INTERFACE_LOAD_S(glEnable);
         GB_GL_INTERFACE_LOAD_S(glGenTextures);
+        GB_GL_INTERFACE_LOAD_S(glGetIntegerv);
         GB_GL_INTERFACE_LOAD_S(glGetString);
         GB_GL_INTERFACE_LOAD_S(glHint);
         GB_GL_INTERFACE_LOAD_S(glIsTexture);
         GB_GL_INTERFACE_LOAD_S(glLineWidth);
         GB_GL_INTERFACE_LOAD_S(glPixelStorei);
+        GB_GL_INTERFACE_LOAD_S(glReadPixels);
         GB_GL_INTERFACE_LOAD_S(glScissor);
         GB_GL_INTERFACE_LOAD_S(glStencilFunc);
         GB_GL_INTERFACE_LOAD_S(glStencilMask);
@@ -260,6 +787,7 @@ tb_bool_t gb_gl_interface_load()
         GB_GL_INTERFACE_LOAD_S(glTexImage2D);
         GB_GL_INTERFACE_LOAD_S(glTexParameterf);
         GB_GL_INTERFACE_LOAD_S(glTexParameteri);
+        GB_GL_INTERFACE_LOAD_S(glTexSubImage2D);
         GB_GL_INTERFACE_LOAD_S(glViewport);
 
         // load interfaces for gl 1.x
@@ -289,13 +817,18 @@ tb_bool_t gb_gl_interface_load()
 #   ifndef TB_CONFIG_OS_WINDOWS
         // load interfaces for gl >= 2.0
         GB_GL_INTERFACE_LOAD_S(glAttachShader);
+        GB_GL_INTERFACE_LOAD_S(glBindBuffer);
+        GB_GL_INTERFACE_LOAD_S(glBufferData);
+        GB_GL_INTERFACE_LOAD_S(glBufferSubData);
         GB_GL_INTERFACE_LOAD_S(glCompileShader);
         GB_GL_INTERFACE_LOAD_S(glCreateProgram);
         GB_GL_INTERFACE_LOAD_S(glCreateShader);
+        GB_GL_INTERFACE_LOAD_S(glDeleteBuffers);
         GB_GL_INTERFACE_LOAD_S(glDeleteProgram);
         GB_GL_INTERFACE_LOAD_S(glDeleteShader);
         GB_GL_INTERFACE_LOAD_S(glDisableVertexAttribArray);
         GB_GL_INTERFACE_LOAD_S(glEnableVertexAttribArray);
+        GB_GL_INTERFACE_LOAD_S(glGenBuffers);
         GB_GL_INTERFACE_LOAD_S(glGetAttribLocation);
         GB_GL_INTERFACE_LOAD_S(glGetProgramiv);
         GB_GL_INTERFACE_LOAD_S(glGetProgramInfoLog);
@@ -304,19 +837,118 @@ tb_bool_t gb_gl_interface_load()
         GB_GL_INTERFACE_LOAD_S(glGetUniformLocation);
         GB_GL_INTERFACE_LOAD_S(glLinkProgram);
         GB_GL_INTERFACE_LOAD_S(glShaderSource);
+        GB_GL_INTERFACE_LOAD_S(glStencilOpSeparate);
         GB_GL_INTERFACE_LOAD_S(glUniform1i);
+        GB_GL_INTERFACE_LOAD_S(glUniform4f);
         GB_GL_INTERFACE_LOAD_S(glUniformMatrix4fv);
         GB_GL_INTERFACE_LOAD_S(glUseProgram);
         GB_GL_INTERFACE_LOAD_S(glVertexAttrib4f);
         GB_GL_INTERFACE_LOAD_S(glVertexAttribPointer);
+
+        // load interfaces of the framebuffer objects for gl >= 2.0
+#       ifdef TB_CONFIG_OS_MACOSX
+        GB_GL_INTERFACE_LOAD_S_(glBindFramebuffer, glBindFramebufferEXT);
+        GB_GL_INTERFACE_LOAD_S_(glBindRenderbuffer, glBindRenderbufferEXT);
+        GB_GL_INTERFACE_LOAD_S_(glCheckFramebufferStatus, glCheckFramebufferStatusEXT);
+        GB_GL_INTERFACE_LOAD_S_(glDeleteFramebuffers, glDeleteFramebuffersEXT);
+        GB_GL_INTERFACE_LOAD_S_(glDeleteRenderbuffers, glDeleteRenderbuffersEXT);
+        GB_GL_INTERFACE_LOAD_S_(glFramebufferRenderbuffer, glFramebufferRenderbufferEXT);
+        GB_GL_INTERFACE_LOAD_S_(glGenFramebuffers, glGenFramebuffersEXT);
+        GB_GL_INTERFACE_LOAD_S_(glGenRenderbuffers, glGenRenderbuffersEXT);
+        GB_GL_INTERFACE_LOAD_S_(glRenderbufferStorage, glRenderbufferStorageEXT);
+#       else
+        GB_GL_INTERFACE_LOAD_S(glBindFramebuffer);
+        GB_GL_INTERFACE_LOAD_S(glBindRenderbuffer);
+        GB_GL_INTERFACE_LOAD_S(glCheckFramebufferStatus);
+        GB_GL_INTERFACE_LOAD_S(glDeleteFramebuffers);
+        GB_GL_INTERFACE_LOAD_S(glDeleteRenderbuffers);
+        GB_GL_INTERFACE_LOAD_S(glFramebufferRenderbuffer);
+        GB_GL_INTERFACE_LOAD_S(glGenFramebuffers);
+        GB_GL_INTERFACE_LOAD_S(glGenRenderbuffers);
+        GB_GL_INTERFACE_LOAD_S(glRenderbufferStorage);
+#       endif
+
+        // load interfaces of the pixel buffer objects for gl >= 2.1, optional
+#       ifndef TB_CONFIG_OS_IOS
+        GB_GL_INTERFACE_LOAD_S(glMapBuffer);
+        GB_GL_INTERFACE_LOAD_S(glUnmapBuffer);
+#       endif
 #   endif
 #endif
 
+        // hook the state functions by the shadow state
+        gb_gl_shadow_hook();
+
         // ok
+        g_loaded = tb_true;
         ok = tb_true;
 
     } while (0);
 
+    // leave
+    tb_spinlock_leave(&g_lock);
+
     // ok?
     return ok;
 }
+gb_gl_interface_shadow_ref_t gb_gl_interface_shadow_init()
+{
+    // make shadow
+    gb_gl_shadow_t* shadow = tb_malloc0_type(gb_gl_shadow_t);
+    tb_assert_and_check_return_val(shadow, tb_null);
+
+    // the states of the new context are unknown
+    gb_gl_shadow_reset(shadow);
+
+    // ok
+    return (gb_gl_interface_shadow_ref_t)shadow;
+}
+tb_void_t gb_gl_interface_shadow_exit(gb_gl_interface_shadow_ref_t shadow)
+{
+    // check
+    tb_assert_and_check_return(shadow);
+
+    // unbind it from the current thread
+    if (g_shadow == (gb_gl_shadow_t*)shadow) g_shadow = tb_null;
+
+    // exit it
+    tb_free(shadow);
+}
+tb_bool_t gb_gl_interface_shadow_enter(gb_gl_interface_shadow_ref_t shadow)
+{
+    // check
+    tb_assert_and_check_return_val(shadow, tb_false);
+
+    // the same context? keep the tracked states
+    if (g_shadow == (gb_gl_shadow_t*)shadow) return tb_false;
+
+    /* the current context has been switched, the states of this context may be modified 
+     * by the other contexts on this thread or by the other threads, so forget them
+     */
+    gb_gl_shadow_reset((gb_gl_shadow_t*)shadow);
+
+    // bind it to the current thread
+    g_shadow = (gb_gl_shadow_t*)shadow;
+
+    // reset
+    return tb_true;
+}
+tb_void_t gb_gl_interface_reset()
+{
+    // reset the shadow state of the current context
+    if (g_shadow) gb_gl_shadow_reset(g_shadow);
+}
+tb_void_t gb_gl_interface_stats(gb_gl_interface_stats_ref_t stats)
+{
+    // check
+    tb_assert_and_check_return(stats);
+
+    // get it
+    if (g_shadow) *stats = g_shadow->stats;
+    else tb_memset(stats, 0, sizeof(gb_gl_interface_stats_t));
+}
+tb_void_t gb_gl_interface_stats_clear()
+{
+    // clear it
+    if (g_shadow) tb_memset(&g_shadow->stats, 0, sizeof(gb_gl_interface_stats_t));
+}
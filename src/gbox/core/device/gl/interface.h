@@ -134,6 +134,7 @@
 
 // antialiasing
 #define GB_GL_MULTISAMPLE               (0x809D)
+#define GB_GL_SAMPLE_BUFFERS            (0x80A8)
 #define GB_GL_LINE_SMOOTH               (0x0B20)
 #define GB_GL_LINE_SMOOTH_HINT          (0x0C52)
 #define GB_GL_FOG                       (0x0B60)
@@ -150,6 +151,14 @@
 #define GB_GL_INCR_WRAP                 (0x8507)
 #define GB_GL_DECR_WRAP                 (0x8508)
 
+// stencil face
+#define GB_GL_FRONT                     (0x0404)
+#define GB_GL_BACK                      (0x0405)
+#define GB_GL_FRONT_AND_BACK            (0x0408)
+
+// stencil bits
+#define GB_GL_STENCIL_BITS              (0x0D57)
+
 // stencil function
 #define GB_GL_NEVER                     (0x0200)
 #define GB_GL_LESS                      (0x0201)
@@ -257,6 +266,26 @@
 #define GB_GL_TEXTURE31                 (0x84DF)
 #define GB_GL_ACTIVE_TEXTURE            (0x84E0)
 
+// buffer objects
+#define GB_GL_ARRAY_BUFFER              (0x8892)
+#define GB_GL_ELEMENT_ARRAY_BUFFER      (0x8893)
+#define GB_GL_STREAM_DRAW               (0x88E0)
+#define GB_GL_STATIC_DRAW               (0x88E4)
+#define GB_GL_DYNAMIC_DRAW              (0x88E8)
+#define GB_GL_PIXEL_PACK_BUFFER         (0x88EB)
+#define GB_GL_STREAM_READ               (0x88E1)
+#define GB_GL_READ_ONLY                 (0x88B8)
+
+// framebuffer objects
+#define GB_GL_FRAMEBUFFER               (0x8D40)
+#define GB_GL_RENDERBUFFER              (0x8D41)
+#define GB_GL_COLOR_ATTACHMENT0         (0x8CE0)
+#define GB_GL_STENCIL_ATTACHMENT        (0x8D20)
+#define GB_GL_FRAMEBUFFER_COMPLETE      (0x8CD5)
+#define GB_GL_RGBA4                     (0x8056)
+#define GB_GL_RGBA8                     (0x8058)
+#define GB_GL_STENCIL_INDEX8            (0x8D48)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -282,6 +311,8 @@ typedef tb_float_t      gb_GLfloat_t;
 typedef tb_float_t      gb_GLclampf_t;
 typedef tb_double_t     gb_GLdouble_t;
 typedef tb_double_t     gb_GLclampd_t;
+typedef tb_long_t       gb_GLintptr_t;
+typedef tb_long_t       gb_GLsizeiptr_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interface types
@@ -289,8 +320,14 @@ typedef tb_double_t     gb_GLclampd_t;
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glActiveTexture))             (gb_GLenum_t texture);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glAlphaFunc))                 (gb_GLenum_t func, gb_GLclampf_t ref);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glAttachShader))              (gb_GLuint_t program, gb_GLuint_t shader);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBindBuffer))                (gb_GLenum_t target, gb_GLuint_t buffer);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBindFramebuffer))           (gb_GLenum_t target, gb_GLuint_t framebuffer);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBindRenderbuffer))          (gb_GLenum_t target, gb_GLuint_t renderbuffer);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBindTexture))               (gb_GLenum_t target, gb_GLuint_t texture);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBlendFunc))                 (gb_GLenum_t sfactor, gb_GLenum_t dfactor);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBufferData))                (gb_GLenum_t target, gb_GLsizeiptr_t size, gb_GLvoid_t const* data, gb_GLenum_t usage);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glBufferSubData))             (gb_GLenum_t target, gb_GLintptr_t offset, gb_GLsizeiptr_t size, gb_GLvoid_t const* data);
+typedef gb_GLenum_t             (GB_GL_INTERFACE_TYPE(glCheckFramebufferStatus))    (gb_GLenum_t target);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glClear))                     (gb_GLbitfield_t mask);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glClearColor))                (gb_GLclampf_t red, gb_GLclampf_t green, gb_GLclampf_t blue, gb_GLclampf_t alpha);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glClearStencil))              (gb_GLint_t s);
@@ -300,7 +337,10 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glColorPointer))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glCompileShader))             (gb_GLuint_t shader);
 typedef gb_GLuint_t             (GB_GL_INTERFACE_TYPE(glCreateProgram))             (gb_GLvoid_t);
 typedef gb_GLuint_t             (GB_GL_INTERFACE_TYPE(glCreateShader))              (gb_GLenum_t type);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteBuffers))             (gb_GLsizei_t n, gb_GLuint_t const* buffers);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteFramebuffers))        (gb_GLsizei_t n, gb_GLuint_t const* framebuffers);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteProgram))             (gb_GLuint_t program);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteRenderbuffers))       (gb_GLsizei_t n, gb_GLuint_t const* renderbuffers);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteShader))              (gb_GLuint_t shader);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDeleteTextures))            (gb_GLsizei_t n, gb_GLuint_t const* textures);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDisable))                   (gb_GLenum_t cap);
@@ -310,7 +350,12 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glDrawArrays))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glEnable))                    (gb_GLenum_t cap);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glEnableClientState))         (gb_GLenum_t cap);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glEnableVertexAttribArray))   (gb_GLuint_t index);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glFramebufferRenderbuffer))   (gb_GLenum_t target, gb_GLenum_t attachment, gb_GLenum_t renderbuffertarget, gb_GLuint_t renderbuffer);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGenBuffers))                (gb_GLsizei_t n, gb_GLuint_t* buffers);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGenFramebuffers))           (gb_GLsizei_t n, gb_GLuint_t* framebuffers);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGenRenderbuffers))          (gb_GLsizei_t n, gb_GLuint_t* renderbuffers);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGenTextures))               (gb_GLsizei_t n, gb_GLuint_t* textures);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGetIntegerv))               (gb_GLenum_t pname, gb_GLint_t* params);
 typedef gb_GLint_t              (GB_GL_INTERFACE_TYPE(glGetAttribLocation))         (gb_GLuint_t program, gb_GLchar_t const* name);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGetProgramiv))              (gb_GLuint_t program, gb_GLenum_t pname, gb_GLint_t* params);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glGetProgramInfoLog))         (gb_GLuint_t program, gb_GLsizei_t bufsize, gb_GLsizei_t* length, gb_GLchar_t* infolog);
@@ -324,6 +369,7 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glLineWidth))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glLinkProgram))               (gb_GLuint_t program);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glLoadIdentity))              (gb_GLvoid_t);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glLoadMatrixf))               (gb_GLfloat_t const* matrix);
+typedef gb_GLvoid_t*            (GB_GL_INTERFACE_TYPE(glMapBuffer))                 (gb_GLenum_t target, gb_GLenum_t access);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glMatrixMode))                (gb_GLenum_t mode);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glMultMatrixf))               (gb_GLfloat_t const* matrix);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glOrtho))                     (gb_GLdouble_t left, gb_GLdouble_t right, gb_GLdouble_t bottom, gb_GLdouble_t top, gb_GLdouble_t near, gb_GLdouble_t far);
@@ -331,6 +377,8 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glOrthof))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glPixelStorei))               (gb_GLenum_t pname, gb_GLint_t param);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glPopMatrix))                 (gb_GLvoid_t);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glPushMatrix))                (gb_GLvoid_t);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glReadPixels))                (gb_GLint_t x, gb_GLint_t y, gb_GLsizei_t width, gb_GLsizei_t height, gb_GLenum_t format, gb_GLenum_t type, gb_GLvoid_t* pixels);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glRenderbufferStorage))       (gb_GLenum_t target, gb_GLenum_t internalformat, gb_GLsizei_t width, gb_GLsizei_t height);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glRotatef))                   (gb_GLfloat_t angle, gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glScalef))                    (gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glScissor))                   (gb_GLint_t x, gb_GLint_t y, gb_GLsizei_t width, gb_GLsizei_t height);
@@ -338,14 +386,18 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glShaderSource))
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilFunc))               (gb_GLenum_t func, gb_GLint_t ref, gb_GLuint_t mask);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilMask))               (gb_GLuint_t mask);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilOp))                 (gb_GLenum_t fail, gb_GLenum_t zfail, gb_GLenum_t zpass);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glStencilOpSeparate))         (gb_GLenum_t face, gb_GLenum_t fail, gb_GLenum_t zfail, gb_GLenum_t zpass);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexCoordPointer))           (gb_GLint_t size, gb_GLenum_t type, gb_GLsizei_t stride, gb_GLvoid_t const* ptr);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexEnvi))                   (gb_GLenum_t target, gb_GLenum_t pname, gb_GLint_t param);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexImage2D))                (gb_GLenum_t target, gb_GLint_t level, gb_GLint_t internalFormat, gb_GLsizei_t width, gb_GLsizei_t height, gb_GLint_t border, gb_GLenum_t format, gb_GLenum_t type, gb_GLvoid_t const* pixels);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexParameterf))             (gb_GLenum_t target, gb_GLenum_t pname, gb_GLfloat_t param);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexParameteri))             (gb_GLenum_t target, gb_GLenum_t pname, gb_GLint_t param);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTexSubImage2D))             (gb_GLenum_t target, gb_GLint_t level, gb_GLint_t xoffset, gb_GLint_t yoffset, gb_GLsizei_t width, gb_GLsizei_t height, gb_GLenum_t format, gb_GLenum_t type, gb_GLvoid_t const* pixels);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glTranslatef))                (gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glUniform1i))                 (gb_GLint_t location, gb_GLint_t x);
+typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glUniform4f))                 (gb_GLint_t location, gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z, gb_GLfloat_t w);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glUniformMatrix4fv))          (gb_GLint_t location, gb_GLsizei_t count, gb_GLboolean_t transpose, gb_GLfloat_t const* value);
+typedef gb_GLboolean_t          (GB_GL_INTERFACE_TYPE(glUnmapBuffer))               (gb_GLenum_t target);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glUseProgram))                (gb_GLuint_t program);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glVertexAttrib4f))            (gb_GLuint_t indx, gb_GLfloat_t x, gb_GLfloat_t y, gb_GLfloat_t z, gb_GLfloat_t w);
 typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glVertexAttribPointer))       (gb_GLuint_t indx, gb_GLint_t size, gb_GLenum_t type, gb_GLboolean_t normalized, gb_GLsizei_t stride, gb_GLvoid_t const* ptr);
@@ -358,8 +410,14 @@ typedef gb_GLvoid_t             (GB_GL_INTERFACE_TYPE(glViewport))
 GB_GL_INTERFACE_EXTERN(glActiveTexture);
 GB_GL_INTERFACE_EXTERN(glAlphaFunc);
 GB_GL_INTERFACE_EXTERN(glAttachShader);
+GB_GL_INTERFACE_EXTERN(glBindBuffer);
+GB_GL_INTERFACE_EXTERN(glBindFramebuffer);
+GB_GL_INTERFACE_EXTERN(glBindRenderbuffer);
 GB_GL_INTERFACE_EXTERN(glBindTexture);
 GB_GL_INTERFACE_EXTERN(glBlendFunc);
+GB_GL_INTERFACE_EXTERN(glBufferData);
+GB_GL_INTERFACE_EXTERN(glBufferSubData);
+GB_GL_INTERFACE_EXTERN(glCheckFramebufferStatus);
 GB_GL_INTERFACE_EXTERN(glClear);
 GB_GL_INTERFACE_EXTERN(glClearColor);
 GB_GL_INTERFACE_EXTERN(glClearStencil);
@@ -369,7 +427,10 @@ GB_GL_INTERFACE_EXTERN(glColorPointer);
 GB_GL_INTERFACE_EXTERN(glCompileShader);
 GB_GL_INTERFACE_EXTERN(glCreateProgram);
 GB_GL_INTERFACE_EXTERN(glCreateShader);
+GB_GL_INTERFACE_EXTERN(glDeleteBuffers);
+GB_GL_INTERFACE_EXTERN(glDeleteFramebuffers);
 GB_GL_INTERFACE_EXTERN(glDeleteProgram);
+GB_GL_INTERFACE_EXTERN(glDeleteRenderbuffers);
 GB_GL_INTERFACE_EXTERN(glDeleteShader);
 GB_GL_INTERFACE_EXTERN(glDeleteTextures);
 GB_GL_INTERFACE_EXTERN(glDisable);
@@ -379,8 +440,13 @@ GB_GL_INTERFACE_EXTERN(glDrawArrays);
 GB_GL_INTERFACE_EXTERN(glEnable);
 GB_GL_INTERFACE_EXTERN(glEnableClientState);
 GB_GL_INTERFACE_EXTERN(glEnableVertexAttribArray);
+GB_GL_INTERFACE_EXTERN(glFramebufferRenderbuffer);
+GB_GL_INTERFACE_EXTERN(glGenBuffers);
+GB_GL_INTERFACE_EXTERN(glGenFramebuffers);
+GB_GL_INTERFACE_EXTERN(glGenRenderbuffers);
 GB_GL_INTERFACE_EXTERN(glGenTextures);
 GB_GL_INTERFACE_EXTERN(glGetAttribLocation);
+GB_GL_INTERFACE_EXTERN(glGetIntegerv);
 GB_GL_INTERFACE_EXTERN(glGetProgramiv);
 GB_GL_INTERFACE_EXTERN(glGetProgramInfoLog);
 GB_GL_INTERFACE_EXTERN(glGetShaderiv);
@@ -393,6 +459,7 @@ GB_GL_INTERFACE_EXTERN(glLineWidth);
 GB_GL_INTERFACE_EXTERN(glLinkProgram);
 GB_GL_INTERFACE_EXTERN(glLoadIdentity);
 GB_GL_INTERFACE_EXTERN(glLoadMatrixf);
+GB_GL_INTERFACE_EXTERN(glMapBuffer);
 GB_GL_INTERFACE_EXTERN(glMatrixMode);
 GB_GL_INTERFACE_EXTERN(glMultMatrixf);
 GB_GL_INTERFACE_EXTERN(glOrtho);
@@ -400,6 +467,8 @@ GB_GL_INTERFACE_EXTERN(glOrthof);
 GB_GL_INTERFACE_EXTERN(glPixelStorei);
 GB_GL_INTERFACE_EXTERN(glPopMatrix);
 GB_GL_INTERFACE_EXTERN(glPushMatrix);
+GB_GL_INTERFACE_EXTERN(glReadPixels);
+GB_GL_INTERFACE_EXTERN(glRenderbufferStorage);
 GB_GL_INTERFACE_EXTERN(glRotatef);
 GB_GL_INTERFACE_EXTERN(glScalef);
 GB_GL_INTERFACE_EXTERN(glScissor);
@@ -407,30 +476,105 @@ GB_GL_INTERFACE_EXTERN(glShaderSource);
 GB_GL_INTERFACE_EXTERN(glStencilFunc);
 GB_GL_INTERFACE_EXTERN(glStencilMask);
 GB_GL_INTERFACE_EXTERN(glStencilOp);
+GB_GL_INTERFACE_EXTERN(glStencilOpSeparate);
 GB_GL_INTERFACE_EXTERN(glTexCoordPointer);
 GB_GL_INTERFACE_EXTERN(glTexEnvi);
 GB_GL_INTERFACE_EXTERN(glTexImage2D);
 GB_GL_INTERFACE_EXTERN(glTexParameterf);
 GB_GL_INTERFACE_EXTERN(glTexParameteri);
+GB_GL_INTERFACE_EXTERN(glTexSubImage2D);
 GB_GL_INTERFACE_EXTERN(glTranslatef);
 GB_GL_INTERFACE_EXTERN(glUniform1i);
+GB_GL_INTERFACE_EXTERN(glUniform4f);
 GB_GL_INTERFACE_EXTERN(glUniformMatrix4fv);
+GB_GL_INTERFACE_EXTERN(glUnmapBuffer);
 GB_GL_INTERFACE_EXTERN(glUseProgram);
 GB_GL_INTERFACE_EXTERN(glVertexAttrib4f);
 GB_GL_INTERFACE_EXTERN(glVertexAttribPointer);
 GB_GL_INTERFACE_EXTERN(glVertexPointer);
 GB_GL_INTERFACE_EXTERN(glViewport);
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * stats types
+ */
+
+// the gl interface stats type
+typedef struct __gb_gl_interface_stats_t
+{
+    // the issued calls count of the tracked states
+    tb_size_t       calls;
+
+    // the skipped calls count of the redundant states
+    tb_size_t       skipped;
+
+    // the draw calls count
+    tb_size_t       draws;
+
+}gb_gl_interface_stats_t, *gb_gl_interface_stats_ref_t;
+
+/*! the gl shadow state ref type of the gl context
+ *
+ * the tracked states belong to the gl context, so each gl context has its own shadow state
+ * and the shadow state of the current context is entered by the calling thread.
+ */
+typedef struct{}*   gb_gl_interface_shadow_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interface
  */
 
 /* load gl interfaces
  *
- * @return          the gl version
+ * the gl interfaces are loaded only once and shared by all gl contexts of the process, 
+ * so only one gl implementation can be used in the process.
+ *
+ * the state functions are hooked by the shadow state which skips the redundant gl calls: 
+ * glEnable, glDisable, glBlendFunc, glUseProgram, glActiveTexture, glBindTexture, glBindBuffer, 
+ * glEnableVertexAttribArray, glDisableVertexAttribArray and glVertexAttrib4f, 
+ * and they call the gl directly if no shadow state is entered by the calling thread.
+ *
+ * @return          tb_true or tb_false
  */
 tb_bool_t           gb_gl_interface_load(tb_noarg_t);
 
+/* init the shadow state for the gl context
+ *
+ * @return          the shadow state
+ */
+gb_gl_interface_shadow_ref_t gb_gl_interface_shadow_init(tb_noarg_t);
+
+/* exit the shadow state and leave it if it is entered by the calling thread
+ *
+ * @param shadow    the shadow state
+ */
+tb_void_t           gb_gl_interface_shadow_exit(gb_gl_interface_shadow_ref_t shadow);
+
+/* enter the shadow state after making its gl context current for the calling thread
+ *
+ * the shadow state will be reset if the calling thread has entered the other shadow state since the last entering
+ *
+ * @param shadow    the shadow state
+ *
+ * @return          tb_true if the shadow state has been reset
+ */
+tb_bool_t           gb_gl_interface_shadow_enter(gb_gl_interface_shadow_ref_t shadow);
+
+/* reset the entered shadow state of the calling thread
+ *
+ * the shadow state will be invalid if the gl states are modified outside
+ */
+tb_void_t           gb_gl_interface_reset(tb_noarg_t);
+
+/* the stats of the gl calls of the entered shadow state since the last clearing
+ *
+ * @param stats     the stats
+ */
+tb_void_t           gb_gl_interface_stats(gb_gl_interface_stats_ref_t stats);
+
+/* clear the stats of the gl calls of the entered shadow state, .e.g for each frame
+ */
+tb_void_t           gb_gl_interface_stats_clear(tb_noarg_t);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
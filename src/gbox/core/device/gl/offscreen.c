@@ -0,0 +1,383 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        offscreen.c
+ * @ingroup     core
+ */
+
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_offscreen"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "offscreen.h"
+#include "../../pixmap.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl offscreen impl type
+typedef struct __gb_gl_offscreen_impl_t
+{
+    // the gl version
+    tb_size_t                   version;
+
+    // the width
+    tb_size_t                   width;
+
+    // the height
+    tb_size_t                   height;
+
+    // the framebuffer object
+    gb_GLuint_t                 framebuffer;
+
+    // the color renderbuffer
+    gb_GLuint_t                 color;
+
+    // the stencil renderbuffer, 0: no stencil buffer
+    gb_GLuint_t                 stencil;
+
+    // the double-buffered pixel buffer objects, 0: not supported
+    gb_GLuint_t                 buffers[2];
+
+    // the pending readbacks of the pixel buffers
+    tb_uint8_t                  pending[2];
+
+    // the pixel buffer index for the next readback
+    tb_size_t                   index;
+
+    // the rgba pixels for reading synchronously
+    tb_byte_t*                  pixels;
+
+}gb_gl_offscreen_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_gl_offscreen_make(gb_gl_offscreen_impl_t* impl, gb_GLenum_t format, tb_bool_t stencil)
+{
+    // check
+    tb_assert_abort(impl && impl->framebuffer && impl->color);
+
+    // make the color storage
+    gb_glBindRenderbuffer(GB_GL_RENDERBUFFER, impl->color);
+    gb_glRenderbufferStorage(GB_GL_RENDERBUFFER, format, (gb_GLsizei_t)impl->width, (gb_GLsizei_t)impl->height);
+
+    // make the stencil storage
+    if (stencil)
+    {
+        if (!impl->stencil) gb_glGenRenderbuffers(1, &impl->stencil);
+        gb_glBindRenderbuffer(GB_GL_RENDERBUFFER, impl->stencil);
+        gb_glRenderbufferStorage(GB_GL_RENDERBUFFER, GB_GL_STENCIL_INDEX8, (gb_GLsizei_t)impl->width, (gb_GLsizei_t)impl->height);
+    }
+    else if (impl->stencil)
+    {
+        gb_glDeleteRenderbuffers(1, &impl->stencil);
+        impl->stencil = 0;
+    }
+    gb_glBindRenderbuffer(GB_GL_RENDERBUFFER, 0);
+
+    // attach them
+    gb_glBindFramebuffer(GB_GL_FRAMEBUFFER, impl->framebuffer);
+    gb_glFramebufferRenderbuffer(GB_GL_FRAMEBUFFER, GB_GL_COLOR_ATTACHMENT0, GB_GL_RENDERBUFFER, impl->color);
+    gb_glFramebufferRenderbuffer(GB_GL_FRAMEBUFFER, GB_GL_STENCIL_ATTACHMENT, GB_GL_RENDERBUFFER, impl->stencil);
+
+    // complete?
+    return gb_glCheckFramebufferStatus(GB_GL_FRAMEBUFFER) == GB_GL_FRAMEBUFFER_COMPLETE;
+}
+static tb_bool_t gb_gl_offscreen_make_all(gb_gl_offscreen_impl_t* impl)
+{
+    // check
+    tb_assert_abort(impl);
+
+    // the color formats, the rgba8 may be not supported for gl es 2.0 without GL_OES_rgb8_rgba8
+    static gb_GLenum_t const s_formats[] = {GB_GL_RGBA8, GB_GL_RGBA4};
+
+    // make the color and stencil storages, the stencil buffer is optional for the stencil-then-cover filling
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    for (i = 0; i < tb_arrayn(s_formats); i++)
+    {
+        for (j = 0; j < 2; j++)
+        {
+            if (gb_gl_offscreen_make(impl, s_formats[i], !j)) 
+            {
+                // trace
+                tb_trace_d("make: %lux%lu, format: %x, stencil: %s", impl->width, impl->height, s_formats[i], impl->stencil? "ok" : "no");
+                return tb_true;
+            }
+        }
+    }
+
+    // trace
+    tb_trace_e("the framebuffer is incomplete!");
+    return tb_false;
+}
+static tb_void_t gb_gl_offscreen_make_buffers(gb_gl_offscreen_impl_t* impl)
+{
+    // check
+    tb_assert_abort(impl);
+
+    // drop the pending readbacks
+    impl->pending[0] = 0;
+    impl->pending[1] = 0;
+
+    // the pixel buffer objects are not supported?
+    tb_check_return(impl->buffers[0] && impl->buffers[1]);
+
+    // resize the pixel buffers
+    tb_size_t i = 0;
+    for (i = 0; i < 2; i++)
+    {
+        gb_glBindBuffer(GB_GL_PIXEL_PACK_BUFFER, impl->buffers[i]);
+        gb_glBufferData(GB_GL_PIXEL_PACK_BUFFER, (gb_GLsizeiptr_t)(impl->width * impl->height * 4), tb_null, GB_GL_STREAM_READ);
+    }
+    gb_glBindBuffer(GB_GL_PIXEL_PACK_BUFFER, 0);
+}
+static tb_void_t gb_gl_offscreen_copy(gb_gl_offscreen_impl_t* impl, gb_bitmap_ref_t bitmap, tb_byte_t const* pixels)
+{
+    // check
+    tb_assert_abort(impl && bitmap && pixels);
+
+    // the bitmap data
+    tb_byte_t*          data = (tb_byte_t*)gb_bitmap_data(bitmap);
+    tb_size_t           row_bytes = gb_bitmap_row_bytes(bitmap);
+    gb_pixmap_ref_t     pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), 0xff);
+    tb_assert_and_check_return(data && row_bytes && pixmap);
+
+    // the copied size
+    tb_size_t width     = tb_min(impl->width, gb_bitmap_width(bitmap));
+    tb_size_t height    = tb_min(impl->height, gb_bitmap_height(bitmap));
+
+    // copy and convert the rgba pixels, the bottom row of the framebuffer is read first
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_size_t   btp = pixmap->btp;
+    gb_color_t  color;
+    for (j = 0; j < height; j++)
+    {
+        tb_byte_t const*    p = pixels + (impl->height - 1 - j) * impl->width * 4;
+        tb_byte_t*          q = data + j * row_bytes;
+        for (i = 0; i < width; i++, p += 4, q += btp)
+        {
+            color.r = p[0];
+            color.g = p[1];
+            color.b = p[2];
+            color.a = p[3];
+            pixmap->color_set(q, color);
+        }
+    }
+
+    // the pixels of the bitmap have been modified
+    gb_bitmap_invalidate(bitmap, tb_null);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_offscreen_ref_t gb_gl_offscreen_init(tb_size_t version, tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert_and_check_return_val(version >= 0x20 && width && height, tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    gb_gl_offscreen_impl_t*     impl = tb_null;
+    do
+    {
+        // the framebuffer objects are not supported?
+        if (!gb_glGenFramebuffers || !gb_glRenderbufferStorage || !gb_glReadPixels)
+        {
+            // trace
+            tb_trace_e("the framebuffer objects are not supported!");
+            break;
+        }
+
+        // make offscreen
+        impl = tb_malloc0_type(gb_gl_offscreen_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init offscreen
+        impl->version   = version;
+        impl->width     = width;
+        impl->height    = height;
+
+        // init framebuffer and color renderbuffer
+        gb_glGenFramebuffers(1, &impl->framebuffer);
+        gb_glGenRenderbuffers(1, &impl->color);
+        tb_assert_and_check_break(impl->framebuffer && impl->color);
+
+        // make storages and bind the framebuffer
+        if (!gb_gl_offscreen_make_all(impl)) break;
+
+        // init the pixel buffer objects for gl >= 2.1
+        if (version >= 0x21 && gb_glMapBuffer && gb_glUnmapBuffer)
+        {
+            gb_glGenBuffers(2, impl->buffers);
+            gb_gl_offscreen_make_buffers(impl);
+        }
+
+        // trace
+        tb_trace_d("init: %lux%lu, readback: %s", width, height, impl->buffers[0]? "async" : "sync");
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_offscreen_exit((gb_gl_offscreen_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_gl_offscreen_ref_t)impl;
+}
+tb_void_t gb_gl_offscreen_exit(gb_gl_offscreen_ref_t offscreen)
+{
+    // check
+    gb_gl_offscreen_impl_t* impl = (gb_gl_offscreen_impl_t*)offscreen;
+    tb_assert_and_check_return(impl);
+
+    // exit pixel buffers
+    if (impl->buffers[0] || impl->buffers[1]) gb_glDeleteBuffers(2, impl->buffers);
+    impl->buffers[0] = 0;
+    impl->buffers[1] = 0;
+
+    // unbind and exit framebuffer
+    if (impl->framebuffer)
+    {
+        gb_glBindFramebuffer(GB_GL_FRAMEBUFFER, 0);
+        gb_glDeleteFramebuffers(1, &impl->framebuffer);
+    }
+    impl->framebuffer = 0;
+
+    // exit renderbuffers
+    if (impl->color) gb_glDeleteRenderbuffers(1, &impl->color);
+    if (impl->stencil) gb_glDeleteRenderbuffers(1, &impl->stencil);
+    impl->color     = 0;
+    impl->stencil   = 0;
+
+    // exit pixels
+    if (impl->pixels) tb_free(impl->pixels);
+    impl->pixels = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_bool_t gb_gl_offscreen_resize(gb_gl_offscreen_ref_t offscreen, tb_size_t width, tb_size_t height)
+{
+    // check
+    gb_gl_offscreen_impl_t* impl = (gb_gl_offscreen_impl_t*)offscreen;
+    tb_assert_and_check_return_val(impl && width && height, tb_false);
+
+    // no changed?
+    tb_check_return_val(width != impl->width || height != impl->height, tb_true);
+
+    // update size
+    impl->width     = width;
+    impl->height    = height;
+
+    // exit the pixels for reading synchronously
+    if (impl->pixels) tb_free(impl->pixels);
+    impl->pixels = tb_null;
+
+    // remake the pixel buffers
+    gb_gl_offscreen_make_buffers(impl);
+
+    // remake storages
+    return gb_gl_offscreen_make_all(impl);
+}
+tb_size_t gb_gl_offscreen_stencil_bits(gb_gl_offscreen_ref_t offscreen)
+{
+    // check
+    gb_gl_offscreen_impl_t* impl = (gb_gl_offscreen_impl_t*)offscreen;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the stencil bits
+    return impl->stencil? 8 : 0;
+}
+tb_bool_t gb_gl_offscreen_read(gb_gl_offscreen_ref_t offscreen, gb_bitmap_ref_t bitmap, tb_bool_t wait)
+{
+    // check
+    gb_gl_offscreen_impl_t* impl = (gb_gl_offscreen_impl_t*)offscreen;
+    tb_assert_and_check_return_val(impl && bitmap, tb_false);
+
+    // the pixel buffer objects are not supported? read it synchronously
+    if (!impl->buffers[0] || !impl->buffers[1])
+    {
+        // make pixels
+        if (!impl->pixels) impl->pixels = tb_nalloc_type(impl->width * impl->height * 4, tb_byte_t);
+        tb_assert_and_check_return_val(impl->pixels, tb_false);
+
+        // read pixels
+        gb_glReadPixels(0, 0, (gb_GLsizei_t)impl->width, (gb_GLsizei_t)impl->height, GB_GL_RGBA, GB_GL_UNSIGNED_BYTE, impl->pixels);
+
+        // copy pixels
+        gb_gl_offscreen_copy(impl, bitmap, impl->pixels);
+        return tb_true;
+    }
+
+    // start reading the current frame to the pixel buffer, it will not wait the gpu
+    tb_size_t index = impl->index;
+    gb_glBindBuffer(GB_GL_PIXEL_PACK_BUFFER, impl->buffers[index]);
+    gb_glReadPixels(0, 0, (gb_GLsizei_t)impl->width, (gb_GLsizei_t)impl->height, GB_GL_RGBA, GB_GL_UNSIGNED_BYTE, tb_null);
+    impl->pending[index] = 1;
+    impl->index = index ^ 1;
+
+    // the ready pixel buffer: the current frame if wait, otherwise the previous frame
+    tb_size_t ready = wait? index : (index ^ 1);
+
+    // copy the ready pixels
+    tb_bool_t ok = tb_false;
+    if (impl->pending[ready])
+    {
+        // map the pixel buffer
+        gb_glBindBuffer(GB_GL_PIXEL_PACK_BUFFER, impl->buffers[ready]);
+        tb_byte_t const* pixels = (tb_byte_t const*)gb_glMapBuffer(GB_GL_PIXEL_PACK_BUFFER, GB_GL_READ_ONLY);
+        if (pixels)
+        {
+            // copy pixels
+            gb_gl_offscreen_copy(impl, bitmap, pixels);
+            ok = tb_true;
+
+            // unmap it
+            gb_glUnmapBuffer(GB_GL_PIXEL_PACK_BUFFER);
+        }
+        impl->pending[ready] = 0;
+    }
+
+    // the previous frame is older than the current frame, drop it
+    if (wait) impl->pending[index ^ 1] = 0;
+
+    // unbind the pixel buffer
+    gb_glBindBuffer(GB_GL_PIXEL_PACK_BUFFER, 0);
+
+    // ok?
+    return ok;
+}
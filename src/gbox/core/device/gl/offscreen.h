@@ -0,0 +1,107 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        offscreen.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_OFFSCREEN_H
+#define GB_CORE_DEVICE_GL_OFFSCREEN_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the gl offscreen target ref type
+ *
+ * render to the framebuffer object with the rgba color and stencil renderbuffers, 
+ * and read back the pixels to the bitmap by the double-buffered pixel buffer objects.
+ *
+ * the reading of the frame n is started to the one pixel buffer and the frame n - 1 is copied 
+ * from the other pixel buffer, so the gpu will not be stalled and the readback has one frame latency.
+ * the pixels are read synchronously if the pixel buffer objects are not supported, .e.g gl es 2.0
+ */
+typedef struct{}*               gb_gl_offscreen_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the offscreen target and bind it
+ *
+ * @param version               the gl version
+ * @param width                 the width
+ * @param height                the height
+ *
+ * @return                      the offscreen target
+ */
+gb_gl_offscreen_ref_t           gb_gl_offscreen_init(tb_size_t version, tb_size_t width, tb_size_t height);
+
+/* exit the offscreen target and delete all gl objects
+ *
+ * @param offscreen             the offscreen target
+ */
+tb_void_t                       gb_gl_offscreen_exit(gb_gl_offscreen_ref_t offscreen);
+
+/* resize the offscreen target and drop the pending readbacks
+ *
+ * @param offscreen             the offscreen target
+ * @param width                 the width
+ * @param height                the height
+ *
+ * @return                      tb_true or tb_false
+ */
+tb_bool_t                       gb_gl_offscreen_resize(gb_gl_offscreen_ref_t offscreen, tb_size_t width, tb_size_t height);
+
+/* the stencil bits of the offscreen target
+ *
+ * @param offscreen             the offscreen target
+ *
+ * @return                      the stencil bits, 0: no stencil buffer
+ */
+tb_size_t                       gb_gl_offscreen_stencil_bits(gb_gl_offscreen_ref_t offscreen);
+
+/* read back the pixels of the offscreen target to the bitmap
+ *
+ * the pending draws must be flushed before reading
+ *
+ * @param offscreen             the offscreen target
+ * @param bitmap                the bitmap, the pixels out of the bitmap or target are ignored
+ * @param wait                  wait the current frame? otherwise read the previous frame
+ *
+ * @return                      tb_true if the bitmap is updated, tb_false if no frame is ready
+ */
+tb_bool_t                       gb_gl_offscreen_read(gb_gl_offscreen_ref_t offscreen, gb_bitmap_ref_t bitmap, tb_bool_t wait);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
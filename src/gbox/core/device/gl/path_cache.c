@@ -0,0 +1,218 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        path_cache.c
+ * @ingroup     core
+ */
+
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_path_cache"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "path_cache.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl path cache impl type
+typedef struct __gb_gl_path_cache_impl_t
+{
+    // the entries, key => entry
+    tb_hash_map_ref_t           entries;
+
+    // the maximum entries count
+    tb_size_t                   maxn;
+
+    // the current time for the lru
+    tb_size_t                   time;
+
+}gb_gl_path_cache_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_gl_path_cache_entry_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    gb_gl_path_cache_entry_ref_t entry = (gb_gl_path_cache_entry_ref_t)buff;
+    tb_assert_and_check_return(entry);
+
+    // delete the vertex buffer
+    if (entry->buffer) gb_glDeleteBuffers(1, &entry->buffer);
+    entry->buffer = 0;
+    entry->count  = 0;
+}
+static tb_bool_t gb_gl_path_cache_entry_pred_old(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+{
+    // the entry
+    gb_gl_path_cache_entry_ref_t entry = item? (gb_gl_path_cache_entry_ref_t)((tb_hash_map_item_ref_t)item)->data : tb_null;
+
+    // is old?
+    return (entry && entry->used <= (tb_size_t)value)? tb_true : tb_false;
+}
+static tb_void_t gb_gl_path_cache_remove_old(gb_gl_path_cache_impl_t* impl)
+{
+    // check
+    tb_assert_abort(impl && impl->entries);
+
+    /* remove the entries which are not used in the last maxn / 2 times, 
+     * at least the half of the entries will be removed in one pass
+     */
+    tb_size_t used = impl->time > (impl->maxn >> 1)? impl->time - (impl->maxn >> 1) : 0;
+    tb_remove_if((tb_iterator_ref_t)impl->entries, gb_gl_path_cache_entry_pred_old, (tb_cpointer_t)used);
+
+    // trace
+    tb_trace_d("remove old: %lu entries left", tb_hash_map_size(impl->entries));
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_path_cache_ref_t gb_gl_path_cache_init(tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(maxn, tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    gb_gl_path_cache_impl_t*    impl = tb_null;
+    do
+    {
+        // make cache
+        impl = tb_malloc0_type(gb_gl_path_cache_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init maxn
+        impl->maxn = maxn;
+
+        // init entries
+        impl->entries = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_SMALL, tb_element_mem(sizeof(gb_gl_path_cache_key_t), tb_null, tb_null), tb_element_mem(sizeof(gb_gl_path_cache_entry_t), gb_gl_path_cache_entry_free, tb_null));
+        tb_assert_and_check_break(impl->entries);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_path_cache_exit((gb_gl_path_cache_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_gl_path_cache_ref_t)impl;
+}
+tb_void_t gb_gl_path_cache_exit(gb_gl_path_cache_ref_t cache)
+{
+    // check
+    gb_gl_path_cache_impl_t* impl = (gb_gl_path_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // exit entries
+    if (impl->entries) tb_hash_map_exit(impl->entries);
+    impl->entries = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_gl_path_cache_clear(gb_gl_path_cache_ref_t cache)
+{
+    // check
+    gb_gl_path_cache_impl_t* impl = (gb_gl_path_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl && impl->entries);
+
+    // clear entries
+    tb_hash_map_clear(impl->entries);
+
+    // clear time
+    impl->time = 0;
+}
+gb_gl_path_cache_entry_ref_t gb_gl_path_cache_get(gb_gl_path_cache_ref_t cache, gb_gl_path_cache_key_ref_t key, tb_bool_t* added)
+{
+    // check
+    gb_gl_path_cache_impl_t* impl = (gb_gl_path_cache_impl_t*)cache;
+    tb_assert_and_check_return_val(impl && impl->entries && key, tb_null);
+
+    // update time
+    impl->time++;
+
+    // find it
+    gb_gl_path_cache_entry_ref_t entry = (gb_gl_path_cache_entry_ref_t)tb_hash_map_get(impl->entries, key);
+    if (entry)
+    {
+        // update the used time
+        entry->used = impl->time;
+
+        // found
+        if (added) *added = tb_false;
+        return entry;
+    }
+
+    // full? remove the least recently used entries
+    if (tb_hash_map_size(impl->entries) >= impl->maxn) gb_gl_path_cache_remove_old(impl);
+
+    // add a new empty entry
+    gb_gl_path_cache_entry_t entry_new = {0};
+    entry_new.used = impl->time;
+    tb_hash_map_insert(impl->entries, key, &entry_new);
+
+    // trace
+    tb_trace_d("add: version: %lu, type: %u, size: %lu", key->version, key->type, tb_hash_map_size(impl->entries));
+
+    // ok
+    if (added) *added = tb_true;
+    return (gb_gl_path_cache_entry_ref_t)tb_hash_map_get(impl->entries, key);
+}
+tb_bool_t gb_gl_path_cache_upload(gb_gl_path_cache_ref_t cache, gb_gl_path_cache_entry_ref_t entry, gb_point_ref_t points, tb_size_t count)
+{
+    // check
+    gb_gl_path_cache_impl_t* impl = (gb_gl_path_cache_impl_t*)cache;
+    tb_assert_and_check_return_val(impl && entry, tb_false);
+
+    // make the vertex buffer
+    if (!entry->buffer) gb_glGenBuffers(1, &entry->buffer);
+    tb_assert_and_check_return_val(entry->buffer, tb_false);
+
+    // no triangles? 
+    if (count < 3) count = 0;
+
+    // upload the vertices
+    gb_glBindBuffer(GB_GL_ARRAY_BUFFER, entry->buffer);
+    gb_glBufferData(GB_GL_ARRAY_BUFFER, (gb_GLsizeiptr_t)(count * sizeof(gb_point_t)), count? points : tb_null, GB_GL_STATIC_DRAW);
+    gb_glBindBuffer(GB_GL_ARRAY_BUFFER, 0);
+
+    // save count
+    entry->count = count;
+
+    // trace
+    tb_trace_d("upload: %lu vertices", count);
+
+    // ok
+    return tb_true;
+}
@@ -0,0 +1,151 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        path_cache.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_PATH_CACHE_H
+#define GB_CORE_DEVICE_GL_PATH_CACHE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl path cache geometry type enum
+typedef enum __gb_gl_path_cache_type_e
+{
+    GB_GL_PATH_CACHE_TYPE_FILL          = 0
+,   GB_GL_PATH_CACHE_TYPE_STROKE        = 1
+
+}gb_gl_path_cache_type_e;
+
+// the gl path cache key type
+typedef struct __gb_gl_path_cache_key_t
+{
+    // the path version
+    tb_size_t                   version;
+
+    // the geometry type
+    tb_uint8_t                  type;
+
+    // the fill rule for filling
+    tb_uint8_t                  rule;
+
+    // the cap for stroking
+    tb_uint8_t                  cap;
+
+    // the join for stroking
+    tb_uint8_t                  join;
+
+    // the width for stroking
+    gb_float_t                  width;
+
+    // the miter limit for stroking
+    gb_float_t                  miter;
+
+}gb_gl_path_cache_key_t, *gb_gl_path_cache_key_ref_t;
+
+// the gl path cache entry type
+typedef struct __gb_gl_path_cache_entry_t
+{
+    // the vertex buffer of the triangle strip, 0: not made
+    gb_GLuint_t                 buffer;
+
+    // the vertices count
+    tb_size_t                   count;
+
+    // the last used time
+    tb_size_t                   used;
+
+}gb_gl_path_cache_entry_t, *gb_gl_path_cache_entry_ref_t;
+
+/*! the gl path cache ref type
+ *
+ * cache the tessellated triangle strips of the static paths in the vertex buffers, 
+ * the vertex matrix is applied by gpu, so the cached geometries are independent of the matrix.
+ *
+ * the path is cached only when it is drawn again with the same version, 
+ * and the least recently used entries will be removed if the cache is full.
+ */
+typedef struct{}*               gb_gl_path_cache_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init path cache
+ *
+ * @param maxn                  the maximum entries count
+ *
+ * @return                      the path cache
+ */
+gb_gl_path_cache_ref_t          gb_gl_path_cache_init(tb_size_t maxn);
+
+/* exit path cache and delete all vertex buffers
+ *
+ * @param cache                 the path cache
+ */
+tb_void_t                       gb_gl_path_cache_exit(gb_gl_path_cache_ref_t cache);
+
+/* clear path cache and delete all vertex buffers
+ *
+ * @param cache                 the path cache
+ */
+tb_void_t                       gb_gl_path_cache_clear(gb_gl_path_cache_ref_t cache);
+
+/* get the cached entry of the given key 
+ *
+ * the new empty entry will be added if it is not found
+ *
+ * @param cache                 the path cache
+ * @param key                   the key, the padding bytes must be zero
+ * @param added                 return tb_true if the new entry is added
+ *
+ * @return                      the entry
+ */
+gb_gl_path_cache_entry_ref_t    gb_gl_path_cache_get(gb_gl_path_cache_ref_t cache, gb_gl_path_cache_key_ref_t key, tb_bool_t* added);
+
+/* upload the triangle strip to the vertex buffer of the entry
+ *
+ * @param cache                 the path cache
+ * @param entry                 the entry
+ * @param points                the points of the triangle strip
+ * @param count                 the points count
+ *
+ * @return                      tb_true or tb_false
+ */
+tb_bool_t                       gb_gl_path_cache_upload(gb_gl_path_cache_ref_t cache, gb_gl_path_cache_entry_ref_t entry, gb_point_ref_t points, tb_size_t count);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -29,6 +29,19 @@
 #include "../prefix.h"
 #include "interface.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the vertex type
+#if defined(GB_CONFIG_FLOAT_FIXED) && defined(GB_GL_FIXED)
+#   define GB_GL_VERTEX_TYPE            GB_GL_FIXED
+#elif defined(GB_CONFIG_FLOAT_FIXED)
+#   define GB_GL_VERTEX_TYPE            GL_GL_INT
+#else
+#   define GB_GL_VERTEX_TYPE            GB_GL_FLOAT
+#endif
+
 #endif
 
 
@@ -54,6 +54,18 @@ typedef struct __gb_gl_program_impl_t
     // the locations
     gb_GLint_t          location[GB_GL_PROGRAM_LOCATION_MAXN];
 
+    // the uploaded matrices for the model, project and texcoord uniforms
+    gb_gl_matrix_t      matrices[3];
+
+    // the uploaded matrices flags
+    tb_uint8_t          matrices_flag;
+
+    // the uploaded integers
+    gb_GLint_t          integers[GB_GL_PROGRAM_LOCATION_MAXN];
+
+    // the uploaded integers flags
+    tb_uint16_t         integers_flag;
+
 }gb_gl_program_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -229,4 +241,38 @@ tb_void_t gb_gl_program_location_set(gb_gl_program_ref_t program, tb_size_t id,
     // save location
     impl->location[id] = location;
 }
+tb_void_t gb_gl_program_matrix_set(gb_gl_program_ref_t program, tb_size_t id, gb_gl_matrix_ref_t matrix)
+{
+    // check
+    gb_gl_program_impl_t* impl = (gb_gl_program_impl_t*)program;
+    tb_assert_and_check_return(impl && matrix && id >= GB_GL_PROGRAM_LOCATION_MATRIX_MODEL && id <= GB_GL_PROGRAM_LOCATION_MATRIX_TEXCOORD);
+
+    // the matrix index
+    tb_size_t index = id - GB_GL_PROGRAM_LOCATION_MATRIX_MODEL;
+
+    // not changed?
+    if ((impl->matrices_flag & (1 << index)) && !tb_memcmp(impl->matrices[index], matrix, sizeof(gb_gl_matrix_t))) return ;
+
+    // upload it
+    gb_glUniformMatrix4fv(impl->location[id], 1, GB_GL_FALSE, matrix);
 
+    // save it
+    tb_memcpy(impl->matrices[index], matrix, sizeof(gb_gl_matrix_t));
+    impl->matrices_flag |= (1 << index);
+}
+tb_void_t gb_gl_program_integer_set(gb_gl_program_ref_t program, tb_size_t id, gb_GLint_t value)
+{
+    // check
+    gb_gl_program_impl_t* impl = (gb_gl_program_impl_t*)program;
+    tb_assert_and_check_return(impl && id < GB_GL_PROGRAM_LOCATION_MAXN);
+
+    // not changed?
+    if ((impl->integers_flag & (1 << id)) && impl->integers[id] == value) return ;
+
+    // upload it
+    gb_glUniform1i(impl->location[id], value);
+
+    // save it
+    impl->integers[id] = value;
+    impl->integers_flag |= (1 << id);
+}
@@ -28,6 +28,7 @@
  * includes
  */
 #include "prefix.h"
+#include "matrix.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -44,7 +45,9 @@ typedef enum __gb_gl_program_type_e
     GB_GL_PROGRAM_TYPE_NONE         = 0
 ,   GB_GL_PROGRAM_TYPE_COLOR        = 1
 ,   GB_GL_PROGRAM_TYPE_BITMAP       = 2
-,   GB_GL_PROGRAM_TYPE_MAXN         = 3
+,   GB_GL_PROGRAM_TYPE_LINEAR       = 3
+,   GB_GL_PROGRAM_TYPE_RADIAL       = 4
+,   GB_GL_PROGRAM_TYPE_MAXN         = 5
 
 }gb_gl_program_type_e;
 
@@ -58,7 +61,10 @@ typedef enum __gb_gl_program_location_e
 ,   GB_GL_PROGRAM_LOCATION_MATRIX_MODEL         = 4
 ,   GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT       = 5
 ,   GB_GL_PROGRAM_LOCATION_MATRIX_TEXCOORD      = 6
-,   GB_GL_PROGRAM_LOCATION_MAXN                 = 7
+,   GB_GL_PROGRAM_LOCATION_MODE                 = 7
+,   GB_GL_PROGRAM_LOCATION_TEXRECT              = 8
+,   GB_GL_PROGRAM_LOCATION_TEXCLAMP             = 9
+,   GB_GL_PROGRAM_LOCATION_MAXN                 = 10
 
 }gb_gl_program_location_e;
 
@@ -91,6 +97,18 @@ gb_gl_program_ref_t     gb_gl_program_init_color(tb_noarg_t);
  */
 gb_gl_program_ref_t     gb_gl_program_init_bitmap(tb_noarg_t);
 
+/* init linear gradient program
+ *
+ * @return              the program
+ */
+gb_gl_program_ref_t     gb_gl_program_init_linear(tb_noarg_t);
+
+/* init radial gradient program
+ *
+ * @return              the program
+ */
+gb_gl_program_ref_t     gb_gl_program_init_radial(tb_noarg_t);
+
 /* exit gl program
  *
  * @param program       the program
@@ -139,6 +157,26 @@ gb_GLint_t              gb_gl_program_location(gb_gl_program_ref_t program, tb_s
  */
 tb_void_t               gb_gl_program_location_set(gb_gl_program_ref_t program, tb_size_t id, gb_GLint_t location);
 
+/* apply the matrix to the uniform of the given location id
+ *
+ * the uploaded matrix is cached and the uniform will not be uploaded again if it is not changed
+ *
+ * @param program       the program
+ * @param id            the location id, .e.g GB_GL_PROGRAM_LOCATION_MATRIX_MODEL, ...
+ * @param matrix        the matrix
+ */
+tb_void_t               gb_gl_program_matrix_set(gb_gl_program_ref_t program, tb_size_t id, gb_gl_matrix_ref_t matrix);
+
+/* apply the integer to the uniform of the given location id
+ *
+ * the uploaded integer is cached and the uniform will not be uploaded again if it is not changed
+ *
+ * @param program       the program
+ * @param id            the location id, .e.g GB_GL_PROGRAM_LOCATION_SAMPLER, GB_GL_PROGRAM_LOCATION_MODE, ...
+ * @param value         the integer value
+ */
+tb_void_t               gb_gl_program_integer_set(gb_gl_program_ref_t program, tb_size_t id, gb_GLint_t value);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -32,43 +32,70 @@
  */
 gb_gl_program_ref_t gb_gl_program_init_bitmap()
 {
-    // the vertex shader
+    /* the vertex shader, the texcoord matrix maps the vertices to the normalized bitmap space
+     *
+     * the batched vertices use the zero texcoord matrix and the per-vertex texcoords, texrects and texclamps,
+     * the others use the texcoord matrix and the constant attributes
+     */
     static tb_char_t const* vshader = 
 #if defined(TB_CONFIG_OS_IOS) || defined(TB_CONFIG_OS_ANDROID)
-        "precision mediump float;                                                           \n"
+        "precision mediump float;                                                            \n"
 #endif
-        "                                                                                   \n"
-        "attribute vec4 aColor;                                                             \n"
-        "attribute vec4 aTexcoords;                                                         \n"
-        "attribute vec4 aVertices;                                                          \n"
-        "                                                                                   \n"
-        "varying vec4 vColors;                                                              \n"
-        "varying vec4 vTexcoords;                                                           \n"
-        "uniform mat4 uMatrixModel;                                                         \n"
-        "uniform mat4 uMatrixProject;                                                       \n"
-        "uniform mat4 uMatrixTexcoord;                                                      \n"
-        "                                                                                   \n"
-        "void main()                                                                        \n"
-        "{                                                                                  \n"
-        "   vColors = aColor;                                                               \n" 
-        "   vTexcoords = uMatrixTexcoord * aTexcoords;                                      \n"  
-        "   gl_Position = uMatrixProject * uMatrixModel * aVertices;                        \n"
-        "}                                                                                  \n";
+        "                                                                                    \n"
+        "attribute vec4 aColor;                                                              \n"
+        "attribute vec4 aVertices;                                                           \n"
+        "attribute vec4 aTexcoords;                                                          \n"
+        "attribute vec4 aTexrect;                                                            \n"
+        "attribute vec4 aTexclamp;                                                           \n"
+        "                                                                                    \n"
+        "varying vec4 vColors;                                                               \n"
+        "varying vec4 vTexcoords;                                                            \n"
+        "varying vec4 vTexrect;                                                              \n"
+        "varying vec4 vTexclamp;                                                             \n"
+        "uniform mat4 uMatrixModel;                                                          \n"
+        "uniform mat4 uMatrixProject;                                                        \n"
+        "uniform mat4 uMatrixTexcoord;                                                       \n"
+        "                                                                                    \n"
+        "void main()                                                                         \n"
+        "{                                                                                   \n"
+        "   vColors = aColor;                                                                \n"
+        "   vTexcoords = uMatrixTexcoord * aVertices + aTexcoords;                           \n"
+        "   vTexrect = aTexrect;                                                             \n"
+        "   vTexclamp = aTexclamp;                                                           \n"
+        "   gl_Position = uMatrixProject * uMatrixModel * aVertices;                         \n"
+        "}                                                                                   \n";
     
-    // the fragment shader
+    /* the fragment shader, the bitmap may be packed into the atlas texture
+     *
+     * the mode: 1: border, 2: clamp, 3: repeat, 4: mirror
+     * the texrect: the normalized rect of the bitmap in the texture: x, y, width, height
+     * the texclamp: the normalized texel-center bounds of the bitmap in the texture: x0, y0, x1, y1
+     */
     static tb_char_t const* fshader = 
 #if defined(TB_CONFIG_OS_IOS) || defined(TB_CONFIG_OS_ANDROID)
-        "precision mediump float;                                                           \n"
+        "precision mediump float;                                                            \n"
 #endif
-        "                                                                                   \n"
-        "varying vec4 vColors;                                                              \n"
-        "varying vec4 vTexcoords;                                                           \n"
-        "uniform sampler2D uSampler;                                                        \n"
-        "                                                                                   \n"
-        "void main()                                                                        \n"
-        "{                                                                                  \n"
-        "   gl_FragColor = vColors * texture2D(uSampler, vec2(vTexcoords.x, vTexcoords.y)); \n"
-        "}                                                                                  \n";
+        "                                                                                    \n"
+        "varying vec4 vColors;                                                               \n"
+        "varying vec4 vTexcoords;                                                            \n"
+        "varying vec4 vTexrect;                                                              \n"
+        "varying vec4 vTexclamp;                                                             \n"
+        "uniform sampler2D uSampler;                                                         \n"
+        "uniform int uMode;                                                                  \n"
+        "                                                                                    \n"
+        "void main()                                                                         \n"
+        "{                                                                                   \n"
+        "   vec2 t = vTexcoords.xy;                                                          \n"
+        "                                                                                    \n"
+        "   // border? clamp? repeat? mirror?                                                \n"
+        "   if (uMode == 1 && (t.x < 0.0 || t.x > 1.0 || t.y < 0.0 || t.y > 1.0)) discard;   \n"
+        "   else if (uMode == 3) t = fract(t);                                               \n"
+        "   else if (uMode == 4) t = 1.0 - abs(mod(t, 2.0) - 1.0);                           \n"
+        "                                                                                    \n"
+        "   // map to the texture and avoid sampling the neighbouring bitmaps in the atlas   \n"
+        "   vec2 uv = clamp(vTexrect.xy + t * vTexrect.zw, vTexclamp.xy, vTexclamp.zw);      \n"
+        "   gl_FragColor = vColors * texture2D(uSampler, uv);                                \n"
+        "}                                                                                   \n";
 
     // init program
     gb_gl_program_ref_t program = gb_gl_program_init(GB_GL_PROGRAM_TYPE_BITMAP, vshader, fshader);
@@ -78,6 +105,10 @@ gb_gl_program_ref_t gb_gl_program_init_bitmap()
     gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_COLORS,          gb_gl_program_attr(program, "aColor"));
     gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_VERTICES,        gb_gl_program_attr(program, "aVertices"));
     gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_TEXCOORDS,       gb_gl_program_attr(program, "aTexcoords"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_TEXRECT,         gb_gl_program_attr(program, "aTexrect"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_TEXCLAMP,        gb_gl_program_attr(program, "aTexclamp"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_SAMPLER,         gb_gl_program_unif(program, "uSampler"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MODE,            gb_gl_program_unif(program, "uMode"));
     gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MATRIX_MODEL,    gb_gl_program_unif(program, "uMatrixModel"));
     gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT,  gb_gl_program_unif(program, "uMatrixProject"));
     gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MATRIX_TEXCOORD, gb_gl_program_unif(program, "uMatrixTexcoord"));
@@ -85,4 +116,3 @@ gb_gl_program_ref_t gb_gl_program_init_bitmap()
     // ok
     return program;
 }
-
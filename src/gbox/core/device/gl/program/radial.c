@@ -0,0 +1,101 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        radial.c
+ * @ingroup     core
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_program_ref_t gb_gl_program_init_radial()
+{
+    // the vertex shader, the texcoord matrix maps the vertices to the gradient space
+    static tb_char_t const* vshader = 
+#if defined(TB_CONFIG_OS_IOS) || defined(TB_CONFIG_OS_ANDROID)
+        "precision mediump float;                                                            \n"
+#endif
+        "                                                                                    \n"
+        "attribute vec4 aColor;                                                              \n"
+        "attribute vec4 aVertices;                                                           \n"
+        "                                                                                    \n"
+        "varying vec4 vColors;                                                               \n"
+        "varying vec4 vTexcoords;                                                            \n"
+        "uniform mat4 uMatrixModel;                                                          \n"
+        "uniform mat4 uMatrixProject;                                                        \n"
+        "uniform mat4 uMatrixTexcoord;                                                       \n"
+        "                                                                                    \n"
+        "void main()                                                                         \n"
+        "{                                                                                   \n"
+        "   vColors = aColor;                                                                \n"
+        "   vTexcoords = uMatrixTexcoord * aVertices;                                        \n"
+        "   gl_Position = uMatrixProject * uMatrixModel * aVertices;                         \n"
+        "}                                                                                   \n";
+    
+    /* the fragment shader, the gradient factor is the distance to the center in the unit circle space: |p - c| / r
+     *
+     * the mode: 1: border, 2: clamp, 3: repeat, 4: mirror
+     */
+    static tb_char_t const* fshader = 
+#if defined(TB_CONFIG_OS_IOS) || defined(TB_CONFIG_OS_ANDROID)
+        "precision mediump float;                                                            \n"
+#endif
+        "                                                                                    \n"
+        "varying vec4 vColors;                                                               \n"
+        "varying vec4 vTexcoords;                                                            \n"
+        "uniform sampler2D uSampler;                                                         \n"
+        "uniform int uMode;                                                                  \n"
+        "                                                                                    \n"
+        "void main()                                                                         \n"
+        "{                                                                                   \n"
+        "   float t = length(vTexcoords.xy);                                                 \n"
+        "                                                                                    \n"
+        "   // border? clamp? repeat? mirror?                                                \n"
+        "   if (uMode == 1 && (t < 0.0 || t > 1.0)) discard;                                 \n"
+        "   else if (uMode == 3) t = fract(t);                                               \n"
+        "   else if (uMode == 4) t = 1.0 - abs(mod(t, 2.0) - 1.0);                           \n"
+        "   t = clamp(t, 0.0, 1.0);                                                          \n"
+        "                                                                                    \n"
+        "   // sample between the first and last texel centers of the ramp                   \n"
+        "   vec4 color = texture2D(uSampler, vec2(t * 0.99609375 + 0.001953125, 0.5));       \n"
+        "   gl_FragColor = vec4(color.rgb, color.a * vColors.a);                             \n"
+        "}                                                                                   \n";
+
+    // init program
+    gb_gl_program_ref_t program = gb_gl_program_init(GB_GL_PROGRAM_TYPE_RADIAL, vshader, fshader);
+    tb_assert_and_check_return_val(program, tb_null);
+
+    // init location
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_COLORS,          gb_gl_program_attr(program, "aColor"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_VERTICES,        gb_gl_program_attr(program, "aVertices"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_SAMPLER,         gb_gl_program_unif(program, "uSampler"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MODE,            gb_gl_program_unif(program, "uMode"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MATRIX_MODEL,    gb_gl_program_unif(program, "uMatrixModel"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT,  gb_gl_program_unif(program, "uMatrixProject"));
+    gb_gl_program_location_set(program, GB_GL_PROGRAM_LOCATION_MATRIX_TEXCOORD, gb_gl_program_unif(program, "uMatrixTexcoord"));
+
+    // ok
+    return program;
+}
@@ -32,22 +32,42 @@
  * includes
  */
 #include "render.h"
+#include "shader.h"
+#include "../../shader.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
 
-// the vertex type
-#if defined(GB_CONFIG_FLOAT_FIXED) && defined(GB_GL_FIXED)
-#   define GB_GL_VERTEX_TYPE            GB_GL_FIXED
-#elif defined(GB_CONFIG_FLOAT_FIXED)
-#   define GB_GL_VERTEX_TYPE            GL_GL_INT
+// test tessellator
+//#define GB_GL_TESSELLATOR_TEST_ENABLE   
+
+// the fill output, the convex polygons are always used for testing tessellator
+#ifdef GB_GL_TESSELLATOR_TEST_ENABLE
+#   define GB_GL_RENDER_FILL_OUTPUT     GB_GL_RENDER_FILL_OUTPUT_CONVEX
 #else
-#   define GB_GL_VERTEX_TYPE            GB_GL_FLOAT
+#   define GB_GL_RENDER_FILL_OUTPUT     GB_GL_RENDER_FILL_OUTPUT_STRIP
 #endif
 
-// test tessellator
-//#define GB_GL_TESSELLATOR_TEST_ENABLE   
+// the minimum edges count of the concave polygon for the stencil-then-cover filling
+#define GB_GL_RENDER_STENCIL_EDGES_MINN         (256)
+
+// the minimum contours and edges count of the concave polygon for the stencil-then-cover filling
+#define GB_GL_RENDER_STENCIL_CONTOURS_MINN      (8)
+#define GB_GL_RENDER_STENCIL_CONTOURS_EDGES_MINN (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the fill output enum
+typedef enum __gb_gl_render_fill_output_e
+{
+    GB_GL_RENDER_FILL_OUTPUT_CONVEX     = 0     //!< draw a triangle fan for each convex polygon
+,   GB_GL_RENDER_FILL_OUTPUT_STRIP      = 1     //!< draw one triangle strip made from all monotone polygons
+,   GB_GL_RENDER_FILL_OUTPUT_STENCIL    = 2     //!< draw the contour fans to the stencil buffer and cover the bounds
+
+}gb_gl_render_fill_output_e;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
@@ -72,33 +92,37 @@ static tb_void_t gb_gl_render_apply_vertices(gb_gl_device_ref_t device, gb_point
         gb_glVertexPointer(2, GB_GL_VERTEX_TYPE, 0, points);
     }
 }
-static tb_void_t gb_gl_render_enter_solid(gb_gl_device_ref_t device)
+static __tb_inline__ tb_bool_t gb_gl_render_batch_enabled(gb_gl_device_ref_t device)
+{
+#ifdef GB_GL_TESSELLATOR_TEST_ENABLE
+    // draw the colored convex polygons one by one for testing tessellator
+    return tb_false;
+#else
+    // only batch the solid and bitmap geometries for gl >= 2.0
+    return (device->batch && device->version >= 0x20 && (!device->shader || device->batch_texture))? tb_true : tb_false;
+#endif
+}
+static __tb_inline__ tb_bool_t gb_gl_render_batch_solid(gb_gl_device_ref_t device)
+{
+    // the batched solid geometries
+    return (!device->shader && gb_gl_render_batch_enabled(device))? tb_true : tb_false;
+}
+static __tb_inline__ tb_bool_t gb_gl_render_fringe_enabled(gb_gl_device_ref_t device)
+{
+    // only add the fringe for the batched solid geometries
+    return (device->fringe_ok && gb_gl_render_batch_solid(device))? tb_true : tb_false;
+}
+static tb_void_t gb_gl_render_apply_color(gb_gl_device_ref_t device, gb_color_t color)
 {
     // check
     tb_assert_abort(device);
- 
-    // the paint
-    gb_paint_ref_t paint = device->base.paint;
-    tb_assert_abort(paint);
-
-    // the color 
-    gb_color_t color = gb_paint_color(paint);
-
-    // the alpha
-    tb_byte_t alpha = gb_paint_alpha(paint);
-
-    // disable texture
-    gb_glDisable(GB_GL_TEXTURE_2D);
 
     // exists alpha?
-    if (alpha != 0xff)
+    if (color.a != 0xff)
     {
         // enable blend
         gb_glEnable(GB_GL_BLEND);
         gb_glBlendFunc(GB_GL_SRC_ALPHA, GB_GL_ONE_MINUS_SRC_ALPHA);
-
-        // apply the alpha 
-        color.a = alpha;
     }
     else
     {
@@ -121,42 +145,163 @@ static tb_void_t gb_gl_render_enter_solid(gb_gl_device_ref_t device)
         gb_glColor4f((gb_GLfloat_t)color.r / 0xff, (gb_GLfloat_t)color.g / 0xff, (gb_GLfloat_t)color.b / 0xff, (gb_GLfloat_t)color.a / 0xff);
     }
 }
+static tb_bool_t gb_gl_render_apply_texture(gb_gl_device_ref_t device)
+{
+    // check
+    tb_assert_abort(device && device->shader && device->program && device->base.paint);
+
+    /* apply the ramp or bitmap texture, mode and texcoord matrix
+     *
+     * the draw will be skipped if the shader matrix is not invertible or the texture is not uploaded
+     */
+    tb_check_return_val(gb_gl_shader_apply(device->shader, device->program), tb_false);
+
+    // the alpha
+    tb_byte_t alpha = gb_paint_alpha(device->base.paint);
+
+    // enable blend if the shader or paint is not opaque
+    if (alpha != 0xff || !gb_gl_shader_opaque(device->shader))
+    {
+        gb_glEnable(GB_GL_BLEND);
+        gb_glBlendFunc(GB_GL_SRC_ALPHA, GB_GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else gb_glDisable(GB_GL_BLEND);
+
+    // apply the alpha of the paint
+    gb_glVertexAttrib4f(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_COLORS), 1.0f, 1.0f, 1.0f, (gb_GLfloat_t)alpha / 0xff);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_gl_render_apply_immediate(gb_gl_device_ref_t device)
+{
+    // check
+    tb_assert_abort(device);
+
+    // not batched?
+    tb_check_return(gb_gl_render_batch_enabled(device));
+
+    // flush the pending geometries before drawing the primitives from the client-side memory
+    gb_gl_batch_flush(device->batch);
+
+    // apply the bitmap texture which is not applied for the batched geometries
+    if (device->shader) gb_gl_render_apply_texture(device);
+    // apply the solid color which is not applied for the batched geometries
+    else gb_gl_render_apply_color(device, device->color);
+}
+static tb_void_t gb_gl_render_enter_solid(gb_gl_device_ref_t device)
+{
+    // check
+    tb_assert_abort(device);
+ 
+    // the paint
+    gb_paint_ref_t paint = device->base.paint;
+    tb_assert_abort(paint);
+
+    // the color 
+    gb_color_t color = gb_paint_color(paint);
+
+    // the alpha
+    tb_byte_t alpha = gb_paint_alpha(paint);
+
+    // apply the alpha 
+    if (alpha != 0xff) color.a = alpha;
+
+    // save color
+    device->color = color;
+
+    // the batched geometries use the per-vertex colors
+    tb_check_return(!gb_gl_render_batch_enabled(device));
+
+    // disable texture
+    gb_glDisable(GB_GL_TEXTURE_2D);
+
+    // apply color
+    gb_gl_render_apply_color(device, color);
+}
 static tb_void_t gb_gl_render_leave_solid(gb_gl_device_ref_t device)
 {    
     // check
     tb_assert_abort(device);
  
+    // the blend state will be applied when flushing the batch
+    tb_check_return(!gb_gl_render_batch_enabled(device));
+
     // disable blend
     gb_glDisable(GB_GL_BLEND);
 }
-static tb_void_t gb_gl_render_enter_shader(gb_gl_device_ref_t device)
+static __tb_inline__ tb_bool_t gb_gl_render_texture_enabled(gb_gl_device_ref_t device)
+{
+    // the gradient and bitmap shaders are only made for gl >= 2.0
+    tb_size_t type = device->shader? gb_shader_type(device->shader) : GB_SHADER_TYPE_NONE;
+    return (device->version >= 0x20 && (type == GB_SHADER_TYPE_LINEAR || type == GB_SHADER_TYPE_RADIAL || type == GB_SHADER_TYPE_BITMAP))? tb_true : tb_false;
+}
+static tb_bool_t gb_gl_render_enter_texture(gb_gl_device_ref_t device)
+{
+    // check
+    tb_assert_abort(device && device->shader && device->base.paint);
+
+    // the batched bitmap uses the per-vertex texcoords and the white color with the paint alpha
+    if (device->batch_texture)
+    {
+        gb_color_t color = GB_COLOR_WHITE;
+        color.a = gb_paint_alpha(device->base.paint);
+        device->color = color;
+        return tb_true;
+    }
+
+    // apply the texture
+    return gb_gl_render_apply_texture(device);
+}
+static tb_bool_t gb_gl_render_enter_shader(gb_gl_device_ref_t device)
 {   
     // check
     tb_assert_abort(device && device->base.paint);
+
+    // enter the gradient or bitmap shader
+    if (gb_gl_render_texture_enabled(device)) return gb_gl_render_enter_texture(device);
  
     // disable blend
     gb_glDisable(GB_GL_BLEND);
 
     // enable texture
     gb_glEnable(GB_GL_TEXTURE_2D);
+
+    // ok
+    return tb_true;
 }
 static tb_void_t gb_gl_render_leave_shader(gb_gl_device_ref_t device)
 {   
     // check
     tb_assert_abort(device);
+
+    // leave the gradient or bitmap shader
+    if (gb_gl_render_texture_enabled(device))
+    {
+        // unbind the texture
+        gb_glBindTexture(GB_GL_TEXTURE_2D, 0);
+
+        // disable blend
+        gb_glDisable(GB_GL_BLEND);
+        return ;
+    }
  
     // disable texture
     gb_glDisable(GB_GL_TEXTURE_2D);
 }
-static tb_void_t gb_gl_render_enter_paint(gb_gl_device_ref_t device)
+static tb_bool_t gb_gl_render_enter_paint(gb_gl_device_ref_t device)
 {
     // check
     tb_assert_abort(device);
 
-    // enter shader
-    if (device->shader) gb_gl_render_enter_shader(device);
+    // enter shader, the shader may be not applied
+    if (device->shader) return gb_gl_render_enter_shader(device);
+
     // enter solid
-    else gb_gl_render_enter_solid(device);
+    gb_gl_render_enter_solid(device);
+
+    // ok
+    return tb_true;
 }
 static tb_void_t gb_gl_render_leave_paint(gb_gl_device_ref_t device)
 {
@@ -171,17 +316,23 @@ static tb_void_t gb_gl_render_leave_paint(gb_gl_device_ref_t device)
 static tb_void_t gb_gl_render_fill_convex(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
 {
     // check
-    tb_assert_abort(priv && points && count);
-
-    // apply it
-    gb_gl_render_apply_vertices((gb_gl_device_ref_t)priv, points);
+    gb_gl_device_ref_t device = (gb_gl_device_ref_t)priv;
+    tb_assert_abort(device && points && count);
 
 #ifndef GB_GL_TESSELLATOR_TEST_ENABLE
-    // draw it
-    gb_glDrawArrays(GB_GL_TRIANGLE_FAN, 0, (gb_GLint_t)count);
+    // add it to the batch
+    if (gb_gl_render_batch_enabled(device)) gb_gl_batch_add_fan(device->batch, points, count, device->color);
+    else
+    {
+        // apply it
+        gb_gl_render_apply_vertices(device, points);
+
+        // draw it
+        gb_glDrawArrays(GB_GL_TRIANGLE_FAN, 0, (gb_GLint_t)count);
+    }
 #else
-    // the device 
-    gb_gl_device_ref_t device = (gb_gl_device_ref_t)priv;
+    // apply it
+    gb_gl_render_apply_vertices(device, points);
 
     // make crc32
     tb_uint32_t crc32 = 0xffffffff ^ tb_crc_encode(TB_CRC_MODE_32_IEEE_LE, 0xffffffff, (tb_byte_t const*)points, count * sizeof(gb_point_t));
@@ -208,31 +359,188 @@ static tb_void_t gb_gl_render_fill_convex(gb_point_ref_t points, tb_uint16_t cou
     gb_glEnable(GB_GL_BLEND);
 #endif
 }
-static tb_void_t gb_gl_render_fill_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule)
+static tb_void_t gb_gl_render_fill_monotone(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_gl_device_ref_t device = (gb_gl_device_ref_t)priv;
+    tb_assert_abort(device && device->strip && points && count);
+
+    // add it to the triangle strip
+    gb_triangle_strip_add_monotone(device->strip, points, count);
+}
+static tb_size_t gb_gl_render_make_strip(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule)
+{
+    // check
+    tb_assert_abort(device && device->tessellator && device->strip);
+
+    // clear the triangle strip
+    gb_triangle_strip_clear(device->strip);
+
+    // set rule, mode and func
+    gb_tessellator_rule_set(device->tessellator, rule);
+    gb_tessellator_mode_set(device->tessellator, GB_TESSELLATOR_MODE_MONOTONE);
+    gb_tessellator_func_set(device->tessellator, gb_gl_render_fill_monotone, device);
+
+    // done tessellator
+    gb_tessellator_done(device->tessellator, polygon, bounds);
+
+    // the points count of the triangle strip
+    return gb_triangle_strip_size(device->strip);
+}
+static tb_void_t gb_gl_render_cover_stencil(gb_gl_device_ref_t device, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert_abort(device && bounds);
+
+    // cover the bounds for the non-zero stencil values and clear them
+    gb_glColorMask(GB_GL_TRUE, GB_GL_TRUE, GB_GL_TRUE, GB_GL_TRUE);
+    gb_glStencilFunc(GB_GL_NOTEQUAL, 0, 0xff);
+    gb_glStencilOp(GB_GL_ZERO, GB_GL_ZERO, GB_GL_ZERO);
+
+    // make the bounds rect
+    gb_point_t rect[4];
+    rect[0].x = bounds->x;
+    rect[0].y = bounds->y;
+    rect[1].x = bounds->x + bounds->w;
+    rect[1].y = bounds->y;
+    rect[2].x = bounds->x + bounds->w;
+    rect[2].y = bounds->y + bounds->h;
+    rect[3].x = bounds->x;
+    rect[3].y = bounds->y + bounds->h;
+
+    // draw the bounds rect
+    gb_gl_render_apply_vertices(device, rect);
+    gb_glDrawArrays(GB_GL_TRIANGLE_FAN, 0, 4);
+
+    // disable stencil test
+    gb_glDisable(GB_GL_STENCIL_TEST);
+}
+static tb_void_t gb_gl_render_fill_stencil(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule)
+{
+    // check
+    tb_assert_abort(device && polygon && polygon->points && polygon->counts && bounds);
+
+    // apply the immediate state
+    gb_gl_render_apply_immediate(device);
+
+    // enable stencil test and disable writing color
+    gb_glEnable(GB_GL_STENCIL_TEST);
+    gb_glColorMask(GB_GL_FALSE, GB_GL_FALSE, GB_GL_FALSE, GB_GL_FALSE);
+    gb_glStencilMask(0xff);
+    gb_glStencilFunc(GB_GL_ALWAYS, 0, 0xff);
+
+    // the odd rule? invert the stencil value for each covering
+    if (rule == GB_PAINT_FILL_RULE_ODD) gb_glStencilOp(GB_GL_KEEP, GB_GL_KEEP, GB_GL_INVERT);
+    // the non-zero rule? count the winding number by the orientation of the triangles
+    else
+    {
+        gb_glStencilOpSeparate(GB_GL_FRONT, GB_GL_KEEP, GB_GL_KEEP, GB_GL_INCR_WRAP);
+        gb_glStencilOpSeparate(GB_GL_BACK, GB_GL_KEEP, GB_GL_KEEP, GB_GL_DECR_WRAP);
+    }
+
+    // draw the fan of each contour to the stencil buffer
+    gb_gl_render_apply_vertices(device, polygon->points);
+    tb_uint16_t         count;
+    tb_uint16_t const*  counts = polygon->counts;
+    tb_size_t           index = 0;
+    while ((count = *counts++))
+    {
+        if (count >= 3) gb_glDrawArrays(GB_GL_TRIANGLE_FAN, (gb_GLint_t)index, (gb_GLint_t)count);
+        index += count;
+    }
+
+    // cover the bounds
+    gb_gl_render_cover_stencil(device, bounds);
+}
+static tb_size_t gb_gl_render_fill_output(gb_gl_device_ref_t device, gb_polygon_ref_t polygon)
+{
+    // check
+    tb_assert_abort(device && polygon && polygon->counts);
+
+    // no stencil buffer? 
+    tb_check_return_val(device->stencil_bits && device->version >= 0x20, GB_GL_RENDER_FILL_OUTPUT);
+
+    // the convex polygon is always tessellated fast
+    tb_check_return_val(!polygon->convex, GB_GL_RENDER_FILL_OUTPUT);
+
+    // count the contours and edges
+    tb_uint16_t         count;
+    tb_uint16_t const*  counts = polygon->counts;
+    tb_size_t           edges = 0;
+    tb_size_t           contours = 0;
+    while ((count = *counts++))
+    {
+        edges += count;
+        contours++;
+    }
+
+    /* the cost of the tessellator grows faster than the edges count for the complex polygon 
+     * with many edges or contours, but the stencil-then-cover filling is linear in the edges count
+     */
+    if (    edges >= GB_GL_RENDER_STENCIL_EDGES_MINN
+        ||  (contours >= GB_GL_RENDER_STENCIL_CONTOURS_MINN && edges >= GB_GL_RENDER_STENCIL_CONTOURS_EDGES_MINN))
+        return GB_GL_RENDER_FILL_OUTPUT_STENCIL;
+
+    // tessellate it
+    return GB_GL_RENDER_FILL_OUTPUT;
+}
+static tb_void_t gb_gl_render_fill_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_rect_ref_t bounds, tb_size_t rule, tb_size_t output)
 {
     // check
     tb_assert_abort(device && device->tessellator);
 
-#ifdef GB_GL_TESSELLATOR_TEST_ENABLE
-    // set mode
-    gb_tessellator_mode_set(device->tessellator, GB_TESSELLATOR_MODE_TRIANGULATION);
-//    gb_tessellator_mode_set(device->tessellator, GB_TESSELLATOR_MODE_MONOTONE);
-#endif
+    // fill it by the stencil buffer?
+    if (output == GB_GL_RENDER_FILL_OUTPUT_STENCIL)
+    {
+        gb_gl_render_fill_stencil(device, polygon, bounds, rule);
+        return ;
+    }
 
     // set rule
     gb_tessellator_rule_set(device->tessellator, rule);
 
-    // set func
-    gb_tessellator_func_set(device->tessellator, gb_gl_render_fill_convex, device);
+    // make one triangle strip from the monotone polygons?
+    if (output == GB_GL_RENDER_FILL_OUTPUT_STRIP && device->strip)
+    {
+        // make the triangle strip
+        tb_size_t count = gb_gl_render_make_strip(device, polygon, bounds, rule);
+        if (count >= 3)
+        {
+            // add it to the batch
+            if (gb_gl_render_batch_enabled(device)) gb_gl_batch_add_strip(device->batch, gb_triangle_strip_data(device->strip), count, device->color);
+            // draw it
+            else
+            {
+                gb_gl_render_apply_vertices(device, gb_triangle_strip_data(device->strip));
+                gb_glDrawArrays(GB_GL_TRIANGLE_STRIP, 0, (gb_GLint_t)count);
+            }
+        }
+    }
+    else
+    {
+        // set mode
+#ifdef GB_GL_TESSELLATOR_TEST_ENABLE
+        gb_tessellator_mode_set(device->tessellator, GB_TESSELLATOR_MODE_TRIANGULATION);
+//      gb_tessellator_mode_set(device->tessellator, GB_TESSELLATOR_MODE_MONOTONE);
+#else
+        gb_tessellator_mode_set(device->tessellator, GB_TESSELLATOR_MODE_CONVEX);
+#endif
 
-    // done tessellator
-    gb_tessellator_done(device->tessellator, polygon, bounds);
+        // set func
+        gb_tessellator_func_set(device->tessellator, gb_gl_render_fill_convex, device);
+
+        // done tessellator
+        gb_tessellator_done(device->tessellator, polygon, bounds);
+    }
 }
 static tb_void_t gb_gl_render_stroke_lines(gb_gl_device_ref_t device, gb_point_ref_t points, tb_size_t count)
 {
     // check
     tb_assert_abort(device && points && count);
 
+    // apply the immediate state
+    gb_gl_render_apply_immediate(device);
+
     // apply vertices
     gb_gl_render_apply_vertices(device, points);
 
@@ -244,6 +552,9 @@ static tb_void_t gb_gl_render_stroke_points(gb_gl_device_ref_t device, gb_point_
     // check
     tb_assert_abort(device && points && count);
 
+    // apply the immediate state
+    gb_gl_render_apply_immediate(device);
+
     // apply vertices
     gb_gl_render_apply_vertices(device, points);
 
@@ -255,6 +566,9 @@ static tb_void_t gb_gl_render_stroke_polygon(gb_gl_device_ref_t device, gb_point
     // check
     tb_assert_abort(device && points && counts);
 
+    // apply the immediate state
+    gb_gl_render_apply_immediate(device);
+
     // apply vertices
     gb_gl_render_apply_vertices(device, points);
 
@@ -267,6 +581,75 @@ static tb_void_t gb_gl_render_stroke_polygon(gb_gl_device_ref_t device, gb_point
         index += count;
     }
 }
+static tb_bool_t gb_gl_render_stroke_strip(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_point_ref_t points, tb_size_t count)
+{
+    // check
+    tb_assert_abort(device && device->base.paint && device->base.matrix && (polygon || points));
+
+    // the fringe need the stroked polygon
+    tb_check_return_val(device->strip_stroker && !gb_gl_render_fringe_enabled(device), tb_false);
+
+    // the paint
+    gb_paint_ref_t paint = device->base.paint;
+
+    /* the triangles of the strip overlap at the joins, so they are drawn directly only for the opaque solid color,
+     * otherwise draw them to the stencil buffer and cover the bounds
+     */
+    tb_bool_t opaque = (!device->shader && gb_paint_alpha(paint) == 0xff && gb_paint_color(paint).a == 0xff)? tb_true : tb_false;
+    tb_check_return_val(opaque || (device->stencil_bits && device->version >= 0x20), tb_false);
+
+    // make the triangle strip of the stroke directly without the tessellator
+    tb_size_t size = polygon?   gb_gl_stroker_done_polygon(device->strip_stroker, paint, device->base.matrix, polygon)
+                            :   gb_gl_stroker_done_lines(device->strip_stroker, paint, device->base.matrix, points, count);
+    tb_check_return_val(size >= 3, tb_true);
+
+    // the points of the triangle strip
+    gb_point_ref_t strip = gb_gl_stroker_data(device->strip_stroker);
+    tb_assert_and_check_return_val(strip, tb_false);
+
+    // enter paint, skip it if the shader cannot be applied
+    tb_check_return_val(gb_gl_render_enter_paint(device), tb_true);
+
+    // draw it directly
+    if (opaque)
+    {
+        // add it to the batch
+        if (gb_gl_render_batch_enabled(device)) gb_gl_batch_add_strip(device->batch, strip, size, device->color);
+        // draw it
+        else
+        {
+            gb_gl_render_apply_vertices(device, strip);
+            gb_glDrawArrays(GB_GL_TRIANGLE_STRIP, 0, (gb_GLint_t)size);
+        }
+    }
+    else
+    {
+        // apply the immediate state
+        gb_gl_render_apply_immediate(device);
+
+        // enable stencil test and disable writing color
+        gb_glEnable(GB_GL_STENCIL_TEST);
+        gb_glColorMask(GB_GL_FALSE, GB_GL_FALSE, GB_GL_FALSE, GB_GL_FALSE);
+        gb_glStencilMask(0xff);
+
+        // mark the covered pixels only once
+        gb_glStencilFunc(GB_GL_ALWAYS, 1, 0xff);
+        gb_glStencilOp(GB_GL_KEEP, GB_GL_KEEP, GB_GL_REPLACE);
+
+        // draw the triangle strip to the stencil buffer
+        gb_gl_render_apply_vertices(device, strip);
+        gb_glDrawArrays(GB_GL_TRIANGLE_STRIP, 0, (gb_GLint_t)size);
+
+        // cover the bounds
+        gb_gl_render_cover_stencil(device, gb_gl_stroker_bounds(device->strip_stroker));
+    }
+
+    // leave paint
+    gb_gl_render_leave_paint(device);
+
+    // ok
+    return tb_true;
+}
 static tb_void_t gb_gl_render_stroke_fill(gb_gl_device_ref_t device, gb_path_ref_t path)
 {
     // check
@@ -287,8 +670,8 @@ static tb_void_t gb_gl_render_stroke_fill(gb_gl_device_ref_t device, gb_path_ref
     // switch to the non-zero fill rule
     gb_paint_fill_rule_set(device->base.paint, GB_PAINT_FILL_RULE_NONZERO);
 
-    // draw path
-    gb_gl_render_draw_path(device, path);
+    // fill the stroked path, it is made for each drawing and need not be cached
+    gb_gl_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
 
     // restore the mode
     gb_paint_mode_set(device->base.paint, mode);
@@ -308,6 +691,115 @@ static __tb_inline__ tb_bool_t gb_gl_render_stroke_only(gb_gl_device_ref_t devic
             &&  !device->shader)? tb_true : tb_false;
 }
 
+static tb_bool_t gb_gl_render_draw_cache(gb_gl_device_ref_t device, gb_path_ref_t path, tb_size_t type)
+{
+    // check
+    tb_assert_abort(device && device->base.paint && path);
+
+    // only cache the solid geometries for gl >= 2.0
+    tb_check_return_val(device->cache && gb_gl_render_batch_solid(device), tb_false);
+
+    // the paint
+    gb_paint_ref_t paint = device->base.paint;
+
+    // the fringe need the stroked polygon which is not cached
+    if (type == GB_GL_PATH_CACHE_TYPE_STROKE && gb_gl_render_fringe_enabled(device)) return tb_false;
+
+    // the line and point are not filled by the triangles
+    if (type == GB_GL_PATH_CACHE_TYPE_FILL)
+    {
+        gb_shape_ref_t hint = gb_path_hint(path);
+        if (hint && (hint->type == GB_SHAPE_TYPE_LINE || hint->type == GB_SHAPE_TYPE_POINT)) return tb_false;
+    }
+
+    // make key, clear the padding bytes first
+    gb_gl_path_cache_key_t key;
+    tb_memset(&key, 0, sizeof(key));
+    key.version = gb_path_version(path);
+    key.type    = (tb_uint8_t)type;
+    if (type == GB_GL_PATH_CACHE_TYPE_FILL) key.rule = (tb_uint8_t)gb_paint_fill_rule(paint);
+    else
+    {
+        key.cap     = (tb_uint8_t)gb_paint_stroke_cap(paint);
+        key.join    = (tb_uint8_t)gb_paint_stroke_join(paint);
+        key.width   = gb_paint_stroke_width(paint);
+        key.miter   = gb_paint_stroke_miter(paint);
+    }
+
+    // get the cache entry
+    tb_bool_t                       added = tb_false;
+    gb_gl_path_cache_entry_ref_t    entry = gb_gl_path_cache_get(device->cache, &key, &added);
+    tb_check_return_val(entry, tb_false);
+
+    // the first drawing? the path may be not static, draw it directly
+    tb_check_return_val(!added, tb_false);
+
+    // make the triangle strip and upload it if be drawn again
+    if (!entry->buffer)
+    {
+        // the polygon and bounds
+        gb_polygon_ref_t    polygon = tb_null;
+        gb_rect_ref_t       bounds  = tb_null;
+        tb_size_t           rule    = GB_PAINT_FILL_RULE_NONZERO;
+        if (type == GB_GL_PATH_CACHE_TYPE_FILL)
+        {
+            polygon = gb_path_polygon(path);
+            bounds  = gb_path_bounds(path);
+            rule    = key.rule;
+        }
+        else
+        {
+            // stroke it
+            gb_path_ref_t stroked = gb_stroker_done_path(device->stroker, paint, path);
+            tb_check_return_val(stroked && !gb_path_null(stroked), tb_false);
+
+            // the polygon and bounds of the stroked path
+            polygon = gb_path_polygon(stroked);
+            bounds  = gb_path_bounds(stroked);
+        }
+        tb_check_return_val(polygon && bounds, tb_false);
+
+        // make the triangle strip
+        tb_size_t count = gb_gl_render_make_strip(device, polygon, bounds, rule);
+
+        // upload it
+        if (!gb_gl_path_cache_upload(device->cache, entry, gb_triangle_strip_data(device->strip), count)) return tb_false;
+    }
+
+    // draw it
+    if (entry->count)
+    {
+        // enter paint, skip it if the shader cannot be applied
+        tb_check_return_val(gb_gl_render_enter_paint(device), tb_true);
+
+        // apply the immediate state
+        gb_gl_render_apply_immediate(device);
+
+        // the vertices location
+        gb_GLint_t location = gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES);
+
+        // apply the cached vertices
+        gb_glBindBuffer(GB_GL_ARRAY_BUFFER, entry->buffer);
+        gb_glVertexAttribPointer(location, 2, GB_GL_VERTEX_TYPE, GB_GL_FALSE, 0, (gb_GLvoid_t const*)0);
+
+        // draw the triangle strip
+        gb_glDrawArrays(GB_GL_TRIANGLE_STRIP, 0, (gb_GLint_t)entry->count);
+
+        // unbind the vertex buffer for the client-side vertices
+        gb_glBindBuffer(GB_GL_ARRAY_BUFFER, 0);
+
+        // add the antialiasing fringe of the filled path, it is made fast without the tessellator
+        if (gb_gl_render_fringe_enabled(device))
+            gb_gl_fringe_done(device->fringe, device->batch, gb_path_polygon(path), key.rule, device->base.matrix, &device->fringe_inverse, device->color);
+
+        // leave paint
+        gb_gl_render_leave_paint(device);
+    }
+
+    // ok
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -321,7 +813,11 @@ tb_bool_t gb_gl_render_init(gb_gl_device_ref_t device)
     do
     {
         // init shader
-        device->shader = gb_paint_shader(device->base.paint);
+        device->shader          = gb_paint_shader(device->base.paint);
+        device->batch_texture   = tb_false;
+
+        // init scissor
+        gb_gl_render_scissor(device);
 
         // init vertex matrix
         gb_gl_matrix_convert(device->matrix_vertex, device->base.matrix);
@@ -334,38 +830,80 @@ tb_bool_t gb_gl_render_init(gb_gl_device_ref_t device)
         device->matrix_vertex[5] /= 65536.0f;
 #endif
 
-        // init antialiasing
-        if (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_ANTIALIASING) 
+        // the antialiasing
+        tb_bool_t antialiasing = (gb_paint_flag(device->base.paint) & GB_PAINT_FLAG_ANTIALIASING)? tb_true : tb_false;
+
+        // init the fringe for the analytic antialiasing instead of the multisample buffer
+        device->fringe_ok = tb_false;
+        if (device->fringe && antialiasing)
         {
-            gb_glEnable(GB_GL_MULTISAMPLE);
-#if 0
-            gb_glEnable(GB_GL_LINE_SMOOTH);
-            gb_glHint(GB_GL_LINE_SMOOTH_HINT, GB_GL_NICEST);
-#endif
+            // the inverse matrix for mapping the fringe back from the device space
+            device->fringe_inverse  = *device->base.matrix;
+            device->fringe_ok       = gb_matrix_invert(&device->fringe_inverse);
+
+            // no multisample buffer
+            antialiasing = tb_false;
         }
-        else gb_glDisable(GB_GL_MULTISAMPLE);
 
         // init vertex and matrix
         if (device->version >= 0x20)
         {   
             // the program type
-            tb_size_t program_type = device->shader? GB_GL_PROGRAM_TYPE_BITMAP : GB_GL_PROGRAM_TYPE_COLOR;
+            tb_size_t program_type = GB_GL_PROGRAM_TYPE_COLOR;
+            if (device->shader)
+            {
+                switch (gb_shader_type(device->shader))
+                {
+                case GB_SHADER_TYPE_LINEAR:
+                    program_type = GB_GL_PROGRAM_TYPE_LINEAR;
+                    break;
+                case GB_SHADER_TYPE_RADIAL:
+                    program_type = GB_GL_PROGRAM_TYPE_RADIAL;
+                    break;
+                default:
+                    program_type = GB_GL_PROGRAM_TYPE_BITMAP;
+                    break;
+                }
+            }
 
             // program
             device->program = device->programs[program_type];
             tb_assert_and_check_break(device->program);
 
-            // bind this program to the current gl context
-            gb_gl_program_bind(device->program);
+            // batch the bitmap with the texture of the bitmap shader
+            gb_gl_batch_texture_t texture;
+            if (device->batch && program_type == GB_GL_PROGRAM_TYPE_BITMAP)
+            {
+                // flush the pending geometries first if the texture cache will upload or remove the textures
+                if (!gb_gl_shader_cached(device->shader)) gb_gl_batch_flush(device->batch);
+
+                // get the texture, it will not be batched if the shader matrix is not invertible or the texture is not uploaded
+                device->batch_texture = gb_gl_shader_texture(device->shader, &texture);
+            }
+
+            // flush the pending geometries of the batch if the state will be changed
+            gb_gl_batch_texture_ref_t batch_texture = device->batch_texture? &texture : tb_null;
+            if (device->batch && !gb_gl_batch_state_set(device->batch, device->program, device->matrix_vertex, antialiasing, batch_texture))
+            {
+                gb_gl_batch_flush(device->batch);
+                gb_gl_batch_state_set(device->batch, device->program, device->matrix_vertex, antialiasing, batch_texture);
+            }
+
+            // bind this program to the current gl context if be changed
+            if (device->program_bound != device->program)
+            {
+                gb_gl_program_bind(device->program);
+                device->program_bound = device->program;
+            }
 
             // enable vertex
             gb_glEnableVertexAttribArray(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_VERTICES));
 
-            // apply projection matrix
-            gb_glUniformMatrix4fv(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT), 1, GB_GL_FALSE, device->matrix_project);
+            // apply projection matrix if be changed
+            gb_gl_program_matrix_set(device->program, GB_GL_PROGRAM_LOCATION_MATRIX_PROJECT, device->matrix_project);
 
-            // apply vertex matrix
-            gb_glUniformMatrix4fv(gb_gl_program_location(device->program, GB_GL_PROGRAM_LOCATION_MATRIX_MODEL), 1, GB_GL_FALSE, device->matrix_vertex);
+            // apply vertex matrix if be changed
+            gb_gl_program_matrix_set(device->program, GB_GL_PROGRAM_LOCATION_MATRIX_MODEL, device->matrix_vertex);
         }
         else
         {
@@ -379,6 +917,17 @@ tb_bool_t gb_gl_render_init(gb_gl_device_ref_t device)
             gb_glMultMatrixf(device->matrix_vertex);
         }
 
+        // init antialiasing
+        if (antialiasing) 
+        {
+            gb_glEnable(GB_GL_MULTISAMPLE);
+#if 0
+            gb_glEnable(GB_GL_LINE_SMOOTH);
+            gb_glHint(GB_GL_LINE_SMOOTH_HINT, GB_GL_NICEST);
+#endif
+        }
+        else gb_glDisable(GB_GL_MULTISAMPLE);
+
         // ok
         ok = tb_true;
 
@@ -420,6 +969,53 @@ tb_void_t gb_gl_render_exit(gb_gl_device_ref_t device)
     // disable antialiasing
     gb_glDisable(GB_GL_MULTISAMPLE);
 }
+tb_void_t gb_gl_render_scissor(gb_gl_device_ref_t device)
+{
+    // check
+    tb_assert_and_check_return(device);
+
+    // the clipped rect
+    gb_rect_ref_t clip = device->base.clipper? gb_clipper_rect(device->base.clipper) : tb_null;
+
+    // the scissor box, the origin of the framebuffer is at the left-bottom corner
+    gb_GLint_t scissor[4] = {0};
+    if (clip)
+    {
+        tb_long_t x0 = tb_max(gb_floor(clip->x), 0);
+        tb_long_t y0 = tb_max(gb_floor(clip->y), 0);
+        tb_long_t x1 = tb_min(gb_ceil(clip->x + clip->w), (tb_long_t)device->base.width);
+        tb_long_t y1 = tb_min(gb_ceil(clip->y + clip->h), (tb_long_t)device->base.height);
+        scissor[0] = (gb_GLint_t)x0;
+        scissor[1] = (gb_GLint_t)(device->base.height - y1);
+        scissor[2] = (gb_GLint_t)tb_max(x1 - x0, 0);
+        scissor[3] = (gb_GLint_t)tb_max(y1 - y0, 0);
+    }
+
+    // not changed?
+    if (clip && device->scissor_ok && !tb_memcmp(scissor, device->scissor, sizeof(scissor))) return ;
+    if (!clip && !device->scissor_ok) return ;
+
+    // flush the pending geometries of the previous scissor box
+    gb_gl_render_flush(device);
+
+    // apply it
+    if (clip)
+    {
+        gb_glEnable(GB_GL_SCISSOR_TEST);
+        gb_glScissor(scissor[0], scissor[1], scissor[2], scissor[3]);
+        tb_memcpy(device->scissor, scissor, sizeof(scissor));
+    }
+    else gb_glDisable(GB_GL_SCISSOR_TEST);
+    device->scissor_ok = clip? tb_true : tb_false;
+}
+tb_void_t gb_gl_render_flush(gb_gl_device_ref_t device)
+{
+    // check
+    tb_assert_and_check_return(device);
+
+    // flush the pending geometries of the batch
+    if (device->batch) gb_gl_batch_flush(device->batch);
+}
 tb_void_t gb_gl_render_draw_path(gb_gl_device_ref_t device, gb_path_ref_t path)
 {
     // check
@@ -431,7 +1027,9 @@ tb_void_t gb_gl_render_draw_path(gb_gl_device_ref_t device, gb_path_ref_t path)
     // fill it
     if (mode & GB_PAINT_MODE_FILL)
     {
-        gb_gl_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
+        // draw the cached geometry or the polygon
+        if (!gb_gl_render_draw_cache(device, path, GB_GL_PATH_CACHE_TYPE_FILL))
+            gb_gl_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
     }
 
     // stroke it
@@ -439,8 +1037,12 @@ tb_void_t gb_gl_render_draw_path(gb_gl_device_ref_t device, gb_path_ref_t path)
     {
         // only stroke?
         if (gb_gl_render_stroke_only(device)) gb_gl_render_draw_polygon(device, gb_path_polygon(path), gb_path_hint(path), gb_path_bounds(path));
-        // fill the stroked path
-        else gb_gl_render_stroke_fill(device, gb_stroker_done_path(device->stroker, device->base.paint, path));
+        /* draw the cached geometry first, the path is drawn again and its stroke has been cached,
+         * otherwise draw the triangle strip of the stroke or fill the stroked path
+         */
+        else if (   !gb_gl_render_draw_cache(device, path, GB_GL_PATH_CACHE_TYPE_STROKE)
+                &&  !gb_gl_render_stroke_strip(device, gb_path_polygon(path), tb_null, 0))
+            gb_gl_render_stroke_fill(device, gb_stroker_done_path(device->stroker, device->base.paint, path));
     }
 }
 tb_void_t gb_gl_render_draw_lines(gb_gl_device_ref_t device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
@@ -454,13 +1056,13 @@ tb_void_t gb_gl_render_draw_lines(gb_gl_device_ref_t device, gb_point_ref_t poin
     // check width
     tb_check_return((gb_paint_stroke_width(device->base.paint) > 0));
 
-    // enter paint
-    gb_gl_render_enter_paint(device);
+    // enter paint, skip it if the shader cannot be applied
+    tb_check_return(gb_gl_render_enter_paint(device));
 
     // only stroke?
     if (gb_gl_render_stroke_only(device)) gb_gl_render_stroke_lines(device, points, count);
-    // fill the stroked lines
-    else gb_gl_render_stroke_fill(device, gb_stroker_done_lines(device->stroker, device->base.paint, points, count));
+    // draw the triangle strip of the stroke or fill the stroked lines
+    else if (!gb_gl_render_stroke_strip(device, tb_null, points, count)) gb_gl_render_stroke_fill(device, gb_stroker_done_lines(device->stroker, device->base.paint, points, count));
 
     // leave paint
     gb_gl_render_leave_paint(device);
@@ -476,8 +1078,8 @@ tb_void_t gb_gl_render_draw_points(gb_gl_device_ref_t device, gb_point_ref_t poi
     // check width
     tb_check_return((gb_paint_stroke_width(device->base.paint) > 0));
 
-    // enter paint
-    gb_gl_render_enter_paint(device);
+    // enter paint, skip it if the shader cannot be applied
+    tb_check_return(gb_gl_render_enter_paint(device));
 
     // only stroke?
     if (gb_gl_render_stroke_only(device)) gb_gl_render_stroke_points(device, points, count);
@@ -508,8 +1110,8 @@ tb_void_t gb_gl_render_draw_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t
         return ;
     }
 
-    // enter paint
-    gb_gl_render_enter_paint(device);
+    // enter paint, skip it if the shader cannot be applied
+    tb_check_return(gb_gl_render_enter_paint(device));
 
     // the mode
     tb_size_t mode = gb_paint_mode(device->base.paint);
@@ -517,8 +1119,15 @@ tb_void_t gb_gl_render_draw_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t
     // fill it
     if (mode & GB_PAINT_MODE_FILL)
     {
+        // the fill rule
+        tb_size_t rule = gb_paint_fill_rule(device->base.paint);
+
         // fill polygon
-        gb_gl_render_fill_polygon(device, polygon, bounds, gb_paint_fill_rule(device->base.paint));
+        gb_gl_render_fill_polygon(device, polygon, bounds, rule, gb_gl_render_fill_output(device, polygon));
+
+        // add the antialiasing fringe
+        if (gb_gl_render_fringe_enabled(device))
+            gb_gl_fringe_done(device->fringe, device->batch, polygon, rule, device->base.matrix, &device->fringe_inverse, device->color);
     }
 
     // stroke it
@@ -526,11 +1135,104 @@ tb_void_t gb_gl_render_draw_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t
     {
         // only stroke?
         if (gb_gl_render_stroke_only(device)) gb_gl_render_stroke_polygon(device, polygon->points, polygon->counts);
-        // fill the stroked polygon
-        else gb_gl_render_stroke_fill(device, gb_stroker_done_polygon(device->stroker, device->base.paint, polygon, hint));
+        // draw the triangle strip of the stroke or fill the stroked polygon
+        else if (!gb_gl_render_stroke_strip(device, polygon, tb_null, 0)) gb_gl_render_stroke_fill(device, gb_stroker_done_polygon(device->stroker, device->base.paint, polygon, hint));
     }
 
     // leave paint
     gb_gl_render_leave_paint(device);
 }
+tb_bool_t gb_gl_render_draw_instances(gb_gl_device_ref_t device, gb_path_ref_t path, gb_matrix_ref_t matrices, gb_color_t const* colors, tb_size_t count)
+{
+    // check
+    tb_assert_abort(device && device->base.paint && device->stroker && path && matrices && count);
+
+    // only expand the solid instances into the batch
+    tb_check_return_val(gb_gl_render_batch_solid(device) && device->strip, tb_false);
+
+    // the paint
+    gb_paint_ref_t paint = device->base.paint;
+
+    // fill or stroke? 
+    tb_size_t mode      = gb_paint_mode(paint);
+    tb_bool_t fill      = (mode & GB_PAINT_MODE_FILL)? tb_true : tb_false;
+    tb_bool_t stroke    = ((mode & GB_PAINT_MODE_STROKE) && gb_paint_stroke_width(paint) > 0)? tb_true : tb_false;
+
+    // the fill and stroke of each instance need be drawn in order
+    tb_check_return_val(fill != stroke, tb_false);
+
+    // the line and point are not filled by the triangles
+    gb_shape_ref_t hint = gb_path_hint(path);
+    if (fill && hint && (hint->type == GB_SHAPE_TYPE_LINE || hint->type == GB_SHAPE_TYPE_POINT)) return tb_false;
+
+    // the hairlines are not made of the triangles
+    if (stroke && gb_gl_render_stroke_only(device)) return tb_false;
+
+    // the polygon and bounds of the instance
+    gb_polygon_ref_t    polygon = tb_null;
+    gb_rect_ref_t       bounds  = tb_null;
+    tb_size_t           rule    = GB_PAINT_FILL_RULE_NONZERO;
+    if (fill)
+    {
+        polygon = gb_path_polygon(path);
+        bounds  = gb_path_bounds(path);
+        rule    = gb_paint_fill_rule(paint);
+    }
+    else
+    {
+        // stroke it
+        gb_path_ref_t stroked = gb_stroker_done_path(device->stroker, paint, path);
+        tb_check_return_val(stroked, tb_false);
+        tb_check_return_val(!gb_path_null(stroked), tb_true);
+
+        // the polygon and bounds of the stroked path
+        polygon = gb_path_polygon(stroked);
+        bounds  = gb_path_bounds(stroked);
+    }
+    tb_check_return_val(polygon && bounds, tb_false);
+
+    // tessellate the instance only once
+    tb_size_t size = gb_gl_render_make_strip(device, polygon, bounds, rule);
+    tb_check_return_val(size >= 3, tb_true);
+
+    // enter paint, skip it if the shader cannot be applied
+    tb_check_return_val(gb_gl_render_enter_paint(device), tb_true);
+
+    // the alpha
+    tb_byte_t alpha = gb_paint_alpha(paint);
+
+    // add the antialiasing fringe?
+    tb_bool_t fringe = gb_gl_render_fringe_enabled(device);
+
+    // add the transformed instances to the batch
+    tb_size_t       i = 0;
+    gb_point_ref_t  points = gb_triangle_strip_data(device->strip);
+    for (i = 0; i < count; i++)
+    {
+        // the color of this instance
+        gb_color_t color = device->color;
+        if (colors)
+        {
+            color = colors[i];
+            if (alpha != 0xff) color.a = alpha;
+        }
+
+        // add it
+        gb_gl_batch_add_instance(device->batch, points, size, &matrices[i], color);
+
+        // add the antialiasing fringe of this instance in the device space
+        if (fringe)
+        {
+            gb_matrix_t matrix = *device->base.matrix;
+            gb_matrix_multiply(&matrix, &matrices[i]);
+            gb_gl_fringe_done(device->fringe, device->batch, polygon, rule, &matrix, &device->fringe_inverse, color);
+        }
+    }
+
+    // leave paint
+    gb_gl_render_leave_paint(device);
+
+    // ok
+    return tb_true;
+}
 
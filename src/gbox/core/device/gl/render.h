@@ -52,6 +52,20 @@ tb_bool_t           gb_gl_render_init(gb_gl_device_ref_t device);
  */
 tb_void_t           gb_gl_render_exit(gb_gl_device_ref_t device);
 
+/* apply the clipped rect of the bound clipper to the scissor test
+ *
+ * the pending geometries of the batch will be flushed if the scissor box is changed
+ *
+ * @param device    the device
+ */
+tb_void_t           gb_gl_render_scissor(gb_gl_device_ref_t device);
+
+/* flush the pending geometries of the batch
+ *
+ * @param device    the device
+ */
+tb_void_t           gb_gl_render_flush(gb_gl_device_ref_t device);
+
 /* draw path
  *
  * @param device    the device
@@ -86,6 +100,18 @@ tb_void_t           gb_gl_render_draw_points(gb_gl_device_ref_t device, gb_point
  */
 tb_void_t           gb_gl_render_draw_polygon(gb_gl_device_ref_t device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds);
 
+/* draw the instances of the path
+ *
+ * @param device    the device
+ * @param path      the path of one instance
+ * @param matrices  the matrices of the instances
+ * @param colors    the colors of the instances, uses the paint color if be null
+ * @param count     the instances count
+ *
+ * @return          tb_false if the instances cannot be batched and need be drawn one by one
+ */
+tb_bool_t           gb_gl_render_draw_instances(gb_gl_device_ref_t device, gb_path_ref_t path, gb_matrix_ref_t matrices, gb_color_t const* colors, tb_size_t count);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -32,19 +32,357 @@
  * includes
  */
 #include "shader.h"
+#include "../../shader.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl gradient shader type
+typedef struct __gb_gl_shader_gradient_t
+{
+    // the base
+    gb_shader_impl_t        base;
+
+    // the gradient space which maps the vertices to the gradient factor
+    gb_gl_matrix_t          space;
+
+    // the ramp texture
+    gb_GLuint_t             texture;
+
+    // all colors are opaque?
+    tb_bool_t               opaque;
+
+}gb_gl_shader_gradient_t;
+
+// the gl bitmap shader type
+typedef struct __gb_gl_shader_bitmap_t
+{
+    // the base
+    gb_shader_impl_t        base;
+
+    // the bitmap
+    gb_bitmap_ref_t         bitmap;
+
+    // the texture cache of the device
+    gb_gl_texture_cache_ref_t cache;
+
+}gb_gl_shader_bitmap_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_gl_shader_gradient_exit(gb_shader_impl_t* shader)
+{
+    // check
+    gb_gl_shader_gradient_t* impl = (gb_gl_shader_gradient_t*)shader;
+    tb_assert_and_check_return(impl);
+
+    // exit the ramp texture
+    if (impl->texture) gb_glDeleteTextures(1, &impl->texture);
+    impl->texture = 0;
+
+    // exit it
+    tb_free(impl);
+}
+static tb_void_t gb_gl_shader_bitmap_exit(gb_shader_impl_t* shader)
+{
+    // check
+    gb_gl_shader_bitmap_t* impl = (gb_gl_shader_bitmap_t*)shader;
+    tb_assert_and_check_return(impl);
+
+    // exit it, the texture is owned by the texture cache
+    tb_free(impl);
+}
+static tb_bool_t gb_gl_shader_gradient_ramp(gb_gl_shader_gradient_t* impl, gb_gradient_ref_t gradient)
+{
+    // check
+    tb_assert_and_check_return_val(impl && gradient && gradient->colors && gradient->count, tb_false);
+
+    // the colors and radios, the stops are distributed evenly if no radios
+    gb_color_t const*   colors = gradient->colors;
+    gb_float_t const*   radios = gradient->radios;
+    tb_size_t           count = gradient->count;
+
+    // opaque?
+    tb_size_t i = 0;
+    impl->opaque = tb_true;
+    for (i = 0; i < count; i++) if (colors[i].a != 0xff) impl->opaque = tb_false;
+
+    // make the ramp pixels: rgba
+    tb_size_t   stop = 0;
+    tb_byte_t   pixels[GB_GL_SHADER_RAMP_SIZE << 2];
+    for (i = 0; i < GB_GL_SHADER_RAMP_SIZE; i++)
+    {
+        // the factor of this texel
+        tb_float_t t = (tb_float_t)i / (GB_GL_SHADER_RAMP_SIZE - 1);
+
+        // find the stops: [stop, stop + 1] which contains this factor
+        while (stop + 1 < count && t > (radios? gb_float_to_tb(radios[stop + 1]) : (tb_float_t)(stop + 1) / (count - 1))) stop++;
+
+        // the left and right stops
+        tb_size_t   next = stop + 1 < count? stop + 1 : stop;
+        tb_float_t  r0 = radios? gb_float_to_tb(radios[stop]) : (count > 1? (tb_float_t)stop / (count - 1) : 0.0f);
+        tb_float_t  r1 = radios? gb_float_to_tb(radios[next]) : (count > 1? (tb_float_t)next / (count - 1) : 0.0f);
+
+        // interpolate the color, uses the left color before the first stop 
+        tb_float_t  f = (r1 > r0 && t > r0)? (t - r0) / (r1 - r0) : 0.0f;
+        if (f > 1.0f) f = 1.0f;
+        gb_color_t const* c0 = &colors[stop];
+        gb_color_t const* c1 = &colors[next];
+        pixels[(i << 2) + 0] = (tb_byte_t)(c0->r + (c1->r - c0->r) * f + 0.5f);
+        pixels[(i << 2) + 1] = (tb_byte_t)(c0->g + (c1->g - c0->g) * f + 0.5f);
+        pixels[(i << 2) + 2] = (tb_byte_t)(c0->b + (c1->b - c0->b) * f + 0.5f);
+        pixels[(i << 2) + 3] = (tb_byte_t)(c0->a + (c1->a - c0->a) * f + 0.5f);
+    }
+
+    // make the ramp texture
+    gb_glGenTextures(1, &impl->texture);
+    tb_assert_and_check_return_val(impl->texture, tb_false);
+
+    // upload it, the spread modes are done in the fragment shader
+    gb_glBindTexture(GB_GL_TEXTURE_2D, impl->texture);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MIN_FILTER, GB_GL_LINEAR);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MAG_FILTER, GB_GL_LINEAR);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_S, GB_GL_CLAMP_TO_EDGE);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_T, GB_GL_CLAMP_TO_EDGE);
+    gb_glTexImage2D(GB_GL_TEXTURE_2D, 0, GB_GL_RGBA, GB_GL_SHADER_RAMP_SIZE, 1, 0, GB_GL_RGBA, GB_GL_UNSIGNED_BYTE, pixels);
+    gb_glBindTexture(GB_GL_TEXTURE_2D, 0);
+
+    // ok
+    return tb_true;
+}
+static gb_shader_ref_t gb_gl_shader_gradient_init(gb_gl_device_ref_t device, tb_size_t type, tb_size_t mode, gb_gradient_ref_t gradient, gb_gl_matrix_ref_t space)
+{
+    // check
+    tb_assert_and_check_return_val(device && gradient && space, tb_null);
+
+    // only for gl >= 2.0
+    tb_check_return_val(device->version >= 0x20, tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    gb_gl_shader_gradient_t*    impl = tb_null;
+    do
+    {
+        // make shader
+        impl = tb_malloc0_type(gb_gl_shader_gradient_t);
+        tb_assert_and_check_break(impl);
+
+        // init shader
+        impl->base.type = (tb_uint8_t)type;
+        impl->base.mode = (tb_uint8_t)mode;
+        impl->base.refn = 1;
+        impl->base.exit = gb_gl_shader_gradient_exit;
+        gb_matrix_clear(&impl->base.matrix);
+
+        // init space
+        gb_gl_matrix_copy(impl->space, space);
+
+        // init the ramp texture, it is uploaded only once for this gradient
+        if (!gb_gl_shader_gradient_ramp(impl, gradient)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_shader_gradient_exit((gb_shader_impl_t*)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_shader_ref_t)impl;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 gb_shader_ref_t gb_gl_shader_init_linear(gb_gl_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_line_ref_t line)
 {
-    return tb_null;
+    // check
+    tb_assert_and_check_return_val(line, tb_null);
+
+    // the line: p0 => p1
+    tb_float_t x0 = gb_float_to_tb(line->p0.x);
+    tb_float_t y0 = gb_float_to_tb(line->p0.y);
+    tb_float_t dx = gb_float_to_tb(line->p1.x) - x0;
+    tb_float_t dy = gb_float_to_tb(line->p1.y) - y0;
+    tb_float_t dd = dx * dx + dy * dy;
+    tb_assert_and_check_return_val(dd > 0.0f, tb_null);
+
+    // make the gradient space: x = (p - p0) * (p1 - p0) / |p1 - p0|^2 
+    gb_gl_matrix_t space;
+    gb_gl_matrix_init(space, dx / dd, dy / dd, 0.0f, 0.0f, -(dx * x0 + dy * y0) / dd, 0.0f);
+
+    // init shader
+    return gb_gl_shader_gradient_init(device, GB_SHADER_TYPE_LINEAR, mode, gradient, space);
 }
 gb_shader_ref_t gb_gl_shader_init_radial(gb_gl_device_ref_t device, tb_size_t mode, gb_gradient_ref_t gradient, gb_circle_ref_t circle)
 {
-    return tb_null;
+    // check
+    tb_assert_and_check_return_val(circle, tb_null);
+
+    // the circle
+    tb_float_t x0 = gb_float_to_tb(circle->c.x);
+    tb_float_t y0 = gb_float_to_tb(circle->c.y);
+    tb_float_t r  = gb_float_to_tb(circle->r);
+    tb_assert_and_check_return_val(r > 0.0f, tb_null);
+
+    // make the gradient space: (x, y) = (p - c) / r 
+    gb_gl_matrix_t space;
+    gb_gl_matrix_init(space, 1.0f / r, 0.0f, 0.0f, 1.0f / r, -x0 / r, -y0 / r);
+
+    // init shader
+    return gb_gl_shader_gradient_init(device, GB_SHADER_TYPE_RADIAL, mode, gradient, space);
 }
 gb_shader_ref_t gb_gl_shader_init_bitmap(gb_gl_device_ref_t device, tb_size_t mode, gb_bitmap_ref_t bitmap)
 {
-    return tb_null;
+    // check
+    tb_assert_and_check_return_val(device && bitmap, tb_null);
+
+    // only for gl >= 2.0 with the texture cache
+    tb_check_return_val(device->version >= 0x20 && device->textures, tb_null);
+
+    // make shader
+    gb_gl_shader_bitmap_t* impl = tb_malloc0_type(gb_gl_shader_bitmap_t);
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // init shader
+    impl->base.type = GB_SHADER_TYPE_BITMAP;
+    impl->base.mode = (tb_uint8_t)mode;
+    impl->base.refn = 1;
+    impl->base.exit = gb_gl_shader_bitmap_exit;
+    gb_matrix_clear(&impl->base.matrix);
+
+    // init bitmap and cache, the texture is uploaded lazily when drawing
+    impl->bitmap    = bitmap;
+    impl->cache     = device->textures;
+
+    // ok
+    return (gb_shader_ref_t)impl;
+}
+tb_bool_t gb_gl_shader_cached(gb_shader_ref_t shader)
+{
+    // check
+    gb_shader_impl_t* impl = (gb_shader_impl_t*)shader;
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // the ramp texture of the gradient is always uploaded
+    tb_check_return_val(impl->type == GB_SHADER_TYPE_BITMAP, tb_true);
+
+    // the bitmap texture has been uploaded and not changed?
+    gb_gl_shader_bitmap_t* bitmap = (gb_gl_shader_bitmap_t*)impl;
+    return gb_gl_texture_cache_ready(bitmap->cache, bitmap->bitmap);
+}
+tb_bool_t gb_gl_shader_texture(gb_shader_ref_t shader, gb_gl_batch_texture_ref_t texture)
+{
+    // check
+    gb_shader_impl_t* impl = (gb_shader_impl_t*)shader;
+    tb_assert_and_check_return_val(impl && texture, tb_false);
+
+    // the inverse shader matrix which maps the user space to the shader space
+    gb_matrix_t matrix = impl->matrix;
+    tb_check_return_val(gb_matrix_invert(&matrix), tb_false);
+    gb_gl_matrix_convert(texture->matrix, &matrix);
+
+    // the texture
+    if (impl->type == GB_SHADER_TYPE_BITMAP)
+    {
+        // get the cached texture, upload the changed pixels if the bitmap has been modified
+        gb_gl_shader_bitmap_t*          bitmap = (gb_gl_shader_bitmap_t*)impl;
+        gb_gl_texture_cache_entry_ref_t entry = gb_gl_texture_cache_get(bitmap->cache, bitmap->bitmap);
+        tb_check_return_val(entry, tb_false);
+        texture->texture = entry->texture;
+
+        // make the texcoord matrix: scale(1 / width, 1 / height) * inverse(matrix)
+        gb_gl_matrix_t space;
+        gb_gl_matrix_init_scale(space, 1.0f / gb_bitmap_width(bitmap->bitmap), 1.0f / gb_bitmap_height(bitmap->bitmap));
+        gb_gl_matrix_multiply_lhs(texture->matrix, space);
+
+        // the rect of the bitmap in the texture, it may be packed into the atlas
+        tb_memcpy(texture->rect, entry->rect, sizeof(texture->rect));
+        tb_memcpy(texture->clamp, entry->clamp, sizeof(texture->clamp));
+    }
+    else
+    {
+        // make the texcoord matrix: space * inverse(matrix)
+        gb_gl_shader_gradient_t* gradient = (gb_gl_shader_gradient_t*)impl;
+        gb_gl_matrix_multiply_lhs(texture->matrix, gradient->space);
+        texture->texture = gradient->texture;
+
+        // the whole ramp texture
+        texture->rect[0]    = 0.0f;
+        texture->rect[1]    = 0.0f;
+        texture->rect[2]    = 1.0f;
+        texture->rect[3]    = 1.0f;
+        tb_memcpy(texture->clamp, texture->rect, sizeof(texture->clamp));
+    }
+    tb_assert_and_check_return_val(texture->texture, tb_false);
+
+    // the mode
+    texture->mode = impl->mode;
+
+    // is opaque?
+    texture->opaque = gb_gl_shader_opaque(shader);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t gb_gl_shader_apply(gb_shader_ref_t shader, gb_gl_program_ref_t program)
+{
+    // check
+    gb_shader_impl_t* impl = (gb_shader_impl_t*)shader;
+    tb_assert_and_check_return_val(impl && program, tb_false);
+
+    // the texture and the texcoord matrix
+    gb_gl_batch_texture_t texture;
+    tb_check_return_val(gb_gl_shader_texture(shader, &texture), tb_false);
+
+    // apply the rect of the bitmap in the texture for all vertices, it may be packed into the atlas
+    if (impl->type == GB_SHADER_TYPE_BITMAP)
+    {
+        gb_glVertexAttrib4f(gb_gl_program_location(program, GB_GL_PROGRAM_LOCATION_TEXCOORDS), 0.0f, 0.0f, 0.0f, 0.0f);
+        gb_glVertexAttrib4f(gb_gl_program_location(program, GB_GL_PROGRAM_LOCATION_TEXRECT), texture.rect[0], texture.rect[1], texture.rect[2], texture.rect[3]);
+        gb_glVertexAttrib4f(gb_gl_program_location(program, GB_GL_PROGRAM_LOCATION_TEXCLAMP), texture.clamp[0], texture.clamp[1], texture.clamp[2], texture.clamp[3]);
+    }
+
+    // apply matrix for the fixed vertex if no GB_GL_FIXED macro
+#if defined(GB_CONFIG_FLOAT_FIXED) && !defined(GB_GL_FIXED)
+    texture.matrix[0] /= 65536.0f;
+    texture.matrix[1] /= 65536.0f;
+    texture.matrix[4] /= 65536.0f;
+    texture.matrix[5] /= 65536.0f;
+#endif
+
+    // apply the texcoord matrix if be changed
+    gb_gl_program_matrix_set(program, GB_GL_PROGRAM_LOCATION_MATRIX_TEXCOORD, texture.matrix);
+
+    // apply the mode if be changed
+    gb_gl_program_integer_set(program, GB_GL_PROGRAM_LOCATION_MODE, (gb_GLint_t)texture.mode);
+
+    // bind the texture to the first texture unit
+    gb_glActiveTexture(GB_GL_TEXTURE0);
+    gb_glBindTexture(GB_GL_TEXTURE_2D, texture.texture);
+    gb_gl_program_integer_set(program, GB_GL_PROGRAM_LOCATION_SAMPLER, 0);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t gb_gl_shader_opaque(gb_shader_ref_t shader)
+{
+    // check
+    gb_shader_impl_t* impl = (gb_shader_impl_t*)shader;
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // the bitmap is opaque if it has no alpha, the outside pixels of the border mode are discarded
+    if (impl->type == GB_SHADER_TYPE_BITMAP) 
+        return !gb_bitmap_has_alpha(((gb_gl_shader_bitmap_t*)impl)->bitmap);
+
+    // opaque?
+    return ((gb_gl_shader_gradient_t*)impl)->opaque;
 }
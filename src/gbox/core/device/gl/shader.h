@@ -35,9 +35,12 @@
 __tb_extern_c_enter__
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * types
+ * macros
  */
 
+// the texels count of the gradient ramp texture
+#define GB_GL_SHADER_RAMP_SIZE      (256)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interface
  */
@@ -74,6 +77,49 @@ gb_shader_ref_t     gb_gl_shader_init_radial(gb_gl_device_ref_t device, tb_size_
  */
 gb_shader_ref_t     gb_gl_shader_init_bitmap(gb_gl_device_ref_t device, tb_size_t mode, gb_bitmap_ref_t bitmap);
 
+/*! the texture of the shader has been uploaded and not changed?
+ *
+ * the texture cache may upload or remove the textures if not, so the pending batch need be flushed first
+ *
+ * @param shader    the linear, radial or bitmap shader
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_gl_shader_cached(gb_shader_ref_t shader);
+
+/*! get the texture of the shader for gl >= 2.0
+ *
+ * make the texcoord matrix which maps the vertices to the gradient or bitmap space,
+ * the bitmap texture will be uploaded by the texture cache if it has been changed
+ *
+ * @param shader    the linear, radial or bitmap shader
+ * @param texture   the texture
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_gl_shader_texture(gb_shader_ref_t shader, gb_gl_batch_texture_ref_t texture);
+
+/*! apply the shader to the given gradient or bitmap program for gl >= 2.0
+ *
+ * bind the ramp or bitmap texture and upload the mode and the texcoord matrix 
+ * which maps the vertices to the gradient or bitmap space, 
+ * the bitmap texture will be uploaded by the texture cache if it has been changed
+ *
+ * @param shader    the linear, radial or bitmap shader
+ * @param program   the gradient or bitmap program
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_gl_shader_apply(gb_shader_ref_t shader, gb_gl_program_ref_t program);
+
+/*! all gradient colors or bitmap pixels are opaque?
+ *
+ * @param shader    the linear, radial or bitmap shader
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_gl_shader_opaque(gb_shader_ref_t shader);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,589 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        stroker.c
+ * @ingroup     core
+ */
+
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_stroker"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "stroker.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum distance between the round arc and its chords in pixels
+#define GB_GL_STROKER_ROUND_TOLERANCE   (0.25f)
+
+// the maximum segments count of the half circle
+#define GB_GL_STROKER_ROUND_MAXN        (64)
+
+// the minimum squared length of the segment
+#define GB_GL_STROKER_SEGMENT_MINN      (1e-12f)
+
+// the pi
+#define GB_GL_STROKER_PI                (3.14159265358979f)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the float point type
+typedef struct __gb_gl_stroker_point_t
+{
+    tb_float_t                  x;
+    tb_float_t                  y;
+
+}gb_gl_stroker_point_t, *gb_gl_stroker_point_ref_t;
+
+// the gl stroker impl type
+typedef struct __gb_gl_stroker_impl_t
+{
+    // the contour points without the repeated points
+    gb_gl_stroker_point_ref_t   contour;
+
+    // the contour maxn
+    tb_size_t                   contour_maxn;
+
+    // the triangle strip
+    gb_point_ref_t              strip;
+
+    // the strip size
+    tb_size_t                   strip_size;
+
+    // the strip maxn
+    tb_size_t                   strip_maxn;
+
+    // link the next contour to the strip by the degenerate triangles?
+    tb_bool_t                   strip_link;
+
+    // the bounds
+    gb_rect_t                   bounds;
+
+    // the bounds in float
+    tb_float_t                  bounds_x0;
+    tb_float_t                  bounds_y0;
+    tb_float_t                  bounds_x1;
+    tb_float_t                  bounds_y1;
+
+    // the cap
+    tb_size_t                   cap;
+
+    // the join
+    tb_size_t                   join;
+
+    // the radius
+    tb_float_t                  radius;
+
+    // the miter limit
+    tb_float_t                  miter;
+
+    // the angle step of the round joins and caps
+    tb_float_t                  step;
+
+}gb_gl_stroker_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_gl_stroker_apply_paint(gb_gl_stroker_impl_t* impl, gb_paint_ref_t paint, gb_matrix_ref_t matrix)
+{
+    // check
+    tb_assert_abort(impl && paint && matrix);
+
+    // init the cap, join, radius and miter limit
+    impl->cap       = gb_paint_stroke_cap(paint);
+    impl->join      = gb_paint_stroke_join(paint);
+    impl->radius    = gb_float_to_tb(gb_paint_stroke_width(paint)) * 0.5f;
+    impl->miter     = gb_float_to_tb(gb_paint_stroke_miter(paint));
+
+    // the radius in the device space
+    tb_float_t sx       = gb_float_to_tb(matrix->sx);
+    tb_float_t kx       = gb_float_to_tb(matrix->kx);
+    tb_float_t ky       = gb_float_to_tb(matrix->ky);
+    tb_float_t sy       = gb_float_to_tb(matrix->sy);
+    tb_float_t det      = sx * sy - kx * ky;
+    tb_float_t radius   = impl->radius * tb_sqrtf(det < 0? -det : det);
+
+    /* compute the angle step for the tolerance
+     *
+     * the distance between the arc and its chord: r - r * cos(a / 2) <= tolerance
+     * a <= 2 * acos(1 - tolerance / r)
+     */
+    impl->step = GB_GL_STROKER_PI / 2;
+    if (radius > GB_GL_STROKER_ROUND_TOLERANCE) 
+        impl->step = 2.0f * tb_acosf(1.0f - GB_GL_STROKER_ROUND_TOLERANCE / radius);
+    if (impl->step < GB_GL_STROKER_PI / GB_GL_STROKER_ROUND_MAXN) impl->step = GB_GL_STROKER_PI / GB_GL_STROKER_ROUND_MAXN;
+
+    // clear the strip and bounds
+    impl->strip_size    = 0;
+    impl->strip_link    = tb_false;
+    impl->bounds_x0     = 0;
+    impl->bounds_y0     = 0;
+    impl->bounds_x1     = 0;
+    impl->bounds_y1     = 0;
+}
+static tb_void_t gb_gl_stroker_make_bounds(gb_gl_stroker_impl_t* impl)
+{
+    // check
+    tb_assert_abort(impl);
+
+    // make the bounds
+    impl->bounds.x = tb_float_to_gb(impl->bounds_x0);
+    impl->bounds.y = tb_float_to_gb(impl->bounds_y0);
+    impl->bounds.w = tb_float_to_gb(impl->bounds_x1 - impl->bounds_x0);
+    impl->bounds.h = tb_float_to_gb(impl->bounds_y1 - impl->bounds_y0);
+}
+static tb_bool_t gb_gl_stroker_grow_contour(gb_gl_stroker_impl_t* impl, tb_size_t count)
+{
+    // check
+    tb_assert_abort(impl);
+
+    // grow contour
+    if (count > impl->contour_maxn)
+    {
+        impl->contour = tb_ralloc_type(impl->contour, count, gb_gl_stroker_point_t);
+        tb_assert_and_check_return_val(impl->contour, tb_false);
+        impl->contour_maxn = count;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_gl_stroker_emit(gb_gl_stroker_impl_t* impl, tb_float_t x, tb_float_t y)
+{
+    // check
+    tb_assert_abort(impl);
+
+    // grow strip, reserve the two points of the degenerate triangles
+    if (impl->strip_size + 3 > impl->strip_maxn)
+    {
+        tb_size_t maxn = tb_align8((impl->strip_size + 3) << 1);
+        impl->strip = tb_ralloc_type(impl->strip, maxn, gb_point_t);
+        tb_assert_and_check_return(impl->strip);
+        impl->strip_maxn = maxn;
+    }
+
+    // the point
+    gb_point_t point;
+    point.x = tb_float_to_gb(x);
+    point.y = tb_float_to_gb(y);
+
+    // link this contour to the previous contour by the degenerate triangles
+    if (impl->strip_link)
+    {
+        impl->strip[impl->strip_size] = impl->strip[impl->strip_size - 1];
+        impl->strip_size++;
+        impl->strip[impl->strip_size++] = point;
+        impl->strip_link = tb_false;
+    }
+
+    // add point
+    impl->strip[impl->strip_size++] = point;
+
+    // update the bounds
+    if (impl->strip_size > 1)
+    {
+        if (x < impl->bounds_x0) impl->bounds_x0 = x;
+        if (y < impl->bounds_y0) impl->bounds_y0 = y;
+        if (x > impl->bounds_x1) impl->bounds_x1 = x;
+        if (y > impl->bounds_y1) impl->bounds_y1 = y;
+    }
+    else
+    {
+        impl->bounds_x0 = x;
+        impl->bounds_y0 = y;
+        impl->bounds_x1 = x;
+        impl->bounds_y1 = y;
+    }
+}
+static tb_void_t gb_gl_stroker_make_fan(gb_gl_stroker_impl_t* impl, gb_gl_stroker_point_ref_t center, tb_float_t x0, tb_float_t y0, tb_float_t x1, tb_float_t y1, tb_float_t sweep)
+{
+    // check
+    tb_assert_abort(impl && center);
+
+    /* make the fan around the center from the vector (x0, y0) to (x1, y1)
+     *
+     * c, v0, c, v1, c, v2, ..., c, vn
+     *
+     * the triangles (c, vi, c) are degenerate and the triangles (vi, c, vi+1) are the fan,
+     * the first point c and the last point vn are on the end edges of the adjacent quads,
+     * so the triangles linked to them are zero-area too.
+     */
+    tb_size_t n = 1;
+    if (sweep != 0)
+    {
+        tb_float_t angle = sweep < 0? -sweep : sweep;
+        n = (tb_size_t)(angle / impl->step) + 1;
+        if (n > GB_GL_STROKER_ROUND_MAXN << 1) n = GB_GL_STROKER_ROUND_MAXN << 1;
+    }
+
+    // the first point
+    gb_gl_stroker_emit(impl, center->x, center->y);
+    gb_gl_stroker_emit(impl, center->x + x0, center->y + y0);
+
+    // the arc points
+    tb_size_t i;
+    for (i = 1; i < n; i++)
+    {
+        // rotate the first vector
+        tb_float_t s;
+        tb_float_t c;
+        tb_sincosf(sweep * (tb_float_t)i / (tb_float_t)n, &s, &c);
+
+        // add it
+        gb_gl_stroker_emit(impl, center->x, center->y);
+        gb_gl_stroker_emit(impl, center->x + x0 * c - y0 * s, center->y + x0 * s + y0 * c);
+    }
+
+    // the last point
+    gb_gl_stroker_emit(impl, center->x, center->y);
+    gb_gl_stroker_emit(impl, center->x + x1, center->y + y1);
+}
+static tb_void_t gb_gl_stroker_make_join(gb_gl_stroker_impl_t* impl, gb_gl_stroker_point_ref_t center, tb_float_t nx0, tb_float_t ny0, tb_float_t nx1, tb_float_t ny1)
+{
+    // check
+    tb_assert_abort(impl && center);
+
+    // the radius
+    tb_float_t radius   = impl->radius;
+    tb_float_t radius2  = radius * radius;
+
+    // the cos and sin of the angle between the normals
+    tb_float_t cos_a    = (nx0 * nx1 + ny0 * ny1) / radius2;
+    tb_float_t sin_a    = (nx0 * ny1 - ny0 * nx1) / radius2;
+
+    // nearly line? the adjacent quads are joined directly
+    if (cos_a > 0 && (sin_a < 0? -sin_a : sin_a) < 1e-6f) return ;
+
+    // the outer side is opposite to the turning side
+    if (sin_a > 0)
+    {
+        nx0 = -nx0;
+        ny0 = -ny0;
+        nx1 = -nx1;
+        ny1 = -ny1;
+    }
+
+    // done join
+    switch (impl->join)
+    {
+    case GB_PAINT_STROKE_JOIN_ROUND:
+        gb_gl_stroker_make_fan(impl, center, nx0, ny0, nx1, ny1, tb_atan2f(nx0 * ny1 - ny0 * nx1, nx0 * nx1 + ny0 * ny1));
+        break;
+    case GB_PAINT_STROKE_JOIN_MITER:
+        {
+            /* the miter length: L = R / cos(a/2), cos(a/2) = sqrt((1 + cos(a)) / 2)
+             *
+             * join the miter if L / R <= M
+             */
+            tb_float_t cos_half_a = tb_sqrtf((1.0f + cos_a) * 0.5f);
+            if (cos_half_a > 1e-6f && cos_half_a * impl->miter >= 1.0f)
+            {
+                // the miter vector
+                tb_float_t mx = nx0 + nx1;
+                tb_float_t my = ny0 + ny1;
+                tb_float_t ml = tb_sqrtf(mx * mx + my * my);
+                if (ml > 0)
+                {
+                    // scale it to the miter length
+                    tb_float_t scale = radius / (cos_half_a * ml);
+                    mx *= scale;
+                    my *= scale;
+
+                    // c, v0, c, miter, c, v1
+                    gb_gl_stroker_emit(impl, center->x, center->y);
+                    gb_gl_stroker_emit(impl, center->x + nx0, center->y + ny0);
+                    gb_gl_stroker_emit(impl, center->x, center->y);
+                    gb_gl_stroker_emit(impl, center->x + mx, center->y + my);
+                    gb_gl_stroker_emit(impl, center->x, center->y);
+                    gb_gl_stroker_emit(impl, center->x + nx1, center->y + ny1);
+                    break;
+                }
+            }
+
+            // exceed the miter limit? join the bevel
+            gb_gl_stroker_make_fan(impl, center, nx0, ny0, nx1, ny1, 0);
+        }
+        break;
+    case GB_PAINT_STROKE_JOIN_BEVEL:
+    default:
+        gb_gl_stroker_make_fan(impl, center, nx0, ny0, nx1, ny1, 0);
+        break;
+    }
+}
+static tb_void_t gb_gl_stroker_make_point(gb_gl_stroker_impl_t* impl, gb_gl_stroker_point_ref_t point)
+{
+    // check
+    tb_assert_abort(impl && point);
+
+    // the radius
+    tb_float_t radius = impl->radius;
+
+    // done cap
+    switch (impl->cap)
+    {
+    case GB_PAINT_STROKE_CAP_ROUND:
+        // the circle
+        gb_gl_stroker_make_fan(impl, point, radius, 0, radius, 0, 2.0f * GB_GL_STROKER_PI);
+        break;
+    case GB_PAINT_STROKE_CAP_SQUARE:
+        // the square
+        gb_gl_stroker_emit(impl, point->x - radius, point->y - radius);
+        gb_gl_stroker_emit(impl, point->x + radius, point->y - radius);
+        gb_gl_stroker_emit(impl, point->x - radius, point->y + radius);
+        gb_gl_stroker_emit(impl, point->x + radius, point->y + radius);
+        break;
+    case GB_PAINT_STROKE_CAP_BUTT:
+    default:
+        break;
+    }
+}
+static tb_void_t gb_gl_stroker_make_contour(gb_gl_stroker_impl_t* impl, tb_size_t count, tb_bool_t closed)
+{
+    // check
+    tb_assert_abort(impl && impl->contour && count);
+
+    // link this contour to the previous contour
+    if (impl->strip_size) impl->strip_link = tb_true;
+
+    // only one point? make the cap only
+    gb_gl_stroker_point_ref_t contour = impl->contour;
+    if (count == 1)
+    {
+        gb_gl_stroker_make_point(impl, contour);
+        return ;
+    }
+
+    // the closed contour need three points at least
+    if (count < 3) closed = tb_false;
+
+    /* make the quads of the segments, the fans of the joins and caps
+     *
+     * cap, a0 + n0, a0 - n0, b0 + n0, b0 - n0, join, a1 + n1, a1 - n1, b1 + n1, b1 - n1, join, ..., cap
+     */
+    tb_size_t   i;
+    tb_size_t   segments = closed? count : count - 1;
+    tb_float_t  radius = impl->radius;
+    tb_float_t  nx = 0;
+    tb_float_t  ny = 0;
+    tb_float_t  dx = 0;
+    tb_float_t  dy = 0;
+    for (i = 0; i < segments; i++)
+    {
+        // the segment
+        gb_gl_stroker_point_t a = contour[i];
+        gb_gl_stroker_point_t b = contour[i + 1 < count? i + 1 : 0];
+
+        // the unit direction
+        dx = b.x - a.x;
+        dy = b.y - a.y;
+        tb_float_t d = tb_sqrtf(dx * dx + dy * dy);
+        dx /= d;
+        dy /= d;
+
+        // the normal with the radius
+        tb_float_t nx1 = -dy * radius;
+        tb_float_t ny1 = dx * radius;
+
+        // join the previous segment
+        if (i) gb_gl_stroker_make_join(impl, &a, nx, ny, nx1, ny1);
+        // make the start cap
+        else if (!closed)
+        {
+            if (impl->cap == GB_PAINT_STROKE_CAP_ROUND) 
+                gb_gl_stroker_make_fan(impl, &a, nx1, ny1, -nx1, -ny1, GB_GL_STROKER_PI);
+            else if (impl->cap == GB_PAINT_STROKE_CAP_SQUARE)
+            {
+                a.x -= dx * radius;
+                a.y -= dy * radius;
+            }
+        }
+
+        // extend the last segment for the square end cap
+        if (!closed && i + 1 == segments && impl->cap == GB_PAINT_STROKE_CAP_SQUARE)
+        {
+            b.x += dx * radius;
+            b.y += dy * radius;
+        }
+
+        // make the quad
+        gb_gl_stroker_emit(impl, a.x + nx1, a.y + ny1);
+        gb_gl_stroker_emit(impl, a.x - nx1, a.y - ny1);
+        gb_gl_stroker_emit(impl, b.x + nx1, b.y + ny1);
+        gb_gl_stroker_emit(impl, b.x - nx1, b.y - ny1);
+
+        // save the normal
+        nx = nx1;
+        ny = ny1;
+    }
+
+    // join the first segment for the closed contour
+    if (closed)
+    {
+        // the first normal
+        tb_float_t fx = contour[1].x - contour[0].x;
+        tb_float_t fy = contour[1].y - contour[0].y;
+        tb_float_t d = tb_sqrtf(fx * fx + fy * fy);
+
+        // join it
+        gb_gl_stroker_make_join(impl, contour, nx, ny, -fy * radius / d, fx * radius / d);
+    }
+    // make the end cap
+    else if (impl->cap == GB_PAINT_STROKE_CAP_ROUND) 
+        gb_gl_stroker_make_fan(impl, contour + count - 1, nx, ny, -nx, -ny, -GB_GL_STROKER_PI);
+}
+static tb_void_t gb_gl_stroker_add_contour(gb_gl_stroker_impl_t* impl, gb_point_ref_t points, tb_size_t count)
+{
+    // check
+    tb_assert_abort(impl && points && count);
+
+    // grow contour
+    if (!gb_gl_stroker_grow_contour(impl, count)) return ;
+
+    // closed?
+    tb_bool_t closed = (count > 1 && points[0].x == points[count - 1].x && points[0].y == points[count - 1].y)? tb_true : tb_false;
+
+    // remove the repeated points
+    tb_size_t                   i;
+    tb_size_t                   n = 0;
+    gb_gl_stroker_point_ref_t   contour = impl->contour;
+    for (i = 0; i < count; i++)
+    {
+        tb_float_t x = gb_float_to_tb(points[i].x);
+        tb_float_t y = gb_float_to_tb(points[i].y);
+        if (n)
+        {
+            tb_float_t dx = x - contour[n - 1].x;
+            tb_float_t dy = y - contour[n - 1].y;
+            if (dx * dx + dy * dy <= GB_GL_STROKER_SEGMENT_MINN) continue;
+        }
+        contour[n].x = x;
+        contour[n].y = y;
+        n++;
+    }
+
+    // remove the repeated last point of the closed contour
+    if (closed && n > 1) n--;
+
+    // make it
+    gb_gl_stroker_make_contour(impl, n, closed);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_stroker_ref_t gb_gl_stroker_init()
+{
+    // make stroker
+    return (gb_gl_stroker_ref_t)tb_malloc0_type(gb_gl_stroker_impl_t);
+}
+tb_void_t gb_gl_stroker_exit(gb_gl_stroker_ref_t stroker)
+{
+    // check
+    gb_gl_stroker_impl_t* impl = (gb_gl_stroker_impl_t*)stroker;
+    tb_assert_and_check_return(impl);
+
+    // exit contour
+    if (impl->contour) tb_free(impl->contour);
+    impl->contour = tb_null;
+
+    // exit strip
+    if (impl->strip) tb_free(impl->strip);
+    impl->strip = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_size_t gb_gl_stroker_done_polygon(gb_gl_stroker_ref_t stroker, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_polygon_ref_t polygon)
+{
+    // check
+    gb_gl_stroker_impl_t* impl = (gb_gl_stroker_impl_t*)stroker;
+    tb_assert_and_check_return_val(impl && paint && matrix && polygon && polygon->points && polygon->counts, 0);
+
+    // apply paint
+    gb_gl_stroker_apply_paint(impl, paint, matrix);
+    tb_check_return_val(impl->radius > 0, 0);
+
+    // done the contours
+    tb_uint16_t         count;
+    tb_uint16_t const*  counts = polygon->counts;
+    gb_point_ref_t      points = polygon->points;
+    while ((count = *counts++))
+    {
+        // add contour
+        gb_gl_stroker_add_contour(impl, points, count);
+
+        // the next contour
+        points += count;
+    }
+
+    // make bounds
+    gb_gl_stroker_make_bounds(impl);
+
+    // the points count of the triangle strip
+    return impl->strip_size;
+}
+tb_size_t gb_gl_stroker_done_lines(gb_gl_stroker_ref_t stroker, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count)
+{
+    // check
+    gb_gl_stroker_impl_t* impl = (gb_gl_stroker_impl_t*)stroker;
+    tb_assert_and_check_return_val(impl && paint && matrix && points && count && !(count & 0x1), 0);
+
+    // apply paint
+    gb_gl_stroker_apply_paint(impl, paint, matrix);
+    tb_check_return_val(impl->radius > 0, 0);
+
+    // done the lines
+    tb_size_t index;
+    for (index = 0; index < count; index += 2) gb_gl_stroker_add_contour(impl, points + index, 2);
+
+    // make bounds
+    gb_gl_stroker_make_bounds(impl);
+
+    // the points count of the triangle strip
+    return impl->strip_size;
+}
+gb_point_ref_t gb_gl_stroker_data(gb_gl_stroker_ref_t stroker)
+{
+    // check
+    gb_gl_stroker_impl_t* impl = (gb_gl_stroker_impl_t*)stroker;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the points
+    return impl->strip;
+}
+gb_rect_ref_t gb_gl_stroker_bounds(gb_gl_stroker_ref_t stroker)
+{
+    // check
+    gb_gl_stroker_impl_t* impl = (gb_gl_stroker_impl_t*)stroker;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the bounds
+    return &impl->bounds;
+}
@@ -0,0 +1,115 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        stroker.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_STROKER_H
+#define GB_CORE_DEVICE_GL_STROKER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the gl stroker ref type
+ *
+ * make the triangle strip of the wide stroke directly without the tessellator.
+ *
+ * each segment is a quad and each join or cap is a small fan around its center point, 
+ * they are linked by the zero-area triangles through the center point, so the whole stroke is one strip.
+ *
+ * the quads and fans overlap at the inner side of the joins and the self-intersections,
+ * so the strip need be drawn by the opaque color or to the stencil buffer.
+ */
+typedef struct{}*               gb_gl_stroker_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init stroker
+ *
+ * @return                      the stroker
+ */
+gb_gl_stroker_ref_t             gb_gl_stroker_init(tb_noarg_t);
+
+/* exit stroker
+ *
+ * @param stroker               the stroker
+ */
+tb_void_t                       gb_gl_stroker_exit(gb_gl_stroker_ref_t stroker);
+
+/* make the triangle strip of the stroked polygon
+ *
+ * the contour is closed if its first and last points are equal
+ *
+ * @param stroker               the stroker
+ * @param paint                 the paint
+ * @param matrix                the matrix for computing the precision of the round joins and caps
+ * @param polygon               the polygon
+ *
+ * @return                      the points count of the triangle strip
+ */
+tb_size_t                       gb_gl_stroker_done_polygon(gb_gl_stroker_ref_t stroker, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_polygon_ref_t polygon);
+
+/* make the triangle strip of the stroked lines
+ *
+ * @param stroker               the stroker
+ * @param paint                 the paint
+ * @param matrix                the matrix for computing the precision of the round caps
+ * @param points                the points of the lines
+ * @param count                 the points count
+ *
+ * @return                      the points count of the triangle strip
+ */
+tb_size_t                       gb_gl_stroker_done_lines(gb_gl_stroker_ref_t stroker, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count);
+
+/* the points of the triangle strip
+ *
+ * @param stroker               the stroker
+ *
+ * @return                      the points
+ */
+gb_point_ref_t                  gb_gl_stroker_data(gb_gl_stroker_ref_t stroker);
+
+/* the bounds of the triangle strip
+ *
+ * @param stroker               the stroker
+ *
+ * @return                      the bounds
+ */
+gb_rect_ref_t                   gb_gl_stroker_bounds(gb_gl_stroker_ref_t stroker);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,597 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        texture_cache.c
+ * @ingroup     core
+ */
+
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "gl_texture_cache"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "texture_cache.h"
+#include "../../pixmap.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the vram bytes of the atlas page
+#define GB_GL_TEXTURE_CACHE_ATLAS_BYTES     (GB_GL_TEXTURE_CACHE_ATLAS_SIZE * GB_GL_TEXTURE_CACHE_ATLAS_SIZE * 4)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl texture cache item type
+typedef struct __gb_gl_texture_cache_item_t
+{
+    // the entry
+    gb_gl_texture_cache_entry_t entry;
+
+    // the uploaded generation of the bitmap
+    tb_size_t                   generation;
+
+    // the last used time
+    tb_size_t                   used;
+
+    // the atlas page index + 1, 0: the standalone texture
+    tb_size_t                   page;
+
+    // the position in the texture
+    tb_uint16_t                 x;
+    tb_uint16_t                 y;
+
+    // the bitmap width and height
+    tb_uint16_t                 width;
+    tb_uint16_t                 height;
+
+    // have been uploaded?
+    tb_uint8_t                  uploaded;
+
+}gb_gl_texture_cache_item_t, *gb_gl_texture_cache_item_ref_t;
+
+// the gl texture cache atlas page type
+typedef struct __gb_gl_texture_cache_page_t
+{
+    // the texture, 0: unused
+    gb_GLuint_t                 texture;
+
+    // the last used time
+    tb_size_t                   used;
+
+    // the current shelf position and height
+    tb_uint16_t                 shelf_x;
+    tb_uint16_t                 shelf_y;
+    tb_uint16_t                 shelf_h;
+
+}gb_gl_texture_cache_page_t, *gb_gl_texture_cache_page_ref_t;
+
+// the gl texture cache impl type
+typedef struct __gb_gl_texture_cache_impl_t
+{
+    // the items, bitmap id => item
+    tb_hash_map_ref_t           items;
+
+    // the atlas pages
+    gb_gl_texture_cache_page_t  pages[GB_GL_TEXTURE_CACHE_ATLAS_MAXN];
+
+    // the vram budget
+    tb_size_t                   budget;
+
+    // the used vram
+    tb_size_t                   size;
+
+    // the current time for the lru
+    tb_size_t                   time;
+
+    // the rgba pixels for uploading
+    tb_byte_t*                  pixels;
+
+    // the rgba pixels maxn
+    tb_size_t                   pixels_maxn;
+
+}gb_gl_texture_cache_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_gl_texture_cache_item_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    gb_gl_texture_cache_item_ref_t item = (gb_gl_texture_cache_item_ref_t)buff;
+    tb_assert_and_check_return(item);
+
+    // delete the standalone texture, the atlas page texture is deleted by the page
+    if (!item->page && item->entry.texture) gb_glDeleteTextures(1, &item->entry.texture);
+    item->entry.texture = 0;
+}
+static tb_bool_t gb_gl_texture_cache_item_pred_page(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+{
+    // the item
+    gb_gl_texture_cache_item_ref_t data = item? (gb_gl_texture_cache_item_ref_t)((tb_hash_map_item_ref_t)item)->data : tb_null;
+
+    // is in this page?
+    return (data && data->page == (tb_size_t)value)? tb_true : tb_false;
+}
+static gb_GLuint_t gb_gl_texture_cache_texture_make(tb_size_t width, tb_size_t height)
+{
+    // make texture
+    gb_GLuint_t texture = 0;
+    gb_glGenTextures(1, &texture);
+    tb_assert_and_check_return_val(texture, 0);
+
+    // init it, the repeat and mirror modes are done in the fragment shader
+    gb_glBindTexture(GB_GL_TEXTURE_2D, texture);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MIN_FILTER, GB_GL_LINEAR);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_MAG_FILTER, GB_GL_LINEAR);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_S, GB_GL_CLAMP_TO_EDGE);
+    gb_glTexParameteri(GB_GL_TEXTURE_2D, GB_GL_TEXTURE_WRAP_T, GB_GL_CLAMP_TO_EDGE);
+    gb_glTexImage2D(GB_GL_TEXTURE_2D, 0, GB_GL_RGBA, (gb_GLsizei_t)width, (gb_GLsizei_t)height, 0, GB_GL_RGBA, GB_GL_UNSIGNED_BYTE, tb_null);
+
+    // ok
+    return texture;
+}
+static tb_void_t gb_gl_texture_cache_page_remove(gb_gl_texture_cache_impl_t* impl, tb_size_t index, tb_bool_t keep)
+{
+    // check
+    tb_assert_abort(impl && impl->items && index < GB_GL_TEXTURE_CACHE_ATLAS_MAXN);
+
+    // the page
+    gb_gl_texture_cache_page_ref_t page = &impl->pages[index];
+
+    // remove all items in this page
+    tb_remove_if((tb_iterator_ref_t)impl->items, gb_gl_texture_cache_item_pred_page, (tb_cpointer_t)(index + 1));
+
+    // delete the texture if not keep it for reusing
+    if (!keep && page->texture)
+    {
+        gb_glDeleteTextures(1, &page->texture);
+        page->texture = 0;
+        impl->size -= GB_GL_TEXTURE_CACHE_ATLAS_BYTES;
+    }
+
+    // reset the shelf
+    page->used      = 0;
+    page->shelf_x   = 0;
+    page->shelf_y   = 0;
+    page->shelf_h   = 0;
+
+    // trace
+    tb_trace_d("remove page: %lu, keep: %d, %lu items left", index, keep, tb_hash_map_size(impl->items));
+}
+static tb_void_t gb_gl_texture_cache_reserve(gb_gl_texture_cache_impl_t* impl, tb_size_t bytes)
+{
+    // check
+    tb_assert_abort(impl && impl->items);
+
+    // remove the least recently used textures until the budget is enough
+    while (impl->size + bytes > impl->budget)
+    {
+        // find the least recently used standalone texture
+        tb_size_t item_id   = 0;
+        tb_size_t item_used = (tb_size_t)-1;
+        tb_for_all_if (tb_hash_map_item_ref_t, hash_item, impl->items, hash_item)
+        {
+            gb_gl_texture_cache_item_ref_t item = (gb_gl_texture_cache_item_ref_t)hash_item->data;
+            if (item && !item->page && item->used < item_used)
+            {
+                item_id     = (tb_size_t)hash_item->name;
+                item_used   = item->used;
+            }
+        }
+
+        // find the least recently used atlas page
+        tb_size_t i = 0;
+        tb_size_t page_index = (tb_size_t)-1;
+        tb_size_t page_used = (tb_size_t)-1;
+        for (i = 0; i < GB_GL_TEXTURE_CACHE_ATLAS_MAXN; i++)
+        {
+            gb_gl_texture_cache_page_ref_t page = &impl->pages[i];
+            if (page->texture && page->used < page_used)
+            {
+                page_index  = i;
+                page_used   = page->used;
+            }
+        }
+
+        // no more textures? the budget is too small for this texture
+        if (item_used == (tb_size_t)-1 && page_index == (tb_size_t)-1) 
+        {
+            // trace
+            tb_trace_d("the budget: %lu is too small for %lu bytes", impl->budget, bytes);
+            break;
+        }
+
+        // remove the older one
+        if (item_used != (tb_size_t)-1 && item_used <= page_used)
+        {
+            // remove the standalone texture
+            gb_gl_texture_cache_item_ref_t item = (gb_gl_texture_cache_item_ref_t)tb_hash_map_get(impl->items, (tb_cpointer_t)item_id);
+            if (item) impl->size -= (tb_size_t)item->width * item->height * 4;
+            tb_hash_map_remove(impl->items, (tb_cpointer_t)item_id);
+
+            // trace
+            tb_trace_d("remove texture: %lu, %lu items left", item_id, tb_hash_map_size(impl->items));
+        }
+        else gb_gl_texture_cache_page_remove(impl, page_index, tb_false);
+    }
+}
+static tb_bool_t gb_gl_texture_cache_page_pack(gb_gl_texture_cache_page_ref_t page, tb_size_t width, tb_size_t height, gb_gl_texture_cache_item_ref_t item)
+{
+    // check
+    tb_assert_abort(page && page->texture && item);
+
+    // the current shelf
+    tb_size_t x = page->shelf_x;
+    tb_size_t y = page->shelf_y;
+    tb_size_t h = page->shelf_h;
+
+    // the current shelf is full? start the next shelf
+    if (x + width > GB_GL_TEXTURE_CACHE_ATLAS_SIZE)
+    {
+        x = 0;
+        y += h;
+        h = 0;
+    }
+
+    // the page is full?
+    tb_check_return_val(y + height <= GB_GL_TEXTURE_CACHE_ATLAS_SIZE, tb_false);
+
+    // save the position
+    item->x = (tb_uint16_t)x;
+    item->y = (tb_uint16_t)y;
+
+    // update the shelf
+    page->shelf_x = (tb_uint16_t)(x + width);
+    page->shelf_y = (tb_uint16_t)y;
+    page->shelf_h = (tb_uint16_t)tb_max(h, height);
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_gl_texture_cache_atlas_alloc(gb_gl_texture_cache_impl_t* impl, tb_size_t width, tb_size_t height, gb_gl_texture_cache_item_ref_t item)
+{
+    // check
+    tb_assert_abort(impl && item);
+
+    // pack it into the used pages
+    tb_size_t i = 0;
+    for (i = 0; i < GB_GL_TEXTURE_CACHE_ATLAS_MAXN; i++)
+    {
+        if (impl->pages[i].texture && gb_gl_texture_cache_page_pack(&impl->pages[i], width, height, item))
+        {
+            item->page = i + 1;
+            return tb_true;
+        }
+    }
+
+    // find an unused page
+    for (i = 0; i < GB_GL_TEXTURE_CACHE_ATLAS_MAXN && impl->pages[i].texture; i++) ;
+    if (i < GB_GL_TEXTURE_CACHE_ATLAS_MAXN)
+    {
+        // reserve the vram for the new page
+        gb_gl_texture_cache_reserve(impl, GB_GL_TEXTURE_CACHE_ATLAS_BYTES);
+
+        // make the page texture
+        gb_gl_texture_cache_page_ref_t page = &impl->pages[i];
+        page->texture = gb_gl_texture_cache_texture_make(GB_GL_TEXTURE_CACHE_ATLAS_SIZE, GB_GL_TEXTURE_CACHE_ATLAS_SIZE);
+        tb_assert_and_check_return_val(page->texture, tb_false);
+        impl->size += GB_GL_TEXTURE_CACHE_ATLAS_BYTES;
+
+        // trace
+        tb_trace_d("add page: %lu, size: %lu", i, impl->size);
+    }
+    // all pages are used? reuse the least recently used page
+    else
+    {
+        tb_size_t j = 0;
+        for (i = 0, j = 1; j < GB_GL_TEXTURE_CACHE_ATLAS_MAXN; j++)
+            if (impl->pages[j].used < impl->pages[i].used) i = j;
+        gb_gl_texture_cache_page_remove(impl, i, tb_true);
+    }
+
+    // pack it into this page
+    tb_check_return_val(gb_gl_texture_cache_page_pack(&impl->pages[i], width, height, item), tb_false);
+    item->page = i + 1;
+
+    // ok
+    return tb_true;
+}
+static gb_gl_texture_cache_item_ref_t gb_gl_texture_cache_add(gb_gl_texture_cache_impl_t* impl, tb_size_t id, tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert_abort(impl && impl->items && width && height);
+
+    // init item
+    gb_gl_texture_cache_item_t item = {{0}};
+    item.width  = (tb_uint16_t)width;
+    item.height = (tb_uint16_t)height;
+
+    // pack the small bitmap into the atlas
+    tb_size_t texture_w;
+    tb_size_t texture_h;
+    if (width <= GB_GL_TEXTURE_CACHE_ATLAS_ITEM_MAXN && height <= GB_GL_TEXTURE_CACHE_ATLAS_ITEM_MAXN)
+    {
+        // alloc it from the atlas
+        if (!gb_gl_texture_cache_atlas_alloc(impl, width, height, &item)) return tb_null;
+
+        // the atlas texture
+        item.entry.texture  = impl->pages[item.page - 1].texture;
+        texture_w           = GB_GL_TEXTURE_CACHE_ATLAS_SIZE;
+        texture_h           = GB_GL_TEXTURE_CACHE_ATLAS_SIZE;
+    }
+    // make the standalone texture
+    else
+    {
+        // reserve the vram
+        tb_size_t bytes = width * height * 4;
+        gb_gl_texture_cache_reserve(impl, bytes);
+
+        // make texture
+        item.entry.texture = gb_gl_texture_cache_texture_make(width, height);
+        tb_assert_and_check_return_val(item.entry.texture, tb_null);
+        impl->size += bytes;
+
+        // the texture size
+        texture_w = width;
+        texture_h = height;
+    }
+
+    // the normalized rect in the texture
+    item.entry.rect[0]  = (gb_GLfloat_t)item.x / texture_w;
+    item.entry.rect[1]  = (gb_GLfloat_t)item.y / texture_h;
+    item.entry.rect[2]  = (gb_GLfloat_t)width / texture_w;
+    item.entry.rect[3]  = (gb_GLfloat_t)height / texture_h;
+
+    // the texel-center bounds, avoid sampling the neighbouring bitmaps in the atlas
+    item.entry.clamp[0] = (item.x + 0.5f) / texture_w;
+    item.entry.clamp[1] = (item.y + 0.5f) / texture_h;
+    item.entry.clamp[2] = (item.x + width - 0.5f) / texture_w;
+    item.entry.clamp[3] = (item.y + height - 0.5f) / texture_h;
+
+    // add it
+    tb_hash_map_insert(impl->items, (tb_cpointer_t)id, &item);
+
+    // trace
+    tb_trace_d("add: %lu, %lux%lu, page: %lu, size: %lu", id, width, height, item.page, impl->size);
+
+    // ok
+    return (gb_gl_texture_cache_item_ref_t)tb_hash_map_get(impl->items, (tb_cpointer_t)id);
+}
+static tb_bool_t gb_gl_texture_cache_upload(gb_gl_texture_cache_impl_t* impl, gb_gl_texture_cache_item_ref_t item, gb_bitmap_ref_t bitmap, tb_size_t x, tb_size_t y, tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert_abort(impl && item && bitmap && width && height);
+
+    // the bitmap data
+    tb_byte_t const*    data = (tb_byte_t const*)gb_bitmap_data(bitmap);
+    tb_size_t           row_bytes = gb_bitmap_row_bytes(bitmap);
+    gb_pixmap_ref_t     pixmap = gb_pixmap(gb_bitmap_pixfmt(bitmap), 0xff);
+    tb_bool_t           has_alpha = gb_bitmap_has_alpha(bitmap);
+    tb_assert_and_check_return_val(data && row_bytes && pixmap, tb_false);
+
+    // grow the rgba pixels
+    tb_size_t size = width * height * 4;
+    if (size > impl->pixels_maxn)
+    {
+        impl->pixels = (tb_byte_t*)tb_ralloc(impl->pixels, size);
+        tb_assert_and_check_return_val(impl->pixels, tb_false);
+        impl->pixels_maxn = size;
+    }
+
+    // convert the dirty pixels to rgba
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_size_t   btp = pixmap->btp;
+    tb_byte_t*  pixels = impl->pixels;
+    for (j = 0; j < height; j++)
+    {
+        tb_byte_t const* p = data + (y + j) * row_bytes + x * btp;
+        for (i = 0; i < width; i++, p += btp, pixels += 4)
+        {
+            gb_color_t color = pixmap->color_get(p);
+            pixels[0] = color.r;
+            pixels[1] = color.g;
+            pixels[2] = color.b;
+            pixels[3] = has_alpha? color.a : 0xff;
+        }
+    }
+
+    // upload them, the texture will be bound again by the shader
+    gb_glBindTexture(GB_GL_TEXTURE_2D, item->entry.texture);
+    gb_glTexSubImage2D(GB_GL_TEXTURE_2D, 0, (gb_GLint_t)(item->x + x), (gb_GLint_t)(item->y + y), (gb_GLsizei_t)width, (gb_GLsizei_t)height, GB_GL_RGBA, GB_GL_UNSIGNED_BYTE, impl->pixels);
+
+    // trace
+    tb_trace_d("upload: %lu, %lu, %lux%lu", x, y, width, height);
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_gl_texture_cache_ref_t gb_gl_texture_cache_init(tb_size_t budget)
+{
+    // check
+    tb_assert_and_check_return_val(budget, tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    gb_gl_texture_cache_impl_t* impl = tb_null;
+    do
+    {
+        // make cache
+        impl = tb_malloc0_type(gb_gl_texture_cache_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init budget
+        impl->budget = budget;
+
+        // init items
+        impl->items = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_SMALL, tb_element_size(), tb_element_mem(sizeof(gb_gl_texture_cache_item_t), gb_gl_texture_cache_item_free, tb_null));
+        tb_assert_and_check_break(impl->items);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_gl_texture_cache_exit((gb_gl_texture_cache_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_gl_texture_cache_ref_t)impl;
+}
+tb_void_t gb_gl_texture_cache_exit(gb_gl_texture_cache_ref_t cache)
+{
+    // check
+    gb_gl_texture_cache_impl_t* impl = (gb_gl_texture_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl);
+
+    // clear it
+    if (impl->items) gb_gl_texture_cache_clear(cache);
+
+    // exit items
+    if (impl->items) tb_hash_map_exit(impl->items);
+    impl->items = tb_null;
+
+    // exit pixels
+    if (impl->pixels) tb_free(impl->pixels);
+    impl->pixels = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_gl_texture_cache_clear(gb_gl_texture_cache_ref_t cache)
+{
+    // check
+    gb_gl_texture_cache_impl_t* impl = (gb_gl_texture_cache_impl_t*)cache;
+    tb_assert_and_check_return(impl && impl->items);
+
+    // clear items and delete the standalone textures
+    tb_hash_map_clear(impl->items);
+
+    // clear pages
+    tb_size_t i = 0;
+    for (i = 0; i < GB_GL_TEXTURE_CACHE_ATLAS_MAXN; i++)
+    {
+        if (impl->pages[i].texture) gb_glDeleteTextures(1, &impl->pages[i].texture);
+    }
+    tb_memset(impl->pages, 0, sizeof(impl->pages));
+
+    // clear size and time
+    impl->size = 0;
+    impl->time = 0;
+}
+gb_gl_texture_cache_entry_ref_t gb_gl_texture_cache_get(gb_gl_texture_cache_ref_t cache, gb_bitmap_ref_t bitmap)
+{
+    // check
+    gb_gl_texture_cache_impl_t* impl = (gb_gl_texture_cache_impl_t*)cache;
+    tb_assert_and_check_return_val(impl && impl->items && bitmap, tb_null);
+
+    // the bitmap id and size
+    tb_size_t id        = gb_bitmap_id(bitmap);
+    tb_size_t width     = gb_bitmap_width(bitmap);
+    tb_size_t height    = gb_bitmap_height(bitmap);
+    tb_check_return_val(width && height && width <= TB_MAXU16 && height <= TB_MAXU16, tb_null);
+
+    // update time
+    impl->time++;
+
+    // find it, remove it if the bitmap has been resized
+    gb_gl_texture_cache_item_ref_t item = (gb_gl_texture_cache_item_ref_t)tb_hash_map_get(impl->items, (tb_cpointer_t)id);
+    if (item && (item->width != width || item->height != height))
+    {
+        if (!item->page) impl->size -= (tb_size_t)item->width * item->height * 4;
+        tb_hash_map_remove(impl->items, (tb_cpointer_t)id);
+        item = tb_null;
+    }
+
+    // not found? add it
+    if (!item) item = gb_gl_texture_cache_add(impl, id, width, height);
+    tb_check_return_val(item, tb_null);
+
+    // the bitmap has been changed? upload it
+    tb_size_t generation = gb_bitmap_generation(bitmap);
+    if (!item->uploaded || item->generation != generation)
+    {
+        // only upload the dirty rect if the changes are known
+        gb_rect_t dirty;
+        if (item->uploaded && gb_bitmap_dirty(bitmap, item->generation, &dirty))
+        {
+            tb_long_t x = gb_float_to_long(dirty.x);
+            tb_long_t y = gb_float_to_long(dirty.y);
+            tb_long_t w = gb_float_to_long(dirty.w);
+            tb_long_t h = gb_float_to_long(dirty.h);
+            if (w > 0 && h > 0) gb_gl_texture_cache_upload(impl, item, bitmap, x, y, w, h);
+        }
+        // upload all pixels
+        else gb_gl_texture_cache_upload(impl, item, bitmap, 0, 0, width, height);
+
+        // the texture has been synchronized to this generation
+        item->uploaded      = 1;
+        item->generation    = generation;
+        gb_bitmap_dirty_clear(bitmap);
+    }
+
+    // update the used time
+    item->used = impl->time;
+    if (item->page) impl->pages[item->page - 1].used = impl->time;
+
+    // ok
+    return &item->entry;
+}
+tb_bool_t gb_gl_texture_cache_ready(gb_gl_texture_cache_ref_t cache, gb_bitmap_ref_t bitmap)
+{
+    // check
+    gb_gl_texture_cache_impl_t* impl = (gb_gl_texture_cache_impl_t*)cache;
+    tb_assert_and_check_return_val(impl && impl->items && bitmap, tb_false);
+
+    // find it
+    gb_gl_texture_cache_item_ref_t item = (gb_gl_texture_cache_item_ref_t)tb_hash_map_get(impl->items, (tb_cpointer_t)gb_bitmap_id(bitmap));
+    tb_check_return_val(item, tb_false);
+
+    // the same size and generation?
+    return (    item->width == gb_bitmap_width(bitmap)
+            &&  item->height == gb_bitmap_height(bitmap)
+            &&  item->uploaded
+            &&  item->generation == gb_bitmap_generation(bitmap))? tb_true : tb_false;
+}
+tb_size_t gb_gl_texture_cache_size(gb_gl_texture_cache_ref_t cache)
+{
+    // check
+    gb_gl_texture_cache_impl_t* impl = (gb_gl_texture_cache_impl_t*)cache;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the used vram
+    return impl->size;
+}
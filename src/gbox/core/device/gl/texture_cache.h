@@ -0,0 +1,136 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        texture_cache.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DEVICE_GL_TEXTURE_CACHE_H
+#define GB_CORE_DEVICE_GL_TEXTURE_CACHE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the width and height of the atlas page
+#define GB_GL_TEXTURE_CACHE_ATLAS_SIZE          (512)
+
+// the maximum width and height of the bitmap which will be packed into the atlas
+#define GB_GL_TEXTURE_CACHE_ATLAS_ITEM_MAXN     (64)
+
+// the maximum count of the atlas pages
+#define GB_GL_TEXTURE_CACHE_ATLAS_MAXN          (4)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the gl texture cache entry type
+typedef struct __gb_gl_texture_cache_entry_t
+{
+    // the texture, it is shared by all small bitmaps in the same atlas page
+    gb_GLuint_t                 texture;
+
+    // the normalized rect of the bitmap in the texture: x, y, width, height
+    gb_GLfloat_t                rect[4];
+
+    // the normalized texel-center bounds of the bitmap in the texture: x0, y0, x1, y1
+    gb_GLfloat_t                clamp[4];
+
+}gb_gl_texture_cache_entry_t, *gb_gl_texture_cache_entry_ref_t;
+
+/*! the gl texture cache ref type
+ *
+ * cache the uploaded textures of the bitmaps which are keyed by the bitmap id,
+ * the texture is uploaded again only if the bitmap generation is changed,
+ * and only the dirty rect is uploaded if the changes of the bitmap are known.
+ *
+ * the small bitmaps are packed into the shared atlas pages for avoiding to rebind textures,
+ * and the least recently used textures or atlas pages will be removed if the used vram exceeds the budget.
+ */
+typedef struct{}*               gb_gl_texture_cache_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init texture cache
+ *
+ * @param budget                the vram budget in bytes
+ *
+ * @return                      the texture cache
+ */
+gb_gl_texture_cache_ref_t       gb_gl_texture_cache_init(tb_size_t budget);
+
+/* exit texture cache and delete all textures
+ *
+ * @param cache                 the texture cache
+ */
+tb_void_t                       gb_gl_texture_cache_exit(gb_gl_texture_cache_ref_t cache);
+
+/* clear texture cache and delete all textures
+ *
+ * @param cache                 the texture cache
+ */
+tb_void_t                       gb_gl_texture_cache_clear(gb_gl_texture_cache_ref_t cache);
+
+/* get the texture entry of the given bitmap 
+ *
+ * the texture will be made or updated if the bitmap is not cached or has been changed
+ *
+ * @param cache                 the texture cache
+ * @param bitmap                the bitmap
+ *
+ * @return                      the entry, it is valid until the next getting
+ */
+gb_gl_texture_cache_entry_ref_t gb_gl_texture_cache_get(gb_gl_texture_cache_ref_t cache, gb_bitmap_ref_t bitmap);
+
+/* the texture of the given bitmap has been uploaded and not changed?
+ *
+ * @param cache                 the texture cache
+ * @param bitmap                the bitmap
+ *
+ * @return                      tb_true if getting it will not upload or remove any textures
+ */
+tb_bool_t                       gb_gl_texture_cache_ready(gb_gl_texture_cache_ref_t cache, gb_bitmap_ref_t bitmap);
+
+/* the used vram of the texture cache
+ *
+ * @param cache                 the texture cache
+ *
+ * @return                      the used bytes
+ */
+tb_size_t                       gb_gl_texture_cache_size(gb_gl_texture_cache_ref_t cache);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -31,6 +31,7 @@
 #include "../path.h"
 #include "../paint.h"
 #include "../shader.h"
+#include "../clipper.h"
 #include "../device.h"
 #include "../bitmap.h"
 #include "../pixmap.h"
@@ -78,6 +79,18 @@ typedef struct __gb_device_impl_t
      * @param color         the color
      */
     tb_void_t               (*draw_clear)(struct __gb_device_impl_t* device, gb_color_t color);
+
+    /* begin drawing a frame, optional
+     *
+     * @param device        the device
+     */
+    tb_void_t               (*draw_begin)(struct __gb_device_impl_t* device);
+
+    /* flush the pending draws, optional
+     *
+     * @param device        the device
+     */
+    tb_void_t               (*draw_flush)(struct __gb_device_impl_t* device);
 	
     /*! draw path
      *
@@ -113,6 +126,55 @@ typedef struct __gb_device_impl_t
      */
     tb_void_t               (*draw_polygon)(struct __gb_device_impl_t* device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds);
 
+    /*! draw rects, optional
+     *
+     * @param device        the device
+     * @param rects         the rects
+     * @param count         the rects count
+     * @param bounds        the bounds of all rects
+     */
+    tb_void_t               (*draw_rects)(struct __gb_device_impl_t* device, gb_rect_ref_t rects, tb_size_t count, gb_rect_ref_t bounds);
+
+    /*! draw triangles, optional
+     *
+     * @param device        the device
+     * @param triangles     the triangles
+     * @param count         the triangles count
+     * @param bounds        the bounds of all triangles
+     */
+    tb_void_t               (*draw_triangles)(struct __gb_device_impl_t* device, gb_triangle_ref_t triangles, tb_size_t count, gb_rect_ref_t bounds);
+
+    /*! draw the source rect of the bitmap to the destination rect, optional
+     *
+     * @param device        the device
+     * @param bitmap        the bitmap
+     * @param src_rect      the source rect in the bitmap
+     * @param dst_rect      the destination rect
+     */
+    tb_void_t               (*draw_bitmap)(struct __gb_device_impl_t* device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect);
+
+    /*! draw the instances of the path, optional
+     *
+     * @param device        the device
+     * @param path          the path of one instance
+     * @param matrices      the matrices of the instances
+     * @param colors        the colors of the instances, uses the paint color if be null
+     * @param count         the instances count
+     *
+     * @return              tb_false if the current paint is not supported and the instances will be drawn one by one
+     */
+    tb_bool_t               (*draw_instances)(struct __gb_device_impl_t* device, gb_path_ref_t path, gb_matrix_ref_t matrices, gb_color_t const* colors, tb_size_t count);
+
+    /*! read back the pixels of the device to the bitmap, optional
+     *
+     * @param device        the device
+     * @param bitmap        the bitmap
+     * @param wait          wait the current frame? otherwise read the previous frame
+     *
+     * @return              tb_true if the bitmap is updated, tb_false if no frame is ready
+     */
+    tb_bool_t               (*read)(struct __gb_device_impl_t* device, gb_bitmap_ref_t bitmap, tb_bool_t wait);
+
     /*! init linear gradient shader
      *
      * @param device        the device
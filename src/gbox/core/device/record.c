@@ -0,0 +1,194 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        record.c
+ * @ingroup     core
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "device_record"
+#define TB_TRACE_MODULE_DEBUG           (1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../impl/display_list.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the record device type
+typedef struct __gb_record_device_t
+{
+    // the base
+    gb_device_impl_t            base;
+
+    // the display list, not owned
+    gb_display_list_ref_t       list;
+
+}gb_record_device_t, *gb_record_device_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_device_record_apply_clip(gb_record_device_ref_t impl)
+{
+    // check
+    tb_assert_abort(impl && impl->list);
+
+    // record the clipped rect if it is changed
+    gb_display_list_record_clip(impl->list, impl->base.clipper? gb_clipper_rect(impl->base.clipper) : tb_null);
+}
+static tb_void_t gb_device_record_resize(gb_device_impl_t* device, tb_size_t width, tb_size_t height)
+{
+    // check
+    gb_record_device_ref_t impl = (gb_record_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // resize
+    impl->base.width    = (tb_uint16_t)width;
+    impl->base.height   = (tb_uint16_t)height;
+}
+static tb_void_t gb_device_record_draw_clear(gb_device_impl_t* device, gb_color_t color)
+{
+    // check
+    gb_record_device_ref_t impl = (gb_record_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->list);
+
+    // record it
+    gb_device_record_apply_clip(impl);
+    gb_display_list_record_clear(impl->list, color);
+}
+static tb_void_t gb_device_record_draw_path(gb_device_impl_t* device, gb_path_ref_t path)
+{
+    // check
+    gb_record_device_ref_t impl = (gb_record_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->list);
+
+    // record it
+    gb_device_record_apply_clip(impl);
+    gb_display_list_record_path(impl->list, impl->base.paint, impl->base.matrix, path);
+}
+static tb_void_t gb_device_record_draw_lines(gb_device_impl_t* device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_record_device_ref_t impl = (gb_record_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->list);
+
+    // record it
+    gb_device_record_apply_clip(impl);
+    gb_display_list_record_lines(impl->list, impl->base.paint, impl->base.matrix, points, count, bounds);
+}
+static tb_void_t gb_device_record_draw_points(gb_device_impl_t* device, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    gb_record_device_ref_t impl = (gb_record_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->list);
+
+    // record it
+    gb_device_record_apply_clip(impl);
+    gb_display_list_record_points(impl->list, impl->base.paint, impl->base.matrix, points, count, bounds);
+}
+static tb_void_t gb_device_record_draw_polygon(gb_device_impl_t* device, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds)
+{
+    // check
+    gb_record_device_ref_t impl = (gb_record_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->list);
+
+    // record it
+    gb_device_record_apply_clip(impl);
+    gb_display_list_record_polygon(impl->list, impl->base.paint, impl->base.matrix, polygon, hint, bounds);
+}
+static tb_bool_t gb_device_record_draw_instances(gb_device_impl_t* device, gb_path_ref_t path, gb_matrix_ref_t matrices, gb_color_t const* colors, tb_size_t count)
+{
+    // check
+    gb_record_device_ref_t impl = (gb_record_device_ref_t)device;
+    tb_assert_and_check_return_val(impl && impl->list, tb_false);
+
+    // record them as one command, the replayed device will draw them by itself
+    gb_device_record_apply_clip(impl);
+    gb_display_list_record_instances(impl->list, impl->base.paint, impl->base.matrix, path, matrices, colors, count);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_device_record_draw_bitmap(gb_device_impl_t* device, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    gb_record_device_ref_t impl = (gb_record_device_ref_t)device;
+    tb_assert_and_check_return(impl && impl->list);
+
+    // record it
+    gb_device_record_apply_clip(impl);
+    gb_display_list_record_bitmap(impl->list, impl->base.paint, impl->base.matrix, bitmap, src_rect, dst_rect);
+}
+static tb_void_t gb_device_record_exit(gb_device_impl_t* device)
+{
+    // check
+    gb_record_device_ref_t impl = (gb_record_device_ref_t)device;
+    tb_assert_and_check_return(impl);
+
+    // exit it
+    tb_free(impl);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_device_ref_t gb_device_init_record(gb_display_list_ref_t list, tb_size_t width, tb_size_t height)
+{
+    // check
+    tb_assert_and_check_return_val(list && width && height && width <= GB_WIDTH_MAXN && height <= GB_HEIGHT_MAXN, tb_null);
+
+    // done
+    gb_record_device_ref_t impl = tb_null;
+    do
+    {
+        // make device
+        impl = tb_malloc0_type(gb_record_device_t);
+        tb_assert_and_check_break(impl);
+
+        // init base 
+        impl->base.type             = GB_DEVICE_TYPE_RECORD;
+        impl->base.pixfmt           = GB_PIXFMT_NONE;
+        impl->base.width            = (tb_uint16_t)width;
+        impl->base.height           = (tb_uint16_t)height;
+        impl->base.resize           = gb_device_record_resize;
+        impl->base.draw_clear       = gb_device_record_draw_clear;
+        impl->base.draw_path        = gb_device_record_draw_path;
+        impl->base.draw_lines       = gb_device_record_draw_lines;
+        impl->base.draw_points      = gb_device_record_draw_points;
+        impl->base.draw_polygon     = gb_device_record_draw_polygon;
+        impl->base.draw_instances   = gb_device_record_draw_instances;
+        impl->base.draw_bitmap      = gb_device_record_draw_bitmap;
+        impl->base.exit             = gb_device_record_exit;
+
+        // init list
+        impl->list = list;
+
+    } while (0);
+
+    // ok?
+    return (gb_device_ref_t)impl;
+}
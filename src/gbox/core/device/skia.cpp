@@ -543,6 +543,9 @@ gb_device_ref_t gb_device_init_skia(gb_bitmap_ref_t bitmap)
 
         // init base 
         impl->base.type             = GB_DEVICE_TYPE_BITMAP;
+        impl->base.pixfmt           = (tb_uint16_t)gb_bitmap_pixfmt(bitmap);
+        impl->base.width            = (tb_uint16_t)width;
+        impl->base.height           = (tb_uint16_t)height;
         impl->base.resize           = gb_device_skia_resize;
         impl->base.draw_clear       = gb_device_skia_draw_clear;
         impl->base.draw_path        = gb_device_skia_draw_path;
@@ -0,0 +1,993 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        display_list.c
+ * @ingroup     core
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "display_list"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "display_list.h"
+#include "path.h"
+#include "paint.h"
+#include "device.h"
+#include "clipper.h"
+#include "device/prefix.h"
+#include "impl/bounds.h"
+#include "impl/display_list.h"
+#include "../utils/spatial_index.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the paths grow
+#define GB_DISPLAY_LIST_PATHS_GROW      (16)
+
+// the paints grow
+#define GB_DISPLAY_LIST_PAINTS_GROW     (16)
+
+// the minimum draws count for culling by the spatial index
+#define GB_DISPLAY_LIST_INDEX_MINN      (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the display list command code enum
+typedef enum __gb_display_list_code_e
+{
+    GB_DISPLAY_LIST_CODE_NONE           = 0
+,   GB_DISPLAY_LIST_CODE_PAINT          = 1 //!< bind the recorded paint
+,   GB_DISPLAY_LIST_CODE_MATRIX         = 2 //!< bind the recorded matrix
+,   GB_DISPLAY_LIST_CODE_CLEAR          = 3 //!< clear the device
+,   GB_DISPLAY_LIST_CODE_CLIP           = 4 //!< clip the device by the recorded rect
+,   GB_DISPLAY_LIST_CODE_PATH           = 5 //!< draw the recorded path, the draw commands must be placed after it
+,   GB_DISPLAY_LIST_CODE_LINES          = 6 //!< draw lines
+,   GB_DISPLAY_LIST_CODE_POINTS         = 7 //!< draw points
+,   GB_DISPLAY_LIST_CODE_POLYGON        = 8 //!< draw polygon
+,   GB_DISPLAY_LIST_CODE_INSTANCES      = 9 //!< draw the instances of the recorded path
+,   GB_DISPLAY_LIST_CODE_BITMAP         = 10 //!< draw the referenced bitmap
+
+}gb_display_list_code_e;
+
+// the display list command flag enum
+typedef enum __gb_display_list_flag_e
+{
+    GB_DISPLAY_LIST_FLAG_NONE           = 0
+,   GB_DISPLAY_LIST_FLAG_RECT           = 1 //!< the bounds argument or the clipped rect exists
+,   GB_DISPLAY_LIST_FLAG_HINT           = 2 //!< the hint shape exists
+,   GB_DISPLAY_LIST_FLAG_CONVEX         = 4 //!< the polygon is convex
+,   GB_DISPLAY_LIST_FLAG_COLORS         = 8 //!< the colors of the instances exist
+
+}gb_display_list_flag_e;
+
+// the display list command type
+typedef struct __gb_display_list_command_t
+{
+    // the code
+    tb_uint16_t                 code;
+
+    // the flag
+    tb_uint16_t                 flag;
+
+    // the size of the command and its data, be aligned by 8 bytes
+    tb_uint32_t                 size;
+
+}gb_display_list_command_t, *gb_display_list_command_ref_t;
+
+// the paint command type
+typedef struct __gb_display_list_paint_t
+{
+    // the base
+    gb_display_list_command_t   base;
+
+    // the paint index
+    tb_size_t                   index;
+
+}gb_display_list_paint_t, *gb_display_list_paint_ref_t;
+
+// the matrix command type
+typedef struct __gb_display_list_matrix_t
+{
+    // the base
+    gb_display_list_command_t   base;
+
+    // the matrix
+    gb_matrix_t                 matrix;
+
+}gb_display_list_matrix_t, *gb_display_list_matrix_ref_t;
+
+// the clear command type
+typedef struct __gb_display_list_clear_t
+{
+    // the base
+    gb_display_list_command_t   base;
+
+    // the color
+    gb_color_t                  color;
+
+}gb_display_list_clear_t, *gb_display_list_clear_ref_t;
+
+// the clip command type
+typedef struct __gb_display_list_clip_t
+{
+    // the base
+    gb_display_list_command_t   base;
+
+    // the clipped rect in the recorded device space, be valid only if the rect flag exists
+    gb_rect_t                   rect;
+
+}gb_display_list_clip_t, *gb_display_list_clip_ref_t;
+
+/* the draw command type
+ *
+ * the data is followed: 
+ *
+ * lines and points:    points
+ * polygon:             [hint], points, counts
+ * instances:           matrices, [colors]
+ * bitmap:              the bitmap reference, the source rect
+ */
+typedef struct __gb_display_list_draw_t
+{
+    // the base
+    gb_display_list_command_t   base;
+
+    // the bounds in the recorded device space for culling
+    gb_rect_t                   bounds;
+
+    // the bounds argument of the lines, points and polygon, the destination rect of the bitmap
+    gb_rect_t                   rect;
+
+    // the path index of the path and instances
+    tb_size_t                   index;
+
+    // the points count of the lines, points and polygon, the instances count 
+    tb_size_t                   count;
+
+    // the counts count of the polygon with the tail zero
+    tb_size_t                   counts;
+
+}gb_display_list_draw_t, *gb_display_list_draw_ref_t;
+
+// the display list impl type
+typedef struct __gb_display_list_impl_t
+{
+    // the commands
+    tb_buffer_t                 commands;
+
+    // the commands count
+    tb_size_t                   size;
+
+    // the recorded paths
+    tb_vector_ref_t             paths;
+
+    // the path version => the path index + 1
+    tb_hash_map_ref_t           versions;
+
+    // the recorded paints
+    tb_vector_ref_t             paints;
+
+    // the last recorded paint
+    gb_paint_ref_t              paint;
+
+    // the last recorded matrix
+    gb_matrix_t                 matrix;
+
+    // the matrix has been recorded?
+    tb_bool_t                   matrix_ok;
+
+    // the last recorded clipped rect
+    gb_rect_t                   clip;
+
+    // the recorded device is clipped?
+    tb_bool_t                   clip_ok;
+
+    // the clipper for replaying the recorded clips
+    gb_clipper_ref_t            clipper;
+
+    // the bounds of all drawings
+    gb_rect_t                   bounds;
+
+    // the bounds is valid?
+    tb_bool_t                   bounds_ok;
+
+    // the draw commands count
+    tb_size_t                   draws;
+
+    // the spatial index of the draw bounds for culling
+    gb_spatial_index_ref_t      index;
+
+    // the spatial index need be rebuilt?
+    tb_bool_t                   index_dirty;
+
+}gb_display_list_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_byte_t* gb_display_list_append(gb_display_list_impl_t* impl, tb_size_t code, tb_size_t flag, tb_size_t size)
+{
+    // check
+    tb_assert_abort(impl && size >= sizeof(gb_display_list_command_t));
+
+    // align the size for the data of the next command
+    size = tb_align8(size);
+
+    // grow the commands
+    tb_size_t   offset = tb_buffer_size(&impl->commands);
+    tb_byte_t*  data = tb_buffer_resize(&impl->commands, offset + size);
+    tb_assert_and_check_return_val(data, tb_null);
+
+    // init command
+    gb_display_list_command_ref_t command = (gb_display_list_command_ref_t)(data + offset);
+    tb_memset(command, 0, size);
+    command->code = (tb_uint16_t)code;
+    command->flag = (tb_uint16_t)flag;
+    command->size = (tb_uint32_t)size;
+
+    // update the commands count
+    impl->size++;
+
+    // the draw command? the spatial index need be rebuilt
+    if (code >= GB_DISPLAY_LIST_CODE_PATH)
+    {
+        impl->draws++;
+        impl->index_dirty = tb_true;
+    }
+
+    // ok
+    return (tb_byte_t*)command;
+}
+static tb_bool_t gb_display_list_paint_equal(gb_paint_ref_t paint, gb_paint_ref_t other)
+{
+    // check
+    tb_assert_abort(paint && other);
+
+    // the colors
+    gb_color_t color = gb_paint_color(paint);
+    gb_color_t color_other = gb_paint_color(other);
+
+    // equal?
+    return (    gb_paint_mode(paint) == gb_paint_mode(other)
+            &&  gb_paint_flag(paint) == gb_paint_flag(other)
+            &&  gb_paint_quality(paint) == gb_paint_quality(other)
+            &&  !tb_memcmp(&color, &color_other, sizeof(gb_color_t))
+            &&  gb_paint_alpha(paint) == gb_paint_alpha(other)
+            &&  gb_paint_stroke_width(paint) == gb_paint_stroke_width(other)
+            &&  gb_paint_stroke_cap(paint) == gb_paint_stroke_cap(other)
+            &&  gb_paint_stroke_join(paint) == gb_paint_stroke_join(other)
+            &&  gb_paint_stroke_miter(paint) == gb_paint_stroke_miter(other)
+            &&  gb_paint_fill_rule(paint) == gb_paint_fill_rule(other)
+            &&  gb_paint_shader(paint) == gb_paint_shader(other))? tb_true : tb_false;
+}
+static tb_bool_t gb_display_list_apply_state(gb_display_list_impl_t* impl, gb_paint_ref_t paint, gb_matrix_ref_t matrix)
+{
+    // check
+    tb_assert_abort(impl && impl->paints && paint && matrix);
+
+    // the paint is changed? record a copy
+    if (!impl->paint || !gb_display_list_paint_equal(impl->paint, paint))
+    {
+        // copy paint
+        gb_paint_ref_t copied = gb_paint_init();
+        tb_assert_and_check_return_val(copied, tb_false);
+        gb_paint_copy(copied, paint);
+
+        // add it
+        tb_vector_insert_tail(impl->paints, copied);
+        impl->paint = copied;
+
+        // append the paint command
+        gb_display_list_paint_ref_t command = (gb_display_list_paint_ref_t)gb_display_list_append(impl, GB_DISPLAY_LIST_CODE_PAINT, GB_DISPLAY_LIST_FLAG_NONE, sizeof(gb_display_list_paint_t));
+        tb_assert_and_check_return_val(command, tb_false);
+        command->index = tb_vector_size(impl->paints) - 1;
+    }
+
+    // the matrix is changed? record it
+    if (!impl->matrix_ok || tb_memcmp(&impl->matrix, matrix, sizeof(gb_matrix_t)))
+    {
+        // append the matrix command
+        gb_display_list_matrix_ref_t command = (gb_display_list_matrix_ref_t)gb_display_list_append(impl, GB_DISPLAY_LIST_CODE_MATRIX, GB_DISPLAY_LIST_FLAG_NONE, sizeof(gb_display_list_matrix_t));
+        tb_assert_and_check_return_val(command, tb_false);
+        command->matrix = *matrix;
+
+        // save it
+        impl->matrix    = *matrix;
+        impl->matrix_ok = tb_true;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_size_t gb_display_list_path(gb_display_list_impl_t* impl, gb_path_ref_t path)
+{
+    // check
+    tb_assert_abort(impl && impl->paths && impl->versions && path);
+
+    // the same version has been recorded? reference it 
+    tb_size_t version = gb_path_version(path);
+    tb_size_t index = (tb_size_t)tb_hash_map_get(impl->versions, (tb_cpointer_t)version);
+    if (index) return index - 1;
+
+    // copy path, the path of the canvas may be reused and changed after drawing
+    gb_path_ref_t copied = gb_path_init();
+    tb_assert_and_check_return_val(copied, -1);
+    gb_path_copy(copied, path);
+
+    // add it
+    tb_vector_insert_tail(impl->paths, copied);
+    index = tb_vector_size(impl->paths);
+    tb_hash_map_insert(impl->versions, (tb_cpointer_t)version, (tb_cpointer_t)index);
+
+    // the path index
+    return index - 1;
+}
+static tb_void_t gb_display_list_add_bounds(gb_display_list_impl_t* impl, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_rect_ref_t rect, tb_bool_t stroke, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert_abort(impl && paint && matrix && rect && bounds);
+
+    // make bounds
+    gb_bounds_make_for_device(bounds, rect, matrix, paint, stroke);
+
+    // add it to the bounds of all drawings
+    if (impl->bounds_ok) gb_rect_merge(&impl->bounds, bounds);
+    else 
+    {
+        impl->bounds    = *bounds;
+        impl->bounds_ok = tb_true;
+    }
+}
+static tb_bool_t gb_display_list_culled(gb_rect_ref_t bounds, gb_matrix_ref_t matrix, gb_rect_ref_t viewport)
+{
+    // check
+    tb_assert_abort(bounds && viewport);
+
+    // map the bounds to the replayed device space
+    gb_rect_t rect = *bounds;
+    if (matrix) 
+    {
+        gb_point_t points[4];
+        gb_point_make(&points[0], bounds->x, bounds->y);
+        gb_point_make(&points[1], bounds->x + bounds->w, bounds->y);
+        gb_point_make(&points[2], bounds->x, bounds->y + bounds->h);
+        gb_point_make(&points[3], bounds->x + bounds->w, bounds->y + bounds->h);
+        gb_matrix_apply_points(matrix, points, tb_arrayn(points));
+        gb_bounds_make(&rect, points, tb_arrayn(points));
+    }
+
+    // out of the viewport?
+    return !gb_rect_intersect(&rect, viewport);
+}
+static tb_bool_t gb_display_list_visible_mark(tb_size_t index, gb_rect_ref_t bounds, tb_cpointer_t item, tb_cpointer_t priv)
+{
+    // mark this drawing as visible
+    tb_byte_t* visible = (tb_byte_t*)priv;
+    visible[index >> 3] |= (1 << (index & 7));
+    return tb_true;
+}
+static tb_byte_t* gb_display_list_visible(gb_display_list_impl_t* impl, gb_matrix_ref_t base, gb_rect_ref_t viewport)
+{
+    // check
+    tb_assert_abort(impl && base && viewport);
+
+    // too few drawings? cull them one by one
+    tb_check_return_val(impl->draws >= GB_DISPLAY_LIST_INDEX_MINN, tb_null);
+
+    // map the replayed viewport to the recorded device space
+    gb_matrix_t inverse = *base;
+    tb_check_return_val(gb_matrix_invert(&inverse), tb_null);
+    gb_point_t points[4];
+    gb_point_make(&points[0], viewport->x, viewport->y);
+    gb_point_make(&points[1], viewport->x + viewport->w, viewport->y);
+    gb_point_make(&points[2], viewport->x, viewport->y + viewport->h);
+    gb_point_make(&points[3], viewport->x + viewport->w, viewport->y + viewport->h);
+    gb_matrix_apply_points(&inverse, points, tb_arrayn(points));
+
+    // the recorded viewport
+    gb_rect_t recorded;
+    gb_bounds_make(&recorded, points, tb_arrayn(points));
+
+    // init the spatial index
+    if (!impl->index) impl->index = gb_spatial_index_init();
+    tb_assert_and_check_return_val(impl->index, tb_null);
+
+    // the drawings are changed? rebuild it 
+    if (impl->index_dirty)
+    {
+        // clear it
+        gb_spatial_index_clear(impl->index);
+
+        // insert the bounds of all drawings in order
+        tb_byte_t*  data = tb_buffer_data(&impl->commands);
+        tb_size_t   size = tb_buffer_size(&impl->commands);
+        tb_size_t   offset = 0;
+        while (data && offset + sizeof(gb_display_list_command_t) <= size)
+        {
+            gb_display_list_command_ref_t command = (gb_display_list_command_ref_t)(data + offset);
+            tb_assert_and_check_break(command->size && offset + command->size <= size);
+            if (command->code >= GB_DISPLAY_LIST_CODE_PATH) 
+                gb_spatial_index_insert(impl->index, &((gb_display_list_draw_ref_t)command)->bounds, tb_null);
+            offset += command->size;
+        }
+        impl->index_dirty = tb_false;
+    }
+
+    // mark the visible drawings
+    tb_size_t   count = gb_spatial_index_size(impl->index);
+    tb_byte_t*  visible = tb_malloc0_bytes((count + 7) >> 3);
+    tb_assert_and_check_return_val(visible, tb_null);
+    gb_spatial_index_query(impl->index, &recorded, gb_display_list_visible_mark, visible);
+
+    // ok
+    return visible;
+}
+static tb_void_t gb_display_list_replay_draw(gb_display_list_impl_t* impl, gb_device_ref_t device, gb_display_list_draw_ref_t draw)
+{
+    // check
+    tb_assert_abort(impl && impl->paths && device && draw);
+
+    // the data
+    tb_byte_t* data = (tb_byte_t*)(draw + 1);
+
+    // the bounds argument
+    gb_rect_ref_t rect = (draw->base.flag & GB_DISPLAY_LIST_FLAG_RECT)? &draw->rect : tb_null;
+
+    // done
+    switch (draw->base.code)
+    {
+    case GB_DISPLAY_LIST_CODE_PATH:
+        gb_device_draw_path(device, (gb_path_ref_t)tb_iterator_item(impl->paths, draw->index));
+        break;
+    case GB_DISPLAY_LIST_CODE_LINES:
+        gb_device_draw_lines(device, (gb_point_ref_t)data, draw->count, rect);
+        break;
+    case GB_DISPLAY_LIST_CODE_POINTS:
+        gb_device_draw_points(device, (gb_point_ref_t)data, draw->count, rect);
+        break;
+    case GB_DISPLAY_LIST_CODE_POLYGON:
+        {
+            // the hint
+            gb_shape_ref_t hint = tb_null;
+            if (draw->base.flag & GB_DISPLAY_LIST_FLAG_HINT)
+            {
+                hint = (gb_shape_ref_t)data;
+                data += sizeof(gb_shape_t);
+            }
+
+            // the polygon
+            gb_polygon_t polygon;
+            polygon.points  = (gb_point_ref_t)data;
+            polygon.counts  = (tb_uint16_t*)(data + draw->count * sizeof(gb_point_t));
+            polygon.convex  = (draw->base.flag & GB_DISPLAY_LIST_FLAG_CONVEX)? tb_true : tb_false;
+
+            // draw it
+            gb_device_draw_polygon(device, &polygon, hint, rect);
+        }
+        break;
+    case GB_DISPLAY_LIST_CODE_INSTANCES:
+        {
+            // the matrices and colors
+            gb_matrix_ref_t     matrices = (gb_matrix_ref_t)data;
+            gb_color_t const*   colors = (draw->base.flag & GB_DISPLAY_LIST_FLAG_COLORS)? (gb_color_t const*)(data + draw->count * sizeof(gb_matrix_t)) : tb_null;
+
+            // draw them
+            gb_device_draw_instances(device, (gb_path_ref_t)tb_iterator_item(impl->paths, draw->index), matrices, colors, draw->count);
+        }
+        break;
+    case GB_DISPLAY_LIST_CODE_BITMAP:
+        {
+            // the bitmap and source rect
+            gb_bitmap_ref_t bitmap = *((gb_bitmap_ref_t*)data);
+            gb_rect_ref_t   src_rect = (gb_rect_ref_t)(data + sizeof(gb_bitmap_ref_t));
+
+            // draw it
+            gb_device_draw_bitmap(device, bitmap, src_rect, &draw->rect);
+        }
+        break;
+    default:
+        // trace
+        tb_trace_e("invalid code: %u", draw->base.code);
+        break;
+    }
+}
+static tb_void_t gb_display_list_record_points_impl(gb_display_list_impl_t* impl, tb_size_t code, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // check
+    tb_assert_and_check_return(impl && paint && matrix && points && count);
+
+    // apply the state
+    if (!gb_display_list_apply_state(impl, paint, matrix)) return ;
+
+    // the bounds of the points
+    gb_rect_t rect;
+    if (bounds) rect = *bounds;
+    else gb_bounds_make(&rect, points, count);
+
+    // append the command
+    gb_display_list_draw_ref_t draw = (gb_display_list_draw_ref_t)gb_display_list_append(impl, code, bounds? GB_DISPLAY_LIST_FLAG_RECT : GB_DISPLAY_LIST_FLAG_NONE, sizeof(gb_display_list_draw_t) + count * sizeof(gb_point_t));
+    tb_assert_and_check_return(draw);
+
+    // init it
+    draw->rect  = rect;
+    draw->count = count;
+    tb_memcpy(draw + 1, points, count * sizeof(gb_point_t));
+
+    // make the bounds for culling
+    gb_display_list_add_bounds(impl, paint, matrix, &rect, tb_true, &draw->bounds);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_display_list_ref_t gb_display_list_init()
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    gb_display_list_impl_t* impl = tb_null;
+    do
+    {
+        // make list
+        impl = tb_malloc0_type(gb_display_list_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init commands
+        if (!tb_buffer_init(&impl->commands)) break;
+
+        // init paths
+        impl->paths = tb_vector_init(GB_DISPLAY_LIST_PATHS_GROW, tb_element_ptr(tb_null, tb_null));
+        tb_assert_and_check_break(impl->paths);
+
+        // init versions
+        impl->versions = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_size(), tb_element_size());
+        tb_assert_and_check_break(impl->versions);
+
+        // init paints
+        impl->paints = tb_vector_init(GB_DISPLAY_LIST_PAINTS_GROW, tb_element_ptr(tb_null, tb_null));
+        tb_assert_and_check_break(impl->paints);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_display_list_exit((gb_display_list_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_display_list_ref_t)impl;
+}
+tb_void_t gb_display_list_exit(gb_display_list_ref_t list)
+{
+    // check
+    gb_display_list_impl_t* impl = (gb_display_list_impl_t*)list;
+    tb_assert_and_check_return(impl);
+
+    // clear it
+    if (impl->paths && impl->paints && impl->versions) gb_display_list_clear(list);
+
+    // exit index
+    if (impl->index) gb_spatial_index_exit(impl->index);
+    impl->index = tb_null;
+
+    // exit clipper
+    if (impl->clipper) gb_clipper_exit(impl->clipper);
+    impl->clipper = tb_null;
+
+    // exit paints
+    if (impl->paints) tb_vector_exit(impl->paints);
+    impl->paints = tb_null;
+
+    // exit versions
+    if (impl->versions) tb_hash_map_exit(impl->versions);
+    impl->versions = tb_null;
+
+    // exit paths
+    if (impl->paths) tb_vector_exit(impl->paths);
+    impl->paths = tb_null;
+
+    // exit commands
+    tb_buffer_exit(&impl->commands);
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_display_list_clear(gb_display_list_ref_t list)
+{
+    // check
+    gb_display_list_impl_t* impl = (gb_display_list_impl_t*)list;
+    tb_assert_and_check_return(impl && impl->paths && impl->paints && impl->versions);
+
+    // exit the recorded paths
+    tb_for_all_if (gb_path_ref_t, path, impl->paths, path)
+    {
+        gb_path_exit(path);
+    }
+    tb_vector_clear(impl->paths);
+    tb_hash_map_clear(impl->versions);
+
+    // exit the recorded paints
+    tb_for_all_if (gb_paint_ref_t, paint, impl->paints, paint)
+    {
+        gb_paint_exit(paint);
+    }
+    tb_vector_clear(impl->paints);
+
+    // clear commands
+    tb_buffer_clear(&impl->commands);
+    impl->size  = 0;
+    impl->draws = 0;
+
+    // clear index
+    if (impl->index) gb_spatial_index_clear(impl->index);
+    impl->index_dirty = tb_false;
+
+    // clear state
+    impl->paint     = tb_null;
+    impl->matrix_ok = tb_false;
+    impl->clip_ok   = tb_false;
+    impl->bounds_ok = tb_false;
+}
+tb_size_t gb_display_list_size(gb_display_list_ref_t list)
+{
+    // check
+    gb_display_list_impl_t* impl = (gb_display_list_impl_t*)list;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // the commands count
+    return impl->size;
+}
+gb_rect_ref_t gb_display_list_bounds(gb_display_list_ref_t list)
+{
+    // check
+    gb_display_list_impl_t* impl = (gb_display_list_impl_t*)list;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the bounds
+    return impl->bounds_ok? &impl->bounds : tb_null;
+}
+tb_void_t gb_display_list_replay(gb_display_list_ref_t list, gb_device_ref_t device, gb_matrix_ref_t matrix)
+{
+    // check
+    gb_display_list_impl_t* impl = (gb_display_list_impl_t*)list;
+    gb_device_impl_t*       device_impl = (gb_device_impl_t*)device;
+    tb_assert_and_check_return(impl && impl->paints && device_impl);
+
+    // the commands
+    tb_byte_t*  data = tb_buffer_data(&impl->commands);
+    tb_size_t   size = tb_buffer_size(&impl->commands);
+    tb_check_return(data && size);
+
+    // save the bound paint, matrix and clipper of the device
+    gb_paint_ref_t      paint_saved = device_impl->paint;
+    gb_matrix_ref_t     matrix_saved = device_impl->matrix;
+    gb_clipper_ref_t    clipper_saved = device_impl->clipper;
+
+    // the base matrix, the culling need not map the bounds if it is identity 
+    gb_matrix_t base;
+    if (matrix) base = *matrix;
+    else gb_matrix_clear(&base);
+    gb_matrix_ref_t base_cull = gb_matrix_identity(&base)? tb_null : &base;
+
+    // the viewport: the device bounds & the clipped rect of the device
+    gb_rect_t       viewport_base;
+    gb_rect_ref_t   clip_saved = clipper_saved? gb_clipper_rect(clipper_saved) : tb_null;
+    gb_rect_imake(&viewport_base, 0, 0, gb_device_width(device), gb_device_height(device));
+    if (clip_saved) gb_rect_intersect(&viewport_base, clip_saved);
+    gb_rect_t       viewport = viewport_base;
+
+    // bind the replayed matrix
+    gb_matrix_t current = base;
+    gb_device_bind_matrix(device, &current);
+
+    // mark the visible drawings by the spatial index if there are many drawings
+    tb_byte_t*  visible = gb_display_list_visible(impl, &base, &viewport_base);
+    tb_size_t   draws = 0;
+
+    // the recorded clip is applied? the drawings need be culled by it one by one
+    tb_bool_t   clipped = tb_false;
+
+    // done
+    tb_size_t   offset = 0;
+    tb_size_t   paint_index = -1;
+    tb_size_t   paint_bound = -1;
+    tb_size_t   paints_count = tb_vector_size(impl->paints);
+    while (offset + sizeof(gb_display_list_command_t) <= size)
+    {
+        // the command
+        gb_display_list_command_ref_t command = (gb_display_list_command_ref_t)(data + offset);
+        tb_assert_and_check_break(command->size && offset + command->size <= size);
+
+        // the next command
+        offset += command->size;
+
+        // done
+        switch (command->code)
+        {
+        case GB_DISPLAY_LIST_CODE_PAINT:
+            // the paint will be bound for the next drawing 
+            paint_index = ((gb_display_list_paint_ref_t)command)->index;
+            break;
+        case GB_DISPLAY_LIST_CODE_MATRIX:
+            // apply the recorded matrix: base * matrix 
+            current = base;
+            gb_matrix_multiply(&current, &((gb_display_list_matrix_ref_t)command)->matrix);
+            break;
+        case GB_DISPLAY_LIST_CODE_CLEAR:
+            gb_device_draw_clear(device, ((gb_display_list_clear_ref_t)command)->color);
+            break;
+        case GB_DISPLAY_LIST_CODE_CLIP:
+            {
+                // init clipper
+                if (!impl->clipper) impl->clipper = gb_clipper_init();
+                tb_assert_and_check_break(impl->clipper);
+
+                // the replayed clip: the clip of the device & (base * the recorded clip) 
+                gb_clipper_clear(impl->clipper);
+                if (clip_saved) gb_clipper_add_rect(impl->clipper, GB_CLIPPER_MODE_REPLACE, clip_saved);
+                clipped = (command->flag & GB_DISPLAY_LIST_FLAG_RECT)? tb_true : tb_false;
+                if (clipped)
+                {
+                    gb_clipper_matrix_set(impl->clipper, &base);
+                    gb_clipper_add_rect(impl->clipper, GB_CLIPPER_MODE_INTERSECT, &((gb_display_list_clip_ref_t)command)->rect);
+                }
+
+                // bind it, the recorded device is not clipped now? restore the clipper of the device
+                gb_device_bind_clipper(device, clipped? impl->clipper : clipper_saved);
+
+                // update the viewport
+                viewport = viewport_base;
+                if (clipped) gb_rect_intersect(&viewport, gb_clipper_rect(impl->clipper));
+            }
+            break;
+        default:
+            {
+                // the draw command
+                gb_display_list_draw_ref_t draw = (gb_display_list_draw_ref_t)command;
+
+                // out of the viewport? skip it
+                tb_size_t index = draws++;
+                if (visible && !(visible[index >> 3] & (1 << (index & 7)))) break;
+                if ((!visible || clipped) && gb_display_list_culled(&draw->bounds, base_cull, &viewport)) break;
+
+                // bind the paint only if it is changed
+                if (paint_index != paint_bound && paint_index < paints_count)
+                {
+                    gb_device_bind_paint(device, (gb_paint_ref_t)tb_iterator_item(impl->paints, paint_index));
+                    paint_bound = paint_index;
+                }
+
+                // draw it
+                gb_display_list_replay_draw(impl, device, draw);
+            }
+            break;
+        }
+    }
+
+    // exit the visible marks
+    if (visible) tb_free(visible);
+
+    // restore the bound paint, matrix and clipper
+    gb_device_bind_paint(device, paint_saved);
+    gb_device_bind_matrix(device, matrix_saved);
+    gb_device_bind_clipper(device, clipper_saved);
+}
+tb_void_t gb_display_list_record_clear(gb_display_list_ref_t list, gb_color_t color)
+{
+    // check
+    gb_display_list_impl_t* impl = (gb_display_list_impl_t*)list;
+    tb_assert_and_check_return(impl);
+
+    // append the clear command
+    gb_display_list_clear_ref_t command = (gb_display_list_clear_ref_t)gb_display_list_append(impl, GB_DISPLAY_LIST_CODE_CLEAR, GB_DISPLAY_LIST_FLAG_NONE, sizeof(gb_display_list_clear_t));
+    tb_assert_and_check_return(command);
+    command->color = color;
+}
+tb_void_t gb_display_list_record_clip(gb_display_list_ref_t list, gb_rect_ref_t rect)
+{
+    // check
+    gb_display_list_impl_t* impl = (gb_display_list_impl_t*)list;
+    tb_assert_and_check_return(impl);
+
+    // the clip is not changed? 
+    if (rect? (impl->clip_ok && !tb_memcmp(&impl->clip, rect, sizeof(gb_rect_t))) : !impl->clip_ok) return ;
+
+    // append the clip command
+    gb_display_list_clip_ref_t command = (gb_display_list_clip_ref_t)gb_display_list_append(impl, GB_DISPLAY_LIST_CODE_CLIP, rect? GB_DISPLAY_LIST_FLAG_RECT : GB_DISPLAY_LIST_FLAG_NONE, sizeof(gb_display_list_clip_t));
+    tb_assert_and_check_return(command);
+    if (rect) command->rect = *rect;
+
+    // save it
+    if (rect) impl->clip = *rect;
+    impl->clip_ok = rect? tb_true : tb_false;
+}
+tb_void_t gb_display_list_record_path(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_path_ref_t path)
+{
+    // check
+    gb_display_list_impl_t* impl = (gb_display_list_impl_t*)list;
+    tb_assert_and_check_return(impl && paint && matrix && path);
+
+    // the path index
+    tb_size_t index = gb_display_list_path(impl, path);
+    tb_check_return(index != -1);
+
+    // apply the state
+    if (!gb_display_list_apply_state(impl, paint, matrix)) return ;
+
+    // append the command
+    gb_display_list_draw_ref_t draw = (gb_display_list_draw_ref_t)gb_display_list_append(impl, GB_DISPLAY_LIST_CODE_PATH, GB_DISPLAY_LIST_FLAG_NONE, sizeof(gb_display_list_draw_t));
+    tb_assert_and_check_return(draw);
+    draw->index = index;
+
+    // make the bounds for culling
+    gb_display_list_add_bounds(impl, paint, matrix, gb_path_bounds(path), (gb_paint_mode(paint) & GB_PAINT_MODE_STROKE)? tb_true : tb_false, &draw->bounds);
+}
+tb_void_t gb_display_list_record_lines(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // record it
+    gb_display_list_record_points_impl((gb_display_list_impl_t*)list, GB_DISPLAY_LIST_CODE_LINES, paint, matrix, points, count, bounds);
+}
+tb_void_t gb_display_list_record_points(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds)
+{
+    // record it
+    gb_display_list_record_points_impl((gb_display_list_impl_t*)list, GB_DISPLAY_LIST_CODE_POINTS, paint, matrix, points, count, bounds);
+}
+tb_void_t gb_display_list_record_polygon(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds)
+{
+    // check
+    gb_display_list_impl_t* impl = (gb_display_list_impl_t*)list;
+    tb_assert_and_check_return(impl && paint && matrix && polygon && polygon->points && polygon->counts);
+
+    // count the points and contours
+    tb_uint16_t         count;
+    tb_uint16_t const*  counts = polygon->counts;
+    tb_size_t           points_count = 0;
+    tb_size_t           counts_count = 1;
+    while ((count = *counts++)) 
+    {
+        points_count += count;
+        counts_count++;
+    }
+    tb_check_return(points_count);
+
+    // the hint of the polygon and path references the external data, do not record it
+    if (hint && (hint->type == GB_SHAPE_TYPE_POLYGON || hint->type == GB_SHAPE_TYPE_PATH)) hint = tb_null;
+
+    // apply the state
+    if (!gb_display_list_apply_state(impl, paint, matrix)) return ;
+
+    // the bounds of the polygon
+    gb_rect_t rect;
+    if (bounds) rect = *bounds;
+    else gb_bounds_make(&rect, polygon->points, points_count);
+
+    // the flag
+    tb_size_t flag = GB_DISPLAY_LIST_FLAG_NONE;
+    if (bounds) flag |= GB_DISPLAY_LIST_FLAG_RECT;
+    if (hint) flag |= GB_DISPLAY_LIST_FLAG_HINT;
+    if (polygon->convex) flag |= GB_DISPLAY_LIST_FLAG_CONVEX;
+
+    // append the command
+    tb_size_t                   size = sizeof(gb_display_list_draw_t) + (hint? sizeof(gb_shape_t) : 0) + points_count * sizeof(gb_point_t) + counts_count * sizeof(tb_uint16_t);
+    gb_display_list_draw_ref_t  draw = (gb_display_list_draw_ref_t)gb_display_list_append(impl, GB_DISPLAY_LIST_CODE_POLYGON, flag, size);
+    tb_assert_and_check_return(draw);
+
+    // init it
+    draw->rect      = rect;
+    draw->count     = points_count;
+    draw->counts    = counts_count;
+
+    // copy the hint, points and counts
+    tb_byte_t* data = (tb_byte_t*)(draw + 1);
+    if (hint)
+    {
+        tb_memcpy(data, hint, sizeof(gb_shape_t));
+        data += sizeof(gb_shape_t);
+    }
+    tb_memcpy(data, polygon->points, points_count * sizeof(gb_point_t));
+    tb_memcpy(data + points_count * sizeof(gb_point_t), polygon->counts, counts_count * sizeof(tb_uint16_t));
+
+    // make the bounds for culling
+    gb_display_list_add_bounds(impl, paint, matrix, &rect, (gb_paint_mode(paint) & GB_PAINT_MODE_STROKE)? tb_true : tb_false, &draw->bounds);
+}
+tb_void_t gb_display_list_record_instances(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_path_ref_t path, gb_matrix_ref_t matrices, gb_color_t const* colors, tb_size_t count)
+{
+    // check
+    gb_display_list_impl_t* impl = (gb_display_list_impl_t*)list;
+    tb_assert_and_check_return(impl && paint && matrix && path && matrices && count);
+
+    // the path index
+    tb_size_t index = gb_display_list_path(impl, path);
+    tb_check_return(index != -1);
+
+    // apply the state
+    if (!gb_display_list_apply_state(impl, paint, matrix)) return ;
+
+    // append the command
+    tb_size_t                   size = sizeof(gb_display_list_draw_t) + count * sizeof(gb_matrix_t) + (colors? count * sizeof(gb_color_t) : 0);
+    gb_display_list_draw_ref_t  draw = (gb_display_list_draw_ref_t)gb_display_list_append(impl, GB_DISPLAY_LIST_CODE_INSTANCES, colors? GB_DISPLAY_LIST_FLAG_COLORS : GB_DISPLAY_LIST_FLAG_NONE, size);
+    tb_assert_and_check_return(draw);
+
+    // init it
+    draw->index = index;
+    draw->count = count;
+
+    // copy the matrices and colors
+    tb_byte_t* data = (tb_byte_t*)(draw + 1);
+    tb_memcpy(data, matrices, count * sizeof(gb_matrix_t));
+    if (colors) tb_memcpy(data + count * sizeof(gb_matrix_t), colors, count * sizeof(gb_color_t));
+
+    // make the bounds of all instances for culling
+    tb_size_t       i;
+    gb_rect_t       bounds;
+    gb_matrix_t     instance;
+    gb_rect_ref_t   rect = gb_path_bounds(path);
+    tb_bool_t       stroke = (gb_paint_mode(paint) & GB_PAINT_MODE_STROKE)? tb_true : tb_false;
+    for (i = 0; i < count; i++)
+    {
+        // the matrix of this instance: matrix * matrices[i]
+        instance = *matrix;
+        gb_matrix_multiply(&instance, &matrices[i]);
+
+        // add the bounds of this instance
+        gb_display_list_add_bounds(impl, paint, &instance, rect, stroke, &bounds);
+        if (i) gb_rect_merge(&draw->bounds, &bounds);
+        else draw->bounds = bounds;
+    }
+}
+tb_void_t gb_display_list_record_bitmap(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect)
+{
+    // check
+    gb_display_list_impl_t* impl = (gb_display_list_impl_t*)list;
+    tb_assert_and_check_return(impl && paint && matrix && bitmap && src_rect && dst_rect);
+
+    // apply the state
+    if (!gb_display_list_apply_state(impl, paint, matrix)) return ;
+
+    // append the command
+    tb_size_t                   size = sizeof(gb_display_list_draw_t) + sizeof(gb_bitmap_ref_t) + sizeof(gb_rect_t);
+    gb_display_list_draw_ref_t  draw = (gb_display_list_draw_ref_t)gb_display_list_append(impl, GB_DISPLAY_LIST_CODE_BITMAP, GB_DISPLAY_LIST_FLAG_RECT, size);
+    tb_assert_and_check_return(draw);
+
+    // init it
+    draw->rect = *dst_rect;
+
+    // copy the bitmap reference and source rect, the bitmap is not retained
+    tb_byte_t* data = (tb_byte_t*)(draw + 1);
+    tb_memcpy(data, &bitmap, sizeof(gb_bitmap_ref_t));
+    tb_memcpy(data + sizeof(gb_bitmap_ref_t), src_rect, sizeof(gb_rect_t));
+
+    // make the bounds for culling
+    gb_display_list_add_bounds(impl, paint, matrix, dst_rect, tb_false, &draw->bounds);
+}
@@ -0,0 +1,120 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        display_list.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_DISPLAY_LIST_H
+#define GB_CORE_DISPLAY_LIST_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init display list
+ *
+ * the display list is recorded by the canvas of the record device and can be replayed onto any device.
+ *
+ * the paints and matrices are recorded only if they are changed, 
+ * the paths are copied once and referenced by all drawings of the same path version.
+ * the shaders are device objects and are kept by reference, so replay them onto the device which made them.
+ *
+ * @code
+ * gb_display_list_ref_t list = gb_display_list_init();
+ * if (list)
+ * {
+ *     // record it
+ *     gb_canvas_ref_t canvas = gb_canvas_init_from_record(list, width, height);
+ *     if (canvas)
+ *     {
+ *         // draw something
+ *         // ...
+ *
+ *         // exit canvas
+ *         gb_canvas_exit(canvas);
+ *     }
+ *
+ *     // replay it for each frame
+ *     gb_canvas_draw_display_list(canvas_of_window, list);
+ *
+ *     // exit list
+ *     gb_display_list_exit(list);
+ * }
+ * @endcode
+ *
+ * @return          the display list
+ */
+gb_display_list_ref_t gb_display_list_init(tb_noarg_t);
+
+/*! exit display list
+ *
+ * @param list      the display list
+ */
+tb_void_t           gb_display_list_exit(gb_display_list_ref_t list);
+
+/*! clear display list for recording again
+ *
+ * @param list      the display list
+ */
+tb_void_t           gb_display_list_clear(gb_display_list_ref_t list);
+
+/*! the commands count
+ *
+ * @param list      the display list
+ *
+ * @return          the count
+ */
+tb_size_t           gb_display_list_size(gb_display_list_ref_t list);
+
+/*! the bounds of all drawings in the recorded device space
+ *
+ * @param list      the display list
+ *
+ * @return          the bounds, be null if nothing is drawn
+ */
+gb_rect_ref_t       gb_display_list_bounds(gb_display_list_ref_t list);
+
+/*! replay display list onto the given device
+ *
+ * the recorded clips are applied within the bound clipper of the device,
+ * the drawings out of the device bounds and the clipped rect are skipped and the state changes are bound only for the drawn commands, 
+ * the bound paint, matrix and clipper of the device are restored after replaying.
+ *
+ * @param list      the display list
+ * @param device    the device
+ * @param matrix    the matrix applied before the recorded matrices, .e.g the canvas matrix, be null for identity
+ */
+tb_void_t           gb_display_list_replay(gb_display_list_ref_t list, gb_device_ref_t device, gb_matrix_ref_t matrix);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
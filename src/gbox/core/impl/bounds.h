@@ -27,6 +27,7 @@
  * includes
  */
 #include "prefix.h"
+#include "../paint.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -81,6 +82,55 @@ static __tb_inline__ tb_void_t  gb_bounds_make(gb_rect_ref_t bounds, gb_point_re
     bounds->h = y1 - y0;
 }
 
+/* make the device bounds of the drawing for culling
+ *
+ * the four corners are mapped for the rotated matrix, 
+ * and the bounds is outset by one pixel for antialiasing and by the stroke width if be stroked
+ *
+ * @param bounds                the device bounds
+ * @param rect                  the bounds of the drawing
+ * @param matrix                the matrix
+ * @param paint                 the paint
+ * @param stroke                is stroked?
+ */
+static __tb_inline__ tb_void_t  gb_bounds_make_for_device(gb_rect_ref_t bounds, gb_rect_ref_t rect, gb_matrix_ref_t matrix, gb_paint_ref_t paint, tb_bool_t stroke)
+{
+    // check
+    tb_assert_abort(bounds && rect && matrix && paint);
+
+    // map the four corners
+    gb_point_t points[4];
+    gb_point_make(&points[0], rect->x, rect->y);
+    gb_point_make(&points[1], rect->x + rect->w, rect->y);
+    gb_point_make(&points[2], rect->x, rect->y + rect->h);
+    gb_point_make(&points[3], rect->x + rect->w, rect->y + rect->h);
+    gb_matrix_apply_points(matrix, points, tb_arrayn(points));
+    gb_bounds_make(bounds, points, tb_arrayn(points));
+
+    // the outset for the antialiasing
+    gb_float_t outset = GB_ONE;
+
+    // the outset for the stroke
+    gb_float_t width = gb_paint_stroke_width(paint);
+    if (stroke && width > 0)
+    {
+        // the maximum scale of the matrix
+        gb_float_t scale_x = gb_abs(matrix->sx) + gb_abs(matrix->kx);
+        gb_float_t scale_y = gb_abs(matrix->ky) + gb_abs(matrix->sy);
+        gb_float_t scale = tb_max(scale_x, scale_y);
+
+        // the miter and square cap may be longer than the half width
+        gb_float_t miter = gb_paint_stroke_miter(paint);
+        gb_float_t limit = (gb_paint_stroke_join(paint) == GB_PAINT_STROKE_JOIN_MITER && miter > GB_SQRT2)? miter : GB_SQRT2;
+
+        // add the outset
+        outset += gb_mul(gb_mul(gb_half(width), limit), scale);
+    }
+
+    // inflate it
+    gb_rect_inflate(bounds, outset, outset);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
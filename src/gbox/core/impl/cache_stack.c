@@ -33,13 +33,31 @@
  * types
  */
 
-// the cache stack impl type
+// the cache stack item type
+typedef struct __gb_cache_stack_item_t
+{
+    // the saved object
+    tb_handle_t                 object;
+
+    // the saved count, all these states are the same object 
+    tb_size_t                   refn;
+
+}gb_cache_stack_item_t;
+
+/* the cache stack impl type
+ *
+ * the saved states are copied on write:
+ *
+ * save:  only increase the lazy count of the current object, O(1)
+ * write: copy the current object to a new saved item for all lazy states once
+ * load:  decrease the lazy count, or restore the top saved item
+ */
 typedef struct __gb_cache_stack_impl_t
 {
     // the object type
     tb_size_t                   type;
 
-    // the stack
+    // the stack, gb_cache_stack_item_t[]
     tb_stack_ref_t              stack;
 
     // the cache
@@ -48,6 +66,9 @@ typedef struct __gb_cache_stack_impl_t
     // the object
     tb_handle_t                 object;
 
+    // the lazy count of the saved states which are still shared with the current object
+    tb_size_t                   lazy;
+
     // the cache size
     tb_size_t                   cache_size;
 
@@ -134,7 +155,52 @@ static tb_bool_t gb_cache_stack_object_free(tb_iterator_ref_t iterator, tb_point
     // ok
     return tb_true;
 }
+static tb_bool_t gb_cache_stack_item_free(tb_iterator_ref_t iterator, tb_pointer_t item, tb_cpointer_t priv)
+{
+    // the type
+    tb_size_t               type = (tb_size_t)priv;
+
+    // the item
+    gb_cache_stack_item_t*  stack_item = (gb_cache_stack_item_t*)item;
+
+    // exit object 
+    if (stack_item && stack_item->object) gb_cache_stack_object_exit(type, stack_item->object);
+
+    // ok
+    return tb_true;
+}
+static tb_handle_t gb_cache_stack_object_make(gb_cache_stack_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && impl->cache, tb_null);
+
+    // get a new object from cache first
+    tb_handle_t object = tb_null;
+    if (tb_stack_size(impl->cache))
+    {
+        // get
+        object = (tb_handle_t)tb_stack_top(impl->cache);
+        tb_assert_and_check_return_val(object, tb_null);
+
+        // pop
+        tb_stack_pop(impl->cache);
+    }
+    // make a new object
+    else object = gb_cache_stack_object_init(impl->type);
+
+    // ok?
+    return object;
+}
+static tb_void_t gb_cache_stack_object_recycle(gb_cache_stack_impl_t* impl, tb_handle_t object)
+{
+    // check
+    tb_assert_and_check_return(impl && impl->cache && object);
 
+    // put this object to the cache if the cache be not full
+    if (tb_stack_size(impl->cache) < impl->cache_size) tb_stack_put(impl->cache, object);
+    // exit this object
+    else gb_cache_stack_object_exit(impl->type, object);
+}
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -161,7 +227,7 @@ gb_cache_stack_ref_t gb_cache_stack_init(tb_size_t grow, tb_size_t type)
         tb_assert_and_check_break(impl->cache);
 
         // init stack
-        impl->stack = tb_stack_init(grow, tb_element_ptr(tb_null, tb_null));
+        impl->stack = tb_stack_init(grow, tb_element_mem(sizeof(gb_cache_stack_item_t), tb_null, tb_null));
         tb_assert_and_check_break(impl->stack);
 
         // ok
@@ -189,12 +255,13 @@ tb_void_t gb_cache_stack_exit(gb_cache_stack_ref_t stack)
     // exit object
     if (impl->object) gb_cache_stack_object_exit(impl->type, impl->object);
     impl->object = tb_null;
+    impl->lazy   = 0;
 
     // exit stack
     if (impl->stack) 
     {
         // exit objects
-        tb_walk_all(impl->stack, gb_cache_stack_object_free, (tb_cpointer_t)impl->type);
+        tb_walk_all(impl->stack, gb_cache_stack_item_free, (tb_cpointer_t)impl->type);
 
         // exit stack
         tb_stack_exit(impl->stack);
@@ -215,70 +282,80 @@ tb_void_t gb_cache_stack_exit(gb_cache_stack_ref_t stack)
     // exit it
     tb_free(impl);
 }
-tb_handle_t gb_cache_stack_save(gb_cache_stack_ref_t stack)
+tb_void_t gb_cache_stack_save(gb_cache_stack_ref_t stack)
 {
     // check
     gb_cache_stack_impl_t* impl = (gb_cache_stack_impl_t*)stack;
-    tb_assert_and_check_return_val(impl && impl->cache && impl->stack, tb_null);
+    tb_assert_and_check_return(impl);
 
-    // init object first if be null
-    if (!impl->object) impl->object = gb_cache_stack_object_init(impl->type);
-    tb_assert_and_check_return_val(impl->object, tb_null);
+    // share the current object with the saved state, it will be copied when it is modified
+    impl->lazy++;
+}
+tb_void_t gb_cache_stack_load(gb_cache_stack_ref_t stack)
+{
+    // check
+    gb_cache_stack_impl_t* impl = (gb_cache_stack_impl_t*)stack;
+    tb_assert_and_check_return(impl && impl->cache && impl->stack);
 
-    // get a new object from cache first
-    tb_handle_t object = tb_null;
-    if (tb_stack_size(impl->cache))
+    // the saved state has not been modified? only drop it
+    if (impl->lazy)
     {
-        // get
-        object = (tb_handle_t)tb_stack_top(impl->cache);
-        tb_assert_and_check_return_val(impl->cache, tb_null);
-
-        // pop
-        tb_stack_pop(impl->cache);
+        impl->lazy--;
+        return ;
     }
-    // make a new object
-    else object = gb_cache_stack_object_init(impl->type);
-    tb_assert_and_check_return_val(object, tb_null);
 
-    // init the new object using the old object
-    gb_cache_stack_object_copy(impl->type, object, impl->object);
+    // load the saved item from the stack top
+    gb_cache_stack_item_t* item = (gb_cache_stack_item_t*)tb_stack_top(impl->stack);
+    tb_assert_and_check_return(item && item->object && item->refn);
 
-    // save the old object
-    tb_stack_put(impl->stack, impl->object);
+    // the saved object and the other states which share it
+    tb_handle_t object  = item->object;
+    tb_size_t   lazy    = item->refn - 1;
+
+    // pop the top item
+    tb_stack_pop(impl->stack);
+
+    // free the current object
+    if (impl->object) gb_cache_stack_object_recycle(impl, impl->object);
 
     // update the current object
     impl->object = object;
-
-    // ok
-    return impl->object;
+    impl->lazy   = lazy;
 }
-tb_void_t gb_cache_stack_load(gb_cache_stack_ref_t stack)
+tb_handle_t gb_cache_stack_object(gb_cache_stack_ref_t stack)
 {
     // check
     gb_cache_stack_impl_t* impl = (gb_cache_stack_impl_t*)stack;
-    tb_assert_and_check_return(impl && impl->cache && impl->stack);
+    tb_assert_and_check_return_val(impl && impl->stack, tb_null);
 
     // init object first if be null
     if (!impl->object) impl->object = gb_cache_stack_object_init(impl->type);
-    tb_assert_and_check_return(impl->object);
+    tb_assert_and_check_return_val(impl->object, tb_null);
 
-    // load new object from the stack top
-    tb_handle_t object = (tb_handle_t)tb_stack_top(impl->stack);
-    tb_assert_and_check_return(object);
+    // the current object will be modified, copy it for the lazy saved states first
+    if (impl->lazy)
+    {
+        // make a new object
+        tb_handle_t object = gb_cache_stack_object_make(impl);
+        tb_assert_and_check_return_val(object, tb_null);
 
-    // pop the top object 
-    tb_stack_pop(impl->stack);
+        // copy the current object to it
+        gb_cache_stack_object_copy(impl->type, object, impl->object);
 
-    // put current object to the cache if the cache be not full
-    if (impl->object && tb_stack_size(impl->cache) < impl->cache_size)
-        tb_stack_put(impl->cache, impl->object);
-    // exit the current object
-    else gb_cache_stack_object_exit(impl->type, impl->object);
+        // save it for all lazy states, the current object will not be changed for the binding
+        gb_cache_stack_item_t item;
+        item.object = object;
+        item.refn   = impl->lazy;
+        tb_stack_put(impl->stack, &item);
 
-    // update the current object
-    impl->object = object;
+        // clear the lazy count
+        impl->lazy = 0;
+    }
+
+    // the current object
+    return impl->object;
 }
-tb_handle_t gb_cache_stack_object(gb_cache_stack_ref_t stack)
+tb_handle_t gb_cache_stack_peek(gb_cache_stack_ref_t stack)
 {
     // check
     gb_cache_stack_impl_t* impl = (gb_cache_stack_impl_t*)stack;
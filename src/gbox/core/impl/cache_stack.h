@@ -72,11 +72,12 @@ tb_void_t               gb_cache_stack_exit(gb_cache_stack_ref_t stack);
 
 /* save the current object to the top object
  *
- * @param stack         the stack
+ * the saved state shares the current object and it will be copied 
+ * only when the current object is modified by gb_cache_stack_object()
  *
- * @return              the current object
+ * @param stack         the stack
  */
-tb_handle_t             gb_cache_stack_save(gb_cache_stack_ref_t stack);
+tb_void_t               gb_cache_stack_save(gb_cache_stack_ref_t stack);
 
 /* load the top object to the current object
  *
@@ -84,14 +85,25 @@ tb_handle_t             gb_cache_stack_save(gb_cache_stack_ref_t stack);
  */
 tb_void_t               gb_cache_stack_load(gb_cache_stack_ref_t stack);
 
-/* get the current object
+/* get the current object for modifying
+ *
+ * the current object will be copied for the shared saved states first,
+ * but the address of the current object will not be changed
  *
  * @param stack         the stack
  *
- * @return              the top object
+ * @return              the current object
  */
 tb_handle_t             gb_cache_stack_object(gb_cache_stack_ref_t stack);
 
+/* get the current object for reading only
+ *
+ * @param stack         the stack
+ *
+ * @return              the current object
+ */
+tb_handle_t             gb_cache_stack_peek(gb_cache_stack_ref_t stack);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
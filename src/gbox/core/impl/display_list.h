@@ -0,0 +1,127 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        display_list.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_IMPL_DISPLAY_LIST_H
+#define GB_CORE_IMPL_DISPLAY_LIST_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* record the clear command
+ *
+ * @param list      the display list
+ * @param color     the color
+ */
+tb_void_t           gb_display_list_record_clear(gb_display_list_ref_t list, gb_color_t color);
+
+/* record the clip command if the clipped rect is changed
+ *
+ * @param list      the display list
+ * @param rect      the clipped rect in the recorded device space, be null if not clipped
+ */
+tb_void_t           gb_display_list_record_clip(gb_display_list_ref_t list, gb_rect_ref_t rect);
+
+/* record the path command
+ *
+ * @param list      the display list
+ * @param paint     the bound paint
+ * @param matrix    the bound matrix
+ * @param path      the path
+ */
+tb_void_t           gb_display_list_record_path(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_path_ref_t path);
+
+/* record the lines command
+ *
+ * @param list      the display list
+ * @param paint     the bound paint
+ * @param matrix    the bound matrix
+ * @param points    the points
+ * @param count     the points count
+ * @param bounds    the bounds, be null if no bounds
+ */
+tb_void_t           gb_display_list_record_lines(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds);
+
+/* record the points command
+ *
+ * @param list      the display list
+ * @param paint     the bound paint
+ * @param matrix    the bound matrix
+ * @param points    the points
+ * @param count     the points count
+ * @param bounds    the bounds, be null if no bounds
+ */
+tb_void_t           gb_display_list_record_points(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_point_ref_t points, tb_size_t count, gb_rect_ref_t bounds);
+
+/* record the polygon command
+ *
+ * @param list      the display list
+ * @param paint     the bound paint
+ * @param matrix    the bound matrix
+ * @param polygon   the polygon
+ * @param hint      the hint shape, be null if no hint
+ * @param bounds    the bounds, be null if no bounds
+ */
+tb_void_t           gb_display_list_record_polygon(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_rect_ref_t bounds);
+
+/* record the instances command
+ *
+ * @param list      the display list
+ * @param paint     the bound paint
+ * @param matrix    the bound matrix
+ * @param path      the path of one instance
+ * @param matrices  the matrices of the instances
+ * @param colors    the colors of the instances, be null if uses the paint color
+ * @param count     the instances count
+ */
+tb_void_t           gb_display_list_record_instances(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_path_ref_t path, gb_matrix_ref_t matrices, gb_color_t const* colors, tb_size_t count);
+
+/* record the bitmap command
+ *
+ * @note only the bitmap reference is recorded, 
+ * so the bitmap must be kept alive and unchanged until the list is replayed
+ *
+ * @param list      the display list
+ * @param paint     the bound paint
+ * @param matrix    the bound matrix
+ * @param bitmap    the bitmap
+ * @param src_rect  the source rect in the bitmap
+ * @param dst_rect  the destination rect
+ */
+tb_void_t           gb_display_list_record_bitmap(gb_display_list_ref_t list, gb_paint_ref_t paint, gb_matrix_ref_t matrix, gb_bitmap_ref_t bitmap, gb_rect_ref_t src_rect, gb_rect_ref_t dst_rect);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
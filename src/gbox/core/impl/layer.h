@@ -0,0 +1,96 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        layer.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_IMPL_LAYER_H
+#define GB_CORE_IMPL_LAYER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* the offscreen device of the layer
+ *
+ * the bitmap is allocated by the size class which is aligned by GB_LAYER_SIZE_ALIGN,
+ * so it will be reused if the size of the drawing is not changed too much.
+ * the cached pixels will be invalid if the bitmap is reallocated.
+ *
+ * @param layer     the layer
+ * @param pixfmt    the pixfmt
+ * @param width     the minimum width
+ * @param height    the minimum height
+ *
+ * @return          the device
+ */
+gb_device_ref_t     gb_layer_device(gb_layer_ref_t layer, tb_size_t pixfmt, tb_size_t width, tb_size_t height);
+
+/* the layer has the bitmap of the given pixfmt and size class?
+ *
+ * @param layer     the layer
+ * @param pixfmt    the pixfmt
+ * @param width     the minimum width
+ * @param height    the minimum height
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_layer_fits(gb_layer_ref_t layer, tb_size_t pixfmt, tb_size_t width, tb_size_t height);
+
+/* clear the pixels in the given bounds to the transparent color
+ *
+ * @param layer     the layer
+ * @param bounds    the integer bounds in the device space
+ */
+tb_void_t           gb_layer_clear(gb_layer_ref_t layer, gb_rect_ref_t bounds);
+
+/* the cached pixels is valid for the given bounds and matrix?
+ *
+ * @param layer     the layer
+ * @param bounds    the integer bounds in the device space
+ * @param matrix    the matrix of the drawing
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_layer_cached(gb_layer_ref_t layer, gb_rect_ref_t bounds, gb_matrix_ref_t matrix);
+
+/* mark the pixels as cached for the given bounds and matrix
+ *
+ * @param layer     the layer
+ * @param bounds    the integer bounds in the device space
+ * @param matrix    the matrix of the drawing
+ */
+tb_void_t           gb_layer_cache(gb_layer_ref_t layer, gb_rect_ref_t bounds, gb_matrix_ref_t matrix);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
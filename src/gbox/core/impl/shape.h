@@ -0,0 +1,116 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        shape.h
+ * @ingroup     core
+ */
+#ifndef GB_CORE_IMPL_SHAPE_H
+#define GB_CORE_IMPL_SHAPE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/* make the closed polygon and hint of the rect
+ *
+ * @param polygon               the polygon
+ * @param hint                  the hint shape
+ * @param points                the points of the polygon, gb_point_t[5]
+ * @param counts                the counts of the polygon, tb_uint16_t[2]
+ * @param rect                  the rect
+ */
+static __tb_inline__ tb_void_t  gb_shape_make_polygon_for_rect(gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_point_ref_t points, tb_uint16_t* counts, gb_rect_ref_t rect)
+{
+    // check
+    tb_assert_abort(polygon && hint && points && counts && rect);
+
+    // init points
+    points[0].x = rect->x;
+    points[0].y = rect->y;
+    points[1].x = rect->x + rect->w;
+    points[1].y = rect->y;
+    points[2].x = rect->x + rect->w;
+    points[2].y = rect->y + rect->h;
+    points[3].x = rect->x;
+    points[3].y = rect->y + rect->h;
+    points[4] = points[0];
+
+    // init counts
+    counts[0] = 5;
+    counts[1] = 0;
+
+    // init polygon
+    polygon->points = points;
+    polygon->counts = counts;
+    polygon->convex = tb_true;
+
+    // init hint
+    hint->type      = GB_SHAPE_TYPE_RECT;
+    hint->u.rect    = *rect;
+}
+
+/* make the closed polygon and hint of the triangle
+ *
+ * @param polygon               the polygon
+ * @param hint                  the hint shape
+ * @param points                the points of the polygon, gb_point_t[4]
+ * @param counts                the counts of the polygon, tb_uint16_t[2]
+ * @param triangle              the triangle
+ */
+static __tb_inline__ tb_void_t  gb_shape_make_polygon_for_triangle(gb_polygon_ref_t polygon, gb_shape_ref_t hint, gb_point_ref_t points, tb_uint16_t* counts, gb_triangle_ref_t triangle)
+{
+    // check
+    tb_assert_abort(polygon && hint && points && counts && triangle);
+
+    // init points
+    points[0] = triangle->p0;
+    points[1] = triangle->p1;
+    points[2] = triangle->p2;
+    points[3] = triangle->p0;
+
+    // init counts
+    counts[0] = 4;
+    counts[1] = 0;
+
+    // init polygon
+    polygon->points = points;
+    polygon->counts = counts;
+    polygon->convex = tb_true;
+
+    // init hint
+    hint->type          = GB_SHAPE_TYPE_TRIANGLE;
+    hint->u.triangle    = *triangle;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -1423,7 +1423,7 @@ tb_void_t gb_stroker_apply_paint(gb_stroker_ref_t stroker, gb_paint_ref_t paint)
     impl->miter = miter;
 
     // the cappers
-    static gb_stroker_capper_t s_cappers[] = 
+    static gb_stroker_capper_t const s_cappers[] = 
     {
         gb_stroker_capper_butt
     ,   gb_stroker_capper_round
@@ -1432,7 +1432,7 @@ tb_void_t gb_stroker_apply_paint(gb_stroker_ref_t stroker, gb_paint_ref_t paint)
     tb_assert_abort(impl->cap < tb_arrayn(s_cappers));
 
     // the joiners
-    static gb_stroker_joiner_t s_joiners[] = 
+    static gb_stroker_joiner_t const s_joiners[] = 
     {
         gb_stroker_joiner_miter
     ,   gb_stroker_joiner_round
@@ -0,0 +1,417 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        triangle_strip.c
+ * @ingroup     core
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "triangle_strip"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "triangle_strip.h"
+#include "../../utils/geometry.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the points grow
+#ifdef __gb_small__
+#   define GB_TRIANGLE_STRIP_POINTS_GROW        (256)
+#else
+#   define GB_TRIANGLE_STRIP_POINTS_GROW        (1024)
+#endif
+
+// the chains of the monotone polygon
+#define GB_TRIANGLE_STRIP_CHAIN_FORWARD         (0)
+#define GB_TRIANGLE_STRIP_CHAIN_BACKWARD        (1)
+
+// a is in b's top or b's horizontal left? the order of the sweep line
+#define gb_triangle_strip_point_le(a, b)        ((a)->y < (b)->y || ((a)->y == (b)->y && (a)->x < (b)->x))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the triangle strip vertex type
+typedef struct __gb_triangle_strip_vertex_t
+{
+    // the point index
+    tb_uint16_t                 index;
+
+    // the chain
+    tb_uint16_t                 chain;
+
+}gb_triangle_strip_vertex_t;
+
+// the triangle strip impl type
+typedef struct __gb_triangle_strip_impl_t
+{
+    // the points of the strip
+    tb_vector_ref_t             points;
+
+    // the sorted vertices of the current monotone polygon
+    gb_triangle_strip_vertex_t* vertices;
+
+    // the vertex stack of the current monotone polygon
+    gb_triangle_strip_vertex_t* stack;
+
+    // the maximum count of the vertices and stack
+    tb_size_t                   maxn;
+
+}gb_triangle_strip_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_long_t gb_triangle_strip_area_sign(gb_point_ref_t points, tb_size_t count)
+{
+    // compute the signed area * 2
+    gb_double_t area = 0;
+    tb_size_t   i = 0;
+    for (i = 0; i < count; i++)
+    {
+        gb_point_ref_t p = points + i;
+        gb_point_ref_t q = points + ((i + 1) % count);
+#ifdef GB_CONFIG_FLOAT_FIXED
+        area += (tb_hong_t)p->x * q->y - (tb_hong_t)q->x * p->y;
+#else
+        area += (tb_double_t)p->x * q->y - (tb_double_t)q->x * p->y;
+#endif
+    }
+
+    // the sign
+    return area < 0? -1 : area > 0;
+}
+static tb_void_t gb_triangle_strip_add_triangle(gb_triangle_strip_impl_t* impl, gb_point_ref_t p, gb_point_ref_t q, gb_point_ref_t r)
+{
+    // check
+    tb_assert_abort(impl && impl->points && p && q && r);
+
+    // the strip is empty? start it
+    tb_size_t size = tb_vector_size(impl->points);
+    if (size < 2)
+    {
+        tb_vector_insert_tail(impl->points, p);
+        tb_vector_insert_tail(impl->points, q);
+        tb_vector_insert_tail(impl->points, r);
+        return ;
+    }
+
+    // the last two points of the strip
+    gb_point_t a = *((gb_point_ref_t)tb_vector_data(impl->points) + size - 2);
+    gb_point_t b = *((gb_point_ref_t)tb_vector_data(impl->points) + size - 1);
+
+    // sort the triangle points for finding the shared points: (x, y, b) or (x, y) if b is not found
+    gb_point_ref_t x = p;
+    gb_point_ref_t y = q;
+    tb_bool_t      has_b = tb_true;
+    if (gb_point_eq(r, &b)) ;
+    else if (gb_point_eq(q, &b)) y = r;
+    else if (gb_point_eq(p, &b)) { x = q; y = r; }
+    else has_b = tb_false;
+
+    // shares the edge (a, b)? append the third point only
+    if (has_b && (gb_point_eq(x, &a) || gb_point_eq(y, &a)))
+    {
+        tb_vector_insert_tail(impl->points, gb_point_eq(x, &a)? y : x);
+    }
+    // shares the point b? (b, b, x) and (b, x, y)
+    else if (has_b)
+    {
+        tb_vector_insert_tail(impl->points, &b);
+        tb_vector_insert_tail(impl->points, x);
+        tb_vector_insert_tail(impl->points, y);
+    }
+    // disjoint? join it by the degenerate triangles: (a, b, b), (b, b, p), (b, p, p), (p, p, q) and (p, q, r)
+    else
+    {
+        tb_vector_insert_tail(impl->points, &b);
+        tb_vector_insert_tail(impl->points, p);
+        tb_vector_insert_tail(impl->points, p);
+        tb_vector_insert_tail(impl->points, q);
+        tb_vector_insert_tail(impl->points, r);
+    }
+}
+static tb_bool_t gb_triangle_strip_sort(gb_triangle_strip_impl_t* impl, gb_point_ref_t points, tb_size_t count)
+{
+    // check
+    tb_assert_abort(impl && impl->vertices && points && count >= 3);
+
+    // find the top and bottom points
+    tb_size_t i = 0;
+    tb_size_t top = 0;
+    tb_size_t bottom = 0;
+    for (i = 1; i < count; i++)
+    {
+        if (gb_triangle_strip_point_le(points + i, points + top)) top = i;
+        if (gb_triangle_strip_point_le(points + bottom, points + i)) bottom = i;
+    }
+    tb_check_return_val(top != bottom, tb_false);
+
+    /* merge the forward and backward chains from the top to the bottom
+     *
+     * forward:  top => top + 1 => ... => bottom
+     * backward: top => top - 1 => ... => bottom
+     */
+    tb_size_t forward   = (top + 1) % count;
+    tb_size_t backward  = (top + count - 1) % count;
+    tb_size_t prev[2]   = {top, top};
+    tb_size_t n         = 0;
+    impl->vertices[n].index = (tb_uint16_t)top;
+    impl->vertices[n].chain = GB_TRIANGLE_STRIP_CHAIN_FORWARD;
+    for (n = 1; n < count - 1; n++)
+    {
+        // pick the upper point of two chains
+        tb_size_t chain;
+        tb_size_t index;
+        if (forward != bottom && (backward == bottom || gb_triangle_strip_point_le(points + forward, points + backward)))
+        {
+            chain   = GB_TRIANGLE_STRIP_CHAIN_FORWARD;
+            index   = forward;
+            forward = (forward + 1) % count;
+        }
+        else
+        {
+            tb_assert_and_check_return_val(backward != bottom, tb_false);
+            chain       = GB_TRIANGLE_STRIP_CHAIN_BACKWARD;
+            index       = backward;
+            backward    = (backward + count - 1) % count;
+        }
+
+        // not monotone?
+        tb_check_return_val(!gb_triangle_strip_point_le(points + index, points + prev[chain]), tb_false);
+        prev[chain] = index;
+
+        // save it
+        impl->vertices[n].index = (tb_uint16_t)index;
+        impl->vertices[n].chain = (tb_uint16_t)chain;
+    }
+
+    // the bottom point is the last one
+    impl->vertices[n].index = (tb_uint16_t)bottom;
+    impl->vertices[n].chain = GB_TRIANGLE_STRIP_CHAIN_FORWARD;
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_triangle_strip_ref_t gb_triangle_strip_init()
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    gb_triangle_strip_impl_t*   impl = tb_null;
+    do
+    {
+        // make strip
+        impl = tb_malloc0_type(gb_triangle_strip_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init points
+        impl->points = tb_vector_init(GB_TRIANGLE_STRIP_POINTS_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
+        tb_assert_and_check_break(impl->points);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_triangle_strip_exit((gb_triangle_strip_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_triangle_strip_ref_t)impl;
+}
+tb_void_t gb_triangle_strip_exit(gb_triangle_strip_ref_t strip)
+{
+    // check
+    gb_triangle_strip_impl_t* impl = (gb_triangle_strip_impl_t*)strip;
+    tb_assert_and_check_return(impl);
+
+    // exit points
+    if (impl->points) tb_vector_exit(impl->points);
+    impl->points = tb_null;
+
+    // exit vertices
+    if (impl->vertices) tb_free(impl->vertices);
+    impl->vertices = tb_null;
+
+    // exit stack
+    if (impl->stack) tb_free(impl->stack);
+    impl->stack = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_triangle_strip_clear(gb_triangle_strip_ref_t strip)
+{
+    // check
+    gb_triangle_strip_impl_t* impl = (gb_triangle_strip_impl_t*)strip;
+    tb_assert_and_check_return(impl && impl->points);
+
+    // clear points
+    tb_vector_clear(impl->points);
+}
+tb_void_t gb_triangle_strip_add_monotone(gb_triangle_strip_ref_t strip, gb_point_ref_t points, tb_uint16_t count)
+{
+    // check
+    gb_triangle_strip_impl_t* impl = (gb_triangle_strip_impl_t*)strip;
+    tb_assert_and_check_return(impl && impl->points && points);
+
+    // remove the closed point
+    tb_size_t n = count;
+    if (n > 1 && gb_point_eq(points, points + n - 1)) n--;
+    tb_check_return(n >= 3);
+
+    // the winding of the polygon, ignore the degenerate polygon
+    tb_long_t winding = gb_triangle_strip_area_sign(points, n);
+    tb_check_return(winding);
+
+    // grow the vertices and stack
+    if (n > impl->maxn)
+    {
+        // grow vertices
+        tb_size_t                   maxn = tb_align8(n);
+        gb_triangle_strip_vertex_t* data = (gb_triangle_strip_vertex_t*)tb_ralloc(impl->vertices, maxn * sizeof(gb_triangle_strip_vertex_t));
+        tb_assert_and_check_return(data);
+        impl->vertices = data;
+
+        // grow stack
+        data = (gb_triangle_strip_vertex_t*)tb_ralloc(impl->stack, maxn * sizeof(gb_triangle_strip_vertex_t));
+        tb_assert_and_check_return(data);
+        impl->stack = data;
+
+        // update maxn
+        impl->maxn = maxn;
+    }
+
+    // sort vertices from the top to the bottom
+    if (!gb_triangle_strip_sort(impl, points, n))
+    {
+        // the monotone polygon is required
+        tb_assertf(0, "the polygon is not monotone!");
+
+        // add it as the convex polygon
+        tb_size_t i = 0;
+        for (i = 1; i + 1 < n; i++) gb_triangle_strip_add_triangle(impl, points, points + i, points + i + 1);
+        return ;
+    }
+
+    /* triangulate the monotone polygon
+     *
+     * refer to: de Berg et al., Computational Geometry: Algorithms and Applications, 3.3
+     *
+     * the triangles are added with the order (p, q, r), (q, r) is the edge that is
+     * most likely to be shared with the next triangle, so the strip will continue for the zigzag.
+     */
+    gb_triangle_strip_vertex_t* vertices    = impl->vertices;
+    gb_triangle_strip_vertex_t* stack       = impl->stack;
+    tb_size_t                   top         = 0;
+    tb_size_t                   j           = 0;
+    stack[top++] = vertices[0];
+    stack[top++] = vertices[1];
+    for (j = 2; j < n - 1; j++)
+    {
+        // the current vertex
+        gb_triangle_strip_vertex_t  u = vertices[j];
+        gb_point_ref_t              pu = points + u.index;
+
+        // on the different chain with the top of stack?
+        if (u.chain != stack[top - 1].chain)
+        {
+            // add the triangles with all stack vertices
+            tb_size_t i = 0;
+            for (i = 0; i + 1 < top; i++)
+                gb_triangle_strip_add_triangle(impl, points + stack[i].index, pu, points + stack[i + 1].index);
+
+            // push the previous and current vertex
+            stack[0]    = vertices[j - 1];
+            stack[1]    = u;
+            top         = 2;
+        }
+        else
+        {
+            // pop the top vertex
+            gb_triangle_strip_vertex_t last = stack[--top];
+
+            /* pop the other vertices while the diagonal (u, top) is inside the polygon
+             *
+             * the last vertex is convex if the turn of (top => last => u) is the same as the winding,
+             * the turn is reversed for the backward chain and the orientation is the negative turn.
+             */
+            while (top)
+            {
+                gb_point_ref_t  pt = points + stack[top - 1].index;
+                tb_long_t       orientation = gb_points_orientation(pt, points + last.index, pu);
+                if (u.chain == GB_TRIANGLE_STRIP_CHAIN_BACKWARD) orientation = -orientation;
+                tb_check_break(orientation * winding < 0);
+
+                // add the triangle
+                gb_triangle_strip_add_triangle(impl, points + last.index, pt, pu);
+
+                // pop it
+                last = stack[--top];
+            }
+
+            // push the last and current vertex
+            stack[top++] = last;
+            stack[top++] = u;
+        }
+    }
+
+    // add the triangles from the bottom vertex to all stack vertices
+    gb_point_ref_t pb = points + vertices[n - 1].index;
+    while (top > 1)
+    {
+        gb_triangle_strip_add_triangle(impl, points + stack[top - 1].index, pb, points + stack[top - 2].index);
+        top--;
+    }
+}
+gb_point_ref_t gb_triangle_strip_data(gb_triangle_strip_ref_t strip)
+{
+    // check
+    gb_triangle_strip_impl_t* impl = (gb_triangle_strip_impl_t*)strip;
+    tb_assert_and_check_return_val(impl && impl->points, tb_null);
+
+    // the points
+    return (gb_point_ref_t)tb_vector_data(impl->points);
+}
+tb_size_t gb_triangle_strip_size(gb_triangle_strip_ref_t strip)
+{
+    // check
+    gb_triangle_strip_impl_t* impl = (gb_triangle_strip_impl_t*)strip;
+    tb_assert_and_check_return_val(impl && impl->points, 0);
+
+    // the points count
+    return tb_vector_size(impl->points);
+}
@@ -0,0 +1,109 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        triangle_strip.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_IMPL_TRIANGLE_STRIP_H
+#define GB_CORE_IMPL_TRIANGLE_STRIP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the triangle strip type
+ *
+ * make one triangle strip from the monotone polygons, the disjoint pieces are joined by the degenerate triangles
+ *
+ * <pre>
+ * monotone polygon: n points => n - 2 triangles
+ *
+ * triangle list:  3 * (n - 2) points
+ * triangle strip: about n + 2 points
+ * </pre>
+ */
+typedef struct{}*           gb_triangle_strip_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init the triangle strip
+ *
+ * @return                  the triangle strip
+ */
+gb_triangle_strip_ref_t     gb_triangle_strip_init(tb_noarg_t);
+
+/* exit the triangle strip
+ *
+ * @param strip             the triangle strip
+ */
+tb_void_t                   gb_triangle_strip_exit(gb_triangle_strip_ref_t strip);
+
+/* clear the triangle strip
+ *
+ * @param strip             the triangle strip
+ */
+tb_void_t                   gb_triangle_strip_clear(gb_triangle_strip_ref_t strip);
+
+/* add a monotone polygon to the triangle strip
+ *
+ * the polygon is monotone with respect to the horizontal sweep line,
+ * e.g. the output contour of the tessellator with GB_TESSELLATOR_MODE_MONOTONE
+ *
+ * @param strip             the triangle strip
+ * @param points            the points of the closed contour
+ * @param count             the points count
+ */
+tb_void_t                   gb_triangle_strip_add_monotone(gb_triangle_strip_ref_t strip, gb_point_ref_t points, tb_uint16_t count);
+
+/* the points of the triangle strip
+ *
+ * @param strip             the triangle strip
+ *
+ * @return                  the points
+ */
+gb_point_ref_t              gb_triangle_strip_data(gb_triangle_strip_ref_t strip);
+
+/* the points count of the triangle strip
+ *
+ * @param strip             the triangle strip
+ *
+ * @return                  the points count
+ */
+tb_size_t                   gb_triangle_strip_size(gb_triangle_strip_ref_t strip);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
+
+
@@ -0,0 +1,241 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        layer.c
+ * @ingroup     core
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "layer"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "layer.h"
+#include "bitmap.h"
+#include "device.h"
+#include "pixmap.h"
+#include "impl/layer.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the size alignment of the layer bitmap
+#define GB_LAYER_SIZE_ALIGN         (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the layer impl type
+typedef struct __gb_layer_impl_t
+{
+    // the bitmap
+    gb_bitmap_ref_t         bitmap;
+
+    // the offscreen device of the bitmap
+    gb_device_ref_t         device;
+
+    // the device bounds of the cached pixels
+    gb_rect_t               bounds;
+
+    // the matrix of the cached pixels
+    gb_matrix_t             matrix;
+
+    // the cached pixels is valid?
+    tb_bool_t               valid;
+
+}gb_layer_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t gb_layer_free(gb_layer_impl_t* impl)
+{
+    // check
+    tb_assert_abort(impl);
+
+    // exit device
+    if (impl->device) gb_device_exit(impl->device);
+    impl->device = tb_null;
+
+    // exit bitmap
+    if (impl->bitmap) gb_bitmap_exit(impl->bitmap);
+    impl->bitmap = tb_null;
+
+    // the cached pixels have been lost
+    impl->valid = tb_false;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_layer_ref_t gb_layer_init()
+{
+    // make layer
+    return (gb_layer_ref_t)tb_malloc0_type(gb_layer_impl_t);
+}
+tb_void_t gb_layer_exit(gb_layer_ref_t layer)
+{
+    // check
+    gb_layer_impl_t* impl = (gb_layer_impl_t*)layer;
+    tb_assert_and_check_return(impl);
+
+    // free the bitmap and device
+    gb_layer_free(impl);
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_layer_invalidate(gb_layer_ref_t layer)
+{
+    // check
+    gb_layer_impl_t* impl = (gb_layer_impl_t*)layer;
+    tb_assert_and_check_return(impl);
+
+    // invalidate it
+    impl->valid = tb_false;
+}
+gb_bitmap_ref_t gb_layer_bitmap(gb_layer_ref_t layer)
+{
+    // check
+    gb_layer_impl_t* impl = (gb_layer_impl_t*)layer;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // the bitmap
+    return impl->bitmap;
+}
+gb_device_ref_t gb_layer_device(gb_layer_ref_t layer, tb_size_t pixfmt, tb_size_t width, tb_size_t height)
+{
+    // check
+    gb_layer_impl_t* impl = (gb_layer_impl_t*)layer;
+    tb_assert_and_check_return_val(impl && width && height, tb_null);
+
+    // reuse it?
+    if (gb_layer_fits(layer, pixfmt, width, height)) return impl->device;
+
+    // free the old bitmap and device
+    gb_layer_free(impl);
+
+#ifdef GB_CONFIG_DEVICE_HAVE_BITMAP
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // the size class
+        tb_size_t bitmap_width  = tb_min(tb_align(width, GB_LAYER_SIZE_ALIGN), GB_WIDTH_MAXN);
+        tb_size_t bitmap_height = tb_min(tb_align(height, GB_LAYER_SIZE_ALIGN), GB_HEIGHT_MAXN);
+
+        // init bitmap, all pixels are transparent
+        impl->bitmap = gb_bitmap_init(tb_null, pixfmt, bitmap_width, bitmap_height, 0, tb_true);
+        tb_assert_and_check_break(impl->bitmap);
+
+        // init device
+        impl->device = gb_device_init_bitmap(impl->bitmap);
+        tb_assert_and_check_break(impl->device);
+
+        // trace
+        tb_trace_d("device: %lux%lu", bitmap_width, bitmap_height);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed? free it
+    if (!ok) gb_layer_free(impl);
+#else
+    // trace
+    tb_trace_e("the bitmap device is disabled, the offscreen layer is not supported!");
+#endif
+
+    // the device
+    return impl->device;
+}
+tb_bool_t gb_layer_fits(gb_layer_ref_t layer, tb_size_t pixfmt, tb_size_t width, tb_size_t height)
+{
+    // check
+    gb_layer_impl_t* impl = (gb_layer_impl_t*)layer;
+    tb_assert_and_check_return_val(impl, tb_false);
+
+    // no bitmap?
+    tb_check_return_val(impl->bitmap && impl->device, tb_false);
+
+    // the same pixfmt and size class?
+    return (    gb_bitmap_pixfmt(impl->bitmap) == pixfmt
+            &&  gb_bitmap_width(impl->bitmap) == tb_min(tb_align(width, GB_LAYER_SIZE_ALIGN), GB_WIDTH_MAXN)
+            &&  gb_bitmap_height(impl->bitmap) == tb_min(tb_align(height, GB_LAYER_SIZE_ALIGN), GB_HEIGHT_MAXN))? tb_true : tb_false;
+}
+tb_void_t gb_layer_clear(gb_layer_ref_t layer, gb_rect_ref_t bounds)
+{
+    // check
+    gb_layer_impl_t* impl = (gb_layer_impl_t*)layer;
+    tb_assert_and_check_return(impl && impl->bitmap && bounds);
+
+    // the pixmap
+    gb_pixmap_ref_t pixmap = gb_pixmap(gb_bitmap_pixfmt(impl->bitmap), 0xff);
+    tb_assert_and_check_return(pixmap);
+
+    // clip the bounds by the bitmap
+    tb_long_t x0 = tb_max(gb_float_to_long(bounds->x), 0);
+    tb_long_t y0 = tb_max(gb_float_to_long(bounds->y), 0);
+    tb_long_t x1 = tb_min(gb_float_to_long(bounds->x + bounds->w), (tb_long_t)gb_bitmap_width(impl->bitmap));
+    tb_long_t y1 = tb_min(gb_float_to_long(bounds->y + bounds->h), (tb_long_t)gb_bitmap_height(impl->bitmap));
+    tb_check_return(x0 < x1 && y0 < y1);
+
+    // clear the rows, the transparent pixel is zero for all alpha formats
+    tb_size_t   row_bytes = gb_bitmap_row_bytes(impl->bitmap);
+    tb_size_t   row_size = (x1 - x0) * pixmap->btp;
+    tb_byte_t*  data = (tb_byte_t*)gb_bitmap_data(impl->bitmap) + y0 * row_bytes + x0 * pixmap->btp;
+    for (; y0 < y1; y0++, data += row_bytes) tb_memset(data, 0, row_size);
+
+    // the pixels are changed
+    gb_bitmap_invalidate(impl->bitmap, bounds);
+
+    // the cached pixels have been cleared
+    impl->valid = tb_false;
+}
+tb_bool_t gb_layer_cached(gb_layer_ref_t layer, gb_rect_ref_t bounds, gb_matrix_ref_t matrix)
+{
+    // check
+    gb_layer_impl_t* impl = (gb_layer_impl_t*)layer;
+    tb_assert_and_check_return_val(impl && bounds && matrix, tb_false);
+
+    // the cached pixels is valid for the same bounds and matrix?
+    return (    impl->valid
+            &&  impl->bitmap
+            &&  !tb_memcmp(&impl->bounds, bounds, sizeof(gb_rect_t))
+            &&  !tb_memcmp(&impl->matrix, matrix, sizeof(gb_matrix_t)))? tb_true : tb_false;
+}
+tb_void_t gb_layer_cache(gb_layer_ref_t layer, gb_rect_ref_t bounds, gb_matrix_ref_t matrix)
+{
+    // check
+    gb_layer_impl_t* impl = (gb_layer_impl_t*)layer;
+    tb_assert_and_check_return(impl && impl->bitmap && bounds && matrix);
+
+    // cache it
+    impl->bounds    = *bounds;
+    impl->matrix    = *matrix;
+    impl->valid     = tb_true;
+}
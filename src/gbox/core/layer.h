@@ -0,0 +1,92 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        layer.h
+ * @ingroup     core
+ *
+ */
+#ifndef GB_CORE_LAYER_H
+#define GB_CORE_LAYER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the cacheable layer
+ *
+ * the layer keeps the pixels of the last drawing between frames, 
+ * so the expensive static sub-scene (.e.g legends, backgrounds) is only drawn once.
+ *
+ * @code
+ * gb_layer_ref_t legend = gb_layer_init();
+ *
+ * // for each frame
+ * if (gb_canvas_save_layer(canvas, &bounds, 255, legend))
+ * {
+ *     // the cached pixels is invalid, draw the legend into the layer
+ *     // ...
+ * }
+ * gb_canvas_load_layer(canvas);
+ *
+ * // the legend is changed, redraw it at the next frame
+ * gb_layer_invalidate(legend);
+ *
+ * // exit it
+ * gb_layer_exit(legend);
+ * @endcode
+ *
+ * @return          the layer
+ */
+gb_layer_ref_t      gb_layer_init(tb_noarg_t);
+
+/*! exit the layer
+ *
+ * @param layer     the layer
+ */
+tb_void_t           gb_layer_exit(gb_layer_ref_t layer);
+
+/*! invalidate the cached pixels of the layer
+ *
+ * @param layer     the layer
+ */
+tb_void_t           gb_layer_invalidate(gb_layer_ref_t layer);
+
+/*! the layer bitmap 
+ *
+ * @param layer     the layer
+ *
+ * @return          the bitmap, be null if the layer has not been drawn
+ */
+gb_bitmap_ref_t     gb_layer_bitmap(gb_layer_ref_t layer);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -72,6 +72,9 @@ typedef struct __gb_paint_impl_t
     // the fill rule
     tb_uint32_t         rule    : 1;
 
+    // the quality
+    tb_uint32_t         quality : 2;
+
     // the paint color
     gb_color_t          color;
 
@@ -152,6 +155,9 @@ tb_void_t gb_paint_clear(gb_paint_ref_t paint)
     impl->alpha         = GB_PAINT_DEFAULT_ALPHA;
     impl->miter         = GB_PAINT_DEFAULT_MITER;
 
+    // init the quality and its flags from the default quality of the current thread
+    gb_paint_quality_set(paint, gb_quality());
+
     // clear shader
     if (impl->shader) gb_shader_exit(impl->shader);
     impl->shader = tb_null;
@@ -196,10 +202,6 @@ tb_size_t gb_paint_flag(gb_paint_ref_t paint)
     gb_paint_impl_t* impl = (gb_paint_impl_t*)paint;
     tb_assert_and_check_return_val(impl, GB_PAINT_FLAG_NONE);
 
-    // modify flag for quality
-    if (gb_quality() > GB_QUALITY_LOW) impl->flag |= (GB_PAINT_FLAG_ANTIALIASING | GB_PAINT_FLAG_FILTER_BITMAP);
-    else impl->flag &= ~(GB_PAINT_FLAG_ANTIALIASING | GB_PAINT_FLAG_FILTER_BITMAP);
-
     // the flag
     return impl->flag;
 }
@@ -212,6 +214,28 @@ tb_void_t gb_paint_flag_set(gb_paint_ref_t paint, tb_size_t flag)
     // done
     impl->flag = flag;
 }
+tb_size_t gb_paint_quality(gb_paint_ref_t paint)
+{
+    // check
+    gb_paint_impl_t* impl = (gb_paint_impl_t*)paint;
+    tb_assert_and_check_return_val(impl, GB_QUALITY_TOP);
+
+    // the quality
+    return impl->quality;
+}
+tb_void_t gb_paint_quality_set(gb_paint_ref_t paint, tb_size_t quality)
+{
+    // check
+    gb_paint_impl_t* impl = (gb_paint_impl_t*)paint;
+    tb_assert_and_check_return(impl && quality <= GB_QUALITY_TOP);
+
+    // save quality
+    impl->quality = (tb_uint32_t)quality;
+
+    // update the antialiasing and filter flags for the quality
+    if (quality > GB_QUALITY_LOW) impl->flag |= (GB_PAINT_FLAG_ANTIALIASING | GB_PAINT_FLAG_FILTER_BITMAP);
+    else impl->flag &= ~(GB_PAINT_FLAG_ANTIALIASING | GB_PAINT_FLAG_FILTER_BITMAP);
+}
 gb_color_t gb_paint_color(gb_paint_ref_t paint)
 {
     // check
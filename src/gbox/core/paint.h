@@ -142,6 +142,27 @@ tb_size_t           gb_paint_flag(gb_paint_ref_t paint);
  */
 tb_void_t           gb_paint_flag_set(gb_paint_ref_t paint, tb_size_t flag);
 
+/*! the paint quality
+ *
+ * @param paint     the paint
+ *
+ * @return          the quality
+ */
+tb_size_t           gb_paint_quality(gb_paint_ref_t paint);
+
+/*! set the paint quality
+ *
+ * the quality decides the alpha thresholds of the transparent and opaque pixels,
+ * it also enables the antialiasing and bitmap filtering flags if the quality is higher than GB_QUALITY_LOW,
+ * these flags can be changed by gb_paint_flag_set() after it
+ *
+ * the new paint takes the default quality of the current thread, see gb_quality()
+ *
+ * @param paint     the paint
+ * @param quality   the quality
+ */
+tb_void_t           gb_paint_quality_set(gb_paint_ref_t paint, tb_size_t quality);
+
 /*! the paint color
  *
  * @param paint     the paint 
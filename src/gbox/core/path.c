@@ -35,6 +35,7 @@
 #include "impl/quad.h"
 #include "impl/cubic.h"
 #include "impl/bounds.h"
+#include "../utils/geometry.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -50,6 +51,9 @@
 // the point step for code
 #define gb_path_point_step(code)    ((code) < 1? 1 : (code) - 1)
 
+// mark the path changed and the new version will be made when getting it
+#define gb_path_changed(impl)       ((impl)->version = 0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -78,6 +82,9 @@ typedef struct __gb_path_impl_t
     // the flag
     tb_uint8_t          flag;
 
+    // the version, 0: changed and need make a new version
+    tb_size_t           version;
+
     // the hint shape
     gb_shape_t          hint;
 
@@ -107,6 +114,13 @@ typedef struct __gb_path_impl_t
 
 }gb_path_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the version of the all paths
+static tb_atomic_t      g_version = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -829,6 +843,7 @@ tb_void_t gb_path_clear(gb_path_ref_t path)
 
     // mark dirty
     impl->flag = GB_PATH_FLAG_DIRTY_ALL | GB_PATH_FLAG_SINGLE;
+    gb_path_changed(impl);
 
     // clear codes
     tb_vector_clear(impl->codes);
@@ -859,6 +874,7 @@ tb_void_t gb_path_copy(gb_path_ref_t path, gb_path_ref_t copied)
 
     // copy flag
     impl->flag = impl_copied->flag | GB_PATH_FLAG_DIRTY_POLYGON;
+    gb_path_changed(impl);
 
     // copy hint
     impl->hint = impl_copied->hint;
@@ -993,6 +1009,18 @@ tb_void_t gb_path_convex_set(gb_path_ref_t path, tb_bool_t convex)
     // clear dirty
     impl->flag &= ~GB_PATH_FLAG_DIRTY_CONVEX;
 }
+tb_size_t gb_path_version(gb_path_ref_t path)
+{
+    // check
+    gb_path_impl_t* impl = (gb_path_impl_t*)path;
+    tb_assert_and_check_return_val(impl, 0);
+
+    // changed? make a new version which is unique for all paths
+    if (!impl->version) impl->version = (tb_size_t)tb_atomic_fetch_and_inc(&g_version) + 1;
+
+    // the version
+    return impl->version;
+}
 tb_bool_t gb_path_last(gb_path_ref_t path, gb_point_ref_t point)
 {
     // check
@@ -1022,6 +1050,10 @@ tb_void_t gb_path_last_set(gb_path_ref_t path, gb_point_ref_t point)
 
     // save it
     if (last) *last = *point;
+
+    // mark dirty
+    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
+    gb_path_changed(impl);
 }
 gb_shape_ref_t gb_path_hint(gb_path_ref_t path)
 {
@@ -1067,6 +1099,58 @@ gb_polygon_ref_t gb_path_polygon(gb_path_ref_t path)
     // ok?
     return &impl->polygon;
 }
+tb_bool_t gb_path_contains(gb_path_ref_t path, gb_point_ref_t point, tb_size_t rule)
+{
+    // check
+    tb_assert_and_check_return_val(path && point, tb_false);
+
+    // out of the bounds? reject it quickly
+    gb_rect_ref_t bounds = gb_path_bounds(path);
+    tb_check_return_val(bounds, tb_false);
+    if (    point->x < bounds->x 
+        ||  point->y < bounds->y 
+        ||  point->x > bounds->x + bounds->w 
+        ||  point->y > bounds->y + bounds->h)
+        return tb_false;
+
+    // the cached polygon
+    gb_polygon_ref_t polygon = gb_path_polygon(path);
+    tb_check_return_val(polygon && polygon->points && polygon->counts, tb_false);
+
+    /* compute the winding number of the point
+     *
+     * count the signed crossings of the edges with the horizontal ray from the point to the right, 
+     * each contour is closed implicitly
+     */
+    tb_long_t           winding = 0;
+    tb_uint16_t         count;
+    tb_uint16_t         index;
+    tb_uint16_t const*  counts = polygon->counts;
+    gb_point_ref_t      points = polygon->points;
+    gb_point_ref_t      pb;
+    gb_point_ref_t      pe;
+    while ((count = *counts++))
+    {
+        for (index = 0; index < count; index++)
+        {
+            // the edge
+            pb = points + index;
+            pe = points + (index + 1 < count? index + 1 : 0);
+
+            // the upward edge and the point is on the left? 
+            if (pb->y <= point->y)
+            {
+                if (pe->y > point->y && gb_points_orientation(pe, pb, point) > 0) winding++;
+            }
+            // the downward edge and the point is on the right?
+            else if (pe->y <= point->y && gb_points_orientation(pe, pb, point) < 0) winding--;
+        }
+        points += count;
+    }
+
+    // inside?
+    return (rule == GB_PAINT_FILL_RULE_NONZERO)? (winding != 0) : (winding & 1);
+}
 tb_void_t gb_path_apply(gb_path_ref_t path, gb_matrix_ref_t matrix)
 {
     // check
@@ -1082,6 +1166,10 @@ tb_void_t gb_path_apply(gb_path_ref_t path, gb_matrix_ref_t matrix)
         // apply it
         gb_point_apply(point, matrix);
     }
+
+    // mark dirty
+    impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
+    gb_path_changed(impl);
 }
 tb_void_t gb_path_clos(gb_path_ref_t path)
 {
@@ -1099,6 +1187,9 @@ tb_void_t gb_path_clos(gb_path_ref_t path)
 
         // append code
         tb_vector_insert_tail(impl->codes, (tb_cpointer_t)GB_PATH_CODE_CLOS);
+
+        // mark changed
+        gb_path_changed(impl);
     }
 
     // mark closed
@@ -1137,6 +1228,7 @@ tb_void_t gb_path_move_to(gb_path_ref_t path, gb_point_ref_t point)
 
     // mark dirty
     impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
+    gb_path_changed(impl);
 }
 tb_void_t gb_path_move2_to(gb_path_ref_t path, gb_float_t x, gb_float_t y)
 {
@@ -1179,6 +1271,7 @@ tb_void_t gb_path_line_to(gb_path_ref_t path, gb_point_ref_t point)
 
     // mark dirty
     impl->flag |= GB_PATH_FLAG_DIRTY_ALL;
+    gb_path_changed(impl);
 }
 tb_void_t gb_path_line2_to(gb_path_ref_t path, gb_float_t x, gb_float_t y)
 {
@@ -1222,6 +1315,7 @@ tb_void_t gb_path_quad_to(gb_path_ref_t path, gb_point_ref_t ctrl, gb_point_ref_
 
     // mark dirty and curve
     impl->flag |= GB_PATH_FLAG_DIRTY_ALL | GB_PATH_FLAG_CURVE;
+    gb_path_changed(impl);
 }
 tb_void_t gb_path_quad2_to(gb_path_ref_t path, gb_float_t cx, gb_float_t cy, gb_float_t x, gb_float_t y)
 {
@@ -1274,6 +1368,7 @@ tb_void_t gb_path_cubic_to(gb_path_ref_t path, gb_point_ref_t ctrl0, gb_point_re
 
     // mark dirty and curve
     impl->flag |= GB_PATH_FLAG_DIRTY_ALL | GB_PATH_FLAG_CURVE;
+    gb_path_changed(impl);
 }
 tb_void_t gb_path_cubic2_to(gb_path_ref_t path, gb_float_t cx0, gb_float_t cy0, gb_float_t cx1, gb_float_t cy1, gb_float_t x, gb_float_t y)
 {
@@ -124,6 +124,17 @@ gb_rect_ref_t       gb_path_bounds(gb_path_ref_t path);
  */
 tb_bool_t           gb_path_convex(gb_path_ref_t path);
 
+/*! the version of the path
+ *
+ * the version is unique for all paths and will be changed after the path is modified,
+ * so it can be used as the key for caching the geometries of the path
+ *
+ * @param path      the path
+ *
+ * @return          the version
+ */
+tb_size_t           gb_path_version(gb_path_ref_t path);
+
 /*! set to be convex path, convex path may draw faster
  *
  * @param path      the path
@@ -164,6 +175,18 @@ gb_shape_ref_t      gb_path_hint(gb_path_ref_t path);
  */
 gb_polygon_ref_t    gb_path_polygon(gb_path_ref_t path);
 
+/*! the path contains the given point?
+ *
+ * the bounds is tested first and the cached polygon of the path is tested exactly by the winding number 
+ *
+ * @param path      the path
+ * @param point     the point
+ * @param rule      the fill rule, .e.g GB_PAINT_FILL_RULE_ODD, GB_PAINT_FILL_RULE_NONZERO
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           gb_path_contains(gb_path_ref_t path, gb_point_ref_t point, tb_size_t rule);
+
 /*! apply the matrix to the path 
  *
  * @param path      the path
@@ -56,15 +56,27 @@
  *
  * is_transparent = alpha < GB_ALPHA_MINN? tb_true : tb_false
  */
-#define GB_ALPHA_MINN           ((tb_byte_t)((GB_QUALITY_TOP - gb_quality()) << 3))
+#define GB_ALPHA_MINN           (1)
 
 /*! the max-alpha 
  *
  * @code
- * has_alpha = alpha <= GB_QUALITY_ALPHA_MAXN? tb_true : tb_false
+ * has_alpha = alpha <= GB_ALPHA_MAXN? tb_true : tb_false
  * @endcode
  */
-#define GB_ALPHA_MAXN           ((tb_byte_t)(0xff - ((GB_QUALITY_TOP - gb_quality()) << 3)))
+#define GB_ALPHA_MAXN           (0xfe)
+
+/*! the min-alpha of the given quality
+ *
+ * the lower quality treats more alpha values as transparent
+ */
+#define GB_QUALITY_ALPHA_MINN(quality)      ((tb_byte_t)tb_max((GB_QUALITY_TOP - (quality)) << 3, GB_ALPHA_MINN))
+
+/*! the max-alpha of the given quality
+ *
+ * the lower quality treats more alpha values as opaque
+ */
+#define GB_QUALITY_ALPHA_MAXN(quality)      ((tb_byte_t)tb_min(0xff - ((GB_QUALITY_TOP - (quality)) << 3), GB_ALPHA_MAXN))
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
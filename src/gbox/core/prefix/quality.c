@@ -25,14 +25,19 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
-#include "quality.h"
+#include "prefix.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
 
-// the quality
-static tb_atomic_t g_quality = GB_QUALITY_TOP;
+#ifdef __gb_thread_local__
+// the quality of the current thread
+static __gb_thread_local__ tb_size_t    g_quality = GB_QUALITY_TOP;
+#else
+// the quality of the process, the compiler has not the thread-local storage
+static tb_atomic_t                      g_quality = GB_QUALITY_TOP;
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -40,7 +45,11 @@ static tb_atomic_t g_quality = GB_QUALITY_TOP;
 
 tb_size_t gb_quality(tb_noarg_t)
 {
+#ifdef __gb_thread_local__
+    return g_quality;
+#else
     return (tb_size_t)tb_atomic_get(&g_quality);
+#endif
 }
 tb_void_t gb_quality_set(tb_size_t quality)
 {
@@ -48,6 +57,23 @@ tb_void_t gb_quality_set(tb_size_t quality)
     tb_assert_and_check_return(quality <= GB_QUALITY_TOP);
 
     // save quality
+#ifdef __gb_thread_local__
+    g_quality = quality;
+#else
     tb_atomic_set(&g_quality, quality);
+#endif
 }
+tb_byte_t gb_quality_alpha(tb_size_t quality, tb_byte_t alpha)
+{
+    // check
+    tb_assert_and_check_return_val(quality <= GB_QUALITY_TOP, alpha);
+
+    // transparent?
+    if (alpha < GB_QUALITY_ALPHA_MINN(quality)) return 0;
 
+    // opaque?
+    if (alpha > GB_QUALITY_ALPHA_MAXN(quality)) return 0xff;
+
+    // the blended alpha
+    return alpha;
+}
@@ -47,18 +47,39 @@ typedef enum __gb_quality_e
  */
 __tb_extern_c_enter__
 
-/*! get quality
+/*! get the default quality of the current thread
+ *
+ * the new paints and canvases take this quality, the quality of an existing canvas
+ * can be changed by gb_canvas_quality_set() or gb_paint_quality_set().
+ *
+ * the quality is thread-local, every thread starts with GB_QUALITY_TOP,
+ * so the canvases rendering on the other threads will not be affected by gb_quality_set()
+ *
+ * @note it is shared by the whole process if the compiler has not the thread-local storage
  *
  * @return          the quality
  */
 tb_size_t           gb_quality(tb_noarg_t);
 
-/*! set quality
+/*! set the default quality of the current thread
  *
  * @param quality   the quality 
  */
 tb_void_t           gb_quality_set(tb_size_t quality);
 
+/*! resolve the alpha for the given quality
+ *
+ * the alpha below GB_QUALITY_ALPHA_MINN(quality) will be transparent 
+ * and the alpha above GB_QUALITY_ALPHA_MAXN(quality) will be opaque,
+ * so the result can be passed to gb_pixmap() directly
+ *
+ * @param quality   the quality
+ * @param alpha     the alpha
+ *
+ * @return          the resolved alpha
+ */
+tb_byte_t           gb_quality_alpha(tb_size_t quality, tb_byte_t alpha);
+
 __tb_extern_c_leave__
 #endif
 
@@ -85,3 +85,39 @@ tb_void_t gb_rect_deflate(gb_rect_ref_t rect, gb_float_t dx, gb_float_t dy)
     rect->w -= gb_lsh(dx, 1);
     rect->h -= gb_lsh(dy, 1);
 }
+tb_bool_t gb_rect_intersect(gb_rect_ref_t rect, gb_rect_ref_t other)
+{
+    // check
+    tb_assert_abort(rect && other);
+
+    // the intersected bounds
+    gb_float_t x0 = tb_max(rect->x, other->x);
+    gb_float_t y0 = tb_max(rect->y, other->y);
+    gb_float_t x1 = tb_min(rect->x + rect->w, other->x + other->w);
+    gb_float_t y1 = tb_min(rect->y + rect->h, other->y + other->h);
+
+    // empty?
+    if (x0 >= x1 || y0 >= y1)
+    {
+        gb_rect_make(rect, x0, y0, 0, 0);
+        return tb_false;
+    }
+
+    // intersect it
+    gb_rect_make(rect, x0, y0, x1 - x0, y1 - y0);
+    return tb_true;
+}
+tb_void_t gb_rect_merge(gb_rect_ref_t rect, gb_rect_ref_t other)
+{
+    // check
+    tb_assert_abort(rect && other);
+
+    // the merged bounds
+    gb_float_t x0 = tb_min(rect->x, other->x);
+    gb_float_t y0 = tb_min(rect->y, other->y);
+    gb_float_t x1 = tb_max(rect->x + rect->w, other->x + other->w);
+    gb_float_t y1 = tb_max(rect->y + rect->h, other->y + other->h);
+
+    // merge it
+    gb_rect_make(rect, x0, y0, x1 - x0, y1 - y0);
+}
@@ -91,6 +91,22 @@ tb_void_t           gb_rect_inflate(gb_rect_ref_t rect, gb_float_t dx, gb_float_
  */
 tb_void_t           gb_rect_deflate(gb_rect_ref_t rect, gb_float_t dx, gb_float_t dy);
 
+/*! intersect rect with the other rect
+ *
+ * @param rect      the rect, it will be empty if they do not intersect
+ * @param other     the other rect
+ *
+ * @return          tb_true if they intersect, otherwise tb_false
+ */
+tb_bool_t           gb_rect_intersect(gb_rect_ref_t rect, gb_rect_ref_t other);
+
+/*! merge the other rect to the bounds of rect
+ *
+ * @param rect      the rect 
+ * @param other     the other rect
+ */
+tb_void_t           gb_rect_merge(gb_rect_ref_t rect, gb_rect_ref_t other);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -367,6 +367,12 @@ typedef struct{}*       gb_shader_ref_t;
 /// the clipper ref type
 typedef struct{}*       gb_clipper_ref_t;
 
+/// the display list ref type
+typedef struct{}*       gb_display_list_ref_t;
+
+/// the layer ref type
+typedef struct{}*       gb_layer_ref_t;
+
 #endif
 
 
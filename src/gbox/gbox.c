@@ -106,6 +106,9 @@ tb_bool_t gb_init_(tb_size_t mode, tb_hize_t build)
     // check version
     gb_version_check(build);
 
+    // init version before any render thread can read it
+    gb_version();
+
     // init platform
     if (!gb_platform_init()) return tb_false;
 
@@ -63,6 +63,23 @@
  * </pre>
  */
 
+/*! threads
+ *
+ * gbox has no locks except loading the gl interfaces, the objects are not synchronized and have the following thread affinity:
+ *
+ * - gb_init() and gb_exit() must be called on one thread, before and after all the other threads
+ * - canvas, device, paint, path, shader, clipper, layer, display list and spatial index belong to
+ *   the thread which is using them, they can be moved to another thread but never be used by two threads at the same time
+ * - the different canvases can be rendered on the different threads at the same time
+ * - the bitmap pixels can be read by many threads if no thread is writing them or drawing to the bitmap
+ * - the path, display list and spatial index compute their bounds, polygon and index lazily on reading,
+ *   so they are not read-only and must not be shared without the external lock
+ * - the default quality of the new paints is thread-local, see gb_quality_set() and gb_canvas_quality_set()
+ * - the gl interfaces are loaded only once and shared by the whole process, so only one gl implementation can be used
+ * - each opengl device keeps the tracked gl states of its own context, the offscreen device makes its headless context 
+ *   current for the calling thread before each drawing, and the window device is bound to the ui thread of the window
+ */
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -57,7 +57,7 @@ typedef struct __gb_window_glut_impl_t
     // the delay for framerate
     tb_size_t               delay;
 
-    // the spak time
+    // the drawing time
     tb_hong_t               time;
 
     // the button
@@ -92,8 +92,11 @@ static tb_void_t gb_window_glut_display()
     gb_window_glut_impl_t* impl = gb_window_glut_get();
     tb_assert_and_check_return(impl && impl->canvas);
 
-    // spak
-    impl->time = gb_window_impl_spak((gb_window_ref_t)impl);
+    // the time before drawing
+    tb_hong_t time = tb_cache_time_spak();
+
+    // the system may also redisplay it after exposing, redraw the whole window
+    gb_window_invalidate((gb_window_ref_t)impl, tb_null);
 
     // draw
     gb_window_impl_draw((gb_window_ref_t)impl, impl->canvas);
@@ -101,8 +104,8 @@ static tb_void_t gb_window_glut_display()
 	// flush
 	glutSwapBuffers();
 
-    // compute the spak time
-    impl->time = tb_cache_time_spak() - impl->time;
+    // compute the drawing time
+    impl->time = tb_cache_time_spak() - time;
 }
 static tb_void_t gb_window_glut_reshape(tb_int_t width, tb_int_t height)
 {
@@ -127,6 +130,9 @@ static tb_void_t gb_window_glut_reshape(tb_int_t width, tb_int_t height)
 
     // done resize
     if (impl->base.info.resize) impl->base.info.resize((gb_window_ref_t)impl, impl->canvas, impl->base.info.priv);
+
+    // redraw the whole window
+    gb_window_invalidate((gb_window_ref_t)impl, tb_null);
 }
 static tb_void_t gb_window_glut_keyboard(tb_byte_t key, tb_int_t x, tb_int_t y)
 { 
@@ -336,14 +342,20 @@ static tb_void_t gb_window_glut_timer(tb_int_t value)
     // trace
 //    tb_trace_d("timer: %d", value);
 
-    // post to draw it
-    glutPostRedisplay();
+    // spak the timer tasks, they may invalidate the window
+    gb_window_impl_spak((gb_window_ref_t)impl);
+
+    // post to draw it only if be damaged
+    if (impl->base.damage_count) glutPostRedisplay();
 
     // compute the delay for framerate
     if (!impl->delay) impl->delay = 1000 / (impl->base.info.framerate? impl->base.info.framerate : GB_WINDOW_DEFAULT_FRAMERATE);
 
     // next timer
     glutTimerFunc(impl->delay > (tb_size_t)impl->time? impl->delay - (tb_size_t)impl->time : 0, gb_window_glut_timer, value);
+
+    // the drawing time has been used
+    impl->time = 0;
 }
 static tb_void_t gb_window_glut_visibility(tb_int_t state)
 {
@@ -435,6 +447,9 @@ static tb_void_t gb_window_glut_loop(gb_window_ref_t window)
     // done init
     if (impl->base.info.init && !impl->base.info.init((gb_window_ref_t)impl, impl->canvas, impl->base.info.priv)) return ;
 
+    // draw the whole window at the first frame
+    gb_window_invalidate((gb_window_ref_t)impl, tb_null);
+
     // loop
 #ifdef TB_CONFIG_OS_MACOSX
     while (!tb_atomic_get(&impl->stop))
@@ -48,9 +48,6 @@ tb_hong_t gb_window_impl_spak(gb_window_ref_t window)
     // init the frame time
     if (!impl->fps_time) impl->fps_time = time;
     
-    // update the frame count
-    impl->fps_count++;
-
     // > 1s?
     if (time > impl->fps_time + 1000)
     {
@@ -73,14 +70,54 @@ tb_hong_t gb_window_impl_spak(gb_window_ref_t window)
     // the spak time
     return time;
 }
-tb_void_t gb_window_impl_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
+tb_bool_t gb_window_impl_draw(gb_window_ref_t window, gb_canvas_ref_t canvas)
 {
     // check
     gb_window_impl_t* impl = (gb_window_impl_t*)window;
     tb_assert_abort(impl && impl->info.draw && canvas);
 
+    // nothing is damaged? 
+    impl->drawn_count = 0;
+    tb_check_return_val(impl->damage_count, tb_false);
+
+    // the back buffer is undefined after swapping for the gl mode, redraw the whole window
+    if (impl->mode == GB_WINDOW_MODE_GL) gb_window_invalidate(window, tb_null);
+
+    // begin drawing this frame
+    gb_device_draw_begin(gb_canvas_device(canvas));
+
+    // move the damaged rects to the drawn rects, the rects damaged when drawing will be drawn at the next frame
+    tb_memcpy(impl->drawn, impl->damage, impl->damage_count * sizeof(gb_rect_t));
+    impl->drawn_count   = impl->damage_count;
+    impl->damage_count  = 0;
+
+    // the bounds of the drawn rects
+    tb_size_t i;
+    gb_rect_t bounds = impl->drawn[0];
+    for (i = 1; i < impl->drawn_count; i++) gb_rect_merge(&bounds, &impl->drawn[i]);
+
+    // clip the canvas to the damaged bounds if only a part of the window is damaged
+    tb_bool_t clipped = (bounds.w < gb_long_to_float(impl->width) || bounds.h < gb_long_to_float(impl->height))? tb_true : tb_false;
+    if (clipped)
+    {
+        gb_canvas_save_clipper(canvas);
+        gb_canvas_clip_rect(canvas, GB_CLIPPER_MODE_REPLACE, &bounds);
+    }
+
     // done draw
     impl->info.draw((gb_window_ref_t)impl, canvas, impl->info.priv);
+
+    // restore the clipper
+    if (clipped) gb_canvas_load_clipper(canvas);
+
+    // flush the pending draws of this frame
+    gb_device_draw_flush(gb_canvas_device(canvas));
+
+    // update the frame count
+    impl->fps_count++;
+
+    // ok
+    return tb_true;
 }
 tb_void_t gb_window_impl_event(gb_window_ref_t window, gb_event_ref_t event)
 {
@@ -32,6 +32,7 @@
 #include "../../core/canvas.h"
 #include "../../core/pixmap.h"
 #include "../../core/bitmap.h"
+#include "../../core/clipper.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -45,6 +46,9 @@ __tb_extern_c_enter__
 // the default framerate: 30
 #define GB_WINDOW_DEFAULT_FRAMERATE         (30)
 
+// the damaged rects maxn, the overflowed rect is merged to the nearest one
+#define GB_WINDOW_DAMAGE_MAXN               (8)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -88,6 +92,18 @@ typedef struct __gb_window_impl_t
     // the frame count for fps
     tb_size_t               fps_count;
 
+    // the damaged rects for the next frame
+    gb_rect_t               damage[GB_WINDOW_DAMAGE_MAXN];
+
+    // the damaged rects count
+    tb_size_t               damage_count;
+
+    // the drawn rects of the current frame for presenting
+    gb_rect_t               drawn[GB_WINDOW_DAMAGE_MAXN];
+
+    // the drawn rects count, 0: nothing is drawn
+    tb_size_t               drawn_count;
+
     /* loop window
      *
      * @param window        the window
@@ -142,12 +158,16 @@ typedef struct __gb_window_impl_t
  */
 tb_hong_t                   gb_window_impl_spak(gb_window_ref_t window);
 
-/* draw window
+/* draw the damaged rects of the window
+ *
+ * the damaged rects are moved to the drawn rects for presenting
  *
  * @param window            the window
  * @param canvas            the canvas
+ *
+ * @return                  tb_true if be drawn, otherwise tb_false if nothing is damaged
  */
-tb_void_t                   gb_window_impl_draw(gb_window_ref_t window, gb_canvas_ref_t canvas);
+tb_bool_t                   gb_window_impl_draw(gb_window_ref_t window, gb_canvas_ref_t canvas);
 
 /* the window event
  *
@@ -102,6 +102,9 @@ static tb_void_t gb_window_sdl_loop(gb_window_ref_t window)
     // done init
     if (impl->base.info.init && !impl->base.info.init((gb_window_ref_t)impl, impl->canvas, impl->base.info.priv)) return ;
 
+    // draw the whole window at the first frame
+    gb_window_invalidate((gb_window_ref_t)impl, tb_null);
+
     // loop
     SDL_Event evet;
     tb_hong_t time;
@@ -112,17 +115,38 @@ static tb_void_t gb_window_sdl_loop(gb_window_ref_t window)
         // spak
         time = gb_window_impl_spak((gb_window_ref_t)impl);
 
+        // the back buffer of the hardware surface is undefined after flipping, redraw the whole window
+        tb_bool_t flipped = (impl->surface->flags & (SDL_HWSURFACE | SDL_DOUBLEBUF)) == (SDL_HWSURFACE | SDL_DOUBLEBUF);
+        if (flipped && impl->base.damage_count) gb_window_invalidate((gb_window_ref_t)impl, tb_null);
+
         // lock the surface
         SDL_LockSurface(impl->surface);
 
-        // draw
-        gb_window_impl_draw((gb_window_ref_t)impl, impl->canvas);
+        // draw the damaged rects
+        tb_bool_t drawn = gb_window_impl_draw((gb_window_ref_t)impl, impl->canvas);
 
         // unlock the surface
         SDL_UnlockSurface(impl->surface);
 
         // flip 
-        if (SDL_Flip(impl->surface) < 0) stop = tb_true;
+        if (drawn && flipped)
+        {
+            if (SDL_Flip(impl->surface) < 0) stop = tb_true;
+        }
+        // update the drawn rects only
+        else if (drawn)
+        {
+            tb_size_t   i;
+            SDL_Rect    rects[GB_WINDOW_DAMAGE_MAXN];
+            for (i = 0; i < impl->base.drawn_count; i++)
+            {
+                rects[i].x = (Sint16)gb_float_to_long(impl->base.drawn[i].x);
+                rects[i].y = (Sint16)gb_float_to_long(impl->base.drawn[i].y);
+                rects[i].w = (Uint16)gb_float_to_long(impl->base.drawn[i].w);
+                rects[i].h = (Uint16)gb_float_to_long(impl->base.drawn[i].h);
+            }
+            SDL_UpdateRects(impl->surface, (tb_int_t)impl->base.drawn_count, rects);
+        }
 
         // poll
         while (SDL_PollEvent(&evet))
@@ -248,6 +272,12 @@ static tb_void_t gb_window_sdl_loop(gb_window_ref_t window)
                     // ...
                 }
                 break;
+            case SDL_VIDEOEXPOSE:
+                {
+                    // the window need be redrawn
+                    gb_window_invalidate((gb_window_ref_t)impl, tb_null);
+                }
+                break;
             case SDL_ACTIVEEVENT:
                 {
                     // trace
@@ -380,6 +410,9 @@ static tb_void_t gb_window_sdl_fullscreen(gb_window_ref_t window, tb_bool_t full
 
         // done resize
         if (impl->base.info.resize) impl->base.info.resize((gb_window_ref_t)impl, impl->canvas, impl->base.info.priv);
+
+        // redraw the whole window
+        gb_window_invalidate((gb_window_ref_t)impl, tb_null);
     }
 }
 
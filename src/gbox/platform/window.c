@@ -208,6 +208,64 @@ gb_float_t gb_window_framerate(gb_window_ref_t window)
     // the framerate
     return impl->framerate;
 }
+tb_void_t gb_window_invalidate(gb_window_ref_t window, gb_rect_ref_t rect)
+{
+    // check
+    gb_window_impl_t* impl = (gb_window_impl_t*)window;
+    tb_assert_and_check_return(impl && impl->width && impl->height);
+
+    // the window bounds
+    gb_rect_t bounds;
+    gb_rect_imake(&bounds, 0, 0, impl->width, impl->height);
+
+    // the whole window is damaged? 
+    if (!rect)
+    {
+        impl->damage[0]     = bounds;
+        impl->damage_count  = 1;
+        return ;
+    }
+
+    // align the damaged rect to the pixels and clip it by the window
+    gb_rect_t damage;
+    tb_long_t x0 = gb_floor(rect->x);
+    tb_long_t y0 = gb_floor(rect->y);
+    tb_long_t x1 = gb_ceil(rect->x + rect->w);
+    tb_long_t y1 = gb_ceil(rect->y + rect->h);
+    tb_check_return(x1 > x0 && y1 > y0);
+    gb_rect_imake(&damage, x0, y0, x1 - x0, y1 - y0);
+    tb_check_return(gb_rect_intersect(&damage, &bounds));
+
+    // merge it to the intersected or the nearest damaged rect
+    tb_size_t   i;
+    tb_size_t   nearest = 0;
+    gb_float_t  growth_min = 0;
+    for (i = 0; i < impl->damage_count; i++)
+    {
+        // intersected? merge it
+        gb_rect_t merged = impl->damage[i];
+        gb_rect_t intersected = impl->damage[i];
+        if (gb_rect_intersect(&intersected, &damage))
+        {
+            gb_rect_merge(&impl->damage[i], &damage);
+            return ;
+        }
+
+        // the growth of the area after merging, the area is estimated by the half perimeter for the fixed-point float
+        gb_rect_merge(&merged, &damage);
+        gb_float_t growth = (merged.w + merged.h) - (impl->damage[i].w + impl->damage[i].h);
+        if (!i || growth < growth_min)
+        {
+            growth_min  = growth;
+            nearest     = i;
+        }
+    }
+
+    // append it
+    if (impl->damage_count < GB_WINDOW_DAMAGE_MAXN) impl->damage[impl->damage_count++] = damage;
+    // merge it to the nearest one
+    else gb_rect_merge(&impl->damage[nearest], &damage);
+}
 tb_timer_ref_t gb_window_timer(gb_window_ref_t window)
 {
     // check
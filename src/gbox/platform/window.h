@@ -294,6 +294,25 @@ gb_float_t              gb_window_framerate(gb_window_ref_t window);
  */
 tb_void_t               gb_window_fullscreen(gb_window_ref_t window, tb_bool_t fullscreen);
 
+/*! invalidate the given rect of the window
+ *
+ * the damaged rects are accumulated and only they are redrawn and presented at the next frame,
+ * the canvas is clipped to the damaged bounds and nothing is drawn if no rect is damaged.
+ *
+ * @code
+    // the value has been changed, redraw the label only
+    gb_rect_t rect;
+    gb_rect_imake(&rect, 10, 10, 100, 20);
+    gb_window_invalidate(window, &rect);
+ * @endcode
+ *
+ * @note the whole window is always redrawn for the gl mode because the back buffer is undefined after swapping
+ *
+ * @param window        the window
+ * @param rect          the damaged rect, invalidate the whole window if be null
+ */
+tb_void_t               gb_window_invalidate(gb_window_ref_t window, gb_rect_ref_t rect);
+
 /*! the window timer
  *
  * @note the timer task will be called in the draw loop
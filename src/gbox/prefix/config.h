@@ -49,6 +49,16 @@
 #   define __gb_debug__
 #endif
 
+/*! @def __gb_thread_local__
+ *
+ * the thread-local storage class, undefined if the compiler has not it
+ */
+#if defined(TB_COMPILER_IS_MSVC)
+#   define __gb_thread_local__          __declspec(thread)
+#elif defined(TB_COMPILER_IS_GCC) || defined(TB_COMPILER_IS_CLANG) || defined(TB_COMPILER_IS_INTEL)
+#   define __gb_thread_local__          __thread
+#endif
+
 #endif
 
 
@@ -32,9 +32,137 @@
  */
 #include "geometry.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+#ifndef GB_CONFIG_FLOAT_FIXED
+
+/* the error bound of the fast filter for the 2x2 determinant
+ *
+ * refer to: Shewchuk, Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates
+ *
+ * epsilon = 2^-53
+ * bound = (3 + 16 * epsilon) * epsilon
+ */
+#   define GB_PREDICATE_EPSILON             (1.1102230246251565e-16)
+#   define GB_PREDICATE_ERRBOUND            ((3.0 + 16.0 * GB_PREDICATE_EPSILON) * GB_PREDICATE_EPSILON)
+
+// the splitter for the exact product: 2^ceil(53 / 2) + 1
+#   define GB_PREDICATE_SPLITTER            (134217729.0)
+
+// the maximum size of the expansion
+#   define GB_PREDICATE_EXPANSION_MAXN      (32)
+
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+#ifndef GB_CONFIG_FLOAT_FIXED
+// x + y = sum + err exactly
+static __tb_inline__ tb_void_t gb_predicate_two_sum(tb_double_t x, tb_double_t y, tb_double_t* sum, tb_double_t* err)
+{
+    tb_double_t s = x + y;
+    tb_double_t v = s - x;
+    *sum = s;
+    *err = (x - (s - v)) + (y - v);
+}
+// x * y = product + err exactly, using the splitting of Dekker
+static __tb_inline__ tb_void_t gb_predicate_two_product(tb_double_t x, tb_double_t y, tb_double_t* product, tb_double_t* err)
+{
+    // split x and y to the high and low halves
+    tb_double_t c   = GB_PREDICATE_SPLITTER * x;
+    tb_double_t xh  = c - (c - x);
+    tb_double_t xl  = x - xh;
+    c               = GB_PREDICATE_SPLITTER * y;
+    tb_double_t yh  = c - (c - y);
+    tb_double_t yl  = y - yh;
+
+    // compute the product and its rounding error
+    tb_double_t p   = x * y;
+    *product        = p;
+    *err            = xl * yl - (((p - xh * yh) - xl * yh) - xh * yl);
+}
+// add b to the nonoverlapping expansion e in place and eliminate the zero components
+static tb_size_t gb_predicate_expansion_grow(tb_double_t* e, tb_size_t n, tb_double_t b)
+{
+    // done
+    tb_size_t   i = 0;
+    tb_size_t   m = 0;
+    tb_double_t q = b;
+    tb_double_t h;
+    for (i = 0; i < n; i++)
+    {
+        gb_predicate_two_sum(q, e[i], &q, &h);
+        if (h != 0) e[m++] = h;
+    }
+    if (q != 0) e[m++] = q;
+
+    // the new size
+    tb_assert_abort(m <= GB_PREDICATE_EXPANSION_MAXN);
+    return m;
+}
+// add the exact product (a + b) * (c + d) with the given sign to the expansion
+static tb_size_t gb_predicate_expansion_add_product(tb_double_t* e, tb_size_t n, tb_double_t a, tb_double_t b, tb_double_t c, tb_double_t d, tb_double_t sign)
+{
+    tb_double_t p;
+    tb_double_t q;
+    gb_predicate_two_product(a, c, &p, &q); n = gb_predicate_expansion_grow(e, n, sign * p); n = gb_predicate_expansion_grow(e, n, sign * q);
+    gb_predicate_two_product(a, d, &p, &q); n = gb_predicate_expansion_grow(e, n, sign * p); n = gb_predicate_expansion_grow(e, n, sign * q);
+    gb_predicate_two_product(b, c, &p, &q); n = gb_predicate_expansion_grow(e, n, sign * p); n = gb_predicate_expansion_grow(e, n, sign * q);
+    gb_predicate_two_product(b, d, &p, &q); n = gb_predicate_expansion_grow(e, n, sign * p); n = gb_predicate_expansion_grow(e, n, sign * q);
+    return n;
+}
+// the exact sign of (a0 - a1) * (b0 - b1) - (c0 - c1) * (d0 - d1)
+static tb_long_t gb_predicate_det_exact(tb_double_t a0, tb_double_t a1, tb_double_t b0, tb_double_t b1, tb_double_t c0, tb_double_t c1, tb_double_t d0, tb_double_t d1)
+{
+    // compute the differences exactly: x0 - x1 = xh + xl
+    tb_double_t ah, al, bh, bl, ch, cl, dh, dl;
+    gb_predicate_two_sum(a0, -a1, &ah, &al);
+    gb_predicate_two_sum(b0, -b1, &bh, &bl);
+    gb_predicate_two_sum(c0, -c1, &ch, &cl);
+    gb_predicate_two_sum(d0, -d1, &dh, &dl);
+
+    // compute the determinant as the expansion
+    tb_double_t e[GB_PREDICATE_EXPANSION_MAXN];
+    tb_size_t   n = 0;
+    n = gb_predicate_expansion_add_product(e, n, ah, al, bh, bl, 1);
+    n = gb_predicate_expansion_add_product(e, n, ch, cl, dh, dl, -1);
+
+    // the sign of the expansion is the sign of its largest component
+    return n? (e[n - 1] < 0? -1 : 1) : 0;
+}
+#endif
+/* the sign of (a0 - a1) * (b0 - b1) - (c0 - c1) * (d0 - d1)
+ *
+ * the float version computes it with a fast floating-point filter
+ * and falls back to the exact arithmetic only when the result is ambiguous.
+ */
+static __tb_inline__ tb_long_t gb_predicate_det(gb_float_t a0, gb_float_t a1, gb_float_t b0, gb_float_t b1, gb_float_t c0, gb_float_t c1, gb_float_t d0, gb_float_t d1)
+{
+#ifdef GB_CONFIG_FLOAT_FIXED
+    // the products of the fixed differences are exact in 64-bits
+    tb_hong_t det = (tb_hong_t)(a0 - a1) * (b0 - b1) - (tb_hong_t)(c0 - c1) * (d0 - d1);
+    return det < 0? -1 : det > 0;
+#else
+    // compute it fastly
+    tb_double_t l   = ((tb_double_t)a0 - a1) * ((tb_double_t)b0 - b1);
+    tb_double_t r   = ((tb_double_t)c0 - c1) * ((tb_double_t)d0 - d1);
+    tb_double_t det = l - r;
+
+    // the result is reliable?
+    tb_double_t bound = GB_PREDICATE_ERRBOUND * (tb_abs(l) + tb_abs(r));
+    if (det > bound) return 1;
+    if (det < -bound) return -1;
+
+    // both products are zero? the determinant is exactly zero
+    if (l == 0 && r == 0) return 0;
+
+    // compute it exactly
+    return gb_predicate_det_exact(a0, a1, b0, b1, c0, c1, d0, d1);
+#endif
+}
 static gb_double_t gb_point_to_segment_distance_h_cheap(gb_point_ref_t center, gb_point_ref_t upper, gb_point_ref_t lower)
 {
     // check
@@ -418,41 +546,37 @@ static tb_bool_t gb_segment_near_parallel(gb_point_ref_t org1, gb_point_ref_t ds
     gb_float_t dy2 = org2->y - dst2->y;
     gb_float_t dx2 = org2->x - dst2->x;
 
-    // compute the slope errors
+    // compute the slope errors, keep 64-bits for the fixed build, it will overflow 16.16 for the large coordinates
 #ifdef GB_CONFIG_FLOAT_FIXED
-    gb_float_t dk = (gb_float_t)(((tb_hong_t)dy1 * dx2 - (tb_hong_t)dy2 * dx1) >> 16);
+    tb_hong_t   dk = ((tb_hong_t)dy1 * dx2 - (tb_hong_t)dy2 * dx1) >> 16;
 #else
-    gb_float_t dk = (gb_float_t)((tb_double_t)dy1 * dx2 - (tb_double_t)dy2 * dx1);
+    tb_double_t dk = (tb_double_t)dy1 * dx2 - (tb_double_t)dy2 * dx1;
 #endif
 
     // is parallel?
-    return gb_near0(dk);
+    return dk >= -GB_NEAR0 && dk <= GB_NEAR0;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_long_t gb_points_is_ccw(gb_point_ref_t p0, gb_point_ref_t p1, gb_point_ref_t p2)
+tb_long_t gb_points_orientation(gb_point_ref_t p0, gb_point_ref_t p1, gb_point_ref_t p2)
 {
     // check
     tb_assert_abort(p0 && p1 && p2);
 
-    // the coordinates
-    tb_fixed_t x0 = gb_float_to_fixed(p0->x);
-    tb_fixed_t y0 = gb_float_to_fixed(p0->y);
-    tb_fixed_t x1 = gb_float_to_fixed(p1->x);
-    tb_fixed_t y1 = gb_float_to_fixed(p1->y);
-    tb_fixed_t x2 = gb_float_to_fixed(p2->x);
-    tb_fixed_t y2 = gb_float_to_fixed(p2->y);
-  
-    /* compute the cross value of the vectors (p1, p0) and (p1, p2)
+    /* compute the sign of the cross value of the vectors (p1, p0) and (p1, p2)
      *
-     * cross[(p1, p0), (p1, p2)] > 0
+     * cross[(p1, p0), (p1, p2)] = (p0.x - p1.x) * (p2.y - p1.y) - (p0.y - p1.y) * (p2.x - p1.x)
      *
-     *
-     * the result is not reliable for almost-degenerate situations
+     * the result is exact for the almost-degenerate situations
      */
-    return ((tb_hong_t)(x0 - x1) * (y2 - y1) - (tb_hong_t)(y0 - y1) * (x2 - x1)) > 0;
+    return gb_predicate_det(p0->x, p1->x, p2->y, p1->y, p0->y, p1->y, p2->x, p1->x);
+}
+tb_long_t gb_points_is_ccw(gb_point_ref_t p0, gb_point_ref_t p1, gb_point_ref_t p2)
+{
+    // cross[(p1, p0), (p1, p2)] > 0
+    return gb_points_orientation(p0, p1, p2) > 0;
 }
 gb_float_t gb_point_to_segment_distance_h(gb_point_ref_t center, gb_point_ref_t upper, gb_point_ref_t lower)
 {
@@ -637,28 +761,54 @@ tb_long_t gb_point_to_segment_position_h(gb_point_ref_t center, gb_point_ref_t u
     // check
     tb_assert_abort(center && upper && lower);
 
-    // compute the cheap distance quickly
-    gb_double_t distance = gb_point_to_segment_distance_h_cheap(center, upper, lower);
+    // must be upper <= center <= lower
+    tb_assertf_abort(gb_point_in_top_or_horizontal(upper, center), "%{point} <=? %{point}", upper, center);
+    tb_assertf_abort(gb_point_in_top_or_horizontal(center, lower), "%{point} <=? %{point}", center, lower);
 
-    // get the sign of the distance
-    return distance < 0? -1 : distance > 0;
+    /* get the sign of the distance, see gb_point_to_segment_distance_h_cheap()
+     *
+     * sign(distance) = sign((center.x - lower.x) * yu + (center.x - upper.x) * yl)
+     *                = sign((center.x - lower.x) * (center.y - upper.y) - (center.x - upper.x) * (center.y - lower.y))
+     *
+     * it is zero for the horizontal edge
+     */
+    return gb_predicate_det(center->x, lower->x, center->y, upper->y, center->x, upper->x, center->y, lower->y);
 }
 tb_long_t gb_point_to_segment_position_v(gb_point_ref_t center, gb_point_ref_t left, gb_point_ref_t right)
 {
     // check
     tb_assert_abort(center && left && right);
 
-    // compute the cheap distance quickly
-    gb_double_t distance = gb_point_to_segment_distance_v_cheap(center, left, right);
+    // must be left <= center <= right
+    tb_assertf_abort(gb_point_in_left_or_vertical(left, center), "%{point} <=? %{point}", left, center);
+    tb_assertf_abort(gb_point_in_left_or_vertical(center, right), "%{point} <=? %{point}", center, right);
 
-    // get the sign of the distance
-    return distance < 0? -1 : distance > 0;
+    /* get the sign of the distance, see gb_point_to_segment_distance_v_cheap()
+     *
+     * sign(distance) = sign((center.y - right.y) * xl + (center.y - left.y) * xr)
+     *                = sign((center.y - right.y) * (center.x - left.x) - (center.y - left.y) * (center.x - right.x))
+     *
+     * it is zero for the vertical edge
+     */
+    return gb_predicate_det(center->y, right->y, center->x, left->x, center->y, left->y, center->x, right->x);
 }
 tb_long_t gb_segment_intersection(gb_point_ref_t org1, gb_point_ref_t dst1, gb_point_ref_t org2, gb_point_ref_t dst2, gb_point_ref_t result)
 {
     // check
     tb_assert_abort(org1 && dst1 && org2 && dst2);
 
+    // the orientations of the endpoints of the one segment relative to the other segment
+    tb_long_t o1 = gb_points_orientation(org1, dst1, org2);
+    tb_long_t o2 = gb_points_orientation(org1, dst1, dst2);
+    tb_long_t o3 = gb_points_orientation(org2, dst2, org1);
+    tb_long_t o4 = gb_points_orientation(org2, dst2, dst1);
+
+    // collinear? no intersection
+    if (!o1 && !o2 && !o3 && !o4) return 0;
+
+    // two endpoints are strictly on the same side of the other segment? no intersection
+    if (o1 * o2 > 0 || o3 * o4 > 0) return -1;
+
     // near parallel? no intersection
     if (gb_segment_near_parallel(org1, dst1, org2, dst2)) return 0;
 
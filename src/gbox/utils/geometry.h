@@ -199,6 +199,21 @@ __tb_extern_c_enter__
  */
 tb_long_t               gb_points_is_ccw(gb_point_ref_t p0, gb_point_ref_t p1, gb_point_ref_t p2);
 
+/*! compute the orientation of three points exactly
+ *
+ * the sign of cross[(p1, p0), (p1, p2)], see gb_points_is_ccw()
+ *
+ * uses a fast floating-point filter and falls back to the exact arithmetic
+ * only when the result is ambiguous for the almost-degenerate situations.
+ *
+ * @param p0            the first point
+ * @param p1            the second point
+ * @param p2            the last point
+ *
+ * @return              1: counter-clockwise, -1: clockwise, 0: collinear
+ */
+tb_long_t               gb_points_orientation(gb_point_ref_t p0, gb_point_ref_t p1, gb_point_ref_t p2);
+
 /*! compute the point-to-segment horizontal distance
  *
  *     upper            upper'
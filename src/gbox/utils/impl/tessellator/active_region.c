@@ -419,14 +419,11 @@ tb_bool_t gb_tessellator_active_regions_make(gb_tessellator_impl_t* impl, gb_rec
         element.cstr = gb_tessellator_active_region_cstr;
 
         // register printf("%{tess_region}", region);
-        static tb_bool_t s_is_registered = tb_false;
-        if (!s_is_registered)
+        static tb_atomic_t s_is_registered = 0;
+        if (!tb_atomic_fetch_and_pset(&s_is_registered, 0, 1))
         {
             // register it
             tb_printf_object_register("tess_region", gb_tessellator_active_region_printf);
-
-            // ok
-            s_is_registered = tb_true;
         }
 #endif
 
@@ -448,10 +445,18 @@ tb_bool_t gb_tessellator_active_regions_make(gb_tessellator_impl_t* impl, gb_rec
      *    |              .  .    .        |
      *                                 (xe, ye)
      */
-    gb_float_t xb = bounds->x - GB_ONE;
-    gb_float_t yb = bounds->y - GB_ONE;
-    gb_float_t xe = bounds->x + bounds->w + GB_ONE;
-    gb_float_t ye = bounds->y + bounds->h + GB_ONE;
+#ifdef GB_CONFIG_FLOAT_FIXED
+    gb_float_t margin = GB_ONE;
+#else
+    /* the margin must be larger than the ulp of the huge coordinates, 
+     * otherwise x + 1 == x and the bounds will be merged with the leftmost and rightmost vertices
+     */
+    gb_float_t margin = GB_ONE + tb_max(tb_max(gb_abs(bounds->x), gb_abs(bounds->x + bounds->w)), tb_max(gb_abs(bounds->y), gb_abs(bounds->y + bounds->h))) / (1 << 20);
+#endif
+    gb_float_t xb = bounds->x - margin;
+    gb_float_t yb = bounds->y - margin;
+    gb_float_t xe = bounds->x + bounds->w + margin;
+    gb_float_t ye = bounds->y + bounds->h + margin;
     gb_tessellator_active_regions_insert_bounds(impl, xb, ye, yb);
     gb_tessellator_active_regions_insert_bounds(impl, xe, ye, yb);
 
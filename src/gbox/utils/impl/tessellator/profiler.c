@@ -39,6 +39,13 @@
 // the profiler 
 static tb_stream_ref_t  g_profiler = tb_null;
 
+/* the owner thread of the profiler
+ *
+ * only one tessellator can be profiled at the same time, 
+ * the others will be ignored if the polygon list is tessellated in parallel
+ */
+static tb_atomic_t      g_owner = 0;
+
 // the head
 static tb_char_t const* g_head = "\
 <!DOCTYPE html>\n\
@@ -140,6 +147,14 @@ static tb_char_t const* g_tail = "\
 </html>\n\
 ";
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_bool_t gb_tessellator_profiler_owned()
+{
+    return g_profiler && (tb_size_t)tb_atomic_get(&g_owner) == tb_thread_self();
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -152,8 +167,13 @@ tb_bool_t gb_tessellator_profiler_init(gb_rect_ref_t bounds)
     tb_bool_t   ok = tb_false;
     tb_char_t*  head = tb_null;
     tb_size_t   head_maxn = tb_strlen(g_head) + 256;
+    tb_bool_t   owned = tb_false;
     do
     {
+        // be profiling on the other thread? ignore it
+        if (tb_atomic_fetch_and_pset(&g_owner, 0, (tb_long_t)tb_thread_self())) break;
+        owned = tb_true;
+
         // check
         tb_assert_abort(!g_profiler);
 
@@ -219,6 +239,9 @@ tb_bool_t gb_tessellator_profiler_init(gb_rect_ref_t bounds)
         // exit it
         if (g_profiler) tb_stream_exit(g_profiler);
         g_profiler = tb_null;
+
+        // release the owner
+        if (owned) tb_atomic_set0(&g_owner);
     }
 
     // exit head
@@ -231,7 +254,7 @@ tb_bool_t gb_tessellator_profiler_init(gb_rect_ref_t bounds)
 tb_void_t gb_tessellator_profiler_exit()
 {
     // check
-    tb_assert_and_check_return(g_profiler);
+    tb_check_return(gb_tessellator_profiler_owned());
 
     // write the tail
     tb_stream_bwrit(g_profiler, (tb_byte_t const*)g_tail, tb_strlen(g_tail));
@@ -239,11 +262,14 @@ tb_void_t gb_tessellator_profiler_exit()
     // exit it
     tb_stream_exit(g_profiler);
     g_profiler = tb_null;
+
+    // release the owner
+    tb_atomic_set0(&g_owner);
 }
 tb_void_t gb_tessellator_profiler_add_edge(gb_mesh_edge_ref_t edge)
 {
     // check
-    tb_assert_and_check_return(g_profiler && edge);
+    tb_check_return(gb_tessellator_profiler_owned() && edge);
 
     // the vertices
     gb_mesh_vertex_ref_t org = gb_mesh_edge_org(edge);
@@ -264,7 +290,7 @@ tb_void_t gb_tessellator_profiler_add_edge(gb_mesh_edge_ref_t edge)
 tb_void_t gb_tessellator_profiler_add_split(gb_mesh_edge_ref_t edge)
 {
     // check
-    tb_assert_and_check_return(g_profiler && edge);
+    tb_check_return(gb_tessellator_profiler_owned() && edge);
 
     // the vertices
     gb_mesh_vertex_ref_t org = gb_mesh_edge_org(edge);
@@ -285,7 +311,7 @@ tb_void_t gb_tessellator_profiler_add_split(gb_mesh_edge_ref_t edge)
 tb_void_t gb_tessellator_profiler_add_patch(gb_mesh_edge_ref_t edge)
 {
     // check
-    tb_assert_and_check_return(g_profiler && edge);
+    tb_check_return(gb_tessellator_profiler_owned() && edge);
 
     // the vertices
     gb_mesh_vertex_ref_t org = gb_mesh_edge_org(edge);
@@ -306,7 +332,7 @@ tb_void_t gb_tessellator_profiler_add_patch(gb_mesh_edge_ref_t edge)
 tb_void_t gb_tessellator_profiler_add_inter(gb_mesh_vertex_ref_t inter)
 {
     // check
-    tb_assert_and_check_return(g_profiler && inter);
+    tb_check_return(gb_tessellator_profiler_owned() && inter);
 
     // the point
     gb_point_ref_t point = gb_tessellator_vertex_point(inter);
@@ -322,7 +348,7 @@ tb_void_t gb_tessellator_profiler_add_inter(gb_mesh_vertex_ref_t inter)
 tb_void_t gb_tessellator_profiler_finish_region(gb_tessellator_active_region_ref_t region)
 {
     // check
-    tb_assert_and_check_return(g_profiler && region);
+    tb_check_return(gb_tessellator_profiler_owned() && region);
 
     // the region is inside?
     tb_check_return(region->inside);
@@ -0,0 +1,1190 @@
+/*!The Graphic Box Library
+ *
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox;
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ *
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        index_mesh.c
+ * @ingroup     utils
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "index_mesh"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "index_mesh.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the grow size
+#ifdef __gb_small__
+#   define GB_INDEX_MESH_GROW                   (64)
+#else
+#   define GB_INDEX_MESH_GROW                   (256)
+#endif
+
+// the maximum count of the edges, faces and vertices
+#define GB_INDEX_MESH_MAXN                      (GB_INDEX_MESH_FREE >> 2)
+
+// set the face edge
+#define gb_index_mesh_face_edge_set(mesh, face, val)        do { tb_assert(face); (mesh)->face_edge[face] = (val); } while (0)
+
+// set the vertex edge
+#define gb_index_mesh_vertex_edge_set(mesh, vertex, val)    do { tb_assert(vertex); (mesh)->vertex_edge[vertex] = (val); } while (0)
+
+// set the edge org
+#define gb_index_mesh_edge_org_set(mesh, edge, val)         do { (mesh)->edge_org[edge] = (val); if (val) gb_index_mesh_vertex_edge_set(mesh, val, edge); } while (0)
+
+// set the edge dst
+#define gb_index_mesh_edge_dst_set(mesh, edge, val)         gb_index_mesh_edge_org_set(mesh, (edge) ^ 1, val)
+
+// set the edge lface
+#define gb_index_mesh_edge_lface_set(mesh, edge, val)       do { (mesh)->edge_lface[edge] = (val); if (val) gb_index_mesh_face_edge_set(mesh, val, edge); } while (0)
+
+// set the edge rface
+#define gb_index_mesh_edge_rface_set(mesh, edge, val)       gb_index_mesh_edge_lface_set(mesh, (edge) ^ 1, val)
+
+// the user data of the half-edge, face and vertex
+#define gb_index_mesh_edge_user(mesh, edge)                 ((mesh)->edge_data + (edge) * (mesh)->edge_element.size)
+#define gb_index_mesh_face_user(mesh, face)                 ((mesh)->face_data + (face) * (mesh)->face_element.size)
+#define gb_index_mesh_vertex_user(mesh, vertex)             ((mesh)->vertex_data + (vertex) * (mesh)->vertex_element.size)
+
+// check edge
+#define gb_index_mesh_check_edge(mesh, edge)                tb_assert(gb_index_mesh_edge_is_valid(mesh, edge))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t gb_index_mesh_grow(gb_index_mesh_index_t** links, tb_size_t count, tb_byte_t** data, tb_size_t size)
+{
+    // grow the links
+    gb_index_mesh_index_t* links_new = (gb_index_mesh_index_t*)tb_ralloc(*links, count * sizeof(gb_index_mesh_index_t));
+    tb_assert_and_check_return_val(links_new, tb_false);
+
+    // save links
+    *links = links_new;
+
+    // grow the user data
+    if (data && size)
+    {
+        // grow it
+        tb_byte_t* data_new = (tb_byte_t*)tb_ralloc(*data, count * size);
+        tb_assert_and_check_return_val(data_new, tb_false);
+
+        // save data
+        *data = data_new;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_index_mesh_grow_edges(gb_index_mesh_ref_t mesh)
+{
+    // check
+    tb_assert_and_check_return_val(mesh && mesh->edge_maxn < GB_INDEX_MESH_MAXN, tb_false);
+
+    // the new maxn, the first pair is the null edge
+    tb_size_t maxn = mesh->edge_maxn? (mesh->edge_maxn << 1) : GB_INDEX_MESH_GROW;
+    if (maxn > GB_INDEX_MESH_MAXN) maxn = GB_INDEX_MESH_MAXN;
+
+    // grow the hot fields and the user data of the half-edges
+    tb_size_t count = maxn << 1;
+    if (!gb_index_mesh_grow(&mesh->edge_org, count, &mesh->edge_data, mesh->edge_element.size)) return tb_false;
+    if (!gb_index_mesh_grow(&mesh->edge_lnext, count, tb_null, 0)) return tb_false;
+    if (!gb_index_mesh_grow(&mesh->edge_onext, count, tb_null, 0)) return tb_false;
+    if (!gb_index_mesh_grow(&mesh->edge_lface, count, tb_null, 0)) return tb_false;
+
+    // init the null edge
+    if (!mesh->edge_maxn)
+    {
+        mesh->edge_org[0]   = mesh->edge_org[1]     = GB_INDEX_MESH_NULL;
+        mesh->edge_lnext[0] = mesh->edge_lnext[1]   = GB_INDEX_MESH_NULL;
+        mesh->edge_onext[0] = mesh->edge_onext[1]   = GB_INDEX_MESH_NULL;
+        mesh->edge_lface[0] = mesh->edge_lface[1]   = GB_INDEX_MESH_NULL;
+        mesh->edge_maxn     = 1;
+    }
+
+    // push the new edges to the free list in reverse order, the lower edges will be used first
+    tb_size_t pair = maxn;
+    while (pair-- > mesh->edge_maxn)
+    {
+        gb_index_mesh_index_t edge = (gb_index_mesh_index_t)(pair << 1);
+        mesh->edge_lnext[edge]      = GB_INDEX_MESH_FREE | mesh->edge_free;
+        mesh->edge_lnext[edge ^ 1]  = GB_INDEX_MESH_FREE;
+        mesh->edge_free             = edge;
+    }
+
+    // update maxn
+    mesh->edge_maxn = maxn;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t gb_index_mesh_grow_items(gb_index_mesh_index_t** links, tb_size_t* pmaxn, gb_index_mesh_index_t* pfree, tb_byte_t** data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(links && pmaxn && pfree && data && *pmaxn < GB_INDEX_MESH_MAXN, tb_false);
+
+    // the new maxn, the first item is the null face or vertex
+    tb_size_t maxn = *pmaxn? (*pmaxn << 1) : GB_INDEX_MESH_GROW;
+    if (maxn > GB_INDEX_MESH_MAXN) maxn = GB_INDEX_MESH_MAXN;
+
+    // grow it
+    if (!gb_index_mesh_grow(links, maxn, data, size)) return tb_false;
+
+    // init the null item
+    if (!*pmaxn)
+    {
+        (*links)[0] = GB_INDEX_MESH_NULL;
+        *pmaxn      = 1;
+    }
+
+    // push the new items to the free list in reverse order
+    tb_size_t item = maxn;
+    while (item-- > *pmaxn)
+    {
+        (*links)[item]  = GB_INDEX_MESH_FREE | *pfree;
+        *pfree          = (gb_index_mesh_index_t)item;
+    }
+
+    // update maxn
+    *pmaxn = maxn;
+
+    // ok
+    return tb_true;
+}
+static tb_void_t gb_index_mesh_splice_edge(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t a, gb_index_mesh_index_t b)
+{
+    // check
+    tb_assert_abort(mesh && a && b && a != b);
+
+    /* splice(a, b), see gb_mesh_splice_edge()
+     *
+     * x = a.onext
+     * y = b.onext
+     */
+    gb_index_mesh_index_t x = mesh->edge_onext[a];
+    gb_index_mesh_index_t y = mesh->edge_onext[b];
+
+    /* a.onext' = y
+     * b.onext' = x
+     */
+    mesh->edge_onext[a] = y;
+    mesh->edge_onext[b] = x;
+
+    /* x.oprev' = b
+     * y.oprev' = a
+     */
+    mesh->edge_lnext[x ^ 1] = b;
+    mesh->edge_lnext[y ^ 1] = a;
+}
+static tb_void_t gb_index_mesh_save_face_at_orbit(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge, gb_index_mesh_index_t lface)
+{
+    // check
+    tb_assert_abort(mesh && edge);
+
+    // done
+    gb_index_mesh_index_t scan = edge;
+    do
+    {
+        // set lface
+        gb_index_mesh_edge_lface_set(mesh, scan, lface);
+
+        // the next edge
+        scan = mesh->edge_lnext[scan];
+    }
+    while (scan != edge);
+}
+static tb_void_t gb_index_mesh_save_vertex_at_orbit(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge, gb_index_mesh_index_t org)
+{
+    // check
+    tb_assert_abort(mesh && edge);
+
+    // done
+    gb_index_mesh_index_t scan = edge;
+    do
+    {
+        // set org
+        gb_index_mesh_edge_org_set(mesh, scan, org);
+
+        // the next edge
+        scan = mesh->edge_onext[scan];
+    }
+    while (scan != edge);
+}
+static __tb_inline__ tb_void_t gb_index_mesh_post_event(gb_index_mesh_ref_t mesh, tb_size_t type, gb_index_mesh_index_t org, gb_index_mesh_index_t dst)
+{
+    // this event is observing? done listener
+    if ((mesh->listener_events & type) && mesh->listener)
+    {
+        // init event
+        gb_index_mesh_event_t event = {type, org, dst, mesh->listener_priv};
+
+        // done event
+        mesh->listener(&event);
+    }
+}
+static gb_index_mesh_index_t gb_index_mesh_make_edge(gb_index_mesh_ref_t mesh, tb_bool_t is_loop, tb_bool_t is_ccw)
+{
+    // check
+    tb_assert_and_check_return_val(mesh, GB_INDEX_MESH_NULL);
+
+    // no free edge? grow it
+    if (!mesh->edge_free && !gb_index_mesh_grow_edges(mesh)) return GB_INDEX_MESH_NULL;
+    tb_assert_and_check_return_val(mesh->edge_free, GB_INDEX_MESH_NULL);
+
+    // pop a free edge
+    gb_index_mesh_index_t edge = mesh->edge_free;
+    gb_index_mesh_index_t edge_sym = edge ^ 1;
+    mesh->edge_free = mesh->edge_lnext[edge] & ~GB_INDEX_MESH_FREE;
+
+    // init the org and lface
+    mesh->edge_org[edge]        = GB_INDEX_MESH_NULL;
+    mesh->edge_org[edge_sym]    = GB_INDEX_MESH_NULL;
+    mesh->edge_lface[edge]      = GB_INDEX_MESH_NULL;
+    mesh->edge_lface[edge_sym]  = GB_INDEX_MESH_NULL;
+
+    // init the links
+    if (is_loop)
+    {
+        mesh->edge_onext[edge]      = edge_sym;
+        mesh->edge_lnext[edge]      = edge;
+        mesh->edge_onext[edge_sym]  = edge;
+        mesh->edge_lnext[edge_sym]  = edge_sym;
+    }
+    else
+    {
+        mesh->edge_onext[edge]      = edge;
+        mesh->edge_lnext[edge]      = edge_sym;
+        mesh->edge_onext[edge_sym]  = edge_sym;
+        mesh->edge_lnext[edge_sym]  = edge;
+    }
+
+    // clear the user data
+    if (mesh->edge_element.size) tb_memset(gb_index_mesh_edge_user(mesh, edge), 0, mesh->edge_element.size << 1);
+
+    // update size
+    mesh->edge_size++;
+
+    // clockwise loop? reverse it
+    if (is_loop && !is_ccw) edge = edge_sym;
+
+    // post the init event
+    gb_index_mesh_post_event(mesh, GB_MESH_EVENT_EDGE_INIT, edge, GB_INDEX_MESH_NULL);
+
+    // ok
+    return edge;
+}
+static gb_index_mesh_index_t gb_index_mesh_make_face(gb_index_mesh_ref_t mesh)
+{
+    // check
+    tb_assert_and_check_return_val(mesh, GB_INDEX_MESH_NULL);
+
+    // no free face? grow it
+    if (!mesh->face_free && !gb_index_mesh_grow_items(&mesh->face_edge, &mesh->face_maxn, &mesh->face_free, &mesh->face_data, mesh->face_element.size))
+        return GB_INDEX_MESH_NULL;
+    tb_assert_and_check_return_val(mesh->face_free, GB_INDEX_MESH_NULL);
+
+    // pop a free face
+    gb_index_mesh_index_t face = mesh->face_free;
+    mesh->face_free = mesh->face_edge[face] & ~GB_INDEX_MESH_FREE;
+    mesh->face_edge[face] = GB_INDEX_MESH_NULL;
+
+    // clear the user data
+    if (mesh->face_element.size) tb_memset(gb_index_mesh_face_user(mesh, face), 0, mesh->face_element.size);
+
+    // update size
+    mesh->face_size++;
+
+    // post the init event
+    gb_index_mesh_post_event(mesh, GB_MESH_EVENT_FACE_INIT, face, GB_INDEX_MESH_NULL);
+
+    // ok
+    return face;
+}
+static gb_index_mesh_index_t gb_index_mesh_make_face_at_orbit(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge)
+{
+    // make the new face
+    gb_index_mesh_index_t face_new = gb_index_mesh_make_face(mesh);
+    tb_assert_and_check_return_val(face_new, GB_INDEX_MESH_NULL);
+
+    // update left face for all edges in the orbit of the edge
+    gb_index_mesh_save_face_at_orbit(mesh, edge, face_new);
+
+    // ok
+    return face_new;
+}
+static gb_index_mesh_index_t gb_index_mesh_make_vertex(gb_index_mesh_ref_t mesh)
+{
+    // check
+    tb_assert_and_check_return_val(mesh, GB_INDEX_MESH_NULL);
+
+    // no free vertex? grow it
+    if (!mesh->vertex_free && !gb_index_mesh_grow_items(&mesh->vertex_edge, &mesh->vertex_maxn, &mesh->vertex_free, &mesh->vertex_data, mesh->vertex_element.size))
+        return GB_INDEX_MESH_NULL;
+    tb_assert_and_check_return_val(mesh->vertex_free, GB_INDEX_MESH_NULL);
+
+    // pop a free vertex
+    gb_index_mesh_index_t vertex = mesh->vertex_free;
+    mesh->vertex_free = mesh->vertex_edge[vertex] & ~GB_INDEX_MESH_FREE;
+    mesh->vertex_edge[vertex] = GB_INDEX_MESH_NULL;
+
+    // clear the user data
+    if (mesh->vertex_element.size) tb_memset(gb_index_mesh_vertex_user(mesh, vertex), 0, mesh->vertex_element.size);
+
+    // update size
+    mesh->vertex_size++;
+
+    // post the init event
+    gb_index_mesh_post_event(mesh, GB_MESH_EVENT_VERTEX_INIT, vertex, GB_INDEX_MESH_NULL);
+
+    // ok
+    return vertex;
+}
+static gb_index_mesh_index_t gb_index_mesh_make_vertex_at_orbit(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge)
+{
+    // make the new vertex
+    gb_index_mesh_index_t vertex_new = gb_index_mesh_make_vertex(mesh);
+    tb_assert_and_check_return_val(vertex_new, GB_INDEX_MESH_NULL);
+
+    // update origin for all edges leaving the orbit of the edge
+    gb_index_mesh_save_vertex_at_orbit(mesh, edge, vertex_new);
+
+    // ok
+    return vertex_new;
+}
+static tb_void_t gb_index_mesh_kill_edge(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge)
+{
+    // check
+    tb_assert_and_check_return(mesh && edge > 1);
+
+    // post the exit event
+    gb_index_mesh_post_event(mesh, GB_MESH_EVENT_EDGE_EXIT, edge, GB_INDEX_MESH_NULL);
+
+    // the first half-edge
+    edge &= ~1;
+
+    // free the user data
+    if (mesh->edge_element.free && mesh->edge_element.size)
+    {
+        mesh->edge_element.free(&mesh->edge_element, gb_index_mesh_edge_user(mesh, edge));
+        mesh->edge_element.free(&mesh->edge_element, gb_index_mesh_edge_user(mesh, edge ^ 1));
+    }
+
+    // push it to the free list
+    mesh->edge_lnext[edge]      = GB_INDEX_MESH_FREE | mesh->edge_free;
+    mesh->edge_lnext[edge ^ 1]  = GB_INDEX_MESH_FREE;
+    mesh->edge_free             = edge;
+
+    // update size
+    mesh->edge_size--;
+}
+static tb_void_t gb_index_mesh_kill_face(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t face)
+{
+    // check
+    tb_assert_and_check_return(mesh && face);
+
+    // post the exit event
+    gb_index_mesh_post_event(mesh, GB_MESH_EVENT_FACE_EXIT, face, GB_INDEX_MESH_NULL);
+
+    // free the user data
+    if (mesh->face_element.free && mesh->face_element.size)
+        mesh->face_element.free(&mesh->face_element, gb_index_mesh_face_user(mesh, face));
+
+    // push it to the free list
+    mesh->face_edge[face]   = GB_INDEX_MESH_FREE | mesh->face_free;
+    mesh->face_free         = face;
+
+    // update size
+    mesh->face_size--;
+}
+static tb_void_t gb_index_mesh_kill_face_at_orbit(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t face, gb_index_mesh_index_t face_new)
+{
+    // check
+    tb_assert_and_check_return(mesh && face);
+
+    // update lface for all edges leaving the deleted face
+    gb_index_mesh_save_face_at_orbit(mesh, mesh->face_edge[face], face_new);
+
+    // kill the face
+    gb_index_mesh_kill_face(mesh, face);
+}
+static tb_void_t gb_index_mesh_kill_vertex(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t vertex)
+{
+    // check
+    tb_assert_and_check_return(mesh && vertex);
+
+    // post the exit event
+    gb_index_mesh_post_event(mesh, GB_MESH_EVENT_VERTEX_EXIT, vertex, GB_INDEX_MESH_NULL);
+
+    // free the user data
+    if (mesh->vertex_element.free && mesh->vertex_element.size)
+        mesh->vertex_element.free(&mesh->vertex_element, gb_index_mesh_vertex_user(mesh, vertex));
+
+    // push it to the free list
+    mesh->vertex_edge[vertex]   = GB_INDEX_MESH_FREE | mesh->vertex_free;
+    mesh->vertex_free           = vertex;
+
+    // update size
+    mesh->vertex_size--;
+}
+static tb_void_t gb_index_mesh_kill_vertex_at_orbit(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t vertex, gb_index_mesh_index_t org_new)
+{
+    // check
+    tb_assert_and_check_return(mesh && vertex);
+
+    // update origin for all edges leaving the deleted vertex
+    gb_index_mesh_save_vertex_at_orbit(mesh, mesh->vertex_edge[vertex], org_new);
+
+    // kill the vertex
+    gb_index_mesh_kill_vertex(mesh, vertex);
+}
+static tb_bool_t gb_index_mesh_kill_isolated_edge(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge)
+{
+    // is isolated edge?
+    if (gb_index_mesh_edge_is_isolated(mesh, edge))
+    {
+        // check
+        tb_assert_abort(gb_index_mesh_edge_org(mesh, edge) != gb_index_mesh_edge_dst(mesh, edge));
+        tb_assert_abort(gb_index_mesh_edge_lface(mesh, edge) == gb_index_mesh_edge_rface(mesh, edge));
+
+        // kill the origin and destination vertices
+        gb_index_mesh_kill_vertex(mesh, gb_index_mesh_edge_org(mesh, edge));
+        gb_index_mesh_kill_vertex(mesh, gb_index_mesh_edge_dst(mesh, edge));
+
+        // kill the face
+        gb_index_mesh_kill_face(mesh, gb_index_mesh_edge_lface(mesh, edge));
+
+        // kill the edge
+        gb_index_mesh_kill_edge(mesh, edge);
+
+        // ok
+        return tb_true;
+    }
+    // is isolated loop edge?
+    else if (gb_index_mesh_edge_is_isolated_loop(mesh, edge))
+    {
+        // check
+        tb_assert_abort(gb_index_mesh_edge_org(mesh, edge) == gb_index_mesh_edge_dst(mesh, edge));
+        tb_assert_abort(gb_index_mesh_edge_lface(mesh, edge) != gb_index_mesh_edge_rface(mesh, edge));
+
+        // kill the vertex
+        gb_index_mesh_kill_vertex(mesh, gb_index_mesh_edge_org(mesh, edge));
+
+        // kill the left and right face
+        gb_index_mesh_kill_face(mesh, gb_index_mesh_edge_lface(mesh, edge));
+        gb_index_mesh_kill_face(mesh, gb_index_mesh_edge_rface(mesh, edge));
+
+        // kill the edge
+        gb_index_mesh_kill_edge(mesh, edge);
+
+        // ok
+        return tb_true;
+    }
+
+    // no isolated
+    return tb_false;
+}
+static tb_void_t gb_index_mesh_free_items(gb_index_mesh_index_t const* links, tb_size_t maxn, tb_byte_t* data, tb_element_ref_t element)
+{
+    // no user data or free func? ok
+    tb_check_return(links && data && element->size && element->free);
+
+    // free the user data of all valid items
+    tb_size_t item = 1;
+    for (item = 1; item < maxn; item++)
+    {
+        if (links[item] && !(links[item] & GB_INDEX_MESH_FREE))
+            element->free(element, data + item * element->size);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_index_mesh_ref_t gb_index_mesh_init(tb_element_t edge_element, tb_element_t face_element, tb_element_t vertex_element)
+{
+    // check
+    tb_assert_and_check_return_val(edge_element.data && edge_element.dupl && edge_element.repl, tb_null);
+    tb_assert_and_check_return_val(face_element.data && face_element.dupl && face_element.repl, tb_null);
+    tb_assert_and_check_return_val(vertex_element.data && vertex_element.dupl && vertex_element.repl, tb_null);
+
+    // make mesh
+    gb_index_mesh_ref_t mesh = tb_malloc0_type(gb_index_mesh_t);
+    tb_assert_and_check_return_val(mesh, tb_null);
+
+    // init elements, the storage will be allocated when making the first edge
+    mesh->edge_element      = edge_element;
+    mesh->face_element      = face_element;
+    mesh->vertex_element    = vertex_element;
+
+    // ok
+    return mesh;
+}
+tb_void_t gb_index_mesh_exit(gb_index_mesh_ref_t mesh)
+{
+    // check
+    tb_assert_and_check_return(mesh);
+
+    // clear it first for freeing the user data
+    gb_index_mesh_clear(mesh);
+
+    // exit edges
+    if (mesh->edge_org) tb_free(mesh->edge_org);
+    if (mesh->edge_lnext) tb_free(mesh->edge_lnext);
+    if (mesh->edge_onext) tb_free(mesh->edge_onext);
+    if (mesh->edge_lface) tb_free(mesh->edge_lface);
+    if (mesh->edge_data) tb_free(mesh->edge_data);
+
+    // exit faces
+    if (mesh->face_edge) tb_free(mesh->face_edge);
+    if (mesh->face_data) tb_free(mesh->face_data);
+
+    // exit vertices
+    if (mesh->vertex_edge) tb_free(mesh->vertex_edge);
+    if (mesh->vertex_data) tb_free(mesh->vertex_data);
+
+    // exit it
+    tb_free(mesh);
+}
+tb_void_t gb_index_mesh_clear(gb_index_mesh_ref_t mesh)
+{
+    // check
+    tb_assert_and_check_return(mesh);
+
+    // free the user data of all valid edges, faces and vertices
+    gb_index_mesh_free_items(mesh->edge_lnext, mesh->edge_maxn << 1, mesh->edge_data, &mesh->edge_element);
+    gb_index_mesh_free_items(mesh->face_edge, mesh->face_maxn, mesh->face_data, &mesh->face_element);
+    gb_index_mesh_free_items(mesh->vertex_edge, mesh->vertex_maxn, mesh->vertex_data, &mesh->vertex_element);
+
+    // reset the free lists and keep the storage
+    tb_size_t item = 0;
+    mesh->edge_free = GB_INDEX_MESH_NULL;
+    for (item = mesh->edge_maxn; item > 1; item--)
+    {
+        gb_index_mesh_index_t edge = (gb_index_mesh_index_t)((item - 1) << 1);
+        mesh->edge_lnext[edge]      = GB_INDEX_MESH_FREE | mesh->edge_free;
+        mesh->edge_lnext[edge ^ 1]  = GB_INDEX_MESH_FREE;
+        mesh->edge_free             = edge;
+    }
+    mesh->face_free = GB_INDEX_MESH_NULL;
+    for (item = mesh->face_maxn; item > 1; item--)
+    {
+        mesh->face_edge[item - 1]   = GB_INDEX_MESH_FREE | mesh->face_free;
+        mesh->face_free             = (gb_index_mesh_index_t)(item - 1);
+    }
+    mesh->vertex_free = GB_INDEX_MESH_NULL;
+    for (item = mesh->vertex_maxn; item > 1; item--)
+    {
+        mesh->vertex_edge[item - 1] = GB_INDEX_MESH_FREE | mesh->vertex_free;
+        mesh->vertex_free           = (gb_index_mesh_index_t)(item - 1);
+    }
+
+    // clear sizes
+    mesh->edge_size     = 0;
+    mesh->face_size     = 0;
+    mesh->vertex_size   = 0;
+}
+tb_bool_t gb_index_mesh_is_empty(gb_index_mesh_ref_t mesh)
+{
+    // check
+    tb_assert_and_check_return_val(mesh, tb_true);
+
+    // is empty?
+    return !mesh->edge_size && !mesh->face_size && !mesh->vertex_size;
+}
+tb_void_t gb_index_mesh_listener_set(gb_index_mesh_ref_t mesh, gb_index_mesh_listener_t listener, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return(mesh);
+
+    // set listener
+    mesh->listener      = listener;
+    mesh->listener_priv = priv;
+}
+tb_void_t gb_index_mesh_listener_event_add(gb_index_mesh_ref_t mesh, tb_size_t events)
+{
+    // check
+    tb_assert_and_check_return(mesh);
+
+    // add listener events
+    mesh->listener_events |= events;
+}
+tb_void_t gb_index_mesh_listener_event_del(gb_index_mesh_ref_t mesh, tb_size_t events)
+{
+    // check
+    tb_assert_and_check_return(mesh);
+
+    // delete listener events
+    mesh->listener_events &= ~events;
+}
+tb_cpointer_t gb_index_mesh_vertex_data(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t vertex)
+{
+    // check
+    tb_assert_and_check_return_val(mesh && mesh->vertex_element.data && gb_index_mesh_vertex_is_valid(mesh, vertex), tb_null);
+
+    // the user data
+    return mesh->vertex_element.data(&mesh->vertex_element, gb_index_mesh_vertex_user(mesh, vertex));
+}
+tb_void_t gb_index_mesh_vertex_data_set(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t vertex, tb_cpointer_t data)
+{
+    // check
+    tb_assert_and_check_return(mesh && mesh->vertex_element.repl && gb_index_mesh_vertex_is_valid(mesh, vertex));
+
+    // set the user data
+    mesh->vertex_element.repl(&mesh->vertex_element, gb_index_mesh_vertex_user(mesh, vertex), data);
+}
+tb_cpointer_t gb_index_mesh_face_data(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t face)
+{
+    // check
+    tb_assert_and_check_return_val(mesh && mesh->face_element.data && gb_index_mesh_face_is_valid(mesh, face), tb_null);
+
+    // the user data
+    return mesh->face_element.data(&mesh->face_element, gb_index_mesh_face_user(mesh, face));
+}
+tb_void_t gb_index_mesh_face_data_set(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t face, tb_cpointer_t data)
+{
+    // check
+    tb_assert_and_check_return(mesh && mesh->face_element.repl && gb_index_mesh_face_is_valid(mesh, face));
+
+    // set the user data
+    mesh->face_element.repl(&mesh->face_element, gb_index_mesh_face_user(mesh, face), data);
+}
+tb_cpointer_t gb_index_mesh_edge_data(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge)
+{
+    // check
+    tb_assert_and_check_return_val(mesh && mesh->edge_element.data && gb_index_mesh_edge_is_valid(mesh, edge), tb_null);
+
+    // the user data
+    return mesh->edge_element.data(&mesh->edge_element, gb_index_mesh_edge_user(mesh, edge));
+}
+tb_void_t gb_index_mesh_edge_data_set(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge, tb_cpointer_t data)
+{
+    // check
+    tb_assert_and_check_return(mesh && mesh->edge_element.repl && gb_index_mesh_edge_is_valid(mesh, edge));
+
+    // set the user data
+    mesh->edge_element.repl(&mesh->edge_element, gb_index_mesh_edge_user(mesh, edge), data);
+}
+gb_index_mesh_index_t gb_index_mesh_edge_make(gb_index_mesh_ref_t mesh)
+{
+    // check
+    tb_assert_and_check_return_val(mesh, GB_INDEX_MESH_NULL);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    gb_index_mesh_index_t   edge = GB_INDEX_MESH_NULL;
+    gb_index_mesh_index_t   face = GB_INDEX_MESH_NULL;
+    gb_index_mesh_index_t   org = GB_INDEX_MESH_NULL;
+    gb_index_mesh_index_t   dst = GB_INDEX_MESH_NULL;
+    do
+    {
+        // make the org
+        org = gb_index_mesh_make_vertex(mesh);
+        tb_assert_and_check_break(org);
+
+        // make the dst
+        dst = gb_index_mesh_make_vertex(mesh);
+        tb_assert_and_check_break(dst);
+
+        // make the face
+        face = gb_index_mesh_make_face(mesh);
+        tb_assert_and_check_break(face);
+
+        // make the edge
+        edge = gb_index_mesh_make_edge(mesh, tb_false, tb_false);
+        tb_assert_and_check_break(edge);
+
+        // init the edge
+        gb_index_mesh_edge_org_set  (mesh, edge, org);
+        gb_index_mesh_edge_lface_set(mesh, edge, face);
+
+        // init the sym edge
+        gb_index_mesh_edge_org_set  (mesh, edge ^ 1, dst);
+        gb_index_mesh_edge_lface_set(mesh, edge ^ 1, face);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // kill the org, dst, face and edge
+        if (org) gb_index_mesh_kill_vertex(mesh, org);
+        if (dst) gb_index_mesh_kill_vertex(mesh, dst);
+        if (face) gb_index_mesh_kill_face(mesh, face);
+        if (edge) gb_index_mesh_kill_edge(mesh, edge);
+        edge = GB_INDEX_MESH_NULL;
+    }
+
+    // ok?
+    return edge;
+}
+gb_index_mesh_index_t gb_index_mesh_edge_make_loop(gb_index_mesh_ref_t mesh, tb_bool_t is_ccw)
+{
+    // check
+    tb_assert_and_check_return_val(mesh, GB_INDEX_MESH_NULL);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    gb_index_mesh_index_t   edge = GB_INDEX_MESH_NULL;
+    gb_index_mesh_index_t   lface = GB_INDEX_MESH_NULL;
+    gb_index_mesh_index_t   rface = GB_INDEX_MESH_NULL;
+    gb_index_mesh_index_t   vertex = GB_INDEX_MESH_NULL;
+    do
+    {
+        // make the vertex
+        vertex = gb_index_mesh_make_vertex(mesh);
+        tb_assert_and_check_break(vertex);
+
+        // make the left face
+        lface = gb_index_mesh_make_face(mesh);
+        tb_assert_and_check_break(lface);
+
+        // make the right face
+        rface = gb_index_mesh_make_face(mesh);
+        tb_assert_and_check_break(rface);
+
+        // make the edge
+        edge = gb_index_mesh_make_edge(mesh, tb_true, is_ccw);
+        tb_assert_and_check_break(edge);
+
+        // init the edge
+        gb_index_mesh_edge_org_set  (mesh, edge, vertex);
+        gb_index_mesh_edge_lface_set(mesh, edge, lface);
+
+        // init the sym edge
+        gb_index_mesh_edge_org_set  (mesh, edge ^ 1, vertex);
+        gb_index_mesh_edge_lface_set(mesh, edge ^ 1, rface);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // kill the vertex, faces and edge
+        if (vertex) gb_index_mesh_kill_vertex(mesh, vertex);
+        if (lface) gb_index_mesh_kill_face(mesh, lface);
+        if (rface) gb_index_mesh_kill_face(mesh, rface);
+        if (edge) gb_index_mesh_kill_edge(mesh, edge);
+        edge = GB_INDEX_MESH_NULL;
+    }
+
+    // ok?
+    return edge;
+}
+gb_index_mesh_index_t gb_index_mesh_edge_split(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_org)
+{
+    // check
+    tb_assert_and_check_return_val(mesh && edge_org, GB_INDEX_MESH_NULL);
+
+    // check edge
+    gb_index_mesh_check_edge(mesh, edge_org);
+
+    // the general case? insert a new edge before the edge_org.dst and reverse it
+    gb_index_mesh_index_t edge_new = GB_INDEX_MESH_NULL;
+    gb_index_mesh_index_t edge_org_dprev = gb_index_mesh_edge_dprev(mesh, edge_org);
+    if (edge_org_dprev != edge_org)
+    {
+        // insert it
+        gb_index_mesh_index_t edge_new_sym = gb_index_mesh_edge_insert(mesh, edge_org_dprev, edge_org ^ 1);
+        tb_assert_and_check_return_val(edge_new_sym, GB_INDEX_MESH_NULL);
+
+        // reverse the new edge
+        edge_new = edge_new_sym ^ 1;
+    }
+    // the special case, see gb_mesh_edge_split()
+    else
+    {
+        // append a new edge
+        gb_index_mesh_index_t edge_new_sym = gb_index_mesh_edge_append(mesh, edge_org);
+        tb_assert_and_check_return_val(edge_new_sym, GB_INDEX_MESH_NULL);
+
+        // the new edge
+        edge_new = edge_new_sym ^ 1;
+
+        // splice(edge_org_sym, edge_new_sym) and splice(edge_org_sym, edge_new)
+        gb_index_mesh_index_t edge_org_sym = edge_org ^ 1;
+        gb_index_mesh_splice_edge(mesh, edge_org_sym, edge_new_sym);
+        gb_index_mesh_splice_edge(mesh, edge_org_sym, edge_new);
+
+        // update the edge_org.dst
+        gb_index_mesh_edge_dst_set(mesh, edge_org, gb_index_mesh_edge_org(mesh, edge_new));
+
+        // update the edge of edge_new.dst, may have pointed to edge_org_sym
+        gb_index_mesh_vertex_edge_set(mesh, gb_index_mesh_edge_dst(mesh, edge_new), edge_new_sym);
+
+        // update the faces of edge_new
+        gb_index_mesh_edge_lface_set(mesh, edge_new,        gb_index_mesh_edge_lface(mesh, edge_org));
+        gb_index_mesh_edge_lface_set(mesh, edge_new_sym,    gb_index_mesh_edge_lface(mesh, edge_org_sym));
+    }
+
+    // check
+    tb_assert_abort(gb_index_mesh_edge_dst(mesh, edge_org) == gb_index_mesh_edge_org(mesh, edge_new));
+
+    // post the split event, split(edge_org) => (edge_org, edge_new)
+    gb_index_mesh_post_event(mesh, GB_MESH_EVENT_EDGE_SPLIT, edge_org, edge_new);
+
+    // ok
+    return edge_new;
+}
+tb_void_t gb_index_mesh_edge_splice(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_org, gb_index_mesh_index_t edge_dst)
+{
+    // check
+    tb_assert_and_check_return(mesh && edge_org && edge_dst);
+
+    // check edges
+    gb_index_mesh_check_edge(mesh, edge_org);
+    gb_index_mesh_check_edge(mesh, edge_dst);
+
+    // done
+    tb_bool_t joining_faces = tb_false;
+    tb_bool_t joining_vertices = tb_false;
+    do
+    {
+        // is same? ok
+        tb_check_break(edge_org != edge_dst);
+
+        // two vertices are disjoint? joins them and remove the edge_dst.org first
+        if (gb_index_mesh_edge_org(mesh, edge_org) != gb_index_mesh_edge_org(mesh, edge_dst))
+        {
+            joining_vertices = tb_true;
+            gb_index_mesh_kill_vertex_at_orbit(mesh, gb_index_mesh_edge_org(mesh, edge_dst), gb_index_mesh_edge_org(mesh, edge_org));
+        }
+
+        // two faces are disjoint? joins them and remove the edge_dst.lface first
+        if (gb_index_mesh_edge_lface(mesh, edge_org) != gb_index_mesh_edge_lface(mesh, edge_dst))
+        {
+            joining_faces = tb_true;
+
+            // post the merge event, merge(edge_dst.lface, edge_org.lface) => edge_org.lface
+            gb_index_mesh_post_event(mesh, GB_MESH_EVENT_FACE_MERGE, gb_index_mesh_edge_lface(mesh, edge_dst), gb_index_mesh_edge_lface(mesh, edge_org));
+
+            // remove the edge_dst.lface
+            gb_index_mesh_kill_face_at_orbit(mesh, gb_index_mesh_edge_lface(mesh, edge_dst), gb_index_mesh_edge_lface(mesh, edge_org));
+        }
+
+        // splice two edges
+        gb_index_mesh_splice_edge(mesh, edge_dst, edge_org);
+
+        // two vertices are disjoint? make new vertex at edge_dst.org
+        if (!joining_vertices)
+        {
+            gb_index_mesh_index_t vertex_new = gb_index_mesh_make_vertex_at_orbit(mesh, edge_dst);
+            tb_assert_and_check_break(vertex_new);
+
+            // update the reference edge, the old reference edge may have been deleted
+            gb_index_mesh_vertex_edge_set(mesh, gb_index_mesh_edge_org(mesh, edge_org), edge_org);
+        }
+
+        // two faces are disjoint? make new face at edge_dst.lface
+        if (!joining_faces)
+        {
+            gb_index_mesh_index_t face_new = gb_index_mesh_make_face_at_orbit(mesh, edge_dst);
+            tb_assert_and_check_break(face_new);
+
+            // post the split event, split(edge_org.lface) => (edge_org.lface, face_new)
+            gb_index_mesh_post_event(mesh, GB_MESH_EVENT_FACE_SPLIT, gb_index_mesh_edge_lface(mesh, edge_org), face_new);
+
+            // update the reference edge, the old reference edge may have been deleted
+            gb_index_mesh_face_edge_set(mesh, gb_index_mesh_edge_lface(mesh, edge_org), edge_org);
+        }
+
+    } while (0);
+}
+gb_index_mesh_index_t gb_index_mesh_edge_append(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_org)
+{
+    // check
+    tb_assert_and_check_return_val(mesh && edge_org, GB_INDEX_MESH_NULL);
+
+    // check edge
+    gb_index_mesh_check_edge(mesh, edge_org);
+
+    // make the new non-loop edge
+    gb_index_mesh_index_t edge_new = gb_index_mesh_make_edge(mesh, tb_false, tb_false);
+    tb_assert_and_check_return_val(edge_new, GB_INDEX_MESH_NULL);
+
+    // append edge
+    gb_index_mesh_splice_edge(mesh, edge_new, gb_index_mesh_edge_lnext(mesh, edge_org));
+
+    // init the new edge
+    gb_index_mesh_edge_org_set  (mesh, edge_new,        gb_index_mesh_edge_dst(mesh, edge_org));
+    gb_index_mesh_edge_lface_set(mesh, edge_new,        gb_index_mesh_edge_lface(mesh, edge_org));
+    gb_index_mesh_edge_lface_set(mesh, edge_new ^ 1,    gb_index_mesh_edge_lface(mesh, edge_org));
+
+    // make the new vertex
+    if (!gb_index_mesh_make_vertex_at_orbit(mesh, edge_new ^ 1))
+    {
+        // kill the new edge
+        gb_index_mesh_kill_edge(mesh, edge_new);
+        edge_new = GB_INDEX_MESH_NULL;
+    }
+
+    // ok?
+    return edge_new;
+}
+gb_index_mesh_index_t gb_index_mesh_edge_insert(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_org, gb_index_mesh_index_t edge_dst)
+{
+    // check
+    tb_assert_and_check_return_val(mesh && edge_org && edge_dst, GB_INDEX_MESH_NULL);
+
+    // check edges
+    gb_index_mesh_check_edge(mesh, edge_org);
+    gb_index_mesh_check_edge(mesh, edge_dst);
+
+    // make the new clockwise self-loop edge
+    gb_index_mesh_index_t edge_new = gb_index_mesh_make_edge(mesh, tb_true, tb_false);
+    tb_assert_and_check_return_val(edge_new, GB_INDEX_MESH_NULL);
+
+    // insert the edge at vertex
+    gb_index_mesh_splice_edge(mesh, edge_dst, edge_new);
+    gb_index_mesh_splice_edge(mesh, edge_org ^ 1, edge_new ^ 1);
+
+    // init the new edge
+    gb_index_mesh_edge_org_set  (mesh, edge_new, gb_index_mesh_edge_dst(mesh, edge_org));
+    gb_index_mesh_edge_lface_set(mesh, edge_new, gb_index_mesh_edge_lface(mesh, edge_dst));
+    gb_index_mesh_edge_rface_set(mesh, edge_new, gb_index_mesh_edge_rface(mesh, edge_org));
+
+    // make the new vertex
+    if (!gb_index_mesh_make_vertex_at_orbit(mesh, edge_new ^ 1))
+    {
+        // kill the new edge
+        gb_index_mesh_kill_edge(mesh, edge_new);
+        edge_new = GB_INDEX_MESH_NULL;
+    }
+
+    // ok?
+    return edge_new;
+}
+tb_void_t gb_index_mesh_edge_remove(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_del)
+{
+    // check
+    tb_assert_and_check_return(mesh && edge_del);
+
+    // check edge
+    gb_index_mesh_check_edge(mesh, edge_del);
+
+    // isolated edge? kill it directly
+    if (gb_index_mesh_kill_isolated_edge(mesh, edge_del)) return ;
+
+    // get the destinate edge
+    gb_index_mesh_index_t edge_dst = gb_index_mesh_edge_lnext(mesh, edge_del);
+
+    // get the original sym edge
+    gb_index_mesh_index_t edge_sym_org = gb_index_mesh_edge_oprev(mesh, edge_del);
+
+    // the sym edge
+    gb_index_mesh_index_t edge_sym = edge_del ^ 1;
+
+    // use edge_sym_org for edge_dst if the destination vertex is isolated
+    if (edge_dst == edge_sym) edge_dst = edge_sym_org;
+    // use edge_dst for edge_sym_org if the original vertex is isolated
+    else if (edge_sym_org == edge_del)
+    {
+        // reverse edge
+        tb_swap(gb_index_mesh_index_t, edge_del, edge_sym);
+
+        // update edge_sym_org
+        edge_sym_org = edge_dst;
+    }
+
+    // kill the destination vertex of the edge
+    gb_index_mesh_kill_vertex_at_orbit(mesh, gb_index_mesh_edge_dst(mesh, edge_del), gb_index_mesh_edge_org(mesh, edge_sym_org));
+
+    // remove edge
+    gb_index_mesh_splice_edge(mesh, edge_sym_org,   edge_sym);
+    gb_index_mesh_splice_edge(mesh, edge_dst,       edge_del);
+
+    // update the reference edge, the old reference edge may have been deleted
+    gb_index_mesh_vertex_edge_set(mesh, gb_index_mesh_edge_org(mesh, edge_sym_org),   edge_sym_org);
+    gb_index_mesh_face_edge_set  (mesh, gb_index_mesh_edge_lface(mesh, edge_sym_org), edge_sym_org);
+    gb_index_mesh_face_edge_set  (mesh, gb_index_mesh_edge_lface(mesh, edge_dst),     edge_dst);
+
+    // kill the edge
+    gb_index_mesh_kill_edge(mesh, edge_del);
+}
+gb_index_mesh_index_t gb_index_mesh_edge_connect(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_org, gb_index_mesh_index_t edge_dst)
+{
+    // check
+    tb_assert_and_check_return_val(mesh && edge_org && edge_dst, GB_INDEX_MESH_NULL);
+
+    // check edges
+    gb_index_mesh_check_edge(mesh, edge_org);
+    gb_index_mesh_check_edge(mesh, edge_dst);
+
+    // make the new non-loop edge
+    gb_index_mesh_index_t edge_new = gb_index_mesh_make_edge(mesh, tb_false, tb_false);
+    tb_assert_and_check_return_val(edge_new, GB_INDEX_MESH_NULL);
+
+    // the new sym edge
+    gb_index_mesh_index_t edge_sym_new = edge_new ^ 1;
+
+    // two faces are disjoint?
+    tb_bool_t joining_faces = tb_false;
+    if (gb_index_mesh_edge_lface(mesh, edge_org) != gb_index_mesh_edge_lface(mesh, edge_dst))
+    {
+        // joins the two faces
+        joining_faces = tb_true;
+
+        // post the merge event, merge(edge_dst.lface, edge_org.lface) => edge_org.lface
+        gb_index_mesh_post_event(mesh, GB_MESH_EVENT_FACE_MERGE, gb_index_mesh_edge_lface(mesh, edge_dst), gb_index_mesh_edge_lface(mesh, edge_org));
+
+        // remove the edge_dst.lface first
+        gb_index_mesh_kill_face_at_orbit(mesh, gb_index_mesh_edge_lface(mesh, edge_dst), gb_index_mesh_edge_lface(mesh, edge_org));
+    }
+
+    // connect edge
+    gb_index_mesh_splice_edge(mesh, edge_new, gb_index_mesh_edge_lnext(mesh, edge_org));
+    gb_index_mesh_splice_edge(mesh, edge_sym_new, edge_dst);
+
+    // init the new edge
+    gb_index_mesh_edge_org_set  (mesh, edge_new,        gb_index_mesh_edge_dst(mesh, edge_org));
+    gb_index_mesh_edge_org_set  (mesh, edge_sym_new,    gb_index_mesh_edge_org(mesh, edge_dst));
+    gb_index_mesh_edge_lface_set(mesh, edge_sym_new,    gb_index_mesh_edge_lface(mesh, edge_org));
+
+    // two faces are disjoint?
+    if (!joining_faces)
+    {
+        // save the old face first, edge_org.lface may have been modified after making new face
+        gb_index_mesh_index_t face_old = gb_index_mesh_edge_lface(mesh, edge_org);
+
+        // make new face at edge_new.lface
+        gb_index_mesh_index_t face_new = gb_index_mesh_make_face_at_orbit(mesh, edge_new);
+        tb_assert_abort(face_new);
+
+        // post the split event, split(edge_org.lface) => (edge_org.lface, face_new)
+        gb_index_mesh_post_event(mesh, GB_MESH_EVENT_FACE_SPLIT, face_old, face_new);
+    }
+    // init the edge_new.lface
+    else gb_index_mesh_edge_lface_set(mesh, edge_new, gb_index_mesh_edge_lface(mesh, edge_org));
+
+    // ok
+    return edge_new;
+}
+tb_void_t gb_index_mesh_edge_delete(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_del)
+{
+    // check
+    tb_assert_and_check_return(mesh && edge_del);
+
+    // check edge
+    gb_index_mesh_check_edge(mesh, edge_del);
+
+    // two faces are disjoint?
+    tb_bool_t joining_faces = tb_false;
+    if (gb_index_mesh_edge_lface(mesh, edge_del) != gb_index_mesh_edge_rface(mesh, edge_del))
+    {
+        // joins the two faces
+        joining_faces = tb_true;
+
+        // post the merge event, merge(edge_del.lface, edge_del.rface) => edge_del.rface
+        gb_index_mesh_post_event(mesh, GB_MESH_EVENT_FACE_MERGE, gb_index_mesh_edge_lface(mesh, edge_del), gb_index_mesh_edge_rface(mesh, edge_del));
+
+        // remove the edge_del.lface first
+        gb_index_mesh_kill_face_at_orbit(mesh, gb_index_mesh_edge_lface(mesh, edge_del), gb_index_mesh_edge_rface(mesh, edge_del));
+    }
+
+    // the edge_del.org is isolated? remove it
+    if (gb_index_mesh_edge_onext(mesh, edge_del) == edge_del)
+        gb_index_mesh_kill_vertex_at_orbit(mesh, gb_index_mesh_edge_org(mesh, edge_del), GB_INDEX_MESH_NULL);
+    else
+    {
+        // update the reference edge, the old reference edge may have been invalid
+        gb_index_mesh_face_edge_set  (mesh, gb_index_mesh_edge_rface(mesh, edge_del),   gb_index_mesh_edge_oprev(mesh, edge_del));
+        gb_index_mesh_vertex_edge_set(mesh, gb_index_mesh_edge_org(mesh, edge_del),     gb_index_mesh_edge_onext(mesh, edge_del));
+
+        // disjoining edges at the edge_del.org
+        gb_index_mesh_splice_edge(mesh, edge_del, gb_index_mesh_edge_oprev(mesh, edge_del));
+
+        // two faces are disjoint?
+        if (!joining_faces)
+        {
+            // save the old face first, edge_del.lface may have been modified after making new face
+            gb_index_mesh_index_t face_old = gb_index_mesh_edge_lface(mesh, edge_del);
+
+            // make new face at edge_del.lface
+            gb_index_mesh_index_t face_new = gb_index_mesh_make_face_at_orbit(mesh, edge_del);
+            tb_assert_abort(face_new);
+
+            // post the split event, split(face_old) => (face_old, face_new)
+            gb_index_mesh_post_event(mesh, GB_MESH_EVENT_FACE_SPLIT, face_old, face_new);
+        }
+    }
+
+    // the sym edge
+    gb_index_mesh_index_t edge_sym = edge_del ^ 1;
+
+    // the deleted edge is isolated now? remove the edge_del.dst and face directly
+    if (gb_index_mesh_edge_onext(mesh, edge_sym) == edge_sym)
+    {
+        gb_index_mesh_kill_vertex_at_orbit(mesh, gb_index_mesh_edge_org(mesh, edge_sym), GB_INDEX_MESH_NULL);
+        gb_index_mesh_kill_face_at_orbit(mesh, gb_index_mesh_edge_lface(mesh, edge_sym), GB_INDEX_MESH_NULL);
+    }
+    else
+    {
+        // update the reference edge, the old reference edge may have been invalid
+        gb_index_mesh_face_edge_set  (mesh, gb_index_mesh_edge_lface(mesh, edge_del),   gb_index_mesh_edge_oprev(mesh, edge_sym));
+        gb_index_mesh_vertex_edge_set(mesh, gb_index_mesh_edge_org(mesh, edge_sym),     gb_index_mesh_edge_onext(mesh, edge_sym));
+
+        // disjoining edges at the edge_del.dst
+        gb_index_mesh_splice_edge(mesh, edge_sym, gb_index_mesh_edge_oprev(mesh, edge_sym));
+    }
+
+    // kill this edge
+    gb_index_mesh_kill_edge(mesh, edge_del);
+}
+#ifdef __gb_debug__
+tb_void_t gb_index_mesh_check(gb_index_mesh_ref_t mesh)
+{
+    // check
+    tb_assert_and_check_return(mesh);
+
+    // check all valid half-edges
+    tb_size_t edge = 2;
+    tb_size_t maxn = mesh->edge_maxn << 1;
+    for (edge = 2; edge < maxn; edge++)
+    {
+        // free?
+        tb_check_continue(gb_index_mesh_edge_is_valid(mesh, edge));
+
+        // the links
+        gb_index_mesh_index_t onext = mesh->edge_onext[edge];
+        gb_index_mesh_index_t lnext = mesh->edge_lnext[edge];
+
+        // check the orbits
+        tb_assert_abort(gb_index_mesh_edge_is_valid(mesh, onext) && gb_index_mesh_edge_is_valid(mesh, lnext));
+        tb_assert_abort(mesh->edge_lnext[onext ^ 1] == edge);
+
+        // check the vertex and face
+        tb_assert_abort(gb_index_mesh_vertex_is_valid(mesh, mesh->edge_org[edge]));
+        tb_assert_abort(gb_index_mesh_face_is_valid(mesh, mesh->edge_lface[edge]));
+        tb_assert_abort(mesh->edge_org[onext] == mesh->edge_org[edge]);
+        tb_assert_abort(mesh->edge_org[lnext] == mesh->edge_org[edge ^ 1]);
+        tb_assert_abort(mesh->edge_lface[lnext] == mesh->edge_lface[edge]);
+    }
+}
+#endif
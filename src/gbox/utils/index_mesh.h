@@ -0,0 +1,436 @@
+/*!The Graphic Box Library
+ *
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ *
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox;
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ *
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        index_mesh.h
+ * @ingroup     utils
+ *
+ */
+#ifndef GB_UTILS_INDEX_MESH_H
+#define GB_UTILS_INDEX_MESH_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "mesh.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the null edge/face/vertex index
+#define GB_INDEX_MESH_NULL                          (0)
+
+/// the free flag of the edge/face/vertex slot
+#define GB_INDEX_MESH_FREE                          (0x80000000)
+
+/// get the face edge
+#define gb_index_mesh_face_edge(mesh, face)         (tb_assert((mesh) && (face)), (mesh)->face_edge[face])
+
+/// get the vertex edge
+#define gb_index_mesh_vertex_edge(mesh, vertex)     (tb_assert((mesh) && (vertex)), (mesh)->vertex_edge[vertex])
+
+/// get the edge sym, the two half-edges of one edge are stored at (2k, 2k + 1)
+#define gb_index_mesh_edge_sym(edge)                ((edge) ^ 1)
+
+/// get the edge org
+#define gb_index_mesh_edge_org(mesh, edge)          (tb_assert((mesh) && (edge)), (mesh)->edge_org[edge])
+
+/// get the edge dst
+#define gb_index_mesh_edge_dst(mesh, edge)          (tb_assert((mesh) && (edge)), (mesh)->edge_org[(edge) ^ 1])
+
+/// get the edge lface
+#define gb_index_mesh_edge_lface(mesh, edge)        (tb_assert((mesh) && (edge)), (mesh)->edge_lface[edge])
+
+/// get the edge rface
+#define gb_index_mesh_edge_rface(mesh, edge)        (tb_assert((mesh) && (edge)), (mesh)->edge_lface[(edge) ^ 1])
+
+/// get the edge onext
+#define gb_index_mesh_edge_onext(mesh, edge)        (tb_assert((mesh) && (edge)), (mesh)->edge_onext[edge])
+
+/// get the edge oprev
+#define gb_index_mesh_edge_oprev(mesh, edge)        (tb_assert((mesh) && (edge)), (mesh)->edge_lnext[(edge) ^ 1])
+
+/// get the edge lnext
+#define gb_index_mesh_edge_lnext(mesh, edge)        (tb_assert((mesh) && (edge)), (mesh)->edge_lnext[edge])
+
+/// get the edge lprev
+#define gb_index_mesh_edge_lprev(mesh, edge)        (gb_index_mesh_edge_onext(mesh, edge) ^ 1)
+
+/// get the edge rnext
+#define gb_index_mesh_edge_rnext(mesh, edge)        (gb_index_mesh_edge_oprev(mesh, edge) ^ 1)
+
+/// get the edge rprev
+#define gb_index_mesh_edge_rprev(mesh, edge)        (gb_index_mesh_edge_onext(mesh, (edge) ^ 1))
+
+/// get the edge dnext
+#define gb_index_mesh_edge_dnext(mesh, edge)        (gb_index_mesh_edge_rprev(mesh, edge) ^ 1)
+
+/// get the edge dprev
+#define gb_index_mesh_edge_dprev(mesh, edge)        (gb_index_mesh_edge_lnext(mesh, edge) ^ 1)
+
+/// the edge is valid?
+#define gb_index_mesh_edge_is_valid(mesh, edge)     ((edge) > 1 && (edge) < ((mesh)->edge_maxn << 1) && (mesh)->edge_lnext[edge] && !((mesh)->edge_lnext[edge] & GB_INDEX_MESH_FREE))
+
+/// the face is valid?
+#define gb_index_mesh_face_is_valid(mesh, face)     ((face) && (face) < (mesh)->face_maxn && (mesh)->face_edge[face] && !((mesh)->face_edge[face] & GB_INDEX_MESH_FREE))
+
+/// the vertex is valid?
+#define gb_index_mesh_vertex_is_valid(mesh, vertex) ((vertex) && (vertex) < (mesh)->vertex_maxn && (mesh)->vertex_edge[vertex] && !((mesh)->vertex_edge[vertex] & GB_INDEX_MESH_FREE))
+
+/// the edge is isolated?
+#define gb_index_mesh_edge_is_isolated(mesh, edge)  \
+    (   gb_index_mesh_edge_onext(mesh, edge) == (edge) \
+    &&  gb_index_mesh_edge_onext(mesh, (edge) ^ 1) == ((edge) ^ 1) \
+    &&  gb_index_mesh_edge_lnext(mesh, edge) == ((edge) ^ 1) \
+    &&  gb_index_mesh_edge_lnext(mesh, (edge) ^ 1) == (edge))
+
+/// the edge is isolated loop?
+#define gb_index_mesh_edge_is_isolated_loop(mesh, edge)  \
+    (   gb_index_mesh_edge_onext(mesh, edge) == ((edge) ^ 1) \
+    &&  gb_index_mesh_edge_onext(mesh, (edge) ^ 1) == (edge) \
+    &&  gb_index_mesh_edge_lnext(mesh, edge) == (edge) \
+    &&  gb_index_mesh_edge_lnext(mesh, (edge) ^ 1) == ((edge) ^ 1))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the index mesh edge/face/vertex index type
+typedef tb_uint32_t                 gb_index_mesh_index_t;
+
+/*! the index mesh listener event type
+ *
+ * the event types are the same as gb_mesh_event_e
+ *
+ * <pre>
+ *
+ * init(org)
+ * exit(org)
+ * merge(org, dst) => dst
+ * split(org) => (org, dst)
+ *
+ * </pre>
+ */
+typedef struct __gb_index_mesh_event_t
+{
+    /// the event type
+    tb_size_t                       type;
+
+    /// the org edge/face/vertex
+    gb_index_mesh_index_t           org;
+
+    /// the dst edge/face/vertex
+    gb_index_mesh_index_t           dst;
+
+    /// the user private data
+    tb_cpointer_t                   priv;
+
+}gb_index_mesh_event_t, *gb_index_mesh_event_ref_t;
+
+/*! the index mesh listener type
+ *
+ * @param event                     the listener event
+ */
+typedef tb_void_t                   (*gb_index_mesh_listener_t)(gb_index_mesh_event_ref_t event);
+
+/*! the index mesh type
+ *
+ * the same half-edge data structure as gb_mesh_ref_t, but all links are the 32-bit indices
+ * and the hot fields are stored as the struct-of-arrays.
+ *
+ * <pre>
+ *
+ * edge:   0, 1 (null), 2, 3, 4, 5, ...     sym: edge ^ 1
+ * face:   0 (null), 1, 2, ...
+ * vertex: 0 (null), 1, 2, ...
+ *
+ * edge_org:   | x | x | org2  | org3  | org4  | ...
+ * edge_lnext: | x | x | lnext2| lnext3| lnext4| ...
+ * edge_onext: | x | x | onext2| onext3| onext4| ...
+ * edge_lface: | x | x | lface2| lface3| lface4| ...
+ *
+ * </pre>
+ *
+ * the edge costs 32 bytes (two half-edges) instead of the 96 bytes of gb_mesh_edge_t on 64-bit,
+ * and the traversal of the sweep only touches the packed arrays.
+ *
+ * @note the index of the removed edge/face/vertex will be reused by the next making
+ */
+typedef struct __gb_index_mesh_t
+{
+    /// the origin vertex of the half-edge
+    gb_index_mesh_index_t*          edge_org;
+
+    /// the next half-edge ccw around the left face
+    gb_index_mesh_index_t*          edge_lnext;
+
+    /// the next half-edge ccw around the origin
+    gb_index_mesh_index_t*          edge_onext;
+
+    /// the left face of the half-edge
+    gb_index_mesh_index_t*          edge_lface;
+
+    /// an arbitrary half-edge of the face
+    gb_index_mesh_index_t*          face_edge;
+
+    /// an arbitrary half-edge of the vertex
+    gb_index_mesh_index_t*          vertex_edge;
+
+    /// the maximum count of the edges (pairs of the half-edges), faces and vertices, include the null slot
+    tb_size_t                       edge_maxn;
+    tb_size_t                       face_maxn;
+    tb_size_t                       vertex_maxn;
+
+    /// the count of the edges, faces and vertices
+    tb_size_t                       edge_size;
+    tb_size_t                       face_size;
+    tb_size_t                       vertex_size;
+
+    /// the head of the free edges, faces and vertices
+    gb_index_mesh_index_t           edge_free;
+    gb_index_mesh_index_t           face_free;
+    gb_index_mesh_index_t           vertex_free;
+
+    /// the user data of the half-edges, faces and vertices
+    tb_byte_t*                      edge_data;
+    tb_byte_t*                      face_data;
+    tb_byte_t*                      vertex_data;
+
+    /// the element of the half-edges, faces and vertices
+    tb_element_t                    edge_element;
+    tb_element_t                    face_element;
+    tb_element_t                    vertex_element;
+
+    /// the listener
+    gb_index_mesh_listener_t        listener;
+
+    /// the listener events
+    tb_size_t                       listener_events;
+
+    /// the listener private data
+    tb_cpointer_t                   listener_priv;
+
+}gb_index_mesh_t, *gb_index_mesh_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the index mesh
+ *
+ * @param edge_element              the half-edge element
+ * @param face_element              the face element
+ * @param vertex_element            the vertex element
+ *
+ * @return                          the mesh
+ */
+gb_index_mesh_ref_t                 gb_index_mesh_init(tb_element_t edge_element, tb_element_t face_element, tb_element_t vertex_element);
+
+/*! exit the index mesh
+ *
+ * @param mesh                      the mesh
+ */
+tb_void_t                           gb_index_mesh_exit(gb_index_mesh_ref_t mesh);
+
+/*! clear the index mesh and keep the storage
+ *
+ * @param mesh                      the mesh
+ */
+tb_void_t                           gb_index_mesh_clear(gb_index_mesh_ref_t mesh);
+
+/*! is empty?
+ *
+ * @param mesh                      the mesh
+ *
+ * @return                          tb_true or tb_false
+ */
+tb_bool_t                           gb_index_mesh_is_empty(gb_index_mesh_ref_t mesh);
+
+/*! set the mesh listener
+ *
+ * @param mesh                      the mesh
+ * @param listener                  the listener
+ * @param priv                      the user private data
+ */
+tb_void_t                           gb_index_mesh_listener_set(gb_index_mesh_ref_t mesh, gb_index_mesh_listener_t listener, tb_cpointer_t priv);
+
+/*! add the mesh listener events
+ *
+ * @param mesh                      the mesh
+ * @param events                    the events, see gb_mesh_event_e
+ */
+tb_void_t                           gb_index_mesh_listener_event_add(gb_index_mesh_ref_t mesh, tb_size_t events);
+
+/*! delete the mesh listener events
+ *
+ * @param mesh                      the mesh
+ * @param events                    the events, see gb_mesh_event_e
+ */
+tb_void_t                           gb_index_mesh_listener_event_del(gb_index_mesh_ref_t mesh, tb_size_t events);
+
+/*! the vertex user data
+ *
+ * @param mesh                      the mesh
+ * @param vertex                    the vertex
+ *
+ * @return                          the vertex user data
+ */
+tb_cpointer_t                       gb_index_mesh_vertex_data(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t vertex);
+
+/*! set the vertex user data
+ *
+ * @param mesh                      the mesh
+ * @param vertex                    the vertex
+ * @param data                      the vertex user data
+ */
+tb_void_t                           gb_index_mesh_vertex_data_set(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t vertex, tb_cpointer_t data);
+
+/*! the face user data
+ *
+ * @param mesh                      the mesh
+ * @param face                      the face
+ *
+ * @return                          the face user data
+ */
+tb_cpointer_t                       gb_index_mesh_face_data(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t face);
+
+/*! set the face user data
+ *
+ * @param mesh                      the mesh
+ * @param face                      the face
+ * @param data                      the face user data
+ */
+tb_void_t                           gb_index_mesh_face_data_set(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t face, tb_cpointer_t data);
+
+/*! the half-edge user data
+ *
+ * @param mesh                      the mesh
+ * @param edge                      the half-edge
+ *
+ * @return                          the half-edge user data
+ */
+tb_cpointer_t                       gb_index_mesh_edge_data(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge);
+
+/*! set the half-edge user data
+ *
+ * @param mesh                      the mesh
+ * @param edge                      the half-edge
+ * @param data                      the half-edge user data
+ */
+tb_void_t                           gb_index_mesh_edge_data_set(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge, tb_cpointer_t data);
+
+/*! make a unconnected edge, see gb_mesh_edge_make()
+ *
+ * @param mesh                      the mesh
+ *
+ * @return                          the new edge, GB_INDEX_MESH_NULL if failed
+ */
+gb_index_mesh_index_t               gb_index_mesh_edge_make(gb_index_mesh_ref_t mesh);
+
+/*! make a self-loop edge, see gb_mesh_edge_make_loop()
+ *
+ * @param mesh                      the mesh
+ * @param is_ccw                    is counter-clockwise?
+ *
+ * @return                          the new edge, GB_INDEX_MESH_NULL if failed
+ */
+gb_index_mesh_index_t               gb_index_mesh_edge_make_loop(gb_index_mesh_ref_t mesh, tb_bool_t is_ccw);
+
+/*! split edge, see gb_mesh_edge_split()
+ *
+ * @param mesh                      the mesh
+ * @param edge_org                  the original edge
+ *
+ * @return                          the new edge, GB_INDEX_MESH_NULL if failed
+ */
+gb_index_mesh_index_t               gb_index_mesh_edge_split(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_org);
+
+/*! splice edge, see gb_mesh_edge_splice()
+ *
+ * @param mesh                      the mesh
+ * @param edge_org                  the original edge
+ * @param edge_dst                  the destination edge
+ */
+tb_void_t                           gb_index_mesh_edge_splice(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_org, gb_index_mesh_index_t edge_dst);
+
+/*! append edge after the destination of the edge_org, see gb_mesh_edge_append()
+ *
+ * @param mesh                      the mesh
+ * @param edge_org                  the original edge
+ *
+ * @return                          the new edge, GB_INDEX_MESH_NULL if failed
+ */
+gb_index_mesh_index_t               gb_index_mesh_edge_append(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_org);
+
+/*! insert edge between edge_org and edge_dst, see gb_mesh_edge_insert()
+ *
+ * @param mesh                      the mesh
+ * @param edge_org                  the original edge
+ * @param edge_dst                  the destination edge
+ *
+ * @return                          the new edge, GB_INDEX_MESH_NULL if failed
+ */
+gb_index_mesh_index_t               gb_index_mesh_edge_insert(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_org, gb_index_mesh_index_t edge_dst);
+
+/*! remove edge and merge its two vertices, see gb_mesh_edge_remove()
+ *
+ * @param mesh                      the mesh
+ * @param edge_del                  the removed edge
+ */
+tb_void_t                           gb_index_mesh_edge_remove(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_del);
+
+/*! connect edge_org.dst and edge_dst.org, see gb_mesh_edge_connect()
+ *
+ * @param mesh                      the mesh
+ * @param edge_org                  the original edge
+ * @param edge_dst                  the destination edge
+ *
+ * @return                          the new edge, GB_INDEX_MESH_NULL if failed
+ */
+gb_index_mesh_index_t               gb_index_mesh_edge_connect(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_org, gb_index_mesh_index_t edge_dst);
+
+/*! delete edge and merge its two faces, see gb_mesh_edge_delete()
+ *
+ * @param mesh                      the mesh
+ * @param edge_del                  the deleted edge
+ */
+tb_void_t                           gb_index_mesh_edge_delete(gb_index_mesh_ref_t mesh, gb_index_mesh_index_t edge_del);
+
+#ifdef __gb_debug__
+/*! check mesh
+ *
+ * @param mesh                      the mesh
+ */
+tb_void_t                           gb_index_mesh_check(gb_index_mesh_ref_t mesh);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
+
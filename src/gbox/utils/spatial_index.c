@@ -0,0 +1,383 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        spatial_index.c
+ * @ingroup     utils
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "spatial_index"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "spatial_index.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum children count of the node
+#define GB_SPATIAL_INDEX_NODE_MAXN      (16)
+
+// the items grow
+#ifdef __gb_small__
+#   define GB_SPATIAL_INDEX_ITEMS_GROW  (64)
+#else
+#   define GB_SPATIAL_INDEX_ITEMS_GROW  (256)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the spatial index item type
+typedef struct __gb_spatial_index_item_t
+{
+    // the bounds
+    gb_rect_t                   bounds;
+
+    // the item
+    tb_cpointer_t               item;
+
+}gb_spatial_index_item_t, *gb_spatial_index_item_ref_t;
+
+/* the spatial index node type
+ *
+ * the nodes are stored level by level: the items, the leaves, ..., the root
+ */
+typedef struct __gb_spatial_index_node_t
+{
+    // the bounds of the node
+    gb_rect_t                   bounds;
+
+    // the first child node index, the item index if it is the item node
+    tb_uint32_t                 first;
+
+    // the children count, zero for the item node
+    tb_uint32_t                 count;
+
+}gb_spatial_index_node_t, *gb_spatial_index_node_ref_t;
+
+// the spatial index impl type
+typedef struct __gb_spatial_index_impl_t
+{
+    // the items
+    tb_vector_ref_t             items;
+
+    // the nodes
+    gb_spatial_index_node_ref_t nodes;
+
+    // the nodes maxn
+    tb_size_t                   nodes_maxn;
+
+    // the root node index
+    tb_size_t                   root;
+
+    // the tree need be rebuilt?
+    tb_bool_t                   dirty;
+
+}gb_spatial_index_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_long_t gb_spatial_index_comp_x(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    // check
+    tb_assert_abort(litem && ritem);
+
+    // compare the x-coordinate of the center
+    gb_rect_ref_t   l = &((gb_spatial_index_node_ref_t)litem)->bounds;
+    gb_rect_ref_t   r = &((gb_spatial_index_node_ref_t)ritem)->bounds;
+    gb_float_t      lx = l->x + gb_half(l->w);
+    gb_float_t      rx = r->x + gb_half(r->w);
+    return lx < rx? -1 : (lx > rx);
+}
+static tb_long_t gb_spatial_index_comp_y(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    // check
+    tb_assert_abort(litem && ritem);
+
+    // compare the y-coordinate of the center
+    gb_rect_ref_t   l = &((gb_spatial_index_node_ref_t)litem)->bounds;
+    gb_rect_ref_t   r = &((gb_spatial_index_node_ref_t)ritem)->bounds;
+    gb_float_t      ly = l->y + gb_half(l->h);
+    gb_float_t      ry = r->y + gb_half(r->h);
+    return ly < ry? -1 : (ly > ry);
+}
+static tb_void_t gb_spatial_index_sort(gb_spatial_index_node_ref_t nodes, tb_size_t size)
+{
+    // check
+    tb_assert_abort(nodes && size);
+
+    // init iterator
+    tb_array_iterator_t array;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_mem(&array, nodes, size, sizeof(gb_spatial_index_node_t));
+
+    // sort all nodes by x
+    tb_quick_sort(iterator, 0, size, gb_spatial_index_comp_x);
+
+    /* the sort-tile-recursive packing
+     *
+     * split the nodes into sqrt(parents) vertical slices 
+     * and sort each slice by y, so the consecutive nodes of each parent are close
+     */
+    tb_size_t parents   = (size + GB_SPATIAL_INDEX_NODE_MAXN - 1) / GB_SPATIAL_INDEX_NODE_MAXN;
+    tb_size_t slices    = tb_isqrti((tb_uint32_t)parents);
+    if (slices * slices < parents) slices++;
+
+    // sort each slice by y
+    tb_size_t i = 0;
+    tb_size_t slice = slices * GB_SPATIAL_INDEX_NODE_MAXN;
+    for (i = 0; i < size; i += slice) tb_quick_sort(iterator, i, tb_min(i + slice, size), gb_spatial_index_comp_y);
+}
+static tb_bool_t gb_spatial_index_build(gb_spatial_index_impl_t* impl)
+{
+    // check
+    tb_assert_abort(impl && impl->items);
+
+    // no items?
+    tb_size_t size = tb_vector_size(impl->items);
+    if (!size)
+    {
+        impl->root  = -1;
+        impl->dirty = tb_false;
+        return tb_true;
+    }
+
+    // the nodes count of all levels
+    tb_size_t total = size;
+    tb_size_t level = size;
+    while (level > 1)
+    {
+        level = (level + GB_SPATIAL_INDEX_NODE_MAXN - 1) / GB_SPATIAL_INDEX_NODE_MAXN;
+        total += level;
+    }
+
+    // grow nodes
+    if (total > impl->nodes_maxn)
+    {
+        impl->nodes = tb_ralloc_type(impl->nodes, total, gb_spatial_index_node_t);
+        tb_assert_and_check_return_val(impl->nodes, tb_false);
+        impl->nodes_maxn = total;
+    }
+
+    // init the item nodes
+    tb_size_t                   i = 0;
+    gb_spatial_index_node_ref_t nodes = impl->nodes;
+    gb_spatial_index_item_ref_t items = (gb_spatial_index_item_ref_t)tb_vector_data(impl->items);
+    tb_assert_and_check_return_val(items, tb_false);
+    for (i = 0; i < size; i++)
+    {
+        nodes[i].bounds = items[i].bounds;
+        nodes[i].first  = (tb_uint32_t)i;
+        nodes[i].count  = 0;
+    }
+
+    // pack the nodes level by level until only the root is left
+    tb_size_t head = 0;
+    tb_size_t tail = size;
+    tb_size_t j = 0;
+    while (size > 1)
+    {
+        // sort the nodes of this level
+        gb_spatial_index_sort(nodes + head, size);
+
+        // make the parent nodes
+        for (i = 0; i < size; i += GB_SPATIAL_INDEX_NODE_MAXN)
+        {
+            gb_spatial_index_node_ref_t parent = &nodes[tail++];
+            parent->first   = (tb_uint32_t)(head + i);
+            parent->count   = (tb_uint32_t)tb_min(GB_SPATIAL_INDEX_NODE_MAXN, size - i);
+            parent->bounds  = nodes[parent->first].bounds;
+            for (j = 1; j < parent->count; j++) gb_rect_merge(&parent->bounds, &nodes[parent->first + j].bounds);
+        }
+
+        // the next level
+        head += size;
+        size = tail - head;
+    }
+    tb_assert_abort(tail == total);
+
+    // trace
+    tb_trace_d("build: %lu items, %lu nodes", tb_vector_size(impl->items), total);
+
+    // ok
+    impl->root  = head;
+    impl->dirty = tb_false;
+    return tb_true;
+}
+static tb_bool_t gb_spatial_index_query_node(gb_spatial_index_impl_t* impl, tb_size_t index, gb_rect_ref_t rect, gb_spatial_index_func_t func, tb_cpointer_t priv, tb_size_t* count)
+{
+    // the node
+    gb_spatial_index_node_ref_t node = &impl->nodes[index];
+
+    // not intersected? continue
+    gb_rect_ref_t bounds = &node->bounds;
+    if (    bounds->x > rect->x + rect->w
+        ||  bounds->y > rect->y + rect->h
+        ||  rect->x > bounds->x + bounds->w
+        ||  rect->y > bounds->y + bounds->h)
+        return tb_true;
+
+    // the item node? visit it
+    if (!node->count)
+    {
+        (*count)++;
+        gb_spatial_index_item_ref_t item = (gb_spatial_index_item_ref_t)tb_iterator_item(impl->items, node->first);
+        return func? func(node->first, &item->bounds, item->item, priv) : tb_true;
+    }
+
+    // query the children
+    tb_size_t i = 0;
+    for (i = 0; i < node->count; i++)
+    {
+        if (!gb_spatial_index_query_node(impl, node->first + i, rect, func, priv, count)) return tb_false;
+    }
+
+    // continue
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+gb_spatial_index_ref_t gb_spatial_index_init()
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    gb_spatial_index_impl_t*    impl = tb_null;
+    do
+    {
+        // make index
+        impl = tb_malloc0_type(gb_spatial_index_impl_t);
+        tb_assert_and_check_break(impl);
+
+        // init items
+        impl->items = tb_vector_init(GB_SPATIAL_INDEX_ITEMS_GROW, tb_element_mem(sizeof(gb_spatial_index_item_t), tb_null, tb_null));
+        tb_assert_and_check_break(impl->items);
+
+        // init root
+        impl->root = -1;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (impl) gb_spatial_index_exit((gb_spatial_index_ref_t)impl);
+        impl = tb_null;
+    }
+
+    // ok?
+    return (gb_spatial_index_ref_t)impl;
+}
+tb_void_t gb_spatial_index_exit(gb_spatial_index_ref_t index)
+{
+    // check
+    gb_spatial_index_impl_t* impl = (gb_spatial_index_impl_t*)index;
+    tb_assert_and_check_return(impl);
+
+    // exit nodes
+    if (impl->nodes) tb_free(impl->nodes);
+    impl->nodes = tb_null;
+
+    // exit items
+    if (impl->items) tb_vector_exit(impl->items);
+    impl->items = tb_null;
+
+    // exit it
+    tb_free(impl);
+}
+tb_void_t gb_spatial_index_clear(gb_spatial_index_ref_t index)
+{
+    // check
+    gb_spatial_index_impl_t* impl = (gb_spatial_index_impl_t*)index;
+    tb_assert_and_check_return(impl && impl->items);
+
+    // clear items
+    tb_vector_clear(impl->items);
+
+    // clear tree
+    impl->root  = -1;
+    impl->dirty = tb_false;
+}
+tb_size_t gb_spatial_index_size(gb_spatial_index_ref_t index)
+{
+    // check
+    gb_spatial_index_impl_t* impl = (gb_spatial_index_impl_t*)index;
+    tb_assert_and_check_return_val(impl && impl->items, 0);
+
+    // the items count
+    return tb_vector_size(impl->items);
+}
+tb_size_t gb_spatial_index_insert(gb_spatial_index_ref_t index, gb_rect_ref_t bounds, tb_cpointer_t item)
+{
+    // check
+    gb_spatial_index_impl_t* impl = (gb_spatial_index_impl_t*)index;
+    tb_assert_and_check_return_val(impl && impl->items && bounds, -1);
+
+    // insert it
+    gb_spatial_index_item_t data;
+    data.bounds = *bounds;
+    data.item   = item;
+    tb_vector_insert_tail(impl->items, &data);
+
+    // the tree need be rebuilt
+    impl->dirty = tb_true;
+
+    // the item index
+    return tb_vector_size(impl->items) - 1;
+}
+tb_size_t gb_spatial_index_query(gb_spatial_index_ref_t index, gb_rect_ref_t rect, gb_spatial_index_func_t func, tb_cpointer_t priv)
+{
+    // check
+    gb_spatial_index_impl_t* impl = (gb_spatial_index_impl_t*)index;
+    tb_assert_and_check_return_val(impl && rect, 0);
+
+    // rebuild the tree if the items are changed
+    if (impl->dirty && !gb_spatial_index_build(impl)) return 0;
+
+    // no items?
+    tb_check_return_val(impl->root != -1, 0);
+
+    // query it
+    tb_size_t count = 0;
+    gb_spatial_index_query_node(impl, impl->root, rect, func, priv, &count);
+    return count;
+}
+tb_size_t gb_spatial_index_query_point(gb_spatial_index_ref_t index, gb_point_ref_t point, gb_spatial_index_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(point, 0);
+
+    // query the empty rect at this point
+    gb_rect_t rect;
+    gb_rect_make(&rect, point->x, point->y, 0, 0);
+    return gb_spatial_index_query(index, &rect, func, priv);
+}
@@ -0,0 +1,143 @@
+/*!The Graphic Box Library
+ * 
+ * GBox is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2.1 of the License, or
+ * (at your option) any later version.
+ * 
+ * GBox is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with GBox; 
+ * If not, see <a href="http://www.gnu.org/licenses/"> http://www.gnu.org/licenses/</a>
+ * 
+ * Copyright (C) 2014 - 2015, ruki All rights reserved.
+ *
+ * @author      ruki
+ * @file        spatial_index.h
+ * @ingroup     utils
+ *
+ */
+#ifndef GB_UTILS_SPATIAL_INDEX_H
+#define GB_UTILS_SPATIAL_INDEX_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the spatial index ref type
+typedef struct{}*       gb_spatial_index_ref_t;
+
+/*! the spatial index query func type
+ *
+ * @param index         the item index in the insertion order
+ * @param bounds        the item bounds
+ * @param item          the item
+ * @param priv          the user private data
+ *
+ * @return              tb_true: continue, tb_false: break
+ */
+typedef tb_bool_t       (*gb_spatial_index_func_t)(tb_size_t index, gb_rect_ref_t bounds, tb_cpointer_t item, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the spatial index
+ *
+ * the spatial index is a static r-tree over the item bounds which is bulk-loaded by 
+ * the sort-tile-recursive algorithm on the first query after the items are changed,
+ * so it is suitable for the scene which is built once and queried many times, .e.g 
+ * the hit testing for the mouse events and the viewport culling.
+ *
+ * @code
+ * gb_spatial_index_ref_t index = gb_spatial_index_init();
+ * if (index)
+ * {
+ *     // insert the bounds of the shapes
+ *     for (i = 0; i < count; i++) gb_spatial_index_insert(index, gb_path_bounds(shapes[i]), shapes[i]);
+ *
+ *     // find the shapes under the cursor, the topmost shape is the last inserted one
+ *     gb_spatial_index_query_point(index, &cursor, func, tb_null);
+ *
+ *     // exit it
+ *     gb_spatial_index_exit(index);
+ * }
+ * @endcode
+ *
+ * @return              the spatial index
+ */
+gb_spatial_index_ref_t  gb_spatial_index_init(tb_noarg_t);
+
+/*! exit the spatial index
+ *
+ * @param index         the spatial index
+ */
+tb_void_t               gb_spatial_index_exit(gb_spatial_index_ref_t index);
+
+/*! clear all items
+ *
+ * @param index         the spatial index
+ */
+tb_void_t               gb_spatial_index_clear(gb_spatial_index_ref_t index);
+
+/*! the items count
+ *
+ * @param index         the spatial index
+ *
+ * @return              the items count
+ */
+tb_size_t               gb_spatial_index_size(gb_spatial_index_ref_t index);
+
+/*! insert the item, the tree will be rebuilt on the next query
+ *
+ * @param index         the spatial index
+ * @param bounds        the item bounds
+ * @param item          the item
+ *
+ * @return              the item index in the insertion order
+ */
+tb_size_t               gb_spatial_index_insert(gb_spatial_index_ref_t index, gb_rect_ref_t bounds, tb_cpointer_t item);
+
+/*! query the items whose bounds intersect the given rect
+ *
+ * the items are visited in the order of the tree, not the insertion order
+ *
+ * @param index         the spatial index
+ * @param rect          the rect
+ * @param func          the query func
+ * @param priv          the user private data
+ *
+ * @return              the visited items count
+ */
+tb_size_t               gb_spatial_index_query(gb_spatial_index_ref_t index, gb_rect_ref_t rect, gb_spatial_index_func_t func, tb_cpointer_t priv);
+
+/*! query the items whose bounds contain the given point
+ *
+ * @param index         the spatial index
+ * @param point         the point
+ * @param func          the query func
+ * @param priv          the user private data
+ *
+ * @return              the visited items count
+ */
+tb_size_t               gb_spatial_index_query_point(gb_spatial_index_ref_t index, gb_point_ref_t point, gb_spatial_index_func_t func, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
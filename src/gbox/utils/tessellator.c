@@ -44,6 +44,83 @@
 #   define GB_TESSELLATOR_OUTPUTS_GROW                          (64)
 #endif
 
+// the polygon count of the list task
+#ifdef __gb_small__
+#   define GB_TESSELLATOR_LIST_TASK_POLYGONS                    (16)
+#else
+#   define GB_TESSELLATOR_LIST_TASK_POLYGONS                    (64)
+#endif
+
+// the private data index of the thread pool worker for saving the worker tessellator
+#define GB_TESSELLATOR_LIST_WORKER_PRIV                         (TB_THREAD_POOL_WORKER_PRIV_MAXN - 1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the tessellator list contour type
+typedef struct __gb_tessellator_list_contour_t
+{
+    // the polygon index
+    tb_uint32_t                         index;
+
+    // the points count
+    tb_uint16_t                         count;
+
+}gb_tessellator_list_contour_t;
+
+// the tessellator list task type
+typedef struct __gb_tessellator_list_task_t
+{
+    // the mode
+    tb_size_t                           mode;
+
+    // the rule
+    tb_size_t                           rule;
+
+    // the polygons
+    gb_polygon_t const*                 polygons;
+
+    // the bounds
+    gb_rect_t const*                    bounds;
+
+    // the polygon start index
+    tb_size_t                           start;
+
+    // the polygon count
+    tb_size_t                           count;
+
+    // the current polygon index
+    tb_size_t                           index;
+
+    // the output points
+    tb_vector_ref_t                     points;
+
+    // the output contours
+    tb_vector_ref_t                     contours;
+
+    // the thread pool task
+    tb_thread_pool_task_ref_t           task;
+
+    // all polygons of this task have been tessellated?
+    tb_bool_t                           made;
+
+}gb_tessellator_list_task_t;
+
+// the tessellator list func wrapper type
+typedef struct __gb_tessellator_list_wrap_t
+{
+    // the polygon index
+    tb_size_t                           index;
+
+    // the func
+    gb_tessellator_list_func_t          func;
+
+    // the user private data
+    tb_cpointer_t                       priv;
+
+}gb_tessellator_list_wrap_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -171,6 +248,110 @@ static tb_void_t gb_tessellator_done_concave(gb_tessellator_impl_t* impl, gb_pol
     gb_tessellator_done_output(impl);
 }
 
+static tb_void_t gb_tessellator_list_task_save(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_tessellator_list_task_t* task = (gb_tessellator_list_task_t*)priv;
+    tb_assert_abort(task && task->points && task->contours && points && count);
+
+    // save points
+    tb_uint16_t i = 0;
+    for (i = 0; i < count; i++) tb_vector_insert_tail(task->points, points + i);
+
+    // save contour
+    gb_tessellator_list_contour_t contour;
+    contour.index = (tb_uint32_t)task->index;
+    contour.count = count;
+    tb_vector_insert_tail(task->contours, &contour);
+}
+static tb_void_t gb_tessellator_list_task_make(gb_tessellator_list_task_t* task, gb_tessellator_ref_t tessellator)
+{
+    // check
+    tb_assert_abort(task && task->polygons && task->bounds && tessellator);
+
+    // init mode and rule
+    gb_tessellator_mode_set(tessellator, task->mode);
+    gb_tessellator_rule_set(tessellator, task->rule);
+
+    // init func
+    gb_tessellator_func_set(tessellator, gb_tessellator_list_task_save, task);
+
+    // done
+    tb_size_t index = task->start;
+    tb_size_t last  = task->start + task->count;
+    for (; index < last; index++)
+    {
+        // save the current polygon index
+        task->index = index;
+
+        // tessellate this polygon
+        gb_tessellator_done(tessellator, (gb_polygon_ref_t)&task->polygons[index], (gb_rect_ref_t)&task->bounds[index]);
+    }
+
+    // ok
+    task->made = tb_true;
+}
+static tb_void_t gb_tessellator_list_worker_exit(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // exit the worker tessellator
+    if (priv) gb_tessellator_exit((gb_tessellator_ref_t)priv);
+}
+static tb_void_t gb_tessellator_list_task_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // check
+    gb_tessellator_list_task_t* task = (gb_tessellator_list_task_t*)priv;
+    tb_assert_abort(worker && task);
+
+    // get the tessellator of this worker 
+    gb_tessellator_ref_t tessellator = (gb_tessellator_ref_t)tb_thread_pool_worker_getp(worker, GB_TESSELLATOR_LIST_WORKER_PRIV);
+    if (!tessellator)
+    {
+        // init it, this task will be made on the calling thread if failed
+        tessellator = gb_tessellator_init();
+        tb_assert_and_check_return(tessellator);
+
+        // save it to the worker and it will be exited when the worker is exited
+        tb_thread_pool_worker_setp(worker, GB_TESSELLATOR_LIST_WORKER_PRIV, gb_tessellator_list_worker_exit, tessellator);
+    }
+
+    // make this task
+    gb_tessellator_list_task_make(task, tessellator);
+}
+static tb_void_t gb_tessellator_list_wrap_func(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv)
+{
+    // check
+    gb_tessellator_list_wrap_t* wrap = (gb_tessellator_list_wrap_t*)priv;
+    tb_assert_abort(wrap && wrap->func);
+
+    // done func
+    wrap->func(wrap->index, points, count, wrap->priv);
+}
+static tb_void_t gb_tessellator_done_list_direct(gb_tessellator_impl_t* impl, gb_polygon_t const* polygons, gb_rect_t const* bounds, tb_size_t start, tb_size_t count, gb_tessellator_list_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_abort(impl && polygons && bounds && func);
+
+    // save the func of the tessellator
+    gb_tessellator_func_t   func_saved = impl->func;
+    tb_cpointer_t           priv_saved = impl->priv;
+
+    // init the func wrapper
+    gb_tessellator_list_wrap_t wrap;
+    wrap.index  = 0;
+    wrap.func   = func;
+    wrap.priv   = priv;
+    impl->func  = gb_tessellator_list_wrap_func;
+    impl->priv  = &wrap;
+
+    // done
+    for (wrap.index = start; wrap.index < start + count; wrap.index++)
+        gb_tessellator_done((gb_tessellator_ref_t)impl, (gb_polygon_ref_t)&polygons[wrap.index], (gb_rect_ref_t)&bounds[wrap.index]);
+
+    // restore the func of the tessellator
+    impl->func = func_saved;
+    impl->priv = priv_saved;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -265,3 +446,117 @@ tb_void_t gb_tessellator_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t
         gb_tessellator_done_concave(impl, polygon, bounds);
     }
 }
+tb_void_t gb_tessellator_done_list(gb_tessellator_ref_t tessellator, gb_polygon_t const* polygons, gb_rect_t const* bounds, tb_size_t count, tb_thread_pool_ref_t pool, gb_tessellator_list_func_t func, tb_cpointer_t priv)
+{
+    // check
+    gb_tessellator_impl_t* impl = (gb_tessellator_impl_t*)tessellator;
+    tb_assert_abort_and_check_return(impl && polygons && bounds && func);
+
+    // empty?
+    tb_check_return(count);
+
+    // the task count
+    tb_size_t task_count = (count + GB_TESSELLATOR_LIST_TASK_POLYGONS - 1) / GB_TESSELLATOR_LIST_TASK_POLYGONS;
+
+    // using the default thread pool if be null
+    if (!pool && task_count > 1) pool = tb_thread_pool();
+
+    // too small? tessellate it on the calling thread directly
+    if (!pool || task_count < 2)
+    {
+        gb_tessellator_done_list_direct(impl, polygons, bounds, 0, count, func, priv);
+        return ;
+    }
+
+    // init tasks, tessellate it on the calling thread directly if failed
+    gb_tessellator_list_task_t* tasks = tb_nalloc0_type(task_count, gb_tessellator_list_task_t);
+    if (!tasks)
+    {
+        gb_tessellator_done_list_direct(impl, polygons, bounds, 0, count, func, priv);
+        return ;
+    }
+
+    // post tasks
+    tb_size_t i = 0;
+    for (i = 0; i < task_count; i++)
+    {
+        // init task
+        gb_tessellator_list_task_t* task = &tasks[i];
+        task->mode      = impl->mode;
+        task->rule      = impl->rule;
+        task->polygons  = polygons;
+        task->bounds    = bounds;
+        task->start     = i * GB_TESSELLATOR_LIST_TASK_POLYGONS;
+        task->count     = tb_min(count - task->start, GB_TESSELLATOR_LIST_TASK_POLYGONS);
+        task->points    = tb_vector_init(GB_TESSELLATOR_OUTPUTS_GROW, tb_element_mem(sizeof(gb_point_t), tb_null, tb_null));
+        task->contours  = tb_vector_init(GB_TESSELLATOR_OUTPUTS_GROW, tb_element_mem(sizeof(gb_tessellator_list_contour_t), tb_null, tb_null));
+
+        // no outputs? this task will be tessellated on the calling thread directly later
+        if (!task->points || !task->contours)
+        {
+            if (task->points) tb_vector_exit(task->points);
+            if (task->contours) tb_vector_exit(task->contours);
+            task->points    = tb_null;
+            task->contours  = tb_null;
+            continue ;
+        }
+
+        // post it, will be made on the calling thread later if failed
+        task->task = tb_thread_pool_task_init(pool, "tessellator", gb_tessellator_list_task_done, tb_null, task, tb_false);
+    }
+
+    // wait tasks and output the results in the submission order
+    for (i = 0; i < task_count; i++)
+    {
+        // the task
+        gb_tessellator_list_task_t* task = &tasks[i];
+
+        // wait it
+        if (task->task)
+        {
+            tb_thread_pool_task_wait(pool, task->task, -1);
+            tb_thread_pool_task_exit(pool, task->task);
+            task->task = tb_null;
+        }
+
+        // the worker has not made it? make it on the calling thread
+        if (!task->made && task->points && task->contours)
+        {
+            // save the func of the tessellator
+            gb_tessellator_func_t   func_saved = impl->func;
+            tb_cpointer_t           priv_saved = impl->priv;
+
+            // make it
+            gb_tessellator_list_task_make(task, tessellator);
+
+            // restore the func of the tessellator
+            impl->func = func_saved;
+            impl->priv = priv_saved;
+        }
+
+        // output the contours of this task
+        if (task->made)
+        {
+            gb_point_ref_t points = (gb_point_ref_t)tb_vector_data(task->points);
+            tb_for_all_if (gb_tessellator_list_contour_t*, contour, task->contours, contour && points)
+            {
+                // done func
+                func(contour->index, points, contour->count, priv);
+
+                // the next contour
+                points += contour->count;
+            }
+        }
+        // no outputs? tessellate it on the calling thread directly
+        else gb_tessellator_done_list_direct(impl, polygons, bounds, task->start, task->count, func, priv);
+
+        // exit points and contours
+        if (task->points) tb_vector_exit(task->points);
+        if (task->contours) tb_vector_exit(task->contours);
+        task->points    = tb_null;
+        task->contours  = tb_null;
+    }
+
+    // exit tasks
+    tb_free(tasks);
+}
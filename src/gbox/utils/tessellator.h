@@ -124,6 +124,15 @@ typedef struct{}*       gb_tessellator_ref_t;
  */
 typedef tb_void_t       (*gb_tessellator_func_t)(gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv);
 
+/*! the polygon list tessellator func type
+ *
+ * @param index         the polygon index in the list
+ * @param points        the points of the contour
+ * @param count         the points count of the contour
+ * @param priv          the user private data
+ */
+typedef tb_void_t       (*gb_tessellator_list_func_t)(tb_size_t index, gb_point_ref_t points, tb_uint16_t count, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -170,6 +179,27 @@ tb_void_t               gb_tessellator_func_set(gb_tessellator_ref_t tessellator
  */
 tb_void_t               gb_tessellator_done(gb_tessellator_ref_t tessellator, gb_polygon_ref_t polygon, gb_rect_ref_t bounds);
 
+/*! done the tessellator for the polygon list in parallel
+ *
+ * the polygons are split into some tasks and tessellated on the workers of the thread pool, 
+ * each worker has its own tessellator and mesh, the mode and rule are inherited from the given tessellator.
+ *
+ * the results are passed to the func on the calling thread in the submission order,
+ * and the polygon list will be tessellated on the calling thread directly if it is too small.
+ *
+ * all polygons are always output, the task which cannot be posted or allocated
+ * will be tessellated on the calling thread after waiting the other tasks.
+ *
+ * @param tessellator   the tessellator
+ * @param polygons      the polygon list
+ * @param bounds        the polygon bounds list
+ * @param count         the polygon count
+ * @param pool          the thread pool, uses tb_thread_pool() if be null
+ * @param func          the list func
+ * @param priv          the user private data
+ */
+tb_void_t               gb_tessellator_done_list(gb_tessellator_ref_t tessellator, gb_polygon_t const* polygons, gb_rect_t const* bounds, tb_size_t count, tb_thread_pool_ref_t pool, gb_tessellator_list_func_t func, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -27,8 +27,10 @@
  * includes
  */
 #include "mesh.h"
+#include "index_mesh.h"
 #include "geometry.h"
 #include "tessellator.h"
+#include "spatial_index.h"
 
 #endif
 
@@ -62,6 +62,7 @@ add_target("gbox")
     if modes("debug") then add_files("utils/impl/tessellator/profiler.c") end
 
     -- add the source files for device
+    add_files("core/device/record.c")
     if options("opengl") then add_files("core/device/gl.c", "core/device/gl/**.c") end
     if options("bitmap") then add_files("core/device/bitmap.c", "core/device/bitmap/**.c") end
     if options("skia") then add_files("core/device/skia.cpp") end
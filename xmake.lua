@@ -112,9 +112,17 @@ add_option("demo")
     set_option_category("option")
     set_option_description("Enable or disable the demo module")
 
+-- add option: bench
+add_option("bench")
+    set_option_enable(false)
+    set_option_showmenu(true)
+    set_option_category("option")
+    set_option_description("Enable or disable the bench module")
+
 -- add packages
 add_pkgdirs("pkg") 
 
 -- add projects
 add_subdirs("src/gbox") 
 if options("demo") then add_subdirs("src/demo") end
+if options("bench") then add_subdirs("src/bench") end